@@ -258,7 +258,7 @@ class ${exportMacro}${LEXERCLASS} : public DSNLEXER
 {
     /// Auto generated lexer keywords table and length:
     static const KEYWORD  keywords[];
-    static const KEYWORD_MAP keywords_hash;
+    static const KEYWORD_PERFECT_HASH keywords_hash;
     static const unsigned keyword_count;
 
 public:
@@ -420,25 +420,6 @@ const char* ${LEXERCLASS}::TokenName( T aTok )
 file( APPEND "${outCppFile}"
 "
 
-const KEYWORD_MAP ${LEXERCLASS}::keywords_hash({
+const KEYWORD_PERFECT_HASH ${LEXERCLASS}::keywords_hash( keywords, keyword_count );
 "
 )
-
-set( TOKEN_NUM 0 )
-
-math( EXPR tokensAfter "${tokensAfter} - 1" )
-
-foreach( token ${tokens} )
-    file(APPEND "${outCppFile}" "    { \"${token}\", ${TOKEN_NUM} }" )
-
-    if( TOKEN_NUM EQUAL tokensAfter )
-        file( APPEND "${outCppFile}" "\n" )
-    else( TOKEN_NUM EQUAL tokensAfter )
-        file( APPEND "${outCppFile}" ",\n" )
-    endif()
-
-    math( EXPR TOKEN_NUM "${TOKEN_NUM} + 1" )
-endforeach()
-
-file( APPEND "${outCppFile}"
-"});")
@@ -62,6 +62,9 @@ namespace AC_KEYS
 {
 
 static const wxChar IncrementalConnectivity[] = wxT( "IncrementalConnectivity" );
+static const wxChar IncrementalConnectivityVerify[] = wxT( "IncrementalConnectivityVerify" );
+static const wxChar SymbolLibraryIndex[] = wxT( "SymbolLibraryIndex" );
+static const wxChar FootprintLibraryIndex[] = wxT( "FootprintLibraryIndex" );
 static const wxChar Use3DConnexionDriver[] = wxT( "3DConnexionDriver" );
 static const wxChar ExtraFillMargin[] = wxT( "ExtraFillMargin" );
 static const wxChar EnableCreepageSlot[] = wxT( "EnableCreepageSlot" );
@@ -69,12 +72,16 @@ static const wxChar DRCEpsilon[] = wxT( "DRCEpsilon" );
 static const wxChar DRCSliverWidthTolerance[] = wxT( "DRCSliverWidthTolerance" );
 static const wxChar DRCSliverMinimumLength[] = wxT( "DRCSliverMinimumLength" );
 static const wxChar DRCSliverAngleTolerance[] = wxT( "DRCSliverAngleTolerance" );
+static const wxChar DRCParallelProviders[] = wxT( "DRCParallelProviders" );
+static const wxChar DRCBatchBroadPhase[] = wxT( "DRCBatchBroadPhase" );
 static const wxChar HoleWallThickness[] = wxT( "HoleWallPlatingThickness" );
 static const wxChar CoroutineStackSize[] = wxT( "CoroutineStackSize" );
 static const wxChar ShowRouterDebugGraphics[] = wxT( "ShowRouterDebugGraphics" );
 static const wxChar EnableRouterDump[] = wxT( "EnableRouterDump" );
 static const wxChar HyperZoom[] = wxT( "HyperZoom" );
 static const wxChar CompactFileSave[] = wxT( "CompactSave" );
+static const wxChar ParallelBoardLoad[] = wxT( "ParallelBoardLoad" );
+static const wxChar ParallelBoardSave[] = wxT( "ParallelBoardSave" );
 static const wxChar DrawArcAccuracy[] = wxT( "DrawArcAccuracy" );
 static const wxChar DrawArcCenterStartEndMaxAngle[] = wxT( "DrawArcCenterStartEndMaxAngle" );
 static const wxChar MaxTangentTrackAngleDeviation[] = wxT( "MaxTangentTrackAngleDeviation" );
@@ -82,7 +89,11 @@ static const wxChar MaxTrackLengthToKeep[] = wxT( "MaxTrackLengthToKeep" );
 static const wxChar StrokeTriangulation[] = wxT( "StrokeTriangulation" );
 static const wxChar ExtraZoneDisplayModes[] = wxT( "ExtraZoneDisplayModes" );
 static const wxChar MinPlotPenWidth[] = wxT( "MinPlotPenWidth" );
+static const wxChar ParallelGerberPlot[] = wxT( "ParallelGerberPlot" );
+static const wxChar ParallelODBPPExport[] = wxT( "ParallelODBPPExport" );
 static const wxChar DebugZoneFiller[] = wxT( "DebugZoneFiller" );
+static const wxChar IncrementalZoneFill[] = wxT( "IncrementalZoneFill" );
+static const wxChar ZoneFillTileThreshold[] = wxT( "ZoneFillTileThreshold" );
 static const wxChar DebugPDFWriter[] = wxT( "DebugPDFWriter" );
 static const wxChar SmallDrillMarkSize[] = wxT( "SmallDrillMarkSize" );
 static const wxChar HotkeysDumper[] = wxT( "HotkeysDumper" );
@@ -235,14 +246,20 @@ ADVANCED_CFG::ADVANCED_CFG()
     m_SliverWidthTolerance      = 0.08;
     m_SliverMinimumLength       = 0.0008;
     m_SliverAngleTolerance      = 20.0;
+    m_DRCParallelProviders      = true;
+    m_DRCBatchBroadPhase        = true;
 
     m_HoleWallThickness         = 0.020;    // IPC-6012 says 15-18um; Cadence says at least
                                             // 0.020 for a Class 2 board and at least 0.025
                                             // for Class 3.
 
     m_MinPlotPenWidth           = 0.0212;   // 1 pixel at 1200dpi.
+    m_ParallelGerberPlot        = false;
+    m_ParallelODBPPExport       = true;
 
     m_DebugZoneFiller           = false;
+    m_IncrementalZoneFill       = false;
+    m_ZoneFillTileThreshold     = 0;
     m_DebugPDFWriter            = false;
     m_SmallDrillMarkSize        = 0.35;
     m_HotkeysDumper             = false;
@@ -255,6 +272,8 @@ ADVANCED_CFG::ADVANCED_CFG()
     m_ShowEventCounters         = false;
     m_AllowManualCanvasScale    = false;
     m_CompactSave               = false;
+    m_ParallelBoardLoad         = false;
+    m_ParallelBoardSave         = true;
     m_UpdateUIEventInterval     = 0;
     m_ShowRepairSchematic       = false;
     m_EnablePcbDesignBlocks     = false;
@@ -271,6 +290,9 @@ ADVANCED_CFG::ADVANCED_CFG()
     m_Use3DConnexionDriver      = true;
 
     m_IncrementalConnectivity   = true;
+    m_IncrementalConnectivityVerify = false;
+    m_SymbolLibraryIndex = true;
+    m_FootprintLibraryIndex = true;
 
     m_DisambiguationMenuDelay   = 500;
 
@@ -378,6 +400,12 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
                                                   &m_SliverAngleTolerance, m_SliverAngleTolerance,
                                                   1.0, 90.0 ) );
 
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::DRCParallelProviders,
+                                                &m_DRCParallelProviders, m_DRCParallelProviders ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::DRCBatchBroadPhase,
+                                                &m_DRCBatchBroadPhase, m_DRCBatchBroadPhase ) );
+
     configParams.push_back( new PARAM_CFG_DOUBLE( true, AC_KEYS::HoleWallThickness,
                                                   &m_HoleWallThickness, m_HoleWallThickness,
                                                   0.0, 1.0 ) );
@@ -403,6 +431,12 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
     configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::CompactFileSave,
                                                 &m_CompactSave, m_CompactSave ) );
 
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ParallelBoardLoad,
+                                                &m_ParallelBoardLoad, m_ParallelBoardLoad ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ParallelBoardSave,
+                                                &m_ParallelBoardSave, m_ParallelBoardSave ) );
+
     configParams.push_back( new PARAM_CFG_DOUBLE( true, AC_KEYS::DrawArcAccuracy,
                                                   &m_DrawArcAccuracy, m_DrawArcAccuracy,
                                                   0.0, 100000.0 ) );
@@ -431,9 +465,23 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
                                                   &m_MinPlotPenWidth, m_MinPlotPenWidth,
                                                   0.0, 1.0 ) );
 
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ParallelGerberPlot,
+                                                &m_ParallelGerberPlot, m_ParallelGerberPlot ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ParallelODBPPExport,
+                                                &m_ParallelODBPPExport, m_ParallelODBPPExport ) );
+
     configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::DebugZoneFiller,
                                                 &m_DebugZoneFiller, m_DebugZoneFiller ) );
 
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::IncrementalZoneFill,
+                                                &m_IncrementalZoneFill,
+                                                m_IncrementalZoneFill ) );
+
+    configParams.push_back( new PARAM_CFG_INT( true, AC_KEYS::ZoneFillTileThreshold,
+                                               &m_ZoneFillTileThreshold,
+                                               m_ZoneFillTileThreshold, 0, 10000000 ) );
+
     configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::DebugPDFWriter,
                                                 &m_DebugPDFWriter, m_DebugPDFWriter ) );
 
@@ -488,6 +536,17 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
                                                 &m_IncrementalConnectivity,
                                                 m_IncrementalConnectivity ) );
 
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::IncrementalConnectivityVerify,
+                                                &m_IncrementalConnectivityVerify,
+                                                m_IncrementalConnectivityVerify ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::SymbolLibraryIndex,
+                                                &m_SymbolLibraryIndex, m_SymbolLibraryIndex ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::FootprintLibraryIndex,
+                                                &m_FootprintLibraryIndex,
+                                                m_FootprintLibraryIndex ) );
+
     configParams.push_back( new PARAM_CFG_INT( true, AC_KEYS::DisambiguationTime,
                                                &m_DisambiguationMenuDelay,
                                                m_DisambiguationMenuDelay,
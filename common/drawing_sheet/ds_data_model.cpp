@@ -56,6 +56,7 @@
 // It is accessible by DS_DATA_MODEL::GetTheInstance()
 static DS_DATA_MODEL wksTheInstance;
 static DS_DATA_MODEL* wksAltInstance = nullptr;
+static thread_local DS_DATA_MODEL* wksThreadInstance = nullptr;
 
 DS_DATA_MODEL::DS_DATA_MODEL() :
         m_WSunits2Iu( 1000.0 ),
@@ -75,7 +76,9 @@ DS_DATA_MODEL::DS_DATA_MODEL() :
 
 DS_DATA_MODEL& DS_DATA_MODEL::GetTheInstance()
 {
-    if( wksAltInstance )
+    if( wksThreadInstance )
+        return *wksThreadInstance;
+    else if( wksAltInstance )
         return *wksAltInstance;
     else
         return wksTheInstance;
@@ -88,6 +91,18 @@ void DS_DATA_MODEL::SetAltInstance( DS_DATA_MODEL* aLayout )
 }
 
 
+void DS_DATA_MODEL::SetThreadInstance( DS_DATA_MODEL* aLayout )
+{
+    wksThreadInstance = aLayout;
+}
+
+
+DS_DATA_MODEL* DS_DATA_MODEL::GetThreadInstance()
+{
+    return wksThreadInstance;
+}
+
+
 void DS_DATA_MODEL::SetupDrawEnvironment( const PAGE_INFO& aPageInfo, double aMilsToIU )
 {
 #define MILS_TO_MM ( 25.4 / 1000 )
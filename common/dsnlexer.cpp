@@ -22,18 +22,93 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
-#include <charconv>
+#include <algorithm>
 #include <cstdarg>
 #include <cstdio>
 #include <cstdlib>         // bsearch()
 #include <cctype>
+#include <numeric>
 
+#include <core/kicad_algo.h>
 #include <dsnlexer.h>
+#include <string_utils.h>
 #include <wx/translation.h>
 
 #define FMT_CLIPBOARD       _( "clipboard" )
 
 
+//-----<KEYWORD_PERFECT_HASH>-------------------------------------------------
+
+KEYWORD_PERFECT_HASH::KEYWORD_PERFECT_HASH( const KEYWORD* aKeywords, unsigned aCount )
+{
+    if( aCount == 0 )
+        return;
+
+    // Half the slots are left empty and buckets average about two keywords, so a displacement
+    // which places a whole bucket is found after a few tries.
+    size_t slotCount = 1;
+    size_t bucketCount = 1;
+
+    while( slotCount < 2 * size_t( aCount ) )
+        slotCount <<= 1;
+
+    while( 2 * bucketCount < aCount )
+        bucketCount <<= 1;
+
+    std::vector<std::vector<const KEYWORD*>> buckets( bucketCount );
+
+    for( unsigned ii = 0; ii < aCount; ++ii )
+        buckets[hashText( aKeywords[ii].name ) & ( bucketCount - 1 )].push_back( &aKeywords[ii] );
+
+    // Place the largest buckets first, while there is the most room
+    std::vector<size_t> order( bucketCount );
+    std::iota( order.begin(), order.end(), 0 );
+
+    std::stable_sort( order.begin(), order.end(),
+            [&]( size_t a, size_t b )
+            {
+                return buckets[a].size() > buckets[b].size();
+            } );
+
+    m_displacements.assign( bucketCount, 0 );
+    m_slots.assign( slotCount, nullptr );
+
+    std::vector<size_t> placed;
+
+    for( size_t bucket : order )
+    {
+        if( buckets[bucket].empty() )
+            break;
+
+        // Keyword names are unique, and so in practice are their 64 bit hashes, so every
+        // bucket can be placed
+        for( uint32_t displacement = 0; ; ++displacement )
+        {
+            placed.clear();
+
+            for( const KEYWORD* keyword : buckets[bucket] )
+            {
+                size_t slot = slotOf( hashText( keyword->name ), displacement );
+
+                if( m_slots[slot] || alg::contains( placed, slot ) )
+                    break;
+
+                placed.push_back( slot );
+            }
+
+            if( placed.size() == buckets[bucket].size() )
+            {
+                for( size_t ii = 0; ii < placed.size(); ++ii )
+                    m_slots[placed[ii]] = buckets[bucket][ii];
+
+                m_displacements[bucket] = displacement;
+                break;
+            }
+        }
+    }
+}
+
+
 //-----<DSNLEXER>-------------------------------------------------------------
 
 void DSNLEXER::init()
@@ -52,13 +127,15 @@ void DSNLEXER::init()
 
 
 DSNLEXER::DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount,
-                    const KEYWORD_MAP* aKeywordMap,
+                    const KEYWORD_PERFECT_HASH* aKeywordMap,
                     FILE* aFile, const wxString& aFilename ) :
     iOwnReaders( true ),
     start( nullptr ),
     next( nullptr ),
     limit( nullptr ),
     reader( nullptr ),
+    mappedReader( nullptr ),
+    curTextValid( true ),
     keywords( aKeywordTable ),
     keywordCount( aKeywordCount ),
     keywordsLookup( aKeywordMap )
@@ -70,13 +147,15 @@ DSNLEXER::DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount,
 
 
 DSNLEXER::DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount,
-                    const KEYWORD_MAP* aKeywordMap,
+                    const KEYWORD_PERFECT_HASH* aKeywordMap,
                     const std::string& aClipboardTxt, const wxString& aSource ) :
     iOwnReaders( true ),
     start( nullptr ),
     next( nullptr ),
     limit( nullptr ),
     reader( nullptr ),
+    mappedReader( nullptr ),
+    curTextValid( true ),
     keywords( aKeywordTable ),
     keywordCount( aKeywordCount ),
     keywordsLookup( aKeywordMap )
@@ -89,13 +168,15 @@ DSNLEXER::DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount,
 
 
 DSNLEXER::DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount,
-                    const KEYWORD_MAP* aKeywordMap,
+                    const KEYWORD_PERFECT_HASH* aKeywordMap,
                     LINE_READER* aLineReader ) :
     iOwnReaders( false ),
     start( nullptr ),
     next( nullptr ),
     limit( nullptr ),
     reader( nullptr ),
+    mappedReader( nullptr ),
+    curTextValid( true ),
     keywords( aKeywordTable ),
     keywordCount( aKeywordCount ),
     keywordsLookup( aKeywordMap )
@@ -114,6 +195,8 @@ DSNLEXER::DSNLEXER( const std::string& aSExpression, const wxString& aSource ) :
     next( nullptr ),
     limit( nullptr ),
     reader( nullptr ),
+    mappedReader( nullptr ),
+    curTextValid( true ),
     keywords( empty_keywords ),
     keywordCount( 0 ),
     keywordsLookup( nullptr )
@@ -178,7 +261,9 @@ bool DSNLEXER::SyncLineReaderWith( DSNLEXER& aLexer )
 
     // Sync these parameters is not mandatory, but could help
     // for instance in debug
-    curText = aLexer.curText;
+    curText = aLexer.CurStr();
+    curView = curText;
+    curTextValid = true;
     curOffset = aLexer.curOffset;
 
     return true;
@@ -187,8 +272,11 @@ bool DSNLEXER::SyncLineReaderWith( DSNLEXER& aLexer )
 
 void DSNLEXER::PushReader( LINE_READER* aLineReader )
 {
+    keepCurText();
+
     readerStack.push_back( aLineReader );
     reader = aLineReader;
+    mappedReader = dynamic_cast<MAPPED_FILE_LINE_READER*>( reader );
     start  = (const char*) (*reader);
 
     // force a new readLine() as first thing.
@@ -203,12 +291,15 @@ LINE_READER* DSNLEXER::PopReader()
 
     if( readerStack.size() )
     {
+        keepCurText();
+
         ret = reader;
         readerStack.pop_back();
 
         if( readerStack.size() )
         {
             reader = readerStack.back();
+            mappedReader = dynamic_cast<MAPPED_FILE_LINE_READER*>( reader );
             start  = reader->Line();
 
             // force a new readLine() as first thing.
@@ -218,6 +309,7 @@ LINE_READER* DSNLEXER::PopReader()
         else
         {
             reader = nullptr;
+            mappedReader = nullptr;
             start  = dummy;
             limit  = dummy;
         }
@@ -226,14 +318,14 @@ LINE_READER* DSNLEXER::PopReader()
 }
 
 
-int DSNLEXER::findToken( const std::string& tok ) const
+int DSNLEXER::findToken( std::string_view tok ) const
 {
     if( keywordsLookup != nullptr )
     {
-        KEYWORD_MAP::const_iterator it = keywordsLookup->find( tok.c_str() );
+        int token = keywordsLookup->Find( tok );
 
-        if( it != keywordsLookup->end() )
-            return it->second;
+        if( token >= 0 )
+            return token;
     }
 
     return DSN_SYMBOL;      // not a keyword, some arbitrary symbol.
@@ -564,8 +656,7 @@ L_read:
                 while( limit[-1] == '\n' || limit[-1] == '\r' )
                     --limit;
 
-                curText.clear();
-                curText.append( start, limit );
+                setCurView( start, limit );
 
                 cur     = start;        // ensure a good curOffset below
                 curTok  = DSN_COMMENT;
@@ -590,7 +681,7 @@ L_read:
 
     if( *cur == '(' )
     {
-        curText = *cur;
+        setCurView( cur, cur + 1 );
         curTok = DSN_LEFT;
         head = cur+1;
         goto exit;
@@ -598,7 +689,7 @@ L_read:
 
     if( *cur == ')' )
     {
-        curText = *cur;
+        setCurView( cur, cur + 1 );
         curTok = DSN_RIGHT;
         head = cur+1;
         goto exit;
@@ -606,7 +697,7 @@ L_read:
 
     if( *cur == '|' )
     {
-        curText = *cur;
+        setCurView( cur, cur + 1 );
         curTok = DSN_BAR;
         head = cur+1;
         goto exit;
@@ -619,8 +710,9 @@ L_read:
         // a quoted string, will return DSN_STRING
         if( *cur == stringDelimiter )
         {
-            // copy the token, character by character so we can remove doubled up quotes.
-            curText.clear();
+            // The token is a view of the line unless it holds escape sequences, in which case
+            // it is decoded into curText.
+            bool escaped = false;
 
             ++cur;  // skip over the leading delimiter, which is always " in non-specctraMode
 
@@ -635,6 +727,12 @@ L_read:
                     char    c;
                     int     i;
 
+                    if( !escaped )
+                    {
+                        curText.assign( cur, head );
+                        escaped = true;
+                    }
+
                     if( ++head >= limit )
                         break;  // throw exception at L_unterminated
 
@@ -651,7 +749,7 @@ L_read:
                     case 'v':   c = '\x0b';     break;
 
                     case 'x':   // 1 or 2 byte hex escape sequence
-                        for( i = 0; i < 2; ++i )
+                        for( i = 0; i < 2 && head + i < limit; ++i )
                         {
                             if( !isxdigit( head[i] ) )
                                 break;
@@ -672,7 +770,7 @@ L_read:
                     default:    // 1-3 byte octal escape sequence
                         --head;
 
-                        for( i=0; i<3; ++i )
+                        for( i=0; i<3 && head + i < limit; ++i )
                         {
                             if( head[i] < '0' || head[i] > '7' )
                                 break;
@@ -696,20 +794,39 @@ L_read:
 
                 else if( *head == '"' )     // end of the non-specctraMode DSN_STRING
                 {
+                    if( escaped )
+                    {
+                        curView = curText;
+                        curTextValid = true;
+                    }
+                    else
+                    {
+                        setCurView( cur, head );
+                    }
+
                     curTok = DSN_STRING;
                     ++head;                 // omit this trailing double quote
                     goto exit;
                 }
 
                 else
-                    curText += *head++;
+                {
+                    // Skip the run of plain characters up to the next escape or delimiter,
+                    // appending it in one go once the string has to be decoded.
+                    const char* run = head;
+
+                    while( head < limit && *head != '\\' && *head != '"' )
+                        ++head;
+
+                    if( escaped )
+                        curText.append( run, head );
+                }
 
             }   // while
 
             // L_unterminated:
             wxString errtxt( _( "Un-terminated delimited string" ) );
-            THROW_PARSE_ERROR( errtxt, CurSource(), CurLine(), CurLineNumber(),
-                               cur - start + curText.length() );
+            THROW_PARSE_ERROR( errtxt, CurSource(), CurLine(), CurLineNumber(), head - start );
         }
     }
     else    // is specctraMode, tests in this block should not occur in KiCad mode.
@@ -720,7 +837,7 @@ L_read:
         */
         if( *cur == '-' && cur>start && !isSpace( cur[-1] ) )
         {
-            curText = '-';
+            setCurView( cur, cur + 1 );
             curTok = DSN_DASH;
             head = cur+1;
             goto exit;
@@ -743,7 +860,7 @@ L_read:
                 THROW_PARSE_ERROR( errtxt, CurSource(), CurLine(), CurLineNumber(), CurOffset() );
             }
 
-            curText = cc;
+            setCurView( cur, cur + 1 );
 
             head = cur+1;
 
@@ -772,8 +889,7 @@ L_read:
                 THROW_PARSE_ERROR( errtxt, CurSource(), CurLine(), CurLineNumber(), CurOffset() );
             }
 
-            curText.clear();
-            curText.append( cur, head );
+            setCurView( cur, head );
 
             ++head;     // skip over the trailing delimiter
 
@@ -782,26 +898,27 @@ L_read:
         }
     }           // specctraMode
 
-    // non-quoted token, read it into curText.
-    curText.clear();
-
+    // non-quoted token, find its end; the token is a view of the line.
     head = cur;
+
     while( head<limit && !isSep( *head ) )
-        curText += *head++;
+        ++head;
+
+    setCurView( cur, head );
 
-    if( isNumber( curText.c_str(), curText.c_str() + curText.size() ) )
+    if( isNumber( cur, head ) )
     {
         curTok = DSN_NUMBER;
         goto exit;
     }
 
-    if( specctraMode && curText == "string_quote" )
+    if( specctraMode && curView == "string_quote" )
     {
         curTok = DSN_STRING_QUOTE;
         goto exit;
     }
 
-    curTok = findToken( curText );
+    curTok = findToken( curView );
 
 exit:   // single point of exit, no returns elsewhere please.
 
@@ -838,59 +955,15 @@ wxArrayString* DSNLEXER::ReadCommentLines()
 
 double DSNLEXER::parseDouble()
 {
-#if ( defined( __GNUC__ ) && __GNUC__ < 11 ) || ( defined( __clang__ ) && __clang_major__ < 13 )
-    // GCC older than 11 "supports" C++17 without supporting the C++17 std::from_chars for doubles
-    // clang is similar
-
-    char* tmp;
-
-    errno = 0;
-
-    double fval = strtod( CurText(), &tmp );
-
-    if( errno )
-    {
-        wxString error;
-        error.Printf( _( "Invalid floating point number in\nfile: '%s'\nline: %d\noffset: %d" ),
-                      CurSource(), CurLineNumber(), CurOffset() );
-
-        THROW_IO_ERROR( error );
-    }
-
-    if( CurText() == tmp )
-    {
-        wxString error;
-        error.Printf( _( "Missing floating point number in\nfile: '%s'\nline: %d\noffset: %d" ),
-                      CurSource(), CurLineNumber(), CurOffset() );
-
-        THROW_IO_ERROR( error );
-    }
-
-    return fval;
-#else
-    // Use std::from_chars which is designed to be locale independent and performance oriented
-    // for data interchange
-
-    const std::string& str = CurStr();
-
-    // Offset any leading whitespace, this is one thing from_chars does not handle
-    size_t woff = 0;
-
-    while( std::isspace( str[woff] ) && woff < str.length() )
-    {
-        woff++;
-    }
-
-    double                 dval{};
-    std::from_chars_result res =
-            std::from_chars( str.data() + woff, str.data() + str.size(), dval );
+    // Locale independent, so files can be read without a LOCALE_IO and from several threads
+    // at once.  The token is parsed where it is, without copying it.
+    double dval{};
 
-    if( res.ec != std::errc() )
+    if( !ParseCDouble( curView.data(), curView.data() + curView.size(), dval ) )
     {
         THROW_PARSE_ERROR( _( "Invalid floating point number" ), CurSource(), CurLine(),
                            CurLineNumber(), CurOffset() );
     }
 
     return dval;
-#endif
 }
@@ -126,6 +126,7 @@ private:
 static MARKUP_CACHE s_markupCache( 1024 );
 static std::mutex s_markupCacheMutex;
 static std::mutex s_defaultFontMutex;;
+static std::mutex s_fontMapMutex;
 
 
 FONT::FONT()
@@ -152,6 +153,9 @@ FONT* FONT::GetFont( const wxString& aFontName, bool aBold, bool aItalic,
 
     std::tuple<wxString, bool, bool, bool> key = { aFontName, aBold, aItalic, aForDrawingSheet };
 
+    // Exporters look up fonts from worker threads
+    std::lock_guard lock( s_fontMapMutex );
+
     FONT* font = nullptr;
 
     if( s_fontMap.find( key ) != s_fontMap.end() )
@@ -26,6 +26,8 @@
 
 #include <fmt/format.h>
 
+#include <string_view>
+
 #include <kiid.h>
 #include <richio.h>
 #include <string_utils.h>
@@ -96,189 +98,229 @@ void FormatStreamData( OUTPUTFORMATTER& aOut, const wxStreamBuffer& aStream )
  */
 void Prettify( std::string& aSource, bool aCompactSave )
 {
-    // Configuration
-    const char quoteChar = '"';
-    const char indentChar = '\t';
-    const int  indentSize = 1;
+    PRETTIFIER  prettifier( aCompactSave );
+    std::string formatted;
 
-    // In order to visually compress PCB files, it is helpful to special-case long lists of (xy ...)
-    // lists, which we allow to exist on a single line until we reach column 99.
-    const int  xySpecialCaseColumnLimit = 99;
+    formatted.reserve( aSource.length() );
 
-    // If whitespace occurs inside a list after this threshold, it will be converted into a newline
-    // and the indentation will be increased.  This is mainly used for image and group objects,
-    // which contain potentially long sets of string tokens within a single list.
-    const int  consecutiveTokenWrapThreshold = 72;
+    prettifier.Feed( aSource.data(), aSource.length(), formatted );
+    prettifier.Finish( formatted );
 
-    std::string formatted;
-    formatted.reserve( aSource.length() );
+    aSource = std::move( formatted );
+}
 
-    auto cursor = aSource.begin();
-    auto seek = cursor;
-
-    int  listDepth = 0;
-    char lastNonWhitespace = 0;
-    bool inQuote = false;
-    bool hasInsertedSpace = false;
-    bool inMultiLineList = false;
-    bool inXY = false;
-    bool inShortForm = false;
-    int  shortFormDepth = 0;
-    int  column = 0;
-    int  backslashCount = 0;    // Count of successive backslash read since any other char
-
-    auto isWhitespace = []( const char aChar )
-            {
-                return ( aChar == ' ' || aChar == '\t' || aChar == '\n' || aChar == '\r' );
-            };
 
-    auto nextNonWhitespace =
-            [&]( std::string::iterator aIt )
-            {
-                seek = aIt;
+// Configuration
+static const char quoteChar = '"';
+static const char indentChar = '\t';
+static const int  indentSize = 1;
 
-                while( seek != aSource.end() && isWhitespace( *seek ) )
-                    seek++;
+// In order to visually compress PCB files, it is helpful to special-case long lists of (xy ...)
+// lists, which we allow to exist on a single line until we reach column 99.
+static const int  xySpecialCaseColumnLimit = 99;
 
-                if( seek == aSource.end() )
-                    return (char)0;
+// If whitespace occurs inside a list after this threshold, it will be converted into a newline
+// and the indentation will be increased.  This is mainly used for image and group objects,
+// which contain potentially long sets of string tokens within a single list.
+static const int  consecutiveTokenWrapThreshold = 72;
 
-                return *seek;
-            };
 
-    auto isXY =
-            [&]( std::string::iterator aIt )
-            {
-                seek = aIt;
+static bool isWhitespace( const char aChar )
+{
+    return ( aChar == ' ' || aChar == '\t' || aChar == '\n' || aChar == '\r' );
+}
 
-                if( ++seek == aSource.end() || *seek != 'x' )
-                    return false;
 
-                if( ++seek == aSource.end() || *seek != 'y' )
-                    return false;
+PRETTIFIER::PRETTIFIER( bool aCompactSave ) :
+        m_compactSave( aCompactSave ),
+        m_started( false ),
+        m_listDepth( 0 ),
+        m_lastNonWhitespace( 0 ),
+        m_inQuote( false ),
+        m_hasInsertedSpace( false ),
+        m_inMultiLineList( false ),
+        m_inXY( false ),
+        m_inShortForm( false ),
+        m_shortFormDepth( 0 ),
+        m_column( 0 ),
+        m_backslashCount( 0 )
+{
+}
+
+
+void PRETTIFIER::Feed( const char* aInput, size_t aCount, std::string& aOutput )
+{
+    if( m_pending.empty() )
+    {
+        size_t used = process( aInput, aCount, false, aOutput );
+        m_pending.assign( aInput + used, aCount - used );
+    }
+    else
+    {
+        m_pending.append( aInput, aCount );
 
-                if( ++seek == aSource.end() || *seek != ' ' )
-                    return false;
+        size_t used = process( m_pending.data(), m_pending.length(), false, aOutput );
+        m_pending.erase( 0, used );
+    }
+}
 
-                return true;
-            };
 
-    auto isShortForm =
-            [&]( std::string::iterator aIt )
-            {
-                seek = aIt;
-                std::string token;
+void PRETTIFIER::Finish( std::string& aOutput )
+{
+    process( m_pending.data(), m_pending.length(), true, aOutput );
+    m_pending.clear();
 
-                while( ++seek != aSource.end() && isalpha( *seek ) )
-                    token += *seek;
+    // newline required at end of line / file for POSIX compliance. Keeps git diffs clean.
+    aOutput.push_back( '\n' );
+}
 
-                return token == "font" || token == "stroke" || token == "fill"
-                        || token == "offset" || token == "rotate" || token == "scale";
-            };
 
-    while( cursor != aSource.end() )
+void PRETTIFIER::newLine( std::string& aOutput )
+{
+    aOutput.push_back( '\n' );
+    aOutput.append( m_listDepth * indentSize, indentChar );
+    m_column = m_listDepth * indentSize;
+}
+
+
+size_t PRETTIFIER::process( const char* aData, size_t aSize, bool aAtEnd, std::string& aOutput )
+{
+    size_t cursor = 0;
+
+    // Each character may need to look ahead at those following it.  If they haven't been
+    // received yet, stop and leave it for the next call.
+    while( cursor < aSize )
     {
-        char next = nextNonWhitespace( cursor );
+        const char ch = aData[cursor];
 
-        if( isWhitespace( *cursor ) && !inQuote )
+        if( isWhitespace( ch ) && !m_inQuote )
         {
-            if( !hasInsertedSpace           // Only permit one space between chars
-                && listDepth > 0            // Do not permit spaces in outer list
-                && lastNonWhitespace != '(' // Remove extra space after start of list
-                && next != ')'              // Remove extra space before end of list
-                && next != '(' )            // Remove extra space before newline
+            size_t seek = cursor;
+
+            while( seek < aSize && isWhitespace( aData[seek] ) )
+                seek++;
+
+            if( seek == aSize && !aAtEnd )
+                break;
+
+            char next = ( seek < aSize ) ? aData[seek] : 0;
+
+            if( !m_hasInsertedSpace             // Only permit one space between chars
+                && m_listDepth > 0              // Do not permit spaces in outer list
+                && m_lastNonWhitespace != '('   // Remove extra space after start of list
+                && next != ')'                  // Remove extra space before end of list
+                && next != '(' )                // Remove extra space before newline
             {
-                if( inXY || column < consecutiveTokenWrapThreshold )
+                if( m_inXY || m_column < consecutiveTokenWrapThreshold )
                 {
                     // Note that we only insert spaces here, no matter what kind of whitespace is
                     // in the input.  Newlines will be inserted as needed by the logic below.
-                    formatted.push_back( ' ' );
-                    column++;
+                    aOutput.push_back( ' ' );
+                    m_column++;
                 }
-                else if( inShortForm )
+                else if( m_inShortForm )
                 {
-                    formatted.push_back( ' ' );
+                    aOutput.push_back( ' ' );
                 }
                 else
                 {
-                    formatted += fmt::format( "\n{}",
-                                              std::string( listDepth * indentSize, indentChar ) );
-                    column = listDepth * indentSize;
-                    inMultiLineList = true;
+                    newLine( aOutput );
+                    m_inMultiLineList = true;
                 }
 
-                hasInsertedSpace = true;
+                m_hasInsertedSpace = true;
             }
         }
         else
         {
-            hasInsertedSpace = false;
-
-            if( *cursor == '(' && !inQuote )
+            if( ch == '(' && !m_inQuote )
             {
-                bool currentIsXY = isXY( cursor );
-                bool currentIsShortForm = aCompactSave && isShortForm( cursor );
+                // Is this an (xy ...) list?
+                if( cursor + 3 >= aSize && !aAtEnd )
+                    break;
 
-                if( formatted.empty() )
+                bool currentIsXY = cursor + 3 < aSize && aData[cursor + 1] == 'x'
+                                   && aData[cursor + 2] == 'y' && aData[cursor + 3] == ' ';
+
+                bool currentIsShortForm = false;
+
+                if( m_compactSave )
+                {
+                    size_t seek = cursor + 1;
+
+                    while( seek < aSize && isalpha( aData[seek] ) )
+                        seek++;
+
+                    if( seek == aSize && !aAtEnd )
+                        break;
+
+                    std::string_view token( aData + cursor + 1, seek - cursor - 1 );
+
+                    currentIsShortForm = token == "font" || token == "stroke" || token == "fill"
+                                         || token == "offset" || token == "rotate"
+                                         || token == "scale";
+                }
+
+                if( !m_started )
                 {
-                    formatted.push_back( '(' );
-                    column++;
+                    aOutput.push_back( '(' );
+                    m_column++;
                 }
-                else if( inXY && currentIsXY && column < xySpecialCaseColumnLimit )
+                else if( m_inXY && currentIsXY && m_column < xySpecialCaseColumnLimit )
                 {
                     // List-of-points special case
-                    formatted += " (";
-                    column += 2;
+                    aOutput += " (";
+                    m_column += 2;
                 }
-                else if( inShortForm )
+                else if( m_inShortForm )
                 {
-                    formatted += " (";
-                    column += 2;
+                    aOutput += " (";
+                    m_column += 2;
                 }
                 else
                 {
-                    formatted += fmt::format( "\n{}(",
-                                              std::string( listDepth * indentSize, indentChar ) );
-                    column = listDepth * indentSize + 1;
+                    newLine( aOutput );
+                    aOutput.push_back( '(' );
+                    m_column++;
                 }
 
-                inXY = currentIsXY;
+                m_inXY = currentIsXY;
 
                 if( currentIsShortForm )
                 {
-                    inShortForm = true;
-                    shortFormDepth = listDepth;
+                    m_inShortForm = true;
+                    m_shortFormDepth = m_listDepth;
                 }
 
-                listDepth++;
+                m_listDepth++;
             }
-            else if( *cursor == ')' && !inQuote )
+            else if( ch == ')' && !m_inQuote )
             {
-                if( listDepth > 0 )
-                    listDepth--;
+                if( m_listDepth > 0 )
+                    m_listDepth--;
 
-                if( inShortForm )
+                if( m_inShortForm )
                 {
-                    formatted.push_back( ')' );
-                    column++;
+                    aOutput.push_back( ')' );
+                    m_column++;
                 }
-                else if( lastNonWhitespace == ')' || inMultiLineList )
+                else if( m_lastNonWhitespace == ')' || m_inMultiLineList )
                 {
-                    formatted += fmt::format( "\n{})",
-                                              std::string( listDepth * indentSize, indentChar ) );
-                    column = listDepth * indentSize + 1;
-                    inMultiLineList = false;
+                    newLine( aOutput );
+                    aOutput.push_back( ')' );
+                    m_column++;
+                    m_inMultiLineList = false;
                 }
                 else
                 {
-                    formatted.push_back( ')' );
-                    column++;
+                    aOutput.push_back( ')' );
+                    m_column++;
                 }
 
-                if( shortFormDepth == listDepth )
+                if( m_shortFormDepth == m_listDepth )
                 {
-                    inShortForm = false;
-                    shortFormDepth = 0;
+                    m_inShortForm = false;
+                    m_shortFormDepth = 0;
                 }
             }
             else
@@ -286,28 +328,27 @@ void Prettify( std::string& aSource, bool aCompactSave )
                 // The output formatter escapes double-quotes (like \")
                 // But a corner case is a sequence like \\"
                 // therefore a '\' is attached to a '"' if a odd number of '\' is detected
-                if( *cursor == '\\' )
-                    backslashCount++;
-                else if( *cursor == quoteChar && ( backslashCount & 1 ) == 0 )
-                    inQuote = !inQuote;
+                if( ch == '\\' )
+                    m_backslashCount++;
+                else if( ch == quoteChar && ( m_backslashCount & 1 ) == 0 )
+                    m_inQuote = !m_inQuote;
 
-                if( *cursor != '\\' )
-                    backslashCount = 0;
+                if( ch != '\\' )
+                    m_backslashCount = 0;
 
-                formatted.push_back( *cursor );
-                column++;
+                aOutput.push_back( ch );
+                m_column++;
             }
 
-            lastNonWhitespace = *cursor;
+            m_hasInsertedSpace = false;
+            m_started = true;
+            m_lastNonWhitespace = ch;
         }
 
         ++cursor;
     }
 
-    // newline required at end of line / file for POSIX compliance. Keeps git diffs clean.
-    formatted += '\n';
-
-    aSource = std::move( formatted );
+    return cursor;
 }
 
 } // namespace KICAD_FORMAT
@@ -83,6 +83,12 @@ wxString JOB::GetSettingsDialogTitle() const
 }
 
 
+bool JOB::ReadsDocumentOnly() const
+{
+    return false;
+}
+
+
 void JOB::SetTempOutputDirectory( const wxString& aBase )
 {
     m_tempOutputDirectory = aBase;
@@ -202,6 +202,12 @@ public:
     virtual wxString GetDefaultDescription() const;
     virtual wxString GetSettingsDialogTitle() const;
 
+    /**
+     * Return true if the job only reads its board or schematic.  Jobs which only read the same
+     * document may be run at the same time as each other.
+     */
+    virtual bool ReadsDocumentOnly() const;
+
     const std::vector<JOB_PARAM_BASE*>& GetParams() { return m_params; }
 
     void ClearExistingOutputs()                 { m_outputs.clear(); }
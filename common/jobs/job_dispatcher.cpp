@@ -25,14 +25,84 @@
 
 class wxWindow;
 
+
+/// The reporter of the job being run by each thread
+static thread_local REPORTER* s_threadJobReporter = nullptr;
+
+
+/**
+ * Passes messages on to the reporter of the job being run by the calling thread.  Threads which
+ * aren't running a job, such as those started by a job, report to the last job started.
+ */
+class JOB_DISPATCHER::JOB_REPORTER : public REPORTER
+{
+public:
+    JOB_REPORTER( JOB_DISPATCHER* aDispatcher ) :
+            m_dispatcher( aDispatcher )
+    {}
+
+    REPORTER& Report( const wxString& aText,
+                      SEVERITY aSeverity = RPT_SEVERITY_UNDEFINED ) override
+    {
+        target()->Report( aText, aSeverity );
+        return *this;
+    }
+
+    REPORTER& ReportTail( const wxString& aText,
+                          SEVERITY aSeverity = RPT_SEVERITY_UNDEFINED ) override
+    {
+        target()->ReportTail( aText, aSeverity );
+        return *this;
+    }
+
+    REPORTER& ReportHead( const wxString& aText,
+                          SEVERITY aSeverity = RPT_SEVERITY_UNDEFINED ) override
+    {
+        target()->ReportHead( aText, aSeverity );
+        return *this;
+    }
+
+    bool HasMessage() const override { return target()->HasMessage(); }
+
+    bool HasMessageOfSeverity( int aSeverityMask ) const override
+    {
+        return target()->HasMessageOfSeverity( aSeverityMask );
+    }
+
+    EDA_UNITS GetUnits() const override { return target()->GetUnits(); }
+
+private:
+    REPORTER* target() const
+    {
+        if( s_threadJobReporter )
+            return s_threadJobReporter;
+
+        if( REPORTER* lastJobReporter = m_dispatcher->m_lastJobReporter )
+            return lastJobReporter;
+
+        return m_dispatcher->m_defaultReporter;
+    }
+
+    JOB_DISPATCHER* m_dispatcher;
+};
+
+
 JOB_DISPATCHER::JOB_DISPATCHER( KIWAY* aKiway ) :
-        m_kiway( aKiway )
+        m_kiway( aKiway ),
+        m_jobReporter( std::make_unique<JOB_REPORTER>( this ) ),
+        m_defaultReporter( &NULL_REPORTER::GetInstance() ),
+        m_lastJobReporter( nullptr )
 {
-    m_reporter = &NULL_REPORTER::GetInstance();
+    m_reporter = m_jobReporter.get();
     m_progressReporter = nullptr;
 }
 
 
+JOB_DISPATCHER::~JOB_DISPATCHER()
+{
+}
+
+
 void JOB_DISPATCHER::Register( const std::string&             aJobTypeName,
                                std::function<int( JOB* job )> aHandler,
                                std::function<bool( JOB* aJob, wxWindow* aParent )> aConfigHandler )
@@ -45,21 +115,29 @@ void JOB_DISPATCHER::Register( const std::string&             aJobTypeName,
 int JOB_DISPATCHER::RunJob( JOB* job, REPORTER* aReporter )
 {
     int       result = CLI::EXIT_CODES::ERR_UNKNOWN;
-    REPORTER* existingReporter = m_reporter;
+    REPORTER* existingReporter = s_threadJobReporter;
+    REPORTER* existingLastReporter = m_lastJobReporter;
 
     if( aReporter )
     {
-        m_reporter = aReporter;
+        s_threadJobReporter = aReporter;
+        m_lastJobReporter = aReporter;
     }
 
     job->ClearExistingOutputs();
 
-    if( m_jobHandlers.count( job->GetType() ) )
+    auto it = m_jobHandlers.find( job->GetType() );
+
+    if( it != m_jobHandlers.end() )
     {
-        result = m_jobHandlers[job->GetType()]( job );
+        result = it->second( job );
     }
 
-    m_reporter = existingReporter;
+    s_threadJobReporter = existingReporter;
+
+    // Leave a later job's reporter in place if one was started meanwhile
+    if( aReporter )
+        m_lastJobReporter.compare_exchange_strong( aReporter, existingLastReporter );
 
     return result;
 }
@@ -79,7 +157,7 @@ bool JOB_DISPATCHER::HandleJobConfig( JOB* job, wxWindow* aParent )
 void JOB_DISPATCHER::SetReporter( REPORTER* aReporter )
 {
     wxCHECK( aReporter != nullptr, /*void*/ );
-    m_reporter = aReporter;
+    m_defaultReporter = aReporter;
 }
 
 
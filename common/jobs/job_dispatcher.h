@@ -22,7 +22,9 @@
 #define JOB_DISPATCHER_H
 
 #include <kicommon.h>
+#include <atomic>
 #include <functional>
+#include <memory>
 #include <string>
 #include <map>
 #include <jobs/job.h>
@@ -37,8 +39,16 @@ class KICOMMON_API JOB_DISPATCHER
 {
 public:
     JOB_DISPATCHER( KIWAY* aKiway );
+    ~JOB_DISPATCHER();
+
     void Register( const std::string& aJobTypeName, std::function<int( JOB* job )> aHandler,
                          std::function<bool( JOB* job, wxWindow* aParent )> aConfigHandler );
+
+    /**
+     * Run \a aJob, reporting to \a aReporter if given.
+     *
+     * Jobs may be run by several threads at once, each reporting to its own reporter.
+     */
     int  RunJob( JOB* aJob, REPORTER* aReporter );
     bool HandleJobConfig( JOB* aJob, wxWindow* aParent );
     void SetReporter( REPORTER* aReporter );
@@ -46,14 +56,22 @@ public:
 
 protected:
     KIWAY*             m_kiway;             // non-owning
-    REPORTER*          m_reporter;          // non-owning
+    REPORTER*          m_reporter;          // reports to the reporter of the calling thread's job
     PROGRESS_REPORTER* m_progressReporter;  // non-owning
 
 private:
+    class JOB_REPORTER;
+
     std::map<std::string, std::function<int( JOB* job )>> m_jobHandlers;
     std::map<std::string, std::function<bool( JOB* job, wxWindow* aParent )>>
             m_jobConfigHandlers;
 
+    std::unique_ptr<JOB_REPORTER> m_jobReporter;
+    REPORTER*                     m_defaultReporter;   // non-owning
+
+    /// The reporter of the last job started, for threads started by the job itself
+    std::atomic<REPORTER*>        m_lastJobReporter;
+
 };
 
 #endif
\ No newline at end of file
@@ -151,6 +151,13 @@ wxString JOB_EXPORT_PCB_3D::GetSettingsDialogTitle() const
 }
 
 
+bool JOB_EXPORT_PCB_3D::ReadsDocumentOnly() const
+{
+    // VRML is written by its own exporter, which hasn't been checked for board changes
+    return m_format != FORMAT::VRML;
+}
+
+
 void JOB_EXPORT_PCB_3D::SetStepFormat( EXPORTER_STEP_PARAMS::FORMAT aFormat )
 {
     m_3dparams.m_Format = aFormat;
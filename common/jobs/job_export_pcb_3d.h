@@ -108,6 +108,7 @@ public:
     JOB_EXPORT_PCB_3D();
     wxString GetDefaultDescription() const override;
     wxString GetSettingsDialogTitle() const override;
+    bool     ReadsDocumentOnly() const override;
 
     void SetStepFormat( EXPORTER_STEP_PARAMS::FORMAT aFormat );
 
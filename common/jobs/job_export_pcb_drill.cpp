@@ -134,5 +134,11 @@ wxString JOB_EXPORT_PCB_DRILL::GetSettingsDialogTitle() const
     return _( "Export Drill Data Job Settings" );
 }
 
+
+bool JOB_EXPORT_PCB_DRILL::ReadsDocumentOnly() const
+{
+    return true;
+}
+
 REGISTER_JOB( pcb_export_drill, _HKI( "PCB: Export Drill Data" ), KIWAY::FACE_PCB,
               JOB_EXPORT_PCB_DRILL );
\ No newline at end of file
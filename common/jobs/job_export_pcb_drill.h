@@ -33,6 +33,7 @@ public:
 
     wxString GetDefaultDescription() const override;
     wxString GetSettingsDialogTitle() const override;
+    bool     ReadsDocumentOnly() const override;
 
     enum class DRILL_FORMAT
     {
@@ -25,10 +25,12 @@
 JOB_EXPORT_PCB_GERBERS::JOB_EXPORT_PCB_GERBERS() :
         JOB_EXPORT_PCB_GERBER( "gerbers" ),
         m_useBoardPlotParams( false ),
-        m_createJobsFile( true )
+        m_createJobsFile( true ),
+        m_refillZones( false )
 {
     m_params.emplace_back( new JOB_PARAM<bool>( "create_gerber_job_file", &m_createJobsFile,
                                                 m_createJobsFile ) );
+    m_params.emplace_back( new JOB_PARAM<bool>( "refill_zones", &m_refillZones, m_refillZones ) );
 }
 
 
@@ -44,5 +46,12 @@ wxString JOB_EXPORT_PCB_GERBERS::GetSettingsDialogTitle() const
 }
 
 
+bool JOB_EXPORT_PCB_GERBERS::ReadsDocumentOnly() const
+{
+    // Refilling zones changes the board
+    return !m_refillZones;
+}
+
+
 REGISTER_JOB( pcb_export_gerbers, _HKI( "PCB: Export Gerbers" ), KIWAY::FACE_PCB,
               JOB_EXPORT_PCB_GERBERS );
\ No newline at end of file
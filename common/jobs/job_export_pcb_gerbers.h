@@ -34,10 +34,13 @@ public:
     JOB_EXPORT_PCB_GERBERS();
     wxString GetDefaultDescription() const override;
     wxString GetSettingsDialogTitle() const override;
+    bool     ReadsDocumentOnly() const override;
 
     bool m_useBoardPlotParams;
 
     bool m_createJobsFile;
+
+    bool m_refillZones;
 };
 
 #endif
\ No newline at end of file
@@ -42,13 +42,15 @@ JOB_EXPORT_PCB_ODB::JOB_EXPORT_PCB_ODB() :
         m_drawingSheet(),
         m_units( ODB_UNITS::MM ),
         m_precision( 2 ),
-        m_compressionMode( ODB_COMPRESSION::ZIP )
+        m_compressionMode( ODB_COMPRESSION::ZIP ),
+        m_refillZones( false )
 {
     m_params.emplace_back( new JOB_PARAM<wxString>( "drawing_sheet", &m_drawingSheet, m_drawingSheet ) );
     m_params.emplace_back( new JOB_PARAM<ODB_UNITS>( "units", &m_units, m_units ) );
     m_params.emplace_back( new JOB_PARAM<int>( "precision", &m_precision, m_precision ) );
     m_params.emplace_back( new JOB_PARAM<ODB_COMPRESSION>( "compression", &m_compressionMode,
                                                            m_compressionMode ) );
+    m_params.emplace_back( new JOB_PARAM<bool>( "refill_zones", &m_refillZones, m_refillZones ) );
 }
 
 
@@ -54,6 +54,8 @@ public:
     int            m_precision;
 
     ODB_COMPRESSION m_compressionMode;
+
+    bool           m_refillZones;
 };
 
 #endif
@@ -72,4 +72,10 @@ wxString JOB_EXPORT_PCB_PDF::GetSettingsDialogTitle() const
 }
 
 
+bool JOB_EXPORT_PCB_PDF::ReadsDocumentOnly() const
+{
+    return true;
+}
+
+
 REGISTER_JOB( pcb_export_pdf, _HKI( "PCB: Export PDF" ), KIWAY::FACE_PCB, JOB_EXPORT_PCB_PDF );
\ No newline at end of file
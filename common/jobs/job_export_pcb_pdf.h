@@ -35,6 +35,7 @@ public:
     JOB_EXPORT_PCB_PDF();
     wxString GetDefaultDescription() const override;
     wxString GetSettingsDialogTitle() const override;
+    bool     ReadsDocumentOnly() const override;
 
     bool m_pdfFrontFPPropertyPopups;
     bool m_pdfBackFPPropertyPopups;
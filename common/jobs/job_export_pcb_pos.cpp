@@ -104,6 +104,12 @@ wxString JOB_EXPORT_PCB_POS::GetSettingsDialogTitle() const
 }
 
 
+bool JOB_EXPORT_PCB_POS::ReadsDocumentOnly() const
+{
+    return true;
+}
+
+
 void JOB_EXPORT_PCB_POS::SetDefaultOutputPath( const wxString& aReferenceName )
 {
     wxFileName fn = aReferenceName;
@@ -32,6 +32,7 @@ public:
     JOB_EXPORT_PCB_POS();
     wxString GetDefaultDescription() const override;
     wxString GetSettingsDialogTitle() const override;
+    bool     ReadsDocumentOnly() const override;
 
     void SetDefaultOutputPath( const wxString& aReferenceName );
 
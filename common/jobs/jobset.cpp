@@ -56,6 +56,7 @@ KICOMMON_API void to_json( nlohmann::json& j, const JOBSET_JOB& f )
     j = nlohmann::json{ { "id", f.m_id },
                         { "type", f.m_type },
                         { "description", f.m_description },
+                        { "depends_on", f.m_dependsOn },
                         { "settings", nlohmann::json::object( {} ) }
                       };
 
@@ -68,6 +69,7 @@ KICOMMON_API void from_json( const nlohmann::json& j, JOBSET_JOB& f )
     j.at( "type" ).get_to( f.m_type );
     j.at( "id" ).get_to( f.m_id );
     f.m_description = j.value( "description", "" );
+    f.m_dependsOn = j.value( "depends_on", std::vector<wxString>() );
 
     nlohmann::json settings_obj = j.at( "settings" );
 
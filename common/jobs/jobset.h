@@ -48,6 +48,9 @@ struct KICOMMON_API JOBSET_JOB
     wxString             m_description;
     std::shared_ptr<JOB> m_job;
 
+    /// Ids of jobs which must finish before this one starts, such as a DRC run before fab outputs
+    std::vector<wxString> m_dependsOn;
+
     wxString GetDescription() const;
     void     SetDescription( const wxString& aDescription );
 
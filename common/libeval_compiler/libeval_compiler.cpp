@@ -262,6 +262,7 @@ COMPILER::COMPILER() :
     m_parser = LIBEVAL::ParseAlloc( malloc );
     m_tree = nullptr;
     m_errorStatus.pendingError = false;
+    m_foldConstants = true;
 }
 
 
@@ -1111,6 +1112,9 @@ bool COMPILER::generateUCode( UCODE* aCode, CONTEXT* aPreflightContext )
         stack.pop_back();
     }
 
+    if( m_foldConstants )
+        aCode->FoldConstants();
+
     libeval_dbg(2,"dump: \n%s\n", aCode->Dump().c_str() );
 
     return true;
@@ -1252,6 +1256,55 @@ void UOP::Exec( CONTEXT* ctx )
 }
 
 
+void UCODE::FoldConstants()
+{
+    std::vector<UOP*> folded;
+    folded.reserve( m_ucode.size() );
+
+    for( UOP* op : m_ucode )
+    {
+        size_t arity = 0;
+
+        if( op->GetOp() & TR_OP_BINARY_MASK )
+            arity = 2;
+        else if( op->GetOp() & TR_OP_UNARY_MASK )
+            arity = 1;
+
+        bool foldable = arity > 0 && folded.size() >= arity;
+
+        for( size_t ii = 1; foldable && ii <= arity; ++ii )
+            foldable = folded[ folded.size() - ii ]->IsNumericConstant();
+
+        if( !foldable )
+        {
+            folded.push_back( op );
+            continue;
+        }
+
+        // Operands are in postfix order, so they're the last ops emitted
+        CONTEXT ctx;
+
+        for( size_t ii = arity; ii > 0; --ii )
+            ctx.Push( folded[ folded.size() - ii ]->GetValue() );
+
+        op->Exec( &ctx );
+
+        std::unique_ptr<VALUE> result = std::make_unique<VALUE>( ctx.Pop()->AsDouble() );
+
+        for( size_t ii = 0; ii < arity; ++ii )
+        {
+            delete folded.back();
+            folded.pop_back();
+        }
+
+        delete op;
+        folded.push_back( new UOP( TR_UOP_PUSH_VALUE, std::move( result ) ) );
+    }
+
+    m_ucode = std::move( folded );
+}
+
+
 VALUE* UCODE::Run( CONTEXT* ctx )
 {
     static VALUE g_false( 0 );
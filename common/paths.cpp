@@ -496,7 +496,10 @@ bool PATHS::EnsurePathExists( const wxString& aPath, bool aPathToFile )
 
     if( !wxFileName::DirExists( path.GetPath() ) )
     {
-        if( !wxFileName::Mkdir( path.GetPath(), wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL ) )
+        // Jobs run at the same time may make the same directories, so a failure may only mean
+        // that another job made one of them first
+        if( !wxFileName::Mkdir( path.GetPath(), wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL )
+                && !wxFileName::Mkdir( path.GetPath(), wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL ) )
         {
             return false;
         }
@@ -31,6 +31,7 @@
 #include <wx/log.h>
 #include <cstdio>
 #include <fmt/format.h>
+#include <hash.h>
 
 #include <build_version.h>
 
@@ -66,6 +67,17 @@
 #define AM_FREEPOLY_BASENAME "FreePoly"
 
 
+// The largest difference between coordinates of similar polygon vertices
+#define POLY_COMPARE_MARGIN 2
+
+// Size of the grid cells used to hash polygons.  The first vertices of similar polygons are
+// always in the same cell or in adjacent cells.
+#define POLY_HASH_CELL_SIZE 8
+
+// The body of the plot goes through a buffer of this size to the work file
+#define WORK_FILE_BUFFER_SIZE ( 1024 * 1024 )
+
+
 // A helper function to compare 2 polygons: polygons are similar if they have the same
 // number of vertices and each vertex coordinate are similar, i.e. if the difference
 // between coordinates is small ( <= margin to accept rounding issues coming from polygon
@@ -77,7 +89,7 @@ static bool polyCompare( const std::vector<VECTOR2I>& aPolygon,
     if( aTestPolygon.size() != aPolygon.size() )
         return false;
 
-    const int margin = 2;
+    const int margin = POLY_COMPARE_MARGIN;
 
     for( size_t jj = 0; jj < aPolygon.size(); jj++ )
     {
@@ -90,6 +102,56 @@ static bool polyCompare( const std::vector<VECTOR2I>& aPolygon,
 }
 
 
+// Return the grid cell holding the first vertex of aPolygon, offset by aDx and aDy cells
+static VECTOR2I polyHashCell( const std::vector<VECTOR2I>& aPolygon, int aDx = 0, int aDy = 0 )
+{
+    if( aPolygon.empty() )
+        return VECTOR2I( aDx, aDy );
+
+    auto cell =
+            []( int aCoord )
+            {
+                // Round towards negative infinity, so that cells don't double up around zero
+                return aCoord >= 0 ? aCoord / POLY_HASH_CELL_SIZE
+                                   : ( aCoord + 1 ) / POLY_HASH_CELL_SIZE - 1;
+            };
+
+    return VECTOR2I( cell( aPolygon[0].x ) + aDx, cell( aPolygon[0].y ) + aDy );
+}
+
+
+// EDA_ANGLE compares degrees exactly, so hash them too, but with a single zero
+static double hashableDegrees( const EDA_ANGLE& aAngle )
+{
+    double degrees = aAngle.AsDegrees();
+    return degrees == 0.0 ? 0.0 : degrees;
+}
+
+
+static size_t apertureHash( APERTURE::APERTURE_TYPE aType, const VECTOR2I& aSize, int aRadius,
+                            const EDA_ANGLE& aRotation, int aApertureAttribute,
+                            const std::string& aCustomAttribute )
+{
+    return hash_val( static_cast<int>( aType ), aSize.x, aSize.y, aRadius,
+                     hashableDegrees( aRotation ), aApertureAttribute, aCustomAttribute );
+}
+
+
+static size_t apertureHash( APERTURE::APERTURE_TYPE aType, size_t aCornerCount,
+                            const VECTOR2I& aCell, const EDA_ANGLE& aRotation,
+                            int aApertureAttribute, const std::string& aCustomAttribute )
+{
+    return hash_val( static_cast<int>( aType ), aCornerCount, aCell.x, aCell.y,
+                     hashableDegrees( aRotation ), aApertureAttribute, aCustomAttribute );
+}
+
+
+static size_t freePolyHash( size_t aCornerCount, const VECTOR2I& aCell )
+{
+    return hash_val( aCornerCount, aCell.x, aCell.y );
+}
+
+
 GERBER_PLOTTER::GERBER_PLOTTER()
 {
     workFile  = nullptr;
@@ -248,18 +310,21 @@ bool GERBER_PLOTTER::StartPlot( const wxString& aPageNumber )
 
     wxASSERT( m_outputFile );
 
-    finalFile = m_outputFile;     // the actual gerber file will be created later
+    finalFile = m_outputFile;
 
-    // Create a temp file in system temp to avoid potential network share buffer issues for
-    // the final read and save.
+    // The aperture list precedes the body of the plot, but is only known at the end of the
+    // plot.  So the header is written to the final file now and the body to a work file, which
+    // is appended to the final file by EndPlot().  The work file is in system temp to avoid
+    // potential network share buffer issues.
     m_workFilename = wxFileName::CreateTempFileName( "" );
-    workFile = wxFopen( m_workFilename, wxT( "wt" ) );
-    m_outputFile = workFile;
-    wxASSERT( m_outputFile );
+    workFile = wxFopen( m_workFilename, wxT( "w+b" ) );
+    wxASSERT( workFile );
 
-    if( m_outputFile == nullptr )
+    if( workFile == nullptr )
         return false;
 
+    setvbuf( workFile, nullptr, _IOFBF, WORK_FILE_BUFFER_SIZE );
+
     for( unsigned ii = 0; ii < m_headerExtraLines.GetCount(); ii++ )
     {
         if( ! m_headerExtraLines[ii].IsEmpty() )
@@ -304,6 +369,8 @@ bool GERBER_PLOTTER::StartPlot( const wxString& aPageNumber )
     // Add aperture list start point
     fmt::println( m_outputFile, "G04 APERTURE LIST*" );
 
+    m_outputFile = workFile;
+
     // Give a minimal value to the default pen size, used to plot items in sketch mode
     if( m_renderSettings )
     {
@@ -318,78 +385,73 @@ bool GERBER_PLOTTER::StartPlot( const wxString& aPageNumber )
 
 bool GERBER_PLOTTER::EndPlot()
 {
-    char     line[1024];
-
     wxASSERT( m_outputFile );
 
     /* Outfile is actually a temporary file i.e. workFile */
     fmt::println( m_outputFile, "M02*" );
-    fflush( m_outputFile );
 
-    fclose( workFile );
-    workFile   = wxFopen( m_workFilename, wxT( "rt" ));
-    wxASSERT( workFile );
     m_outputFile = finalFile;
 
-    // Placement of apertures in RS274X
-    while( fgets( line, 1024, workFile ) )
+    // Placement of apertures in RS274X, just after the header written by StartPlot()
+    // Add aperture list macro:
+    if( m_hasApertureRoundRect || m_hasApertureRotOval ||
+        m_hasApertureOutline4P || m_hasApertureRotRect ||
+        m_hasApertureChamferedRect || m_am_freepoly_list.AmCount() )
     {
-        fmt::print( m_outputFile, "{}", line );
+        fmt::println( m_outputFile, "G04 Aperture macros list*" );
 
-        char* substr = strtok( line, "\n\r" );
+        if( m_hasApertureRoundRect )
+            fmt::print( m_outputFile, APER_MACRO_ROUNDRECT_HEADER );
 
-        if( substr && strcmp( substr, "G04 APERTURE LIST*" ) == 0 )
-        {
-            // Add aperture list macro:
-            if( m_hasApertureRoundRect || m_hasApertureRotOval ||
-                m_hasApertureOutline4P || m_hasApertureRotRect ||
-                m_hasApertureChamferedRect || m_am_freepoly_list.AmCount() )
-            {
-                fmt::println( m_outputFile, "G04 Aperture macros list*" );
+        if( m_hasApertureRotOval )
+            fmt::print( m_outputFile, APER_MACRO_SHAPE_OVAL_HEADER );
 
-                if( m_hasApertureRoundRect )
-                    fmt::print( m_outputFile, APER_MACRO_ROUNDRECT_HEADER );
+        if( m_hasApertureRotRect )
+            fmt::print( m_outputFile, APER_MACRO_ROT_RECT_HEADER );
 
-                if( m_hasApertureRotOval )
-                    fmt::print( m_outputFile, APER_MACRO_SHAPE_OVAL_HEADER );
+        if( m_hasApertureOutline4P )
+            fmt::print( m_outputFile, APER_MACRO_OUTLINE4P_HEADER );
 
-                if( m_hasApertureRotRect )
-                    fmt::print( m_outputFile, APER_MACRO_ROT_RECT_HEADER );
+        if( m_hasApertureChamferedRect )
+        {
+            fmt::print( m_outputFile, APER_MACRO_OUTLINE5P_HEADER );
+            fmt::print( m_outputFile, APER_MACRO_OUTLINE6P_HEADER );
+            fmt::print( m_outputFile, APER_MACRO_OUTLINE7P_HEADER );
+            fmt::print( m_outputFile, APER_MACRO_OUTLINE8P_HEADER );
+        }
 
-                if( m_hasApertureOutline4P )
-                    fmt::print( m_outputFile, APER_MACRO_OUTLINE4P_HEADER );
+        if( m_am_freepoly_list.AmCount() )
+        {
+            // aperture sizes are in inch or mm, regardless the
+            // coordinates format
+            double fscale = 0.0001 * m_plotScale / m_IUsPerDecimil; // inches
 
-                if( m_hasApertureChamferedRect )
-                {
-                    fmt::print( m_outputFile, APER_MACRO_OUTLINE5P_HEADER );
-                    fmt::print( m_outputFile, APER_MACRO_OUTLINE6P_HEADER );
-                    fmt::print( m_outputFile, APER_MACRO_OUTLINE7P_HEADER );
-                    fmt::print( m_outputFile, APER_MACRO_OUTLINE8P_HEADER );
-                }
+            if(! m_gerberUnitInch )
+                fscale *= 25.4;     // size in mm
 
-                if( m_am_freepoly_list.AmCount() )
-                {
-                    // aperture sizes are in inch or mm, regardless the
-                    // coordinates format
-                    double fscale = 0.0001 * m_plotScale / m_IUsPerDecimil; // inches
+            m_am_freepoly_list.Format( m_outputFile, fscale );
+        }
 
-                    if(! m_gerberUnitInch )
-                        fscale *= 25.4;     // size in mm
+        fmt::println( m_outputFile, "G04 Aperture macros list end*" );
+    }
 
-                    m_am_freepoly_list.Format( m_outputFile, fscale );
-                }
+    writeApertureList();
+    fmt::println( m_outputFile, "G04 APERTURE END LIST*" );
 
-                fmt::println( m_outputFile, "G04 Aperture macros list end*" );
-            }
+    // Then the body of the plot, copied in large blocks
+    std::vector<char> buffer( WORK_FILE_BUFFER_SIZE );
+    size_t            count;
 
-            writeApertureList();
-            fmt::println( m_outputFile, "G04 APERTURE END LIST*" );
-        }
-    }
+    rewind( workFile );
+
+    while( ( count = fread( buffer.data(), 1, buffer.size(), workFile ) ) > 0 )
+        fwrite( buffer.data(), 1, count, finalFile );
 
     fclose( workFile );
     fclose( finalFile );
     ::wxRemoveFile( m_workFilename );
+    workFile = nullptr;
+    finalFile = nullptr;
     m_outputFile = nullptr;
 
     return true;
@@ -425,13 +487,14 @@ int GERBER_PLOTTER::GetOrCreateAperture( const VECTOR2I& aSize, int aRadius,
                                          int                aApertureAttribute,
                                          const std::string& aCustomAttribute )
 {
-    int last_D_code = 9;
+    size_t            hash = apertureHash( aType, aSize, aRadius, aRotation, aApertureAttribute,
+                                           aCustomAttribute );
+    std::vector<int>& bucket = m_apertureIndex[hash];
 
     // Search an existing aperture
-    for( int idx = 0; idx < (int)m_apertures.size(); ++idx )
+    for( int idx : bucket )
     {
         APERTURE* tool = &m_apertures[idx];
-        last_D_code = tool->m_DCode;
 
         if( ( tool->m_Type == aType ) && ( tool->m_Size == aSize ) && ( tool->m_Radius == aRadius )
             && ( tool->m_Rotation == aRotation )
@@ -448,11 +511,13 @@ int GERBER_PLOTTER::GetOrCreateAperture( const VECTOR2I& aSize, int aRadius,
     new_tool.m_Type     = aType;
     new_tool.m_Radius   = aRadius;
     new_tool.m_Rotation = aRotation;
-    new_tool.m_DCode    = last_D_code + 1;
+    new_tool.m_DCode    = m_apertures.empty() ? FIRST_DCODE_VALUE
+                                              : m_apertures.back().m_DCode + 1;
     new_tool.m_ApertureAttribute = aApertureAttribute;
     new_tool.m_CustomAttribute = aCustomAttribute;
 
     m_apertures.push_back( new_tool );
+    bucket.push_back( m_apertures.size() - 1 );
 
     return m_apertures.size() - 1;
 }
@@ -463,8 +528,6 @@ int GERBER_PLOTTER::GetOrCreateAperture( const std::vector<VECTOR2I>& aCorners,
                                          int                aApertureAttribute,
                                          const std::string& aCustomAttribute )
 {
-    int last_D_code = 9;
-
     // For APERTURE::AM_FREE_POLYGON aperture macros, we need to create the macro
     // on the fly, because due to the fact the vertex count is not a constant we
     // cannot create a static definition.
@@ -476,26 +539,42 @@ int GERBER_PLOTTER::GetOrCreateAperture( const std::vector<VECTOR2I>& aCorners,
             m_am_freepoly_list.Append( aCorners );
     }
 
-    // Search an existing aperture
-    for( int idx = 0; idx < (int)m_apertures.size(); ++idx )
+    // Search an existing aperture.  Similar corner lists may be hashed in adjacent cells, and
+    // the first similar aperture is the one to use.
+    int found = -1;
+
+    for( int dx = -1; dx <= 1; ++dx )
     {
-        APERTURE* tool = &m_apertures[idx];
+        for( int dy = -1; dy <= 1; ++dy )
+        {
+            size_t hash = apertureHash( aType, aCorners.size(), polyHashCell( aCorners, dx, dy ),
+                                        aRotation, aApertureAttribute, aCustomAttribute );
+            auto   it = m_apertureIndex.find( hash );
 
-        last_D_code = tool->m_DCode;
+            if( it == m_apertureIndex.end() )
+                continue;
 
-        if( ( tool->m_Type == aType ) && ( tool->m_Corners.size() == aCorners.size() )
-            && ( tool->m_Rotation == aRotation )
-            && ( tool->m_ApertureAttribute == aApertureAttribute )
-            && ( tool->m_CustomAttribute == aCustomAttribute ) )
-        {
-            // A candidate is found. the corner lists must be similar
-            bool is_same = polyCompare( tool->m_Corners, aCorners );
+            for( int idx : it->second )
+            {
+                APERTURE* tool = &m_apertures[idx];
 
-            if( is_same )
-                return idx;
+                if( ( found < 0 || idx < found )
+                    && ( tool->m_Type == aType ) && ( tool->m_Corners.size() == aCorners.size() )
+                    && ( tool->m_Rotation == aRotation )
+                    && ( tool->m_ApertureAttribute == aApertureAttribute )
+                    && ( tool->m_CustomAttribute == aCustomAttribute ) )
+                {
+                    // A candidate is found. the corner lists must be similar
+                    if( polyCompare( tool->m_Corners, aCorners ) )
+                        found = idx;
+                }
+            }
         }
     }
 
+    if( found >= 0 )
+        return found;
+
     // Allocate a new aperture
     APERTURE new_tool;
 
@@ -504,12 +583,17 @@ int GERBER_PLOTTER::GetOrCreateAperture( const std::vector<VECTOR2I>& aCorners,
     new_tool.m_Type     = aType;
     new_tool.m_Radius   = 0;             // Not used
     new_tool.m_Rotation = aRotation;
-    new_tool.m_DCode    = last_D_code + 1;
+    new_tool.m_DCode    = m_apertures.empty() ? FIRST_DCODE_VALUE
+                                              : m_apertures.back().m_DCode + 1;
     new_tool.m_ApertureAttribute = aApertureAttribute;
     new_tool.m_CustomAttribute = aCustomAttribute;
 
     m_apertures.push_back( new_tool );
 
+    size_t hash = apertureHash( aType, aCorners.size(), polyHashCell( aCorners ), aRotation,
+                                aApertureAttribute, aCustomAttribute );
+    m_apertureIndex[hash].push_back( m_apertures.size() - 1 );
+
     return m_apertures.size() - 1;
 }
 
@@ -2074,17 +2158,33 @@ void APER_MACRO_FREEPOLY_LIST::Format( FILE * aOutput, double aIu2GbrMacroUnit )
 
 void APER_MACRO_FREEPOLY_LIST::Append( const std::vector<VECTOR2I>& aPolygon )
 {
+    m_index[freePolyHash( aPolygon.size(), polyHashCell( aPolygon ) )].push_back( AmCount() );
     m_AMList.emplace_back( aPolygon, AmCount() );
 }
 
 
 int APER_MACRO_FREEPOLY_LIST::FindAm( const std::vector<VECTOR2I>& aPolygon ) const
 {
-    for( int idx = 0; idx < AmCount(); idx++ )
+    // Similar polygons may be hashed in adjacent cells, and the first one is the one to use
+    int found = -1;
+
+    for( int dx = -1; dx <= 1; ++dx )
     {
-        if( m_AMList[idx].IsSamePoly( aPolygon ) )
-            return idx;
+        for( int dy = -1; dy <= 1; ++dy )
+        {
+            auto it = m_index.find( freePolyHash( aPolygon.size(),
+                                                  polyHashCell( aPolygon, dx, dy ) ) );
+
+            if( it == m_index.end() )
+                continue;
+
+            for( int idx : it->second )
+            {
+                if( ( found < 0 || idx < found ) && m_AMList[idx].IsSamePoly( aPolygon ) )
+                    found = idx;
+            }
+        }
     }
 
-    return -1;
+    return found;
 }
@@ -24,12 +24,14 @@
 
 
 #include <cstdarg>
+#include <cstring>
 #include <config.h> // HAVE_FGETC_NOLOCK
 
 #include <kiplatform/io.h>
 #include <core/ignore.h>
 #include <richio.h>
 #include <errno.h>
+#include <string_utils.h>
 #include <advanced_config.h>
 #include <io/kicad/kicad_io_utils.h>
 
@@ -277,6 +279,137 @@ char* FILE_LINE_READER::ReadLine()
 }
 
 
+MAPPED_FILE_LINE_READER::MAPPED_FILE_LINE_READER( const wxString& aFileName,
+                                                  unsigned aStartingLineNumber,
+                                                  unsigned aMaxLineLength ) :
+        LINE_READER( aMaxLineLength ),
+        m_data( nullptr ),
+        m_size( 0 ),
+        m_ndx( 0 ),
+        m_lineStart( 0 ),
+        m_mapping( nullptr ),
+        m_mapped( false )
+{
+    m_data = KIPLATFORM::IO::MapFile( aFileName, m_size, m_mapping );
+
+    if( m_data )
+    {
+        m_mapped = true;
+    }
+    else
+    {
+        FILE* fp = KIPLATFORM::IO::SeqFOpen( aFileName, wxT( "rb" ) );
+
+        if( !fp )
+        {
+            wxString msg = wxString::Format( _( "Unable to open %s for reading." ),
+                                             aFileName.GetData() );
+            THROW_IO_ERROR( msg );
+        }
+
+        char   buf[65536];
+        size_t count;
+
+        while( ( count = fread( buf, 1, sizeof( buf ), fp ) ) > 0 )
+            m_buffer.append( buf, count );
+
+        fclose( fp );
+
+        m_data = m_buffer.data();
+        m_size = m_buffer.size();
+    }
+
+    m_source  = aFileName;
+    m_lineNum = aStartingLineNumber;
+}
+
+
+MAPPED_FILE_LINE_READER::MAPPED_FILE_LINE_READER( const MAPPED_FILE_LINE_READER& aParent ) :
+        LINE_READER( aParent.m_maxLineLength ),
+        m_data( aParent.m_data ),
+        m_size( aParent.m_size ),
+        m_ndx( aParent.m_ndx ),
+        m_lineStart( aParent.m_ndx ),
+        m_mapping( nullptr ),
+        m_mapped( false )
+{
+    m_source  = aParent.m_source;
+    m_lineNum = aParent.m_lineNum;
+}
+
+
+MAPPED_FILE_LINE_READER::~MAPPED_FILE_LINE_READER()
+{
+    if( m_mapped )
+        KIPLATFORM::IO::UnmapFile( m_data, m_size, m_mapping );
+}
+
+
+unsigned MAPPED_FILE_LINE_READER::CountLines() const
+{
+    unsigned    count = 0;
+    const char* cur = m_data;
+    const char* end = m_data + m_size;
+
+    while( cur < end )
+    {
+        const char* nl = static_cast<const char*>( memchr( cur, '\n', end - cur ) );
+
+        ++count;
+
+        if( !nl )
+            break;
+
+        cur = nl + 1;
+    }
+
+    return count;
+}
+
+
+std::string_view MAPPED_FILE_LINE_READER::ReadLineView()
+{
+    size_t      remaining = m_size - m_ndx;
+    const char* begin = m_data + m_ndx;
+    const char* nl = static_cast<const char*>( memchr( begin, '\n', remaining ) );
+    size_t      new_length = nl ? ( nl - begin ) + 1 : remaining;   // include the newline
+
+    if( new_length >= m_maxLineLength )
+        THROW_IO_ERROR( _( "Maximum line length exceeded" ) );
+
+    m_lineStart = m_ndx;
+    m_ndx += new_length;
+    m_length = new_length;
+
+    // m_lineNum is incremented even if there was no line read, because this
+    // leads to better error reporting when we hit an end of file.
+    ++m_lineNum;
+
+    return std::string_view( begin, new_length );
+}
+
+
+const char* MAPPED_FILE_LINE_READER::CurLine()
+{
+    if( m_length + 1 > m_capacity )   // +1 for terminating nul
+        expandCapacity( m_length + 1 );
+
+    memcpy( m_line, m_data + m_lineStart, m_length );
+    m_line[ m_length ] = 0;
+
+    return m_line;
+}
+
+
+char* MAPPED_FILE_LINE_READER::ReadLine()
+{
+    ReadLineView();
+    CurLine();
+
+    return m_length ? m_line : nullptr;
+}
+
+
 STRING_LINE_READER::STRING_LINE_READER( const std::string& aString, const wxString& aSource ):
     LINE_READER( LINE_READER_LINE_DEFAULT_MAX ),
     m_lines( aString ), m_ndx( 0 )
@@ -426,14 +559,16 @@ int OUTPUTFORMATTER::vprint( const char* fmt, va_list ap )
     // va_arg was used on it, and thus the state of the va_list is likely to be altered by the call.
     // see: www.cplusplus.com/reference/cstdio/vsnprintf
     // we make a copy of va_list ap for the second call, if happens
+    //
+    // Numbers are always written in the "C" locale, so callers don't need a LOCALE_IO.
     va_list tmp;
     va_copy( tmp, ap );
-    int ret = vsnprintf( &m_buffer[0], m_buffer.size(), fmt, ap );
+    int ret = CLocaleVsnprintf( &m_buffer[0], m_buffer.size(), fmt, ap );
 
     if( ret >= (int) m_buffer.size() )
     {
         m_buffer.resize( ret + 1000 );
-        ret = vsnprintf( &m_buffer[0], m_buffer.size(), fmt, tmp );
+        ret = CLocaleVsnprintf( &m_buffer[0], m_buffer.size(), fmt, tmp );
     }
 
     va_end( tmp );      // Release the temporary va_list, initialised from ap
@@ -606,12 +741,15 @@ void FILE_OUTPUTFORMATTER::write( const char* aOutBuf, int aCount )
 PRETTIFIED_FILE_OUTPUTFORMATTER::PRETTIFIED_FILE_OUTPUTFORMATTER( const wxString& aFileName,
                                                                   const wxChar* aMode,
                                                                   char aQuoteChar ) :
-        OUTPUTFORMATTER( OUTPUTFMTBUFZ, aQuoteChar )
+        OUTPUTFORMATTER( OUTPUTFMTBUFZ, aQuoteChar ),
+        m_prettifier( ADVANCED_CFG::GetCfg().m_CompactSave )
 {
     m_fp = wxFopen( aFileName, aMode );
 
     if( !m_fp )
         THROW_IO_ERROR( strerror( errno ) );
+
+    m_buf.reserve( PRETTIFIED_BUFFER_SIZE + OUTPUTFMTBUFZ );
 }
 
 
@@ -631,10 +769,8 @@ bool PRETTIFIED_FILE_OUTPUTFORMATTER::Finish()
     if( !m_fp )
         return false;
 
-    KICAD_FORMAT::Prettify( m_buf, ADVANCED_CFG::GetCfg().m_CompactSave );
-
-    if( fwrite( m_buf.c_str(), m_buf.length(), 1, m_fp ) != 1 )
-        THROW_IO_ERROR( strerror( errno ) );
+    m_prettifier.Finish( m_buf );
+    flush();
 
     fclose( m_fp );
     m_fp = nullptr;
@@ -645,5 +781,17 @@ bool PRETTIFIED_FILE_OUTPUTFORMATTER::Finish()
 
 void PRETTIFIED_FILE_OUTPUTFORMATTER::write( const char* aOutBuf, int aCount )
 {
-    m_buf.append( aOutBuf, aCount );
+    m_prettifier.Feed( aOutBuf, aCount, m_buf );
+
+    if( m_buf.length() >= PRETTIFIED_BUFFER_SIZE )
+        flush();
+}
+
+
+void PRETTIFIED_FILE_OUTPUTFORMATTER::flush()
+{
+    if( !m_buf.empty() && fwrite( m_buf.c_str(), m_buf.length(), 1, m_fp ) != 1 )
+        THROW_IO_ERROR( strerror( errno ) );
+
+    m_buf.clear();
 }
@@ -26,8 +26,14 @@
  * @brief Some useful functions to handle strings.
  */
 
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <charconv>
 #include <clocale>
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
 #include <map>
 #include <core/map_helpers.h>
 #include <fmt/core.h>
@@ -40,6 +46,14 @@
 #include <wx/regex.h>
 #include "locale_io.h"
 
+#if !defined( _WIN32 )
+#include <locale.h>
+
+#if defined( __APPLE__ ) || defined( __FreeBSD__ ) || defined( __OpenBSD__ ) || defined( __NetBSD__ )
+#include <xlocale.h>
+#endif
+#endif
+
 
 /**
  * Illegal file name characters used to ensure file names will be valid on all supported
@@ -1403,6 +1417,91 @@ std::string FormatDouble2Str( double aValue )
 }
 
 
+#if defined( _WIN32 )
+typedef _locale_t C_NUMERIC_LOCALE;
+#else
+typedef locale_t  C_NUMERIC_LOCALE;
+#endif
+
+
+/**
+ * The "C" numeric locale, used to read and write numbers without switching the global locale.
+ * It is created on first use and lives as long as the program.
+ */
+static C_NUMERIC_LOCALE cNumericLocale()
+{
+#if defined( _WIN32 )
+    static _locale_t locale = _create_locale( LC_NUMERIC, "C" );
+#else
+    static locale_t locale = newlocale( LC_NUMERIC_MASK, "C", (locale_t) 0 );
+#endif
+
+    return locale;
+}
+
+
+const char* ParseCDouble( const char* aBegin, const char* aEnd, double& aValue )
+{
+    // std::from_chars doesn't skip whitespace
+    while( aBegin < aEnd && std::isspace( static_cast<unsigned char>( *aBegin ) ) )
+        ++aBegin;
+
+#if ( defined( __GNUC__ ) && __GNUC__ < 11 ) || ( defined( __clang__ ) && __clang_major__ < 13 )
+    // GCC older than 11 "supports" C++17 without supporting the C++17 std::from_chars for doubles
+    // clang is similar.  strtod_l() needs a terminated string.
+    std::string text( aBegin, aEnd );
+    char*       end = nullptr;
+
+    errno = 0;
+
+#if defined( _WIN32 )
+    aValue = _strtod_l( text.c_str(), &end, cNumericLocale() );
+#else
+    aValue = strtod_l( text.c_str(), &end, cNumericLocale() );
+#endif
+
+    if( errno || end == text.c_str() )
+        return nullptr;
+
+    return aBegin + ( end - text.c_str() );
+#else
+    std::from_chars_result res = std::from_chars( aBegin, aEnd, aValue );
+
+    if( res.ec != std::errc() )
+        return nullptr;
+
+    return res.ptr;
+#endif
+}
+
+
+int CLocaleVsnprintf( char* aBuffer, size_t aSize, const char* aFormat, va_list aArgs )
+{
+#if defined( _WIN32 )
+    va_list tmp;
+    va_copy( tmp, aArgs );
+    int len = _vscprintf_l( aFormat, cNumericLocale(), tmp );
+    va_end( tmp );
+
+    if( len >= 0 && aSize > 0 )
+    {
+        // Unlike C99 vsnprintf(), _vsnprintf_l() doesn't terminate truncated text
+        _vsnprintf_l( aBuffer, aSize - 1, aFormat, cNumericLocale(), aArgs );
+        aBuffer[std::min( static_cast<size_t>( len ), aSize - 1 )] = '\0';
+    }
+
+    return len;
+#else
+    // uselocale() only changes the locale of the calling thread
+    locale_t previous = uselocale( cNumericLocale() );
+    int      len = vsnprintf( aBuffer, aSize, aFormat, aArgs );
+
+    uselocale( previous );
+    return len;
+#endif
+}
+
+
 std::string UIDouble2Str( double aValue )
 {
     char    buf[50];
@@ -24,6 +24,7 @@
 #include <future>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <core/profile.h>
 #include <core/kicad_algo.h>
 #include <common.h>
@@ -634,11 +635,43 @@ void CONNECTION_GRAPH::Merge( CONNECTION_GRAPH& aGraph )
     for( auto& [key, value] : aGraph.m_sheet_to_subgraphs_map )
         m_sheet_to_subgraphs_map.insert_or_assign( key, value );
 
+    // The partial graph started with a copy of our name to code maps from before the affected
+    // nets were removed.  Only take over the codes its subgraphs still use, so that the entries
+    // of removed nets don't come back.
+    std::unordered_set<int> netCodes;
+    std::unordered_set<int> busCodes;
+
+    auto collectCodes =
+            [&]( const SCH_CONNECTION* aConnection )
+            {
+                if( aConnection->IsBus() )
+                    busCodes.insert( aConnection->BusCode() );
+                else
+                    netCodes.insert( aConnection->NetCode() );
+            };
+
+    for( CONNECTION_SUBGRAPH* sg : aGraph.m_subgraphs )
+    {
+        if( !sg->m_driver_connection )
+            continue;
+
+        collectCodes( sg->m_driver_connection );
+
+        for( const std::shared_ptr<SCH_CONNECTION>& member : sg->m_driver_connection->AllMembers() )
+            collectCodes( member.get() );
+    }
+
     for( auto& [key, value] : aGraph.m_net_name_to_code_map )
-        m_net_name_to_code_map.insert_or_assign( key, value );
+    {
+        if( netCodes.contains( value ) )
+            m_net_name_to_code_map.insert_or_assign( key, value );
+    }
 
     for( auto& [key, value] : aGraph.m_bus_name_to_code_map )
-        m_bus_name_to_code_map.insert_or_assign( key, value );
+    {
+        if( busCodes.contains( value ) )
+            m_bus_name_to_code_map.insert_or_assign( key, value );
+    }
 
     for( auto& [key, value] : aGraph.m_net_code_to_subgraphs_map )
         m_net_code_to_subgraphs_map.insert_or_assign( key, value );
@@ -863,6 +896,7 @@ std::set<std::pair<SCH_SHEET_PATH, SCH_ITEM*>> CONNECTION_GRAPH::ExtractAffected
 {
     std::set<std::pair<SCH_SHEET_PATH, SCH_ITEM*>> retvals;
     std::set<CONNECTION_SUBGRAPH*> subgraphs;
+    std::unordered_set<SCH_ITEM*>  removedItems;
 
     auto traverse_subgraph = [&retvals, &subgraphs]( CONNECTION_SUBGRAPH* aSubgraph )
     {
@@ -933,7 +967,7 @@ std::set<std::pair<SCH_SHEET_PATH, SCH_ITEM*>> CONNECTION_GRAPH::ExtractAffected
             }
         }
 
-        alg::delete_matching( m_items, aItem );
+        removedItems.insert( aItem );
     };
 
     for( SCH_ITEM* item : aItems )
@@ -961,7 +995,15 @@ std::set<std::pair<SCH_SHEET_PATH, SCH_ITEM*>> CONNECTION_GRAPH::ExtractAffected
     removeSubgraphs( subgraphs );
 
     for( const auto& [path, item] : retvals )
-        alg::delete_matching( m_items, item );
+        removedItems.insert( item );
+
+    // A big net can drag in thousands of items; remove them all in a single pass over m_items
+    // rather than one search each.
+    alg::delete_if( m_items,
+                    [&]( SCH_ITEM* aItem )
+                    {
+                        return removedItems.contains( aItem );
+                    } );
 
     return retvals;
 }
@@ -985,18 +1027,67 @@ void CONNECTION_GRAPH::RemoveItem( SCH_ITEM* aItem )
 }
 
 
-void CONNECTION_GRAPH::removeSubgraphs( std::set<CONNECTION_SUBGRAPH*>& aSubgraphs )
+CONNECTION_GRAPH::ITEM_NET_NAMES CONNECTION_GRAPH::GetItemNetNames() const
 {
-    wxLogTrace( ConnTrace, wxT( "Removing %zu subgraphs" ), aSubgraphs.size() );
-    std::sort( m_driver_subgraphs.begin(), m_driver_subgraphs.end() );
-    std::sort( m_subgraphs.begin(), m_subgraphs.end() );
-    std::set<int> codes_to_remove;
+    ITEM_NET_NAMES netNames;
 
-    for( auto& el : m_sheet_to_subgraphs_map )
+    for( SCH_ITEM* item : m_items )
     {
-        std::sort( el.second.begin(), el.second.end() );
+        for( const auto& [sheet, connection] : item->m_connection_map )
+        {
+            if( connection )
+                netNames[{ sheet, item }] = connection->Name();
+        }
     }
 
+    return netNames;
+}
+
+
+int CONNECTION_GRAPH::CompareItemNetNames( const ITEM_NET_NAMES& aIncremental,
+                                           const ITEM_NET_NAMES& aFull )
+{
+    int differences = 0;
+
+    for( const auto& [key, fullName] : aFull )
+    {
+        const auto& [sheet, item] = key;
+        auto        it = aIncremental.find( key );
+
+        if( it == aIncremental.end() )
+        {
+            wxLogTrace( ConnTrace, wxT( "%s on %s (net %s) missing from incremental update" ),
+                        item->GetTypeDesc(), sheet.PathHumanReadable(), fullName );
+            differences++;
+        }
+        else if( it->second != fullName )
+        {
+            wxLogTrace( ConnTrace, wxT( "%s on %s is on net %s, full rebuild gives %s" ),
+                        item->GetTypeDesc(), sheet.PathHumanReadable(), it->second, fullName );
+            differences++;
+        }
+    }
+
+    for( const auto& [key, incrementalName] : aIncremental )
+    {
+        if( !aFull.contains( key ) )
+        {
+            wxLogTrace( ConnTrace, wxT( "%s on %s (net %s) not in full rebuild" ),
+                        key.second->GetTypeDesc(), key.first.PathHumanReadable(),
+                        incrementalName );
+            differences++;
+        }
+    }
+
+    return differences;
+}
+
+
+void CONNECTION_GRAPH::removeSubgraphs( std::set<CONNECTION_SUBGRAPH*>& aSubgraphs )
+{
+    wxLogTrace( ConnTrace, wxT( "Removing %zu subgraphs" ), aSubgraphs.size() );
+    std::set<int> codes_to_remove;
+
     for( CONNECTION_SUBGRAPH* sg : aSubgraphs )
     {
         for( auto& it : sg->m_bus_neighbors )
@@ -1036,88 +1127,77 @@ void CONNECTION_GRAPH::removeSubgraphs( std::set<CONNECTION_SUBGRAPH*>& aSubgrap
                     parent->m_bus_neighbors.erase( it.first );
             }
         }
+    }
 
-        {
-            auto it = std::lower_bound( m_driver_subgraphs.begin(), m_driver_subgraphs.end(), sg );
-
-            while( it != m_driver_subgraphs.end() && *it == sg )
-                it = m_driver_subgraphs.erase( it );
-        }
-
-        {
-            auto it = std::lower_bound( m_subgraphs.begin(), m_subgraphs.end(), sg );
-
-            while( it != m_subgraphs.end() && *it == sg )
-                it = m_subgraphs.erase( it );
-        }
-
-        for( auto& el : m_sheet_to_subgraphs_map )
-        {
-            auto it = std::lower_bound( el.second.begin(), el.second.end(), sg );
+    // Each container is swept once for all the removed subgraphs.  Sweeping them once per
+    // subgraph made removing a large net quadratic in the size of the schematic.
+    auto isRemoved =
+            [&]( const CONNECTION_SUBGRAPH* aSubgraph ) -> bool
+            {
+                return aSubgraphs.contains( const_cast<CONNECTION_SUBGRAPH*>( aSubgraph ) );
+            };
 
-            while( it != el.second.end() && *it == sg )
-                it = el.second.erase( it );
-        }
+    auto containsRemoved =
+            [&]( const auto& aSubgraphList ) -> bool
+            {
+                for( const CONNECTION_SUBGRAPH* test_sg : aSubgraphList )
+                {
+                    if( isRemoved( test_sg ) )
+                        return true;
+                }
 
-        auto remove_sg = [sg]( auto it ) -> bool
-                         {
-                             for( const CONNECTION_SUBGRAPH* test_sg : it->second )
-                             {
-                                 if( sg == test_sg )
-                                     return true;
-                             }
+                return false;
+            };
 
-                             return false;
-                         };
+    alg::delete_if( m_driver_subgraphs, isRemoved );
+    alg::delete_if( m_subgraphs, isRemoved );
 
-        for( auto it = m_global_label_cache.begin(); it != m_global_label_cache.end(); )
-        {
-            if( remove_sg( it ) )
-                it = m_global_label_cache.erase( it );
-            else
-                ++it;
-        }
+    for( auto& el : m_sheet_to_subgraphs_map )
+        alg::delete_if( el.second, isRemoved );
 
-        for( auto it = m_local_label_cache.begin(); it != m_local_label_cache.end(); )
-        {
-            if( remove_sg( it ) )
-                it = m_local_label_cache.erase( it );
-            else
-                ++it;
-        }
+    for( auto it = m_global_label_cache.begin(); it != m_global_label_cache.end(); )
+    {
+        if( containsRemoved( it->second ) )
+            it = m_global_label_cache.erase( it );
+        else
+            ++it;
+    }
 
-        for( auto it = m_net_code_to_subgraphs_map.begin();
-             it != m_net_code_to_subgraphs_map.end(); )
-        {
-            if( remove_sg( it ) )
-            {
-                codes_to_remove.insert( it->first.Netcode );
-                it = m_net_code_to_subgraphs_map.erase( it );
-            }
-            else
-            {
-                ++it;
-            }
-        }
+    for( auto it = m_local_label_cache.begin(); it != m_local_label_cache.end(); )
+    {
+        if( containsRemoved( it->second ) )
+            it = m_local_label_cache.erase( it );
+        else
+            ++it;
+    }
 
-        for( auto it = m_net_name_to_subgraphs_map.begin();
-             it != m_net_name_to_subgraphs_map.end(); )
+    for( auto it = m_net_code_to_subgraphs_map.begin(); it != m_net_code_to_subgraphs_map.end(); )
+    {
+        if( containsRemoved( it->second ) )
         {
-            if( remove_sg( it ) )
-                it = m_net_name_to_subgraphs_map.erase( it );
-            else
-                ++it;
+            codes_to_remove.insert( it->first.Netcode );
+            it = m_net_code_to_subgraphs_map.erase( it );
         }
-
-        for( auto it = m_item_to_subgraph_map.begin(); it != m_item_to_subgraph_map.end(); )
+        else
         {
-            if( it->second == sg )
-                it = m_item_to_subgraph_map.erase( it );
-            else
-                ++it;
+            ++it;
         }
+    }
 
+    for( auto it = m_net_name_to_subgraphs_map.begin(); it != m_net_name_to_subgraphs_map.end(); )
+    {
+        if( containsRemoved( it->second ) )
+            it = m_net_name_to_subgraphs_map.erase( it );
+        else
+            ++it;
+    }
 
+    for( auto it = m_item_to_subgraph_map.begin(); it != m_item_to_subgraph_map.end(); )
+    {
+        if( isRemoved( it->second ) )
+            it = m_item_to_subgraph_map.erase( it );
+        else
+            ++it;
     }
 
     for( auto it = m_net_name_to_code_map.begin(); it != m_net_name_to_code_map.end(); )
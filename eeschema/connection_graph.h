@@ -22,6 +22,7 @@
 #ifndef _CONNECTION_GRAPH_H
 #define _CONNECTION_GRAPH_H
 
+#include <map>
 #include <mutex>
 #include <utility>
 #include <vector>
@@ -376,11 +377,18 @@ public:
         m_schematic = aSchematic;
     }
 
+    /**
+     * Continue the net, bus and subgraph numbering of \a aOther.  Net and bus names already
+     * known to \a aOther keep their codes, so an incremental update only assigns new codes to
+     * nets that didn't exist before.
+     */
     void SetLastCodes( const CONNECTION_GRAPH* aOther )
     {
         m_last_net_code = aOther->m_last_net_code;
         m_last_bus_code = aOther->m_last_bus_code;
         m_last_subgraph_code = aOther->m_last_subgraph_code;
+        m_net_name_to_code_map = aOther->m_net_name_to_code_map;
+        m_bus_name_to_code_map = aOther->m_bus_name_to_code_map;
     }
 
     /**
@@ -474,6 +482,24 @@ public:
 
     void RemoveItem( SCH_ITEM* aItem );
 
+    /// The net name of each connected item, for each sheet the item is used on.
+    using ITEM_NET_NAMES = std::map<std::pair<SCH_SHEET_PATH, SCH_ITEM*>, wxString>;
+
+    /**
+     * Return the net name of every item in the graph.  Used to check an incremental update
+     * against a full rebuild.
+     */
+    ITEM_NET_NAMES GetItemNetNames() const;
+
+    /**
+     * Compare the item net names from an incremental update with those from a full rebuild,
+     * tracing each difference.
+     *
+     * @return the number of items whose net differs or which are only in one of the sets
+     */
+    static int CompareItemNetNames( const ITEM_NET_NAMES& aIncremental,
+                                    const ITEM_NET_NAMES& aFull );
+
     /**
      * Replace all references to #aOldItem with #aNewItem in the graph.
     */
@@ -56,6 +56,7 @@
 #include <wx/ffile.h>
 #include <sim/sim_lib_mgr.h>
 #include <progress_reporter.h>
+#include <thread_pool.h>
 #include <kiway.h>
 
 
@@ -842,309 +843,353 @@ int ERC_TESTER::TestFourWayJunction()
 
 int ERC_TESTER::TestNoConnectPins()
 {
-    int err_count = 0;
+    std::vector<PENDING_MARKERS> sheetMarkers( m_sheetList.size() );
 
-    for( const SCH_SHEET_PATH& sheet : m_sheetList )
-    {
-        std::map<VECTOR2I, std::vector<SCH_ITEM*>> pinMap;
+    // Sheets are checked on the thread pool.  Several sheet paths can share a screen, so the
+    // markers are only added once all the sheets are done.
+    thread_pool& tp = GetKiCadThreadPool();
 
-        auto addOther =
-                [&]( const VECTOR2I& pt, SCH_ITEM* aOther )
-                {
-                    if( pinMap.count( pt ) )
-                        pinMap[pt].emplace_back( aOther );
-                };
+    tp.parallelize_loop( m_sheetList.size(),
+            [&]( const int a, const int b )
+            {
+                for( int ii = a; ii < b; ++ii )
+                    testNoConnectPins( m_sheetList[ii], sheetMarkers[ii] );
+            } ).wait();
 
-        for( SCH_ITEM* item : sheet.LastScreen()->Items().OfType( SCH_SYMBOL_T ) )
-        {
-            SCH_SYMBOL* symbol = static_cast<SCH_SYMBOL*>( item );
+    return appendMarkers( sheetMarkers );
+}
 
-            for( SCH_PIN* pin : symbol->GetPins( &sheet ) )
+
+void ERC_TESTER::testNoConnectPins( const SCH_SHEET_PATH& aSheet, PENDING_MARKERS& aMarkers ) const
+{
+    std::map<VECTOR2I, std::vector<SCH_ITEM*>> pinMap;
+
+    auto addOther =
+            [&]( const VECTOR2I& pt, SCH_ITEM* aOther )
             {
-                if( pin->GetLibPin()->GetType() == ELECTRICAL_PINTYPE::PT_NC )
-                    pinMap[pin->GetPosition()].emplace_back( pin );
-            }
+                if( pinMap.count( pt ) )
+                    pinMap[pt].emplace_back( aOther );
+            };
+
+    for( SCH_ITEM* item : aSheet.LastScreen()->Items().OfType( SCH_SYMBOL_T ) )
+    {
+        SCH_SYMBOL* symbol = static_cast<SCH_SYMBOL*>( item );
+
+        for( SCH_PIN* pin : symbol->GetPins( &aSheet ) )
+        {
+            if( pin->GetLibPin()->GetType() == ELECTRICAL_PINTYPE::PT_NC )
+                pinMap[pin->GetPosition()].emplace_back( pin );
         }
+    }
 
-        for( SCH_ITEM* item : sheet.LastScreen()->Items() )
+    for( SCH_ITEM* item : aSheet.LastScreen()->Items() )
+    {
+        if( item->Type() == SCH_SYMBOL_T )
         {
-            if( item->Type() == SCH_SYMBOL_T )
-            {
-                SCH_SYMBOL* symbol = static_cast<SCH_SYMBOL*>( item );
+            SCH_SYMBOL* symbol = static_cast<SCH_SYMBOL*>( item );
 
-                for( SCH_PIN* pin : symbol->GetPins( &sheet ) )
-                {
-                    if( pin->GetLibPin()->GetType() != ELECTRICAL_PINTYPE::PT_NC )
-                        addOther( pin->GetPosition(), pin );
-                }
-            }
-            else if( item->IsConnectable() && item->Type() != SCH_NO_CONNECT_T )
+            for( SCH_PIN* pin : symbol->GetPins( &aSheet ) )
             {
-                for( const VECTOR2I& pt : item->GetConnectionPoints() )
-                    addOther( pt, item );
+                if( pin->GetLibPin()->GetType() != ELECTRICAL_PINTYPE::PT_NC )
+                    addOther( pin->GetPosition(), pin );
             }
         }
-
-        for( const std::pair<const VECTOR2I, std::vector<SCH_ITEM*>>& pair : pinMap )
+        else if( item->IsConnectable() && item->Type() != SCH_NO_CONNECT_T )
         {
-            if( pair.second.size() > 1 )
-            {
-                err_count++;
+            for( const VECTOR2I& pt : item->GetConnectionPoints() )
+                addOther( pt, item );
+        }
+    }
 
-                std::shared_ptr<ERC_ITEM> ercItem = ERC_ITEM::Create( ERCE_NOCONNECT_CONNECTED );
+    for( const std::pair<const VECTOR2I, std::vector<SCH_ITEM*>>& pair : pinMap )
+    {
+        if( pair.second.size() > 1 )
+        {
+            std::shared_ptr<ERC_ITEM> ercItem = ERC_ITEM::Create( ERCE_NOCONNECT_CONNECTED );
 
-                ercItem->SetItems( pair.second[0], pair.second[1],
-                                   pair.second.size() > 2 ? pair.second[2] : nullptr,
-                                   pair.second.size() > 3 ? pair.second[3] : nullptr );
-                ercItem->SetErrorMessage( _( "Pin with 'no connection' type is connected" ) );
-                ercItem->SetSheetSpecificPath( sheet );
+            ercItem->SetItems( pair.second[0], pair.second[1],
+                               pair.second.size() > 2 ? pair.second[2] : nullptr,
+                               pair.second.size() > 3 ? pair.second[3] : nullptr );
+            ercItem->SetErrorMessage( _( "Pin with 'no connection' type is connected" ) );
+            ercItem->SetSheetSpecificPath( aSheet );
 
-                SCH_MARKER* marker = new SCH_MARKER( ercItem, pair.first );
-                sheet.LastScreen()->Append( marker );
-            }
+            SCH_MARKER* marker = new SCH_MARKER( ercItem, pair.first );
+            aMarkers.emplace_back( aSheet.LastScreen(), marker );
         }
     }
-
-    return err_count;
 }
 
 
 int ERC_TESTER::TestPinToPin()
 {
-    int errors = 0;
+    std::vector<const std::vector<CONNECTION_SUBGRAPH*>*> nets;
+    std::vector<PENDING_MARKERS>                          netMarkers( m_nets.size() );
 
-    for( const std::pair<NET_NAME_CODE_CACHE_KEY, std::vector<CONNECTION_SUBGRAPH*>> net : m_nets )
+    nets.reserve( m_nets.size() );
+
+    for( const auto& [key, subgraphs] : m_nets )
+        nets.push_back( &subgraphs );
+
+    // Nets are independent, so check them on the thread pool.  The markers are added to their
+    // screens afterwards, in net order, so the results don't depend on the scheduling.
+    thread_pool& tp = GetKiCadThreadPool();
+
+    tp.parallelize_loop( nets.size(),
+            [&]( const int a, const int b )
+            {
+                for( int ii = a; ii < b; ++ii )
+                    testPinToPin( *nets[ii], netMarkers[ii] );
+            } ).wait();
+
+    return appendMarkers( netMarkers );
+}
+
+
+void ERC_TESTER::testPinToPin( const std::vector<CONNECTION_SUBGRAPH*>& aSubgraphs,
+                               PENDING_MARKERS& aMarkers ) const
+{
+    using iterator_t = std::vector<ERC_SCH_PIN_CONTEXT>::iterator;
+    std::vector<ERC_SCH_PIN_CONTEXT>           pins;
+    std::unordered_map<EDA_ITEM*, SCH_SCREEN*> pinToScreenMap;
+    bool has_noconnect = false;
+
+    for( CONNECTION_SUBGRAPH* subgraph : aSubgraphs )
     {
-        using iterator_t = std::vector<ERC_SCH_PIN_CONTEXT>::iterator;
-        std::vector<ERC_SCH_PIN_CONTEXT>           pins;
-        std::unordered_map<EDA_ITEM*, SCH_SCREEN*> pinToScreenMap;
-        bool has_noconnect = false;
+        if( subgraph->GetNoConnect() )
+            has_noconnect = true;
 
-        for( CONNECTION_SUBGRAPH* subgraph: net.second )
+        for( SCH_ITEM* item : subgraph->GetItems() )
         {
-            if( subgraph->GetNoConnect() )
-                has_noconnect = true;
-
-            for( SCH_ITEM* item : subgraph->GetItems() )
+            if( item->Type() == SCH_PIN_T )
             {
-                if( item->Type() == SCH_PIN_T )
-                {
-                    pins.emplace_back( static_cast<SCH_PIN*>( item ), subgraph->GetSheet() );
-                    pinToScreenMap[item] = subgraph->GetSheet().LastScreen();
-                }
+                pins.emplace_back( static_cast<SCH_PIN*>( item ), subgraph->GetSheet() );
+                pinToScreenMap[item] = subgraph->GetSheet().LastScreen();
             }
         }
+    }
+
+    std::sort( pins.begin(), pins.end(),
+               []( const ERC_SCH_PIN_CONTEXT& lhs, const ERC_SCH_PIN_CONTEXT& rhs )
+               {
+                   int ret = StrNumCmp( lhs.Pin()->GetParentSymbol()->GetRef( &lhs.Sheet() ),
+                                        rhs.Pin()->GetParentSymbol()->GetRef( &rhs.Sheet() ) );
 
-        std::sort( pins.begin(), pins.end(),
-                   []( const ERC_SCH_PIN_CONTEXT& lhs, const ERC_SCH_PIN_CONTEXT& rhs )
-                   {
-                       int ret = StrNumCmp( lhs.Pin()->GetParentSymbol()->GetRef( &lhs.Sheet() ),
-                                            rhs.Pin()->GetParentSymbol()->GetRef( &rhs.Sheet() ) );
+                   if( ret == 0 )
+                       ret = StrNumCmp( lhs.Pin()->GetNumber(), rhs.Pin()->GetNumber() );
 
-                       if( ret == 0 )
-                           ret = StrNumCmp( lhs.Pin()->GetNumber(), rhs.Pin()->GetNumber() );
+                   if( ret == 0 )
+                       ret = lhs < rhs; // Fallback to hash to guarantee deterministic sort
 
-                       if( ret == 0 )
-                           ret = lhs < rhs; // Fallback to hash to guarantee deterministic sort
+                   return ret < 0;
+               } );
 
-                       return ret < 0;
-                   } );
+    ERC_SCH_PIN_CONTEXT needsDriver;
+    ELECTRICAL_PINTYPE  needsDriverType = ELECTRICAL_PINTYPE::PT_UNSPECIFIED;
+    bool                hasDriver = false;
+
+    // We need different drivers for power nets and normal nets.
+    // A power net has at least one pin having the ELECTRICAL_PINTYPE::PT_POWER_IN
+    // and power nets can be driven only by ELECTRICAL_PINTYPE::PT_POWER_OUT pins
+    bool     ispowerNet  = false;
+
+    for( ERC_SCH_PIN_CONTEXT& refPin : pins )
+    {
+        if( refPin.Pin()->GetType() == ELECTRICAL_PINTYPE::PT_POWER_IN )
+        {
+            ispowerNet = true;
+            break;
+        }
+    }
 
-        ERC_SCH_PIN_CONTEXT needsDriver;
-        ELECTRICAL_PINTYPE  needsDriverType = ELECTRICAL_PINTYPE::PT_UNSPECIFIED;
-        bool                hasDriver = false;
+    std::vector<std::tuple<iterator_t, iterator_t, PIN_ERROR>> pin_mismatches;
+    std::map<iterator_t, int>                                  pin_mismatch_counts;
 
-        // We need different drivers for power nets and normal nets.
-        // A power net has at least one pin having the ELECTRICAL_PINTYPE::PT_POWER_IN
-        // and power nets can be driven only by ELECTRICAL_PINTYPE::PT_POWER_OUT pins
-        bool     ispowerNet  = false;
+    for( auto refIt = pins.begin(); refIt != pins.end(); ++refIt )
+    {
+        ERC_SCH_PIN_CONTEXT& refPin = *refIt;
+        ELECTRICAL_PINTYPE refType = refPin.Pin()->GetType();
 
-        for( ERC_SCH_PIN_CONTEXT& refPin : pins )
+        if( DrivenPinTypes.contains( refType ) )
         {
-            if( refPin.Pin()->GetType() == ELECTRICAL_PINTYPE::PT_POWER_IN )
+            // needsDriver will be the pin shown in the error report eventually, so try to
+            // upgrade to a "better" pin if possible: something visible and only a power symbol
+            // if this net needs a power driver
+            if( !needsDriver.Pin()
+                || ( !needsDriver.Pin()->IsVisible() && refPin.Pin()->IsVisible() )
+                || ( ispowerNet != ( needsDriverType == ELECTRICAL_PINTYPE::PT_POWER_IN )
+                     && ispowerNet == ( refType == ELECTRICAL_PINTYPE::PT_POWER_IN ) ) )
             {
-                ispowerNet = true;
-                break;
+                needsDriver = refPin;
+                needsDriverType = needsDriver.Pin()->GetType();
             }
         }
 
-        std::vector<std::tuple<iterator_t, iterator_t, PIN_ERROR>> pin_mismatches;
-        std::map<iterator_t, int>                                  pin_mismatch_counts;
+        if( ispowerNet )
+            hasDriver |= ( DrivingPowerPinTypes.count( refType ) != 0 );
+        else
+            hasDriver |= ( DrivingPinTypes.count( refType ) != 0 );
 
-        for( auto refIt = pins.begin(); refIt != pins.end(); ++refIt )
+        for( auto testIt = refIt + 1; testIt != pins.end(); ++testIt )
         {
-            ERC_SCH_PIN_CONTEXT& refPin = *refIt;
-            ELECTRICAL_PINTYPE refType = refPin.Pin()->GetType();
+            ERC_SCH_PIN_CONTEXT& testPin = *testIt;
 
-            if( DrivenPinTypes.contains( refType ) )
-            {
-                // needsDriver will be the pin shown in the error report eventually, so try to
-                // upgrade to a "better" pin if possible: something visible and only a power symbol
-                // if this net needs a power driver
-                if( !needsDriver.Pin()
-                    || ( !needsDriver.Pin()->IsVisible() && refPin.Pin()->IsVisible() )
-                    || ( ispowerNet != ( needsDriverType == ELECTRICAL_PINTYPE::PT_POWER_IN )
-                         && ispowerNet == ( refType == ELECTRICAL_PINTYPE::PT_POWER_IN ) ) )
-                {
-                    needsDriver = refPin;
-                    needsDriverType = needsDriver.Pin()->GetType();
-                }
-            }
+            // Multiple pins in the same symbol that share a type,
+            // name and position are considered
+            // "stacked" and shouldn't trigger ERC errors
+            if( refPin.Pin()->IsStacked( testPin.Pin() ) && refPin.Sheet() == testPin.Sheet() )
+                continue;
+
+            ELECTRICAL_PINTYPE testType = testPin.Pin()->GetType();
 
             if( ispowerNet )
-                hasDriver |= ( DrivingPowerPinTypes.count( refType ) != 0 );
+                hasDriver |= DrivingPowerPinTypes.contains( testType );
             else
-                hasDriver |= ( DrivingPinTypes.count( refType ) != 0 );
+                hasDriver |= DrivingPinTypes.contains( testType );
 
-            for( auto testIt = refIt + 1; testIt != pins.end(); ++testIt )
-            {
-                ERC_SCH_PIN_CONTEXT& testPin = *testIt;
+            PIN_ERROR erc = m_settings.GetPinMapValue( refType, testType );
 
-                // Multiple pins in the same symbol that share a type,
-                // name and position are considered
-                // "stacked" and shouldn't trigger ERC errors
-                if( refPin.Pin()->IsStacked( testPin.Pin() ) && refPin.Sheet() == testPin.Sheet() )
-                    continue;
+            if( erc != PIN_ERROR::OK && m_settings.IsTestEnabled( ERCE_PIN_TO_PIN_WARNING ) )
+            {
+                pin_mismatches.emplace_back(
+                        std::tuple<iterator_t, iterator_t, PIN_ERROR>{ refIt, testIt, erc } );
 
-                ELECTRICAL_PINTYPE testType = testPin.Pin()->GetType();
+                if( m_settings.GetERCSortingMetric() == ERC_PIN_SORTING_METRIC::SM_HEURISTICS )
+                {
+                    pin_mismatch_counts[refIt] =
+                            m_settings.GetPinTypeWeight( ( *refIt ).Pin()->GetType() );
 
-                if( ispowerNet )
-                    hasDriver |= DrivingPowerPinTypes.contains( testType );
+                    pin_mismatch_counts[testIt] =
+                            m_settings.GetPinTypeWeight( ( *testIt ).Pin()->GetType() );
+                }
                 else
-                    hasDriver |= DrivingPinTypes.contains( testType );
-
-                PIN_ERROR erc = m_settings.GetPinMapValue( refType, testType );
-
-                if( erc != PIN_ERROR::OK && m_settings.IsTestEnabled( ERCE_PIN_TO_PIN_WARNING ) )
                 {
-                    pin_mismatches.emplace_back(
-                            std::tuple<iterator_t, iterator_t, PIN_ERROR>{ refIt, testIt, erc } );
-
-                    if( m_settings.GetERCSortingMetric() == ERC_PIN_SORTING_METRIC::SM_HEURISTICS )
-                    {
-                        pin_mismatch_counts[refIt] =
-                                m_settings.GetPinTypeWeight( ( *refIt ).Pin()->GetType() );
+                    if( !pin_mismatch_counts.contains( testIt ) )
+                        pin_mismatch_counts.emplace( testIt, 1 );
+                    else
+                        pin_mismatch_counts[testIt]++;
 
-                        pin_mismatch_counts[testIt] =
-                                m_settings.GetPinTypeWeight( ( *testIt ).Pin()->GetType() );
-                    }
+                    if( !pin_mismatch_counts.contains( refIt ) )
+                        pin_mismatch_counts.emplace( refIt, 1 );
                     else
-                    {
-                        if( !pin_mismatch_counts.contains( testIt ) )
-                            pin_mismatch_counts.emplace( testIt, 1 );
-                        else
-                            pin_mismatch_counts[testIt]++;
-
-                        if( !pin_mismatch_counts.contains( refIt ) )
-                            pin_mismatch_counts.emplace( refIt, 1 );
-                        else
-                            pin_mismatch_counts[refIt]++;
-                    }
+                        pin_mismatch_counts[refIt]++;
                 }
             }
         }
+    }
 
-        std::multimap<size_t, iterator_t, std::greater<size_t>> pins_dsc;
+    std::multimap<size_t, iterator_t, std::greater<size_t>> pins_dsc;
 
-        std::transform( pin_mismatch_counts.begin(), pin_mismatch_counts.end(),
-                        std::inserter( pins_dsc, pins_dsc.begin() ),
-                        []( const auto& p )
-                        {
-                            return std::pair<size_t, iterator_t>( p.second, p.first );
-                        } );
+    std::transform( pin_mismatch_counts.begin(), pin_mismatch_counts.end(),
+                    std::inserter( pins_dsc, pins_dsc.begin() ),
+                    []( const auto& p )
+                    {
+                        return std::pair<size_t, iterator_t>( p.second, p.first );
+                    } );
 
-        for( const auto& [amount, pinItBind] : pins_dsc )
-        {
-            auto& pinIt = pinItBind;
+    for( const auto& [amount, pinItBind] : pins_dsc )
+    {
+        auto& pinIt = pinItBind;
 
-            if( pin_mismatches.empty() )
-                break;
+        if( pin_mismatches.empty() )
+            break;
 
-            SCH_PIN* pin = ( *pinIt ).Pin();
-            VECTOR2I position = pin->GetPosition();
+        SCH_PIN* pin = ( *pinIt ).Pin();
+        VECTOR2I position = pin->GetPosition();
 
-            iterator_t nearest_pin = pins.end();
-            double     smallest_distance = std::numeric_limits<double>::infinity();
-            PIN_ERROR  erc;
+        iterator_t nearest_pin = pins.end();
+        double     smallest_distance = std::numeric_limits<double>::infinity();
+        PIN_ERROR  erc;
 
-            std::erase_if(
-                    pin_mismatches,
-                    [&]( const auto& tuple )
-                    {
-                        iterator_t other;
+        std::erase_if(
+                pin_mismatches,
+                [&]( const auto& tuple )
+                {
+                    iterator_t other;
 
-                        if( pinIt == std::get<0>( tuple ) )
-                            other = std::get<1>( tuple );
-                        else if( pinIt == std::get<1>( tuple ) )
-                            other = std::get<0>( tuple );
-                        else
-                            return false;
+                    if( pinIt == std::get<0>( tuple ) )
+                        other = std::get<1>( tuple );
+                    else if( pinIt == std::get<1>( tuple ) )
+                        other = std::get<0>( tuple );
+                    else
+                        return false;
 
-                        if( ( *pinIt ).Sheet().Cmp( ( *other ).Sheet() ) != 0 )
+                    if( ( *pinIt ).Sheet().Cmp( ( *other ).Sheet() ) != 0 )
+                    {
+                        if( std::isinf( smallest_distance ) )
                         {
-                            if( std::isinf( smallest_distance ) )
-                            {
-                                nearest_pin = other;
-                                erc = std::get<2>( tuple );
-                            }
+                            nearest_pin = other;
+                            erc = std::get<2>( tuple );
                         }
-                        else
-                        {
-                            double distance = position.Distance( ( *other ).Pin()->GetPosition() );
+                    }
+                    else
+                    {
+                        double distance = position.Distance( ( *other ).Pin()->GetPosition() );
 
-                            if( std::isinf( smallest_distance ) || distance < smallest_distance )
-                            {
-                                smallest_distance = distance;
-                                nearest_pin = other;
-                                erc = std::get<2>( tuple );
-                            }
+                        if( std::isinf( smallest_distance ) || distance < smallest_distance )
+                        {
+                            smallest_distance = distance;
+                            nearest_pin = other;
+                            erc = std::get<2>( tuple );
                         }
+                    }
 
-                        return true;
-                    } );
-
-            if( nearest_pin != pins.end() )
-            {
-                SCH_PIN* other_pin = ( *nearest_pin ).Pin();
+                    return true;
+                } );
 
-                std::shared_ptr<ERC_ITEM> ercItem =
-                        ERC_ITEM::Create( erc == PIN_ERROR::WARNING ? ERCE_PIN_TO_PIN_WARNING
-                                                                    : ERCE_PIN_TO_PIN_ERROR );
-                ercItem->SetItems( pin, other_pin );
-                ercItem->SetSheetSpecificPath( ( *pinIt ).Sheet() );
-                ercItem->SetItemsSheetPaths( ( *pinIt ).Sheet(), ( *nearest_pin ).Sheet() );
-
-                ercItem->SetErrorMessage(
-                        wxString::Format( _( "Pins of type %s and %s are connected" ),
-                                          ElectricalPinTypeGetText( pin->GetType() ),
-                                          ElectricalPinTypeGetText( other_pin->GetType() ) ) );
-
-                SCH_MARKER* marker = new SCH_MARKER( ercItem, pin->GetPosition() );
-                pinToScreenMap[pin]->Append( marker );
-                errors++;
-            }
+        if( nearest_pin != pins.end() )
+        {
+            SCH_PIN* other_pin = ( *nearest_pin ).Pin();
+
+            std::shared_ptr<ERC_ITEM> ercItem =
+                    ERC_ITEM::Create( erc == PIN_ERROR::WARNING ? ERCE_PIN_TO_PIN_WARNING
+                                                                : ERCE_PIN_TO_PIN_ERROR );
+            ercItem->SetItems( pin, other_pin );
+            ercItem->SetSheetSpecificPath( ( *pinIt ).Sheet() );
+            ercItem->SetItemsSheetPaths( ( *pinIt ).Sheet(), ( *nearest_pin ).Sheet() );
+
+            ercItem->SetErrorMessage(
+                    wxString::Format( _( "Pins of type %s and %s are connected" ),
+                                      ElectricalPinTypeGetText( pin->GetType() ),
+                                      ElectricalPinTypeGetText( other_pin->GetType() ) ) );
+
+            SCH_MARKER* marker = new SCH_MARKER( ercItem, pin->GetPosition() );
+            aMarkers.emplace_back( pinToScreenMap[pin], marker );
         }
+    }
+
+    if( needsDriver.Pin() && !hasDriver && !has_noconnect )
+    {
+        int err_code = ispowerNet ? ERCE_POWERPIN_NOT_DRIVEN : ERCE_PIN_NOT_DRIVEN;
 
-        if( needsDriver.Pin() && !hasDriver && !has_noconnect )
+        if( m_settings.IsTestEnabled( err_code ) )
         {
-            int err_code = ispowerNet ? ERCE_POWERPIN_NOT_DRIVEN : ERCE_PIN_NOT_DRIVEN;
+            std::shared_ptr<ERC_ITEM> ercItem = ERC_ITEM::Create( err_code );
 
-            if( m_settings.IsTestEnabled( err_code ) )
-            {
-                std::shared_ptr<ERC_ITEM> ercItem = ERC_ITEM::Create( err_code );
+            ercItem->SetItems( needsDriver.Pin() );
+            ercItem->SetSheetSpecificPath( needsDriver.Sheet() );
+            ercItem->SetItemsSheetPaths( needsDriver.Sheet() );
+
+            SCH_MARKER* marker = new SCH_MARKER( ercItem, needsDriver.Pin()->GetPosition() );
+            aMarkers.emplace_back( pinToScreenMap[needsDriver.Pin()], marker );
+        }
+    }
+}
 
-                ercItem->SetItems( needsDriver.Pin() );
-                ercItem->SetSheetSpecificPath( needsDriver.Sheet() );
-                ercItem->SetItemsSheetPaths( needsDriver.Sheet() );
 
-                SCH_MARKER* marker = new SCH_MARKER( ercItem, needsDriver.Pin()->GetPosition() );
-                pinToScreenMap[needsDriver.Pin()]->Append( marker );
-                errors++;
-            }
+int ERC_TESTER::appendMarkers( const std::vector<PENDING_MARKERS>& aMarkers )
+{
+    int count = 0;
+
+    for( const PENDING_MARKERS& markers : aMarkers )
+    {
+        for( const auto& [screen, marker] : markers )
+        {
+            screen->Append( marker );
+            count++;
         }
     }
 
-    return errors;
+    return count;
 }
 
 
@@ -1296,74 +1341,124 @@ int ERC_TESTER::TestSimilarLabels()
         sheet.LastScreen()->Append( marker );
     };
 
-    for( const std::pair<NET_NAME_CODE_CACHE_KEY, std::vector<CONNECTION_SUBGRAPH*>> net : m_nets )
+    /// A label or power pin and the text it is compared by.  Text containing variables is
+    /// left unresolved by the helper threads and resolved afterwards on the calling thread.
+    struct LABEL_TEXT
     {
-        for( CONNECTION_SUBGRAPH* subgraph : net.second )
-        {
-            const SCH_SHEET_PATH& sheet = subgraph->GetSheet();
+        SCH_ITEM*             m_item;
+        const SCH_SHEET_PATH* m_sheet;
+        wxString              m_text;
+        bool                  m_resolved;
+    };
 
-            for( SCH_ITEM* item : subgraph->GetItems() )
+    auto hasTextVars =
+            []( SCH_ITEM* aItem ) -> bool
             {
-                switch( item->Type() )
-                {
-                case SCH_LABEL_T:
-                case SCH_HIER_LABEL_T:
-                case SCH_GLOBAL_LABEL_T:
+                if( aItem->Type() == SCH_PIN_T )
                 {
-                    SCH_LABEL_BASE* label = static_cast<SCH_LABEL_BASE*>( item );
-                    wxString        unnormalized = label->GetShownText( &sheet, false );
-                    wxString        normalized = unnormalized.Lower();
+                    SCH_PIN*    pin = static_cast<SCH_PIN*>( aItem );
+                    SCH_SYMBOL* symbol = static_cast<SCH_SYMBOL*>( pin->GetParentSymbol() );
 
-                    generalMap[normalized].emplace_back( std::make_tuple( unnormalized, label, sheet ) );
+                    return symbol->GetField( FIELD_T::VALUE )->HasTextVars();
+                }
 
-                    for( const auto& otherTuple : generalMap.at( normalized ) )
-                    {
-                        const auto& [otherText, otherItem, otherSheet] = otherTuple;
+                return static_cast<SCH_LABEL_BASE*>( aItem )->HasTextVars();
+            };
 
-                        if( unnormalized != otherText )
-                        {
-                            logError( normalized, label, sheet, otherTuple );
-                            errors += 1;
-                        }
-                    }
+    auto resolveText =
+            []( SCH_ITEM* aItem, const SCH_SHEET_PATH& aSheet ) -> wxString
+            {
+                if( aItem->Type() == SCH_PIN_T )
+                {
+                    SCH_PIN*    pin = static_cast<SCH_PIN*>( aItem );
+                    SCH_SYMBOL* symbol = static_cast<SCH_SYMBOL*>( pin->GetParentSymbol() );
 
-                    break;
+                    return symbol->GetValue( true, &aSheet, false );
                 }
-                case SCH_PIN_T:
-                {
-                    SCH_PIN* pin = static_cast<SCH_PIN*>( item );
 
-                    if( !pin->IsPower() )
-                    {
-                        continue;
-                    }
+                return static_cast<SCH_LABEL_BASE*>( aItem )->GetShownText( &aSheet, false );
+            };
 
-                    SCH_SYMBOL* symbol = static_cast<SCH_SYMBOL*>( pin->GetParentSymbol() );
-                    wxString    unnormalized = symbol->GetValue( true, &sheet, false );
-                    wxString    normalized = unnormalized.Lower();
+    std::vector<const std::vector<CONNECTION_SUBGRAPH*>*> nets;
+    std::vector<std::vector<LABEL_TEXT>>                  netLabels( m_nets.size() );
 
-                    generalMap[normalized].emplace_back( std::make_tuple( unnormalized, pin, sheet ) );
+    nets.reserve( m_nets.size() );
 
-                    for( const auto& otherTuple : generalMap.at( normalized ) )
-                    {
-                        const auto& [otherText, otherItem, otherSheet] = otherTuple;
+    for( const auto& [key, subgraphs] : m_nets )
+        nets.push_back( &subgraphs );
+
+    // Gathering the label texts of a net doesn't depend on the other nets, so it is done on the
+    // thread pool.  Variables are resolved later as that can update the project's netclasses.
+    thread_pool& tp = GetKiCadThreadPool();
 
-                        if( unnormalized != otherText )
+    tp.parallelize_loop( nets.size(),
+            [&]( const int a, const int b )
+            {
+                for( int ii = a; ii < b; ++ii )
+                {
+                    for( CONNECTION_SUBGRAPH* subgraph : *nets[ii] )
+                    {
+                        for( SCH_ITEM* item : subgraph->GetItems() )
                         {
-                            logError( normalized, pin, sheet, otherTuple );
-                            errors += 1;
+                            switch( item->Type() )
+                            {
+                            case SCH_LABEL_T:
+                            case SCH_HIER_LABEL_T:
+                            case SCH_GLOBAL_LABEL_T:
+                                break;
+
+                            case SCH_PIN_T:
+                                if( !static_cast<SCH_PIN*>( item )->IsPower() )
+                                    continue;
+
+                                break;
+
+                            default:
+                                continue;
+                            }
+
+                            const SCH_SHEET_PATH& sheet = subgraph->GetSheet();
+                            LABEL_TEXT            label{ item, &sheet, wxEmptyString, false };
+
+                            if( !hasTextVars( item ) )
+                            {
+                                label.m_text = resolveText( item, sheet );
+                                label.m_resolved = true;
+                            }
+
+                            netLabels[ii].push_back( std::move( label ) );
                         }
                     }
-
-                    break;
                 }
+            } ).wait();
 
-                default:
-                    break;
+    // Similar texts are looked for across all nets, in net order.
+    for( std::vector<LABEL_TEXT>& labels : netLabels )
+    {
+        for( LABEL_TEXT& label : labels )
+        {
+            if( !label.m_resolved )
+                label.m_text = resolveText( label.m_item, *label.m_sheet );
+
+            const SCH_SHEET_PATH& sheet = *label.m_sheet;
+            wxString              normalized = label.m_text.Lower();
+
+            generalMap[normalized].emplace_back( std::make_tuple( label.m_text, label.m_item,
+                                                                  sheet ) );
+
+            for( const auto& otherTuple : generalMap.at( normalized ) )
+            {
+                const auto& [otherText, otherItem, otherSheet] = otherTuple;
+
+                if( label.m_text != otherText )
+                {
+                    logError( normalized, label.m_item, sheet, otherTuple );
+                    errors += 1;
                 }
             }
         }
     }
+
     return errors;
 }
 
@@ -42,6 +42,7 @@ class PROGRESS_REPORTER;
 struct KIFACE;
 class PROJECT;
 class SCH_RULE_AREA;
+class SCH_MARKER;
 
 
 extern const wxString CommentERC_H[];
@@ -183,6 +184,26 @@ public:
                    KIFACE* aCvPcb, PROJECT* aProject, PROGRESS_REPORTER* aProgressReporter );
 
 private:
+    /// Markers created by a test running on the thread pool, with the screens they belong on.
+    using PENDING_MARKERS = std::vector<std::pair<SCH_SCREEN*, SCH_MARKER*>>;
+
+    /**
+     * Run the checks of TestNoConnectPins() on a single sheet.
+     */
+    void testNoConnectPins( const SCH_SHEET_PATH& aSheet, PENDING_MARKERS& aMarkers ) const;
+
+    /**
+     * Run the checks of TestPinToPin() on the subgraphs of a single net.
+     */
+    void testPinToPin( const std::vector<CONNECTION_SUBGRAPH*>& aSubgraphs,
+                       PENDING_MARKERS& aMarkers ) const;
+
+    /**
+     * Add the markers to their screens, in order.
+     * @return the number of markers added
+     */
+    static int appendMarkers( const std::vector<PENDING_MARKERS>& aMarkers );
+
     SCHEMATIC*                   m_schematic;
     ERC_SETTINGS&                m_settings;
     SCH_SHEET_LIST               m_sheetList;
@@ -38,31 +38,38 @@
 #include <memory>
 
 std::vector<SEARCH_TERM> LIB_SYMBOL::GetSearchTerms()
+{
+    std::map<wxString, wxString> fields;
+    GetChooserFields( fields );
+
+    return BuildSearchTerms( GetName(), GetKeyWords(), fields, GetDescription(), GetFootprint() );
+}
+
+
+std::vector<SEARCH_TERM>
+LIB_SYMBOL::BuildSearchTerms( const wxString& aName, const wxString& aKeywords,
+                              const std::map<wxString, wxString>& aChooserFields,
+                              const wxString& aDescription, const wxString& aFootprint )
 {
     std::vector<SEARCH_TERM> terms;
 
-    terms.emplace_back( SEARCH_TERM( GetName(), 8 ) );
+    terms.emplace_back( SEARCH_TERM( aName, 8 ) );
 
-    wxStringTokenizer keywordTokenizer( GetKeyWords(), wxS( " " ), wxTOKEN_STRTOK );
+    wxStringTokenizer keywordTokenizer( aKeywords, wxS( " " ), wxTOKEN_STRTOK );
 
     while( keywordTokenizer.HasMoreTokens() )
         terms.emplace_back( SEARCH_TERM( keywordTokenizer.GetNextToken(), 4 ) );
 
     // TODO(JE) rework this later so we can highlight matches in their column
-    std::map<wxString, wxString> fields;
-    GetChooserFields( fields );
-
-    for( const auto& [ name, text ] : fields )
+    for( const auto& [ name, text ] : aChooserFields )
         terms.emplace_back( SEARCH_TERM( text, 4 ) );
 
     // Also include keywords as one long string, just in case
-    terms.emplace_back( SEARCH_TERM( GetKeyWords(), 1 ) );
-    terms.emplace_back( SEARCH_TERM( GetDescription(), 1 ) );
-
-    wxString footprint = GetFootprint();
+    terms.emplace_back( SEARCH_TERM( aKeywords, 1 ) );
+    terms.emplace_back( SEARCH_TERM( aDescription, 1 ) );
 
-    if( !footprint.IsEmpty() )
-        terms.emplace_back( SEARCH_TERM( GetFootprintField().GetText(), 1 ) );
+    if( !aFootprint.IsEmpty() )
+        terms.emplace_back( SEARCH_TERM( aFootprint, 1 ) );
 
     return terms;
 }
@@ -193,6 +193,16 @@ public:
 
     std::vector<SEARCH_TERM> GetSearchTerms() override;
 
+    /**
+     * Build the chooser search terms of a symbol from its summary fields.  Shared with library
+     * index entries, so that search results don't depend on whether a library was read from
+     * its index.
+     */
+    static std::vector<SEARCH_TERM>
+    BuildSearchTerms( const wxString& aName, const wxString& aKeywords,
+                      const std::map<wxString, wxString>& aChooserFields,
+                      const wxString& aDescription, const wxString& aFootprint );
+
     wxString GetFootprint() override
     {
         return GetFootprintField().GetText();
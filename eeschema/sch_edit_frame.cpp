@@ -2004,15 +2004,17 @@ void SCH_EDIT_FRAME::RecalculateConnections( SCH_COMMIT* aCommit, SCH_CLEANUP_FL
             }
         }
 
+        // Take over the existing net codes before the affected nets are removed, so that nets
+        // which survive the edit keep their codes.
+        CONNECTION_GRAPH new_graph( &Schematic() );
+
+        new_graph.SetLastCodes( Schematic().ConnectionGraph() );
+
         std::set<std::pair<SCH_SHEET_PATH, SCH_ITEM*>> all_items =
                 Schematic().ConnectionGraph()->ExtractAffectedItems( changed_items );
 
         all_items.insert( item_paths.begin(), item_paths.end() );
 
-        CONNECTION_GRAPH new_graph( &Schematic() );
-
-        new_graph.SetLastCodes( Schematic().ConnectionGraph() );
-
         std::shared_ptr<NET_SETTINGS> netSettings = Prj().GetProjectFile().NetSettings();
 
         std::set<wxString> affectedNets;
@@ -2033,8 +2035,40 @@ void SCH_EDIT_FRAME::RecalculateConnections( SCH_COMMIT* aCommit, SCH_CLEANUP_FL
         for( const wxString& netName : affectedNets )
             netSettings->ClearCacheForNet( netName );
 
-        new_graph.Recalculate( list, false, &changeHandler );
+        // Only sheets showing an affected item need to be revisited.  All instances of those
+        // sheets are included, as a dirty item is updated for every path it appears on.
+        std::unordered_set<SCH_SCREEN*> affectedScreens;
+        SCH_SHEET_LIST                  affectedSheets;
+
+        for( const auto& [path, item] : all_items )
+            affectedScreens.insert( path.LastScreen() );
+
+        for( const SCH_SHEET_PATH& path : list )
+        {
+            if( affectedScreens.contains( path.LastScreen() ) )
+                affectedSheets.push_back( path );
+        }
+
+        new_graph.Recalculate( affectedSheets, false, &changeHandler );
         Schematic().ConnectionGraph()->Merge( new_graph );
+
+        if( ADVANCED_CFG::GetCfg().m_IncrementalConnectivityVerify )
+        {
+            CONNECTION_GRAPH::ITEM_NET_NAMES incremental =
+                    Schematic().ConnectionGraph()->GetItemNetNames();
+
+            Schematic().ConnectionGraph()->Recalculate( list, true, &changeHandler );
+
+            int differences = CONNECTION_GRAPH::CompareItemNetNames(
+                    incremental, Schematic().ConnectionGraph()->GetItemNetNames() );
+
+            if( differences )
+            {
+                wxLogWarning( wxS( "Incremental connectivity update differs from a full rebuild "
+                                   "for %d items.  Enable the CONN trace for details." ),
+                              differences );
+            }
+        }
     }
 
     GetCanvas()->GetView()->UpdateAllItemsConditionally(
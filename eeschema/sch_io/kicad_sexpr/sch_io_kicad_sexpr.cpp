@@ -21,17 +21,18 @@
  */
 
 #include <algorithm>
+#include <mutex>
 
 #include <wx/log.h>
 #include <wx/mstream.h>
 
 #include <base_units.h>
 #include <bitmap_base.h>
+#include <advanced_config.h>
 #include <build_version.h>
 #include <sch_selection.h>
 #include <font/fontconfig.h>
 #include <io/kicad/kicad_io_utils.h>
-#include <locale_io.h>
 #include <progress_reporter.h>
 #include <schematic.h>
 #include <schematic_lexer.h>
@@ -41,6 +42,7 @@
 #include <sch_io/kicad_sexpr/sch_io_kicad_sexpr.h>
 #include <sch_io/kicad_sexpr/sch_io_kicad_sexpr_common.h>
 #include <sch_io/kicad_sexpr/sch_io_kicad_sexpr_lib_cache.h>
+#include <sch_io/kicad_sexpr/sch_io_kicad_sexpr_lib_index.h>
 #include <sch_io/kicad_sexpr/sch_io_kicad_sexpr_parser.h>
 #include <sch_junction.h>
 #include <sch_line.h>
@@ -63,6 +65,10 @@
 using namespace TSCHEMATIC_T;
 
 
+/// Stored symbol library indexes not used for this many days are removed
+static const int SYMBOL_INDEX_MAX_AGE_DAYS = 60;
+
+
 #define SCH_PARSE_ERROR( text, reader, pos )                         \
     THROW_PARSE_ERROR( text, reader.GetSource(), reader.Line(),      \
                        reader.LineNumber(), pos - reader.Line() )
@@ -76,6 +82,7 @@ SCH_IO_KICAD_SEXPR::SCH_IO_KICAD_SEXPR() : SCH_IO( wxS( "Eeschema s-expression"
 
 SCH_IO_KICAD_SEXPR::~SCH_IO_KICAD_SEXPR()
 {
+    clearIndex();
     delete m_cache;
 }
 
@@ -98,7 +105,6 @@ SCH_SHEET* SCH_IO_KICAD_SEXPR::LoadSchematicFile( const wxString& aFileName, SCH
 {
     wxASSERT( !aFileName || aSchematic != nullptr );
 
-    LOCALE_IO   toggle;     // toggles on, then off, the C locale.
     SCH_SHEET*  sheet;
 
     wxFileName fn = aFileName;
@@ -321,7 +327,6 @@ void SCH_IO_KICAD_SEXPR::LoadContent( LINE_READER& aReader, SCH_SHEET* aSheet, i
 {
     wxCHECK( aSheet, /* void */ );
 
-    LOCALE_IO toggle;
     SCH_IO_KICAD_SEXPR_PARSER parser( &aReader );
 
     parser.ParseSchematic( aSheet, true, aFileVersion );
@@ -335,8 +340,6 @@ void SCH_IO_KICAD_SEXPR::SaveSchematicFile( const wxString& aFileName, SCH_SHEET
     wxCHECK_RET( aSheet != nullptr, "NULL SCH_SHEET object." );
     wxCHECK_RET( !aFileName.IsEmpty(), "No schematic file name defined." );
 
-    LOCALE_IO   toggle;     // toggles on, then off, the C locale, to write floating point values.
-
     init( aSchematic, aProperties );
 
     wxFileName fn = aFileName;
@@ -499,7 +502,6 @@ void SCH_IO_KICAD_SEXPR::Format( SCH_SELECTION* aSelection, SCH_SHEET_PATH* aSel
 {
     wxCHECK( aSelection && aSelectionPath && aFormatter, /* void */ );
 
-    LOCALE_IO toggle;
     SCH_SHEET_LIST sheets = aSchematic.Hierarchy();
 
     m_schematic = &aSchematic;
@@ -1524,8 +1526,6 @@ void SCH_IO_KICAD_SEXPR::EnumerateSymbolLib( wxArrayString&    aSymbolNameList,
                                              const wxString&   aLibraryPath,
                                              const std::map<std::string, UTF8>* aProperties )
 {
-    LOCALE_IO   toggle;     // toggles on, then off, the C locale.
-
     bool powerSymbolsOnly = ( aProperties &&
                               aProperties->find( SYMBOL_LIB_TABLE::PropPowerSymsOnly ) != aProperties->end() );
 
@@ -1545,8 +1545,6 @@ void SCH_IO_KICAD_SEXPR::EnumerateSymbolLib( std::vector<LIB_SYMBOL*>& aSymbolLi
                                              const wxString&   aLibraryPath,
                                              const std::map<std::string, UTF8>* aProperties )
 {
-    LOCALE_IO   toggle;     // toggles on, then off, the C locale.
-
     bool powerSymbolsOnly = ( aProperties &&
                               aProperties->find( SYMBOL_LIB_TABLE::PropPowerSymsOnly ) != aProperties->end() );
 
@@ -1562,11 +1560,158 @@ void SCH_IO_KICAD_SEXPR::EnumerateSymbolLib( std::vector<LIB_SYMBOL*>& aSymbolLi
 }
 
 
+bool SCH_IO_KICAD_SEXPR::EnumerateSymbolIndex( std::vector<SYMBOL_INDEX_ENTRY>& aEntries,
+                                               const wxString& aLibraryPath,
+                                               const std::map<std::string, UTF8>* aProperties )
+{
+    if( !ADVANCED_CFG::GetCfg().m_SymbolLibraryIndex || isBuffering( aProperties ) )
+        return false;
+
+    // Unsaved changes are only in the cache
+    if( m_cache && m_cache->IsFile( aLibraryPath ) && m_cache->m_isModified )
+        return false;
+
+    if( m_index && ( m_index->GetLibraryPath() != aLibraryPath || !m_index->IsCurrent() ) )
+        clearIndex();
+
+    static std::once_flag pruned;
+    std::call_once( pruned,
+                    []()
+                    {
+                        SCH_IO_KICAD_SEXPR_LIB_INDEX::Prune( SYMBOL_INDEX_MAX_AGE_DAYS );
+                    } );
+
+    if( !m_index )
+        m_index = SCH_IO_KICAD_SEXPR_LIB_INDEX::Read( aLibraryPath );
+
+    if( !m_index )
+    {
+        cacheLib( aLibraryPath, aProperties );
+
+        if( !m_cache->IsUnmodifiedSinceLoad() )
+            return false;
+
+        m_index = std::make_unique<SCH_IO_KICAD_SEXPR_LIB_INDEX>( *m_cache );
+        m_index->Write();
+    }
+
+    bool powerSymbolsOnly = ( aProperties &&
+                              aProperties->find( SYMBOL_LIB_TABLE::PropPowerSymsOnly ) != aProperties->end() );
+
+    for( const SYMBOL_INDEX_ENTRY& entry : m_index->GetEntries() )
+    {
+        if( !powerSymbolsOnly || entry.m_IsPower )
+            aEntries.push_back( entry );
+    }
+
+    return true;
+}
+
+
+bool SCH_IO_KICAD_SEXPR::useIndex( const wxString& aLibraryPath,
+                                   const std::map<std::string, UTF8>* aProperties )
+{
+    if( !m_index || m_index->GetLibraryPath() != aLibraryPath || isBuffering( aProperties ) )
+        return false;
+
+    // Once the whole library has been loaded it is used as before
+    if( m_cache && m_cache->IsFile( aLibraryPath ) && !m_cache->IsFileChanged() )
+        return false;
+
+    if( !m_index->IsCurrent() )
+    {
+        clearIndex();
+        return false;
+    }
+
+    return true;
+}
+
+
+LIB_SYMBOL* SCH_IO_KICAD_SEXPR::loadIndexedSymbol( const wxString& aName )
+{
+    auto it = m_indexedSymbols.find( aName );
+
+    if( it != m_indexedSymbols.end() )
+        return it->second;
+
+    SCH_IO_KICAD_SEXPR_LIB_INDEX::SYMBOL_LOCATION location;
+    const SYMBOL_INDEX_ENTRY* entry = m_index->Find( aName, location );
+
+    if( !entry )
+        return nullptr;
+
+    // A derived symbol is parsed against its parent, so that has to be read first
+    LIB_SYMBOL_MAP parents;
+
+    if( !entry->m_ParentName.IsEmpty() )
+    {
+        LIB_SYMBOL* parent = loadIndexedSymbol( entry->m_ParentName );
+
+        if( !parent )
+        {
+            THROW_IO_ERROR( wxString::Format( _( "No parent for extended symbol %s" ),
+                                              aName ) );
+        }
+
+        parents[entry->m_ParentName] = parent;
+    }
+
+    if( !m_indexReader )
+        m_indexReader = std::make_unique<MAPPED_FILE_LINE_READER>( m_index->GetLibraryPath() );
+
+    m_indexReader->Seek( location.start, location.line );
+
+    SCH_IO_KICAD_SEXPR_PARSER parser( m_indexReader.get() );
+    LIB_SYMBOL* symbol = parser.ParseSymbol( parents, m_index->GetFileFormatVersion() );
+
+    // Guard against the file changing after the index was checked
+    if( !symbol || symbol->GetName() != aName )
+    {
+        delete symbol;
+        THROW_IO_ERROR( wxString::Format( _( "Symbol library '%s' changed while it was being "
+                                             "read." ),
+                                          m_index->GetLibraryPath() ) );
+    }
+
+    m_indexedSymbols[aName] = symbol;
+    return symbol;
+}
+
+
+void SCH_IO_KICAD_SEXPR::clearIndex()
+{
+    for( auto& [name, symbol] : m_indexedSymbols )
+        delete symbol;
+
+    m_indexedSymbols.clear();
+    m_indexReader.reset();
+    m_index.reset();
+}
+
+
 LIB_SYMBOL* SCH_IO_KICAD_SEXPR::LoadSymbol( const wxString& aLibraryPath,
                                             const wxString& aSymbolName,
                                             const std::map<std::string, UTF8>* aProperties )
 {
-    LOCALE_IO toggle;     // toggles on, then off, the C locale.
+    // If the library has been indexed but not loaded, read just this symbol
+    if( useIndex( aLibraryPath, aProperties ) )
+    {
+        LIB_SYMBOL* symbol = loadIndexedSymbol( aSymbolName );
+
+        // We no longer escape '/' in symbol names, but we used to.
+        if( !symbol && aSymbolName.Contains( '/' ) )
+            symbol = loadIndexedSymbol( EscapeString( aSymbolName, CTX_LEGACY_LIBID ) );
+
+        if( !symbol && aSymbolName.Contains( wxT( "{slash}" ) ) )
+        {
+            wxString unescaped = aSymbolName;
+            unescaped.Replace( wxT( "{slash}" ), wxT( "/" ) );
+            symbol = loadIndexedSymbol( unescaped );
+        }
+
+        return symbol;
+    }
 
     cacheLib( aLibraryPath, aProperties );
 
@@ -1593,8 +1738,6 @@ LIB_SYMBOL* SCH_IO_KICAD_SEXPR::LoadSymbol( const wxString& aLibraryPath,
 void SCH_IO_KICAD_SEXPR::SaveSymbol( const wxString& aLibraryPath, const LIB_SYMBOL* aSymbol,
                                      const std::map<std::string, UTF8>* aProperties )
 {
-    LOCALE_IO toggle;     // toggles on, then off, the C locale.
-
     cacheLib( aLibraryPath, aProperties );
 
     m_cache->AddSymbol( aSymbol );
@@ -1607,8 +1750,6 @@ void SCH_IO_KICAD_SEXPR::SaveSymbol( const wxString& aLibraryPath, const LIB_SYM
 void SCH_IO_KICAD_SEXPR::DeleteSymbol( const wxString& aLibraryPath, const wxString& aSymbolName,
                                        const std::map<std::string, UTF8>* aProperties )
 {
-    LOCALE_IO toggle;     // toggles on, then off, the C locale.
-
     cacheLib( aLibraryPath, aProperties );
 
     m_cache->DeleteSymbol( aSymbolName );
@@ -1627,8 +1768,6 @@ void SCH_IO_KICAD_SEXPR::CreateLibrary( const wxString& aLibraryPath,
                                           aLibraryPath.GetData() ) );
     }
 
-    LOCALE_IO toggle;
-
     delete m_cache;
     m_cache = new SCH_IO_KICAD_SEXPR_LIB_CACHE( aLibraryPath );
     m_cache->SetModified();
@@ -1743,7 +1882,6 @@ std::vector<LIB_SYMBOL*> SCH_IO_KICAD_SEXPR::ParseLibSymbols( std::string& aSymb
                                                               std::string  aSource,
                                                               int aFileVersion )
 {
-    LOCALE_IO      toggle;     // toggles on, then off, the C locale.
     LIB_SYMBOL*    newSymbol = nullptr;
     LIB_SYMBOL_MAP map;
 
@@ -1770,7 +1908,6 @@ std::vector<LIB_SYMBOL*> SCH_IO_KICAD_SEXPR::ParseLibSymbols( std::string& aSymb
 
 void SCH_IO_KICAD_SEXPR::FormatLibSymbol( LIB_SYMBOL* symbol, OUTPUTFORMATTER & formatter )
 {
-    LOCALE_IO toggle;     // toggles on, then off, the C locale.
     SCH_IO_KICAD_SEXPR_LIB_CACHE::SaveSymbol( symbol, formatter );
 }
 
@@ -53,6 +53,8 @@ class SCH_FIELD;
 struct SCH_SYMBOL_INSTANCE;
 class SCH_SELECTION;
 class SCH_IO_KICAD_SEXPR_LIB_CACHE;
+class SCH_IO_KICAD_SEXPR_LIB_INDEX;
+class MAPPED_FILE_LINE_READER;
 class LIB_SYMBOL;
 class SYMBOL_LIB;
 class BUS_ALIAS;
@@ -112,6 +114,9 @@ public:
     void EnumerateSymbolLib( std::vector<LIB_SYMBOL*>& aSymbolList,
                              const wxString&           aLibraryPath,
                              const std::map<std::string, UTF8>*         aProperties = nullptr ) override;
+    bool EnumerateSymbolIndex( std::vector<SYMBOL_INDEX_ENTRY>& aEntries,
+                               const wxString& aLibraryPath,
+                               const std::map<std::string, UTF8>* aProperties = nullptr ) override;
     LIB_SYMBOL* LoadSymbol( const wxString& aLibraryPath, const wxString& aAliasName,
                             const std::map<std::string, UTF8>* aProperties = nullptr ) override;
     void SaveSymbol( const wxString& aLibraryPath, const LIB_SYMBOL* aSymbol,
@@ -164,6 +169,18 @@ private:
     void cacheLib( const wxString& aLibraryFileName, const std::map<std::string, UTF8>* aProperties );
     bool isBuffering( const std::map<std::string, UTF8>* aProperties );
 
+    /**
+     * @return true if symbols from \a aLibraryPath should be read on their own using the
+     *         library index rather than by loading the whole library.
+     */
+    bool useIndex( const wxString& aLibraryPath, const std::map<std::string, UTF8>* aProperties );
+
+    /// Parse the symbol \a aName (and any symbol it is derived from) using the library index.
+    LIB_SYMBOL* loadIndexedSymbol( const wxString& aName );
+
+    /// Drop the library index and the symbols read using it.
+    void clearIndex();
+
 protected:
     int                     m_version;          ///< Version of file being loaded.
     bool                    m_appending;        ///< Schematic load append status.
@@ -178,6 +195,10 @@ protected:
     OUTPUTFORMATTER*        m_out;              ///< The formatter for saving SCH_SCREEN objects.
     SCH_IO_KICAD_SEXPR_LIB_CACHE* m_cache;
 
+    std::unique_ptr<SCH_IO_KICAD_SEXPR_LIB_INDEX> m_index;
+    std::unique_ptr<MAPPED_FILE_LINE_READER>      m_indexReader;
+    std::map<wxString, LIB_SYMBOL*>               m_indexedSymbols;    ///< Read using m_index.
+
     /// initialize PLUGIN like a constructor would.
     void init( SCHEMATIC* aSchematic, const std::map<std::string, UTF8>* aProperties = nullptr );
 };
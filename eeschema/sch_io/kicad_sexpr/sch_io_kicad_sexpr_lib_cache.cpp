@@ -25,7 +25,6 @@
 #include <sch_shape.h>
 #include <lib_symbol.h>
 #include <sch_textbox.h>
-#include <locale_io.h>
 #include <macros.h>
 #include <richio.h>
 #include "sch_io_kicad_sexpr_lib_cache.h"
@@ -40,6 +39,7 @@ SCH_IO_KICAD_SEXPR_LIB_CACHE::SCH_IO_KICAD_SEXPR_LIB_CACHE( const wxString& aFul
     SCH_IO_LIB_CACHE( aFullPathAndFileName )
 {
     m_fileFormatVersionAtLoad = 0;
+    m_fileSizeAtLoad = 0;
 }
 
 
@@ -60,18 +60,16 @@ void SCH_IO_KICAD_SEXPR_LIB_CACHE::Load()
                  wxString::Format( "Cannot use relative file paths in sexpr plugin to "
                                    "open library '%s'.", m_libFileName.GetFullPath() ) );
 
-    // The current locale must use period as the decimal point.
-    // Yes, we did this earlier, but it's sadly not thread-safe.
-    LOCALE_IO toggle;
-
     wxLogTrace( traceSchLegacyPlugin, "Loading sexpr symbol library file '%s'",
                 m_libFileName.GetFullPath() );
 
-    FILE_LINE_READER reader( m_libFileName.GetFullPath() );
+    MAPPED_FILE_LINE_READER reader( m_libFileName.GetFullPath() );
 
     SCH_IO_KICAD_SEXPR_PARSER parser( &reader );
 
-    parser.ParseLib( m_symbols );
+    m_symbolLocations.clear();
+    parser.ParseLib( m_symbols, &m_symbolLocations );
+    m_fileSizeAtLoad = reader.FileLength();
     IncrementModifyHash();
 
     // Remember the file modification time of library file when the cache snapshot was made,
@@ -86,8 +84,6 @@ void SCH_IO_KICAD_SEXPR_LIB_CACHE::Save( const std::optional<bool>& aOpt )
     if( !m_isModified )
         return;
 
-    LOCALE_IO   toggle;     // toggles on, then off, the C locale.
-
     // Write through symlinks, don't replace them.
     wxFileName fn = GetRealFile();
 
@@ -126,6 +122,9 @@ void SCH_IO_KICAD_SEXPR_LIB_CACHE::Save( const std::optional<bool>& aOpt )
 
     formatter.reset();
 
+    // The symbols have moved within the file
+    m_symbolLocations.clear();
+
     m_fileModTime = fn.GetModificationTime();
     m_isModified = false;
 }
@@ -136,11 +135,6 @@ void SCH_IO_KICAD_SEXPR_LIB_CACHE::SaveSymbol( LIB_SYMBOL* aSymbol, OUTPUTFORMAT
 {
     wxCHECK_RET( aSymbol, "Invalid LIB_SYMBOL pointer." );
 
-    // The current locale must use period as the decimal point.
-    wxCHECK2( wxLocale::GetInfo( wxLOCALE_DECIMAL_POINT, wxLOCALE_CAT_NUMBER ) == ".",
-              LOCALE_IO toggle );
-
-
     // If we've requested to embed the fonts in the symbol, do so.
     // Otherwise, clear the embedded fonts from the symbol.  Embedded
     // fonts will be used if available
@@ -23,6 +23,7 @@
 #define SCH_IO_KICAD_SEXPR_LIB_CACHE_H_
 
 #include "sch_io/sch_io_lib_cache.h"
+#include "sch_io_kicad_sexpr_parser.h"
 
 class FILE_LINE_READER;
 class SCH_PIN;
@@ -57,11 +58,33 @@ public:
     void SetFileFormatVersionAtLoad( int aVersion ) { m_fileFormatVersionAtLoad = aVersion; }
     int GetFileFormatVersionAtLoad()  const { return m_fileFormatVersionAtLoad; }
 
+    /**
+     * @return true if the symbols are exactly as read from the library file, so that the
+     *         symbol locations and file size from the last Load() describe them.
+     */
+    bool IsUnmodifiedSinceLoad() const { return !m_isModified && !m_symbolLocations.empty(); }
+
+    using SYMBOL_LOCATION = SCH_IO_KICAD_SEXPR_PARSER::SYMBOL_LOCATION;
+
+    /// Where each symbol starts in the library file, as of the last Load().
+    const std::map<wxString, SYMBOL_LOCATION>& GetSymbolLocations() const
+    {
+        return m_symbolLocations;
+    }
+
+    /// Size of the library file in bytes, as of the last Load().
+    size_t GetFileSizeAtLoad() const { return m_fileSizeAtLoad; }
+
+    wxDateTime GetFileModTimeAtLoad() const { return m_fileModTime; }
+
 private:
     friend SCH_IO_KICAD_SEXPR;
 
     int m_fileFormatVersionAtLoad;
 
+    std::map<wxString, SYMBOL_LOCATION> m_symbolLocations;
+    size_t                              m_fileSizeAtLoad;
+
     static void saveSymbolDrawItem( SCH_ITEM* aItem, OUTPUTFORMATTER& aFormatter );
     static void saveField( SCH_FIELD* aField, OUTPUTFORMATTER& aFormatter );
     static void savePin( SCH_PIN* aPin, OUTPUTFORMATTER& aFormatter );
@@ -0,0 +1,469 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <wx/dir.h>
+#include <wx/filename.h>
+#include <wx/textfile.h>
+#include <wx/txtstrm.h>
+#include <wx/wfstream.h>
+
+#include <kiplatform/io.h>
+#include <lib_symbol.h>
+#include <mmh3_hash.h>
+#include <paths.h>
+#include <wx_filename.h>
+#include "sch_io_kicad_sexpr_lib_cache.h"
+#include "sch_io_kicad_sexpr_lib_index.h"
+
+
+// Bump whenever the stored fields or their layout change.
+static const int      LIB_INDEX_VERSION = 1;
+static const uint32_t LIB_INDEX_SEED = 0x58444953;      // "SIDX"
+static const wxString LIB_INDEX_HEADER = wxS( "kicad_symbol_index" );
+
+
+// Each value is stored on its own line.  EscapeString() isn't used as UnescapeString() would
+// also expand any {token} sequences in the text.
+static wxString escapeLine( const wxString& aText )
+{
+    wxString escaped;
+
+    escaped.reserve( aText.length() );
+
+    for( wxUniChar c : aText )
+    {
+        if( c == '\\' )
+            escaped += wxS( "\\\\" );
+        else if( c == '\n' )
+            escaped += wxS( "\\n" );
+        else if( c == '\r' )
+            escaped += wxS( "\\r" );
+        else
+            escaped += c;
+    }
+
+    return escaped;
+}
+
+
+static wxString unescapeLine( const wxString& aLine )
+{
+    wxString text;
+    bool     escape = false;
+
+    text.reserve( aLine.length() );
+
+    for( wxUniChar c : aLine )
+    {
+        if( escape )
+        {
+            if( c == 'n' )
+                text += '\n';
+            else if( c == 'r' )
+                text += '\r';
+            else
+                text += c;
+
+            escape = false;
+        }
+        else if( c == '\\' )
+        {
+            escape = true;
+        }
+        else
+        {
+            text += c;
+        }
+    }
+
+    return text;
+}
+
+
+SCH_IO_KICAD_SEXPR_LIB_INDEX::SCH_IO_KICAD_SEXPR_LIB_INDEX( const wxString& aLibraryPath ) :
+        m_libraryPath( aLibraryPath ),
+        m_fileModTime( 0 ),
+        m_fileSize( 0 ),
+        m_fileFormatVersion( 0 )
+{
+}
+
+
+SCH_IO_KICAD_SEXPR_LIB_INDEX::SCH_IO_KICAD_SEXPR_LIB_INDEX( SCH_IO_KICAD_SEXPR_LIB_CACHE& aCache ) :
+        SCH_IO_KICAD_SEXPR_LIB_INDEX( aCache.GetFileName() )
+{
+    wxASSERT( aCache.IsUnmodifiedSinceLoad() );
+
+    m_fileModTime = aCache.GetFileModTimeAtLoad().GetValue().GetValue();
+    m_fileSize = static_cast<long long>( aCache.GetFileSizeAtLoad() );
+    m_fileFormatVersion = aCache.GetFileFormatVersionAtLoad();
+
+    const std::map<wxString, SYMBOL_LOCATION>& locations = aCache.GetSymbolLocations();
+
+    for( const auto& [name, symbol] : aCache.GetSymbolMap() )
+    {
+        auto it = locations.find( name );
+
+        wxCHECK2( it != locations.end(), continue );
+
+        addEntry( SYMBOL_INDEX_ENTRY( *symbol ), it->second );
+    }
+}
+
+
+void SCH_IO_KICAD_SEXPR_LIB_INDEX::addEntry( SYMBOL_INDEX_ENTRY&& aEntry,
+                                             const SYMBOL_LOCATION& aLocation )
+{
+    m_entryMap[aEntry.GetName()] = m_entries.size();
+    m_entries.push_back( std::move( aEntry ) );
+    m_locations.push_back( aLocation );
+}
+
+
+const SYMBOL_INDEX_ENTRY* SCH_IO_KICAD_SEXPR_LIB_INDEX::Find( const wxString& aName,
+                                                              SYMBOL_LOCATION& aLocation ) const
+{
+    auto it = m_entryMap.find( aName );
+
+    if( it == m_entryMap.end() )
+        return nullptr;
+
+    aLocation = m_locations[it->second];
+    return &m_entries[it->second];
+}
+
+
+bool SCH_IO_KICAD_SEXPR_LIB_INDEX::fileStamp( const wxString& aLibraryPath, long long& aModTime,
+                                              long long& aSize )
+{
+    wxFileName fn( aLibraryPath );
+
+    WX_FILENAME::ResolvePossibleSymlinks( fn );
+
+    if( !fn.FileExists() )
+        return false;
+
+    wxULongLong size = fn.GetSize();
+
+    if( size == wxInvalidSize )
+        return false;
+
+    aModTime = fn.GetModificationTime().GetValue().GetValue();
+    aSize = static_cast<long long>( size.GetValue() );
+    return true;
+}
+
+
+bool SCH_IO_KICAD_SEXPR_LIB_INDEX::IsCurrent() const
+{
+    long long modTime = 0;
+    long long size = 0;
+
+    return fileStamp( m_libraryPath, modTime, size ) && modTime == m_fileModTime
+                && size == m_fileSize;
+}
+
+
+wxString SCH_IO_KICAD_SEXPR_LIB_INDEX::indexDir()
+{
+    wxFileName fn;
+    fn.AssignDir( PATHS::GetUserCachePath() );
+    fn.AppendDir( wxT( "symbol_index" ) );
+
+    return fn.GetPath();
+}
+
+
+wxString SCH_IO_KICAD_SEXPR_LIB_INDEX::indexPath( const wxString& aLibraryPath )
+{
+    MMH3_HASH hash( LIB_INDEX_SEED );
+    hash.add( std::string( aLibraryPath.utf8_str() ) );
+
+    wxFileName fn;
+    fn.AssignDir( indexDir() );
+    fn.SetName( wxString( hash.digest().ToString() ) );
+    fn.SetExt( wxT( "idx" ) );
+
+    return fn.GetFullPath();
+}
+
+
+void SCH_IO_KICAD_SEXPR_LIB_INDEX::Write() const
+{
+    wxString   path = indexPath( m_libraryPath );
+    wxFileName fn( path );
+
+    if( !PATHS::EnsurePathExists( fn.GetPath() ) )
+        return;
+
+    // Write to a temporary file first so that another instance never reads a partial index.
+    wxString tmpPath = wxFileName::CreateTempFileName( path );
+
+    if( tmpPath.IsEmpty() )
+        return;
+
+    {
+        wxFFileOutputStream outStream( tmpPath );
+        wxTextOutputStream  txtStream( outStream );
+
+        if( !outStream.IsOk() )
+        {
+            wxRemoveFile( tmpPath );
+            return;
+        }
+
+        auto writeText =
+                [&]( const wxString& aText )
+                {
+                    txtStream << escapeLine( aText ) << endl;
+                };
+
+        auto writeNumber =
+                [&]( long long aValue )
+                {
+                    txtStream << wxString::Format( wxT( "%lld" ), aValue ) << endl;
+                };
+
+        txtStream << LIB_INDEX_HEADER << wxString::Format( wxT( " %d" ), LIB_INDEX_VERSION )
+                  << endl;
+        writeText( m_libraryPath );
+        writeNumber( m_fileModTime );
+        writeNumber( m_fileSize );
+        writeNumber( m_fileFormatVersion );
+        writeNumber( static_cast<long long>( m_entries.size() ) );
+
+        for( size_t ii = 0; ii < m_entries.size(); ++ii )
+        {
+            const SYMBOL_INDEX_ENTRY& entry = m_entries[ii];
+
+            writeText( entry.GetName() );
+            writeText( entry.m_ParentName );
+            writeText( entry.m_Description );
+            writeText( entry.m_Keywords );
+            writeText( entry.m_Footprint );
+            writeNumber( entry.m_PinCount );
+            writeNumber( entry.m_UnitCount );
+            writeNumber( entry.m_IsPower ? 1 : 0 );
+            writeNumber( static_cast<long long>( m_locations[ii].start ) );
+            writeNumber( m_locations[ii].line );
+
+            writeNumber( static_cast<long long>( entry.m_FPFilters.size() ) );
+
+            for( const wxString& filter : entry.m_FPFilters )
+                writeText( filter );
+
+            writeNumber( static_cast<long long>( entry.m_UnitDisplayNames.size() ) );
+
+            for( const auto& [unit, name] : entry.m_UnitDisplayNames )
+            {
+                writeNumber( unit );
+                writeText( name );
+            }
+
+            writeNumber( static_cast<long long>( entry.m_ChooserFields.size() ) );
+
+            for( const auto& [name, text] : entry.m_ChooserFields )
+            {
+                writeText( name );
+                writeText( text );
+            }
+        }
+
+        txtStream.Flush();
+
+        if( !outStream.Close() )
+        {
+            wxRemoveFile( tmpPath );
+            return;
+        }
+    }
+
+    // Preserve the permissions of the current file
+    if( wxFileName::FileExists( path ) )
+        KIPLATFORM::IO::DuplicatePermissions( path, tmpPath );
+
+    if( !wxRenameFile( tmpPath, path, true ) )
+        wxRemoveFile( tmpPath );
+}
+
+
+std::unique_ptr<SCH_IO_KICAD_SEXPR_LIB_INDEX>
+SCH_IO_KICAD_SEXPR_LIB_INDEX::Read( const wxString& aLibraryPath )
+{
+    long long modTime = 0;
+    long long size = 0;
+
+    if( !fileStamp( aLibraryPath, modTime, size ) )
+        return nullptr;
+
+    wxString   path = indexPath( aLibraryPath );
+    wxTextFile indexFile( path );
+
+    if( !wxFileName::FileExists( path ) || !indexFile.Open() )
+        return nullptr;
+
+    std::unique_ptr<SCH_IO_KICAD_SEXPR_LIB_INDEX> index( new SCH_IO_KICAD_SEXPR_LIB_INDEX(
+            aLibraryPath ) );
+
+    size_t lineCount = indexFile.GetLineCount();
+    size_t lineNo = 0;
+
+    // Any problem with the file just means the library is read and indexed again
+    struct BAD_INDEX {};
+
+    auto readLine =
+            [&]() -> const wxString&
+            {
+                if( lineNo >= lineCount )
+                    throw BAD_INDEX();
+
+                return indexFile.GetLine( lineNo++ );
+            };
+
+    auto readText =
+            [&]() -> wxString
+            {
+                return unescapeLine( readLine() );
+            };
+
+    auto readNumber =
+            [&]() -> long long
+            {
+                long long value = 0;
+
+                if( !readLine().ToLongLong( &value ) )
+                    throw BAD_INDEX();
+
+                return value;
+            };
+
+    auto readCount =
+            [&]() -> size_t
+            {
+                long long count = readNumber();
+
+                // Each counted item takes at least one line
+                if( count < 0 || static_cast<size_t>( count ) > lineCount - lineNo )
+                    throw BAD_INDEX();
+
+                return static_cast<size_t>( count );
+            };
+
+    try
+    {
+        if( readLine() != LIB_INDEX_HEADER + wxString::Format( wxT( " %d" ), LIB_INDEX_VERSION ) )
+            return nullptr;
+
+        if( readText() != aLibraryPath )
+            return nullptr;
+
+        index->m_fileModTime = readNumber();
+        index->m_fileSize = readNumber();
+
+        if( index->m_fileModTime != modTime || index->m_fileSize != size )
+            return nullptr;
+
+        index->m_fileFormatVersion = static_cast<int>( readNumber() );
+
+        size_t entryCount = readCount();
+
+        index->m_entries.reserve( entryCount );
+        index->m_locations.reserve( entryCount );
+
+        for( size_t ii = 0; ii < entryCount; ++ii )
+        {
+            SYMBOL_INDEX_ENTRY entry;
+            SYMBOL_LOCATION    location;
+
+            entry.m_LibId.SetLibItemName( readText() );
+            entry.m_ParentName = readText();
+            entry.m_Description = readText();
+            entry.m_Keywords = readText();
+            entry.m_Footprint = readText();
+            entry.m_PinCount = static_cast<int>( readNumber() );
+            entry.m_UnitCount = static_cast<int>( readNumber() );
+            entry.m_IsPower = readNumber() != 0;
+
+            long long start = readNumber();
+            long long line = readNumber();
+
+            if( start < 0 || start >= size || line < 1 )
+                throw BAD_INDEX();
+
+            location.start = static_cast<size_t>( start );
+            location.line = static_cast<unsigned>( line );
+
+            for( size_t jj = readCount(); jj > 0; --jj )
+                entry.m_FPFilters.Add( readText() );
+
+            for( size_t jj = readCount(); jj > 0; --jj )
+            {
+                int unit = static_cast<int>( readNumber() );
+                entry.m_UnitDisplayNames[unit] = readText();
+            }
+
+            for( size_t jj = readCount(); jj > 0; --jj )
+            {
+                wxString name = readText();
+                entry.m_ChooserFields[name] = readText();
+            }
+
+            index->addEntry( std::move( entry ), location );
+        }
+    }
+    catch( const BAD_INDEX& )
+    {
+        return nullptr;
+    }
+
+    indexFile.Close();
+
+    // Keep indexes in use from being pruned
+    wxFileName( path ).Touch();
+
+    return index;
+}
+
+
+void SCH_IO_KICAD_SEXPR_LIB_INDEX::Prune( int aMaxAgeDays )
+{
+    wxString dirPath = indexDir();
+    wxDir    dir;
+
+    if( !wxDirExists( dirPath ) || !dir.Open( dirPath ) )
+        return;
+
+    wxDateTime    threshold = wxDateTime::Now() - wxDateSpan::Days( aMaxAgeDays );
+    wxString      fileName;
+    wxArrayString stale;
+
+    // Also catches temporary files left behind by an instance which stopped while writing
+    for( bool cont = dir.GetFirst( &fileName, wxEmptyString, wxDIR_FILES ); cont;
+         cont = dir.GetNext( &fileName ) )
+    {
+        wxFileName fn( dirPath, fileName );
+        wxDateTime modified;
+
+        if( fn.GetTimes( nullptr, &modified, nullptr ) && modified.IsEarlierThan( threshold ) )
+            stale.Add( fn.GetFullPath() );
+    }
+
+    for( const wxString& path : stale )
+        wxRemoveFile( path );
+}
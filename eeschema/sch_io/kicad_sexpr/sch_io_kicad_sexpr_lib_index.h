@@ -0,0 +1,116 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCH_IO_KICAD_SEXPR_LIB_INDEX_H_
+#define SCH_IO_KICAD_SEXPR_LIB_INDEX_H_
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <wx/string.h>
+
+#include <symbol_index_entry.h>
+#include "sch_io_kicad_sexpr_parser.h"
+
+class SCH_IO_KICAD_SEXPR_LIB_CACHE;
+
+
+/**
+ * A persistent index of a KiCad s-expression symbol library.
+ *
+ * The index holds a #SYMBOL_INDEX_ENTRY for each symbol and where the symbol starts in the
+ * library file, so that the symbol chooser can be filled without parsing the library and
+ * single symbols can be parsed on their own when they are needed.
+ *
+ * Indexes are stored in the user cache directory, one file per library, and are only used
+ * while the library file's modification time and size match those it was indexed at.
+ */
+class SCH_IO_KICAD_SEXPR_LIB_INDEX
+{
+public:
+    using SYMBOL_LOCATION = SCH_IO_KICAD_SEXPR_PARSER::SYMBOL_LOCATION;
+
+    /**
+     * Index a library which has just been loaded into \a aCache.
+     *
+     * The cache must not have been modified since it was loaded.
+     */
+    SCH_IO_KICAD_SEXPR_LIB_INDEX( SCH_IO_KICAD_SEXPR_LIB_CACHE& aCache );
+
+    /**
+     * Read the stored index of \a aLibraryPath.
+     *
+     * @return the index, or nullptr if there is none or it is out of date.
+     */
+    static std::unique_ptr<SCH_IO_KICAD_SEXPR_LIB_INDEX> Read( const wxString& aLibraryPath );
+
+    /**
+     * Store the index in the user cache directory.  Failures are silently ignored; the index
+     * is only an optimization.
+     */
+    void Write() const;
+
+    /**
+     * Remove stored indexes which haven't been read or written for \a aMaxAgeDays.  Called
+     * once per session when the first symbol libraries are enumerated.
+     */
+    static void Prune( int aMaxAgeDays );
+
+    /// @return true if the library file hasn't changed since it was indexed.
+    bool IsCurrent() const;
+
+    const wxString& GetLibraryPath() const { return m_libraryPath; }
+
+    int GetFileFormatVersion() const { return m_fileFormatVersion; }
+
+    const std::vector<SYMBOL_INDEX_ENTRY>& GetEntries() const { return m_entries; }
+
+    /**
+     * Look up the symbol \a aName.
+     *
+     * @param aLocation is set to where the symbol starts in the library file.
+     * @return the symbol's entry or nullptr if the library has no such symbol.
+     */
+    const SYMBOL_INDEX_ENTRY* Find( const wxString& aName, SYMBOL_LOCATION& aLocation ) const;
+
+private:
+    SCH_IO_KICAD_SEXPR_LIB_INDEX( const wxString& aLibraryPath );
+
+    void addEntry( SYMBOL_INDEX_ENTRY&& aEntry, const SYMBOL_LOCATION& aLocation );
+
+    /// Read the modification time and size of \a aLibraryPath, following any symlink.
+    static bool fileStamp( const wxString& aLibraryPath, long long& aModTime, long long& aSize );
+
+    static wxString indexDir();
+
+    static wxString indexPath( const wxString& aLibraryPath );
+
+private:
+    wxString  m_libraryPath;
+    long long m_fileModTime;        ///< milliseconds since the epoch
+    long long m_fileSize;
+    int       m_fileFormatVersion;
+
+    std::vector<SYMBOL_INDEX_ENTRY>       m_entries;
+    std::vector<SYMBOL_LOCATION>          m_locations;    ///< in the same order as m_entries
+    std::unordered_map<wxString, size_t>  m_entryMap;     ///< symbol name to m_entries index
+};
+
+#endif    // SCH_IO_KICAD_SEXPR_LIB_INDEX_H_
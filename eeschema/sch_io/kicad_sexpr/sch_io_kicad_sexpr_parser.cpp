@@ -174,10 +174,17 @@ bool SCH_IO_KICAD_SEXPR_PARSER::parseMaybeAbsentBool( bool aDefaultValue )
 }
 
 
-void SCH_IO_KICAD_SEXPR_PARSER::ParseLib( LIB_SYMBOL_MAP& aSymbolLibMap )
+void SCH_IO_KICAD_SEXPR_PARSER::ParseLib( LIB_SYMBOL_MAP& aSymbolLibMap,
+                                         std::map<wxString, SYMBOL_LOCATION>* aLocations )
 {
     T token;
 
+    MAPPED_FILE_LINE_READER* mappedReader = nullptr;
+    SYMBOL_LOCATION          location = { 0, 0 };
+
+    if( aLocations )
+        mappedReader = dynamic_cast<MAPPED_FILE_LINE_READER*>( reader );
+
     NeedLEFT();
     NextTok();
     parseHeader( T_kicad_symbol_lib, SEXPR_SYMBOL_LIB_FILE_VERSION );
@@ -201,6 +208,14 @@ void SCH_IO_KICAD_SEXPR_PARSER::ParseLib( LIB_SYMBOL_MAP& aSymbolLibMap )
         if( token != T_LEFT )
             Expecting( T_LEFT );
 
+        // The lexer works on a copy of the current line; find where the parenthesis is in
+        // the file before the next token moves on to another line.
+        if( mappedReader )
+        {
+            location.start = mappedReader->CurPos() - mappedReader->Length() + curOffset;
+            location.line = mappedReader->LineNumber();
+        }
+
         token = NextTok();
 
         switch( token )
@@ -245,6 +260,10 @@ void SCH_IO_KICAD_SEXPR_PARSER::ParseLib( LIB_SYMBOL_MAP& aSymbolLibMap )
             m_bodyStyle = 1;
             LIB_SYMBOL* symbol = parseLibSymbol( aSymbolLibMap );
             aSymbolLibMap[symbol->GetName()] = symbol;
+
+            if( mappedReader )
+                ( *aLocations )[symbol->GetName()] = location;
+
             break;
         }
 
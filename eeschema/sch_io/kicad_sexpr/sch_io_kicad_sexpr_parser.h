@@ -80,7 +80,22 @@ public:
                       PROGRESS_REPORTER* aProgressReporter = nullptr, unsigned aLineCount = 0,
                       SCH_SHEET* aRootSheet = nullptr, bool aIsAppending = false );
 
-    void ParseLib( LIB_SYMBOL_MAP& aSymbolLibMap );
+    /// Where a top level symbol starts in a library file.
+    struct SYMBOL_LOCATION
+    {
+        size_t   start;     ///< offset of the symbol's opening parenthesis in the file
+        unsigned line;      ///< line number of \a start
+    };
+
+    /**
+     * Parse a symbol library into \a aSymbolLibMap.
+     *
+     * @param aLocations, if not null and the library is read with a #MAPPED_FILE_LINE_READER,
+     *                   is filled with the location of each top level symbol so that it can
+     *                   later be read on its own with ParseSymbol().
+     */
+    void ParseLib( LIB_SYMBOL_MAP& aSymbolLibMap,
+                   std::map<wxString, SYMBOL_LOCATION>* aLocations = nullptr );
 
     /**
      * Parse internal #LINE_READER object into symbols and return all found.
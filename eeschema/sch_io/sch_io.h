@@ -32,6 +32,8 @@
 #include <i18n_utility.h>
 #include <wx/arrstr.h>
 
+class SYMBOL_INDEX_ENTRY;
+
 /**
  * Base class that schematic file and library loading and saving plugins should derive from.
  * Implementations can provide either LoadSchematicFile() or SaveSchematicFile() functions,
@@ -187,6 +189,28 @@ public:
                                      const wxString& aLibraryPath,
                                      const std::map<std::string, UTF8>* aProperties = nullptr );
 
+    /**
+     * Populate a list of #SYMBOL_INDEX_ENTRY summaries of the symbols in \a aLibraryPath,
+     * without necessarily loading the symbols themselves.
+     *
+     * @param aEntries is an array to populate with an entry for each symbol.
+     * @param aLibraryPath is a locator for the "library", usually a directory, file,
+     *                     or URL containing one or more #LIB_SYMBOL objects.
+     * @param aProperties is an associative array that can be used to tell the plugin anything
+     *                    needed about how to perform with respect to \a aLibraryPath.
+     *
+     * @return false if the plugin doesn't keep library indexes, in which case the caller
+     *         should enumerate the symbols instead.
+     *
+     * @throw IO_ERROR if the library cannot be found, the part library cannot be loaded.
+     */
+    virtual bool EnumerateSymbolIndex( std::vector<SYMBOL_INDEX_ENTRY>& aEntries,
+                                       const wxString& aLibraryPath,
+                                       const std::map<std::string, UTF8>* aProperties = nullptr )
+    {
+        return false;
+    }
+
     /**
      * Load a #LIB_SYMBOL object having \a aPartName from the \a aLibraryPath containing
      * a library format that this #SCH_IO knows about.
@@ -144,9 +144,13 @@ public:
                 static_cast<const SCH_PIN*>( this )->GetAlternates() );
     }
 
-    ALT GetAlt( const wxString& aAlt )
+    ALT GetAlt( const wxString& aAlt ) const
     {
-        return GetAlternates()[ aAlt ];
+        // Look up rather than insert: library pins are read from several threads during ERC.
+        const std::map<wxString, ALT>& alternates = GetAlternates();
+        auto                           it = alternates.find( aAlt );
+
+        return it != alternates.end() ? it->second : ALT();
     }
 
     wxString GetAlt() const { return m_alt; }
@@ -18,12 +18,11 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <thread>
-
 #include <core/wx_stl_compat.h>
 #include <symbol_async_loader.h>
 #include <symbol_lib_table.h>
 #include <progress_reporter.h>
+#include <thread_pool.h>
 
 
 SYMBOL_ASYNC_LOADER::SYMBOL_ASYNC_LOADER( const std::vector<wxString>& aNicknames,
@@ -34,11 +33,16 @@ SYMBOL_ASYNC_LOADER::SYMBOL_ASYNC_LOADER( const std::vector<wxString>& aNickname
         m_table( aTable ),
         m_onlyPowerSymbols( aOnlyPowerSymbols ),
         m_output( aOutput ),
+        m_indexOutput( nullptr ),
         m_reporter( aReporter ),
         m_nextLibrary( 0 )
 {
     wxASSERT( m_table );
-    m_threadCount = std::max<size_t>( 1, std::thread::hardware_concurrency() );
+
+    // Each job works through libraries until there are none left, so there is no point in
+    // queueing more jobs than there are libraries or pool threads.
+    m_threadCount = std::max<size_t>( 1, GetKiCadThreadPool().get_thread_count() );
+    m_threadCount = std::min( m_threadCount, std::max<size_t>( 1, m_nicknames.size() ) );
 
     m_returns.resize( m_threadCount );
 }
@@ -53,8 +57,10 @@ SYMBOL_ASYNC_LOADER::~SYMBOL_ASYNC_LOADER()
 
 void SYMBOL_ASYNC_LOADER::Start()
 {
+    thread_pool& tp = GetKiCadThreadPool();
+
     for( size_t ii = 0; ii < m_threadCount; ++ii )
-        m_returns[ii] = std::async( std::launch::async, &SYMBOL_ASYNC_LOADER::worker, this );
+        m_returns[ii] = tp.submit( [this]() { return worker(); } );
 }
 
 
@@ -67,11 +73,11 @@ bool SYMBOL_ASYNC_LOADER::Join()
 
         m_returns[ii].wait();
 
-        const std::vector<LOADED_PAIR>& ret = m_returns[ii].get();
+        RESULTS ret = m_returns[ii].get();
 
-        if( m_output && !ret.empty() )
+        if( m_output )
         {
-            for( const LOADED_PAIR& pair : ret )
+            for( const LOADED_PAIR& pair : ret.loaded )
             {
                 // Don't show libraries that had no power symbols
                 if( m_onlyPowerSymbols && pair.second.empty() )
@@ -81,6 +87,17 @@ bool SYMBOL_ASYNC_LOADER::Join()
                 m_output->insert( pair );
             }
         }
+
+        if( m_indexOutput )
+        {
+            for( INDEXED_PAIR& pair : ret.indexed )
+            {
+                if( m_onlyPowerSymbols && pair.second.empty() )
+                    continue;
+
+                m_indexOutput->insert( std::move( pair ) );
+            }
+        }
     }
 
     return true;
@@ -93,9 +110,9 @@ bool SYMBOL_ASYNC_LOADER::Done()
 }
 
 
-std::vector<SYMBOL_ASYNC_LOADER::LOADED_PAIR> SYMBOL_ASYNC_LOADER::worker()
+SYMBOL_ASYNC_LOADER::RESULTS SYMBOL_ASYNC_LOADER::worker()
 {
-    std::vector<LOADED_PAIR> ret;
+    RESULTS ret;
 
     bool onlyPower = m_onlyPowerSymbols;
 
@@ -110,12 +127,20 @@ std::vector<SYMBOL_ASYNC_LOADER::LOADED_PAIR> SYMBOL_ASYNC_LOADER::worker()
         if( m_reporter && m_reporter->IsCancelled() )
             break;
 
-        LOADED_PAIR pair( nickname, {} );
-
         try
         {
-            m_table->LoadSymbolLib( pair.second, nickname, onlyPower );
-            ret.emplace_back( std::move( pair ) );
+            if( m_indexOutput )
+            {
+                INDEXED_PAIR pair( nickname, {} );
+                m_table->LoadSymbolLibIndex( pair.second, nickname, onlyPower );
+                ret.indexed.emplace_back( std::move( pair ) );
+            }
+            else
+            {
+                LOADED_PAIR pair( nickname, {} );
+                m_table->LoadSymbolLib( pair.second, nickname, onlyPower );
+                ret.loaded.emplace_back( std::move( pair ) );
+            }
         }
         catch( const IO_ERROR& ioe )
         {
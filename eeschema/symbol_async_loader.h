@@ -29,6 +29,8 @@
 
 #include <wx/string.h>
 
+#include <symbol_index_entry.h>
+
 class LIB_SYMBOL;
 class PROGRESS_REPORTER;
 class SYMBOL_LIB_TABLE;
@@ -54,7 +56,16 @@ public:
     ~SYMBOL_ASYNC_LOADER();
 
     /**
-     * Spin up threads to load all the libraries in m_nicknames.
+     * Summarize the symbols of each library into \a aOutput instead of loading them, using
+     * the library's index where it has one.  Must be called before Start().
+     */
+    void SetIndexOutput( std::unordered_map<wxString, std::vector<SYMBOL_INDEX_ENTRY>>* aOutput )
+    {
+        m_indexOutput = aOutput;
+    }
+
+    /**
+     * Queue jobs on the thread pool to load all the libraries in m_nicknames.
      */
     void Start();
 
@@ -72,9 +83,19 @@ public:
     /// Represent a pair of <nickname, loaded parts list>.
     typedef std::pair<wxString, std::vector<LIB_SYMBOL*>> LOADED_PAIR;
 
+    /// Represent a pair of <nickname, symbol summaries>.
+    typedef std::pair<wxString, std::vector<SYMBOL_INDEX_ENTRY>> INDEXED_PAIR;
+
+    /// What one worker job loaded.
+    struct RESULTS
+    {
+        std::vector<LOADED_PAIR>  loaded;
+        std::vector<INDEXED_PAIR> indexed;
+    };
+
 private:
-    /// Worker job that loads libraries and returns a list of pairs of <nickname, loaded parts>.
-    std::vector<LOADED_PAIR> worker();
+    /// Worker job that loads libraries until there are none left.
+    RESULTS worker();
 
     /// List of libraries to load.
     std::vector<wxString> m_nicknames;
@@ -88,6 +109,9 @@ private:
     /// Handle to map that will be filled with the loaded parts per library.
     std::unordered_map<wxString, std::vector<LIB_SYMBOL*>>* m_output;
 
+    /// Handle to map that will be filled with the symbol summaries per library.
+    std::unordered_map<wxString, std::vector<SYMBOL_INDEX_ENTRY>>* m_indexOutput;
+
     /// Progress reporter (may be null).
     PROGRESS_REPORTER* m_reporter;
 
@@ -96,7 +120,7 @@ private:
     wxString            m_errors;
     std::mutex          m_errorMutex;
 
-    std::vector<std::future<std::vector<LOADED_PAIR>>> m_returns;
+    std::vector<std::future<RESULTS>> m_returns;
 };
 
 #endif
@@ -0,0 +1,84 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <lib_symbol.h>
+#include <symbol_index_entry.h>
+
+
+SYMBOL_INDEX_ENTRY::SYMBOL_INDEX_ENTRY() :
+        m_PinCount( 0 ),
+        m_UnitCount( 1 ),
+        m_IsPower( false )
+{
+}
+
+
+SYMBOL_INDEX_ENTRY::SYMBOL_INDEX_ENTRY( LIB_SYMBOL& aSymbol ) :
+        m_LibId( aSymbol.GetLibId() ),
+        m_Description( aSymbol.GetDescription() ),
+        m_Keywords( aSymbol.GetKeyWords() ),
+        m_Footprint( aSymbol.GetFootprint() ),
+        m_FPFilters( aSymbol.GetFPFilters() ),
+        m_PinCount( aSymbol.GetPinCount() ),
+        m_UnitCount( aSymbol.GetUnitCount() ),
+        m_IsPower( aSymbol.IsPower() )
+{
+    m_LibId.SetLibItemName( aSymbol.GetName() );
+
+    if( LIB_SYMBOL_SPTR parent = aSymbol.GetParent().lock() )
+        m_ParentName = parent->GetName();
+
+    aSymbol.CopyUnitDisplayNames( m_UnitDisplayNames );
+    aSymbol.GetChooserFields( m_ChooserFields );
+}
+
+
+void SYMBOL_INDEX_ENTRY::GetChooserFields( std::map<wxString, wxString>& aColumnMap )
+{
+    for( const auto& [name, text] : m_ChooserFields )
+        aColumnMap[name] = text;
+}
+
+
+std::vector<SEARCH_TERM> SYMBOL_INDEX_ENTRY::GetSearchTerms()
+{
+    return LIB_SYMBOL::BuildSearchTerms( GetName(), m_Keywords, m_ChooserFields, m_Description,
+                                         m_Footprint );
+}
+
+
+wxString SYMBOL_INDEX_ENTRY::GetUnitReference( int aUnit )
+{
+    return LIB_SYMBOL::LetterSubReference( aUnit, 'A' );
+}
+
+
+bool SYMBOL_INDEX_ENTRY::HasUnitDisplayName( int aUnit )
+{
+    return m_UnitDisplayNames.count( aUnit ) == 1;
+}
+
+
+wxString SYMBOL_INDEX_ENTRY::GetUnitDisplayName( int aUnit )
+{
+    if( HasUnitDisplayName( aUnit ) )
+        return m_UnitDisplayNames[aUnit];
+    else
+        return wxString::Format( _( "Unit %s" ), GetUnitReference( aUnit ) );
+}
@@ -0,0 +1,83 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SYMBOL_INDEX_ENTRY_H
+#define SYMBOL_INDEX_ENTRY_H
+
+#include <map>
+#include <vector>
+
+#include <wx/arrstr.h>
+#include <wx/string.h>
+
+#include <lib_id.h>
+#include <lib_tree_item.h>
+
+class LIB_SYMBOL;
+
+
+/**
+ * Everything the symbol chooser needs to know about a library symbol, without the symbol's
+ * graphics and pins.
+ *
+ * Entries can be stored in a library index so that the chooser can be filled without parsing
+ * the library; the symbol itself is only loaded when it is previewed or placed.
+ */
+class SYMBOL_INDEX_ENTRY : public LIB_TREE_ITEM
+{
+public:
+    SYMBOL_INDEX_ENTRY();
+
+    /**
+     * Summarize \a aSymbol.
+     */
+    SYMBOL_INDEX_ENTRY( LIB_SYMBOL& aSymbol );
+
+    LIB_ID GetLIB_ID() const override { return m_LibId; }
+    wxString GetName() const override { return m_LibId.GetUniStringLibItemName(); }
+    wxString GetLibNickname() const override { return m_LibId.GetUniStringLibNickname(); }
+    wxString GetDesc() override { return m_Description; }
+
+    void GetChooserFields( std::map<wxString, wxString>& aColumnMap ) override;
+
+    std::vector<SEARCH_TERM> GetSearchTerms() override;
+
+    bool IsRoot() const override { return m_ParentName.IsEmpty(); }
+    wxString GetFootprint() override { return m_Footprint; }
+    int GetPinCount() override { return m_PinCount; }
+    int GetSubUnitCount() const override { return m_UnitCount; }
+
+    wxString GetUnitReference( int aUnit ) override;
+    wxString GetUnitDisplayName( int aUnit ) override;
+    bool HasUnitDisplayName( int aUnit ) override;
+
+    LIB_ID                       m_LibId;
+    wxString                     m_ParentName;      ///< empty unless the symbol is derived
+    wxString                     m_Description;
+    wxString                     m_Keywords;
+    wxString                     m_Footprint;
+    wxArrayString                m_FPFilters;
+    int                          m_PinCount;
+    int                          m_UnitCount;
+    bool                         m_IsPower;
+    std::map<int, wxString>      m_UnitDisplayNames;
+    std::map<wxString, wxString> m_ChooserFields;
+};
+
+#endif // SYMBOL_INDEX_ENTRY_H
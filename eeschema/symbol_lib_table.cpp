@@ -35,6 +35,7 @@
 #include <systemdirsappend.h>
 #include <symbol_lib_table.h>
 #include <lib_symbol.h>
+#include <symbol_index_entry.h>
 #include <sch_io/database/sch_io_database.h>
 #include <dialogs/dialog_database_lib_settings.h>
 
@@ -409,6 +410,45 @@ void SYMBOL_LIB_TABLE::LoadSymbolLib( std::vector<LIB_SYMBOL*>& aSymbolList,
 }
 
 
+void SYMBOL_LIB_TABLE::LoadSymbolLibIndex( std::vector<SYMBOL_INDEX_ENTRY>& aEntries,
+                                           const wxString& aNickname, bool aPowerSymbolsOnly )
+{
+    SYMBOL_LIB_TABLE_ROW* row = FindRow( aNickname, true );
+
+    if( !row || !row->plugin )
+        return;
+
+    std::lock_guard<std::mutex> lock( row->GetMutex() );
+
+    wxString options = row->GetOptions();
+
+    if( aPowerSymbolsOnly )
+        row->SetOptions( row->GetOptions() + " " + PropPowerSymsOnly );
+
+    row->SetLoaded( false );
+    row->plugin->SetLibTable( this );
+
+    if( !row->plugin->EnumerateSymbolIndex( aEntries, row->GetFullURI( true ),
+                                            row->GetProperties() ) )
+    {
+        std::vector<LIB_SYMBOL*> symbols;
+
+        row->plugin->EnumerateSymbolLib( symbols, row->GetFullURI( true ), row->GetProperties() );
+
+        for( LIB_SYMBOL* symbol : symbols )
+            aEntries.emplace_back( *symbol );
+    }
+
+    row->SetLoaded( true );
+
+    if( aPowerSymbolsOnly )
+        row->SetOptions( options );
+
+    for( SYMBOL_INDEX_ENTRY& entry : aEntries )
+        entry.m_LibId.SetLibNickname( row->GetNickName() );
+}
+
+
 LIB_SYMBOL* SYMBOL_LIB_TABLE::LoadSymbol( const wxString& aNickname, const wxString& aSymbolName )
 {
     SYMBOL_LIB_TABLE_ROW* row = FindRow( aNickname, true );
@@ -204,6 +204,17 @@ public:
     void LoadSymbolLib( std::vector<LIB_SYMBOL*>& aAliasList, const wxString& aNickname,
                         bool aPowerSymbolsOnly = false );
 
+    /**
+     * Fill \a aEntries with a summary of each symbol in the library given by \a aNickname.
+     *
+     * Libraries whose plugin keeps an index are summarized without loading the symbols;
+     * others are loaded as by LoadSymbolLib().
+     *
+     * @throw IO_ERROR if the library cannot be found or loaded.
+     */
+    void LoadSymbolLibIndex( std::vector<SYMBOL_INDEX_ENTRY>& aEntries, const wxString& aNickname,
+                             bool aPowerSymbolsOnly = false );
+
     /**
      * Load a #LIB_SYMBOL having @a aName from the library given by @a aNickname.
      *
@@ -78,10 +78,13 @@ bool SYMBOL_TREE_MODEL_ADAPTER::AddLibraries( const std::vector<wxString>& aNick
     // Disable KIID generation: not needed for library parts; sometimes very slow
     KIID::CreateNilUuids( true );
 
-    std::unordered_map<wxString, std::vector<LIB_SYMBOL*>> loadedSymbolMap;
+    // The tree only needs a summary of each symbol, so libraries are read from their indexes
+    // where possible and symbols are loaded when they are previewed or placed.
+    std::unordered_map<wxString, std::vector<SYMBOL_INDEX_ENTRY>> loadedSymbolMap;
 
-    SYMBOL_ASYNC_LOADER loader( aNicknames, m_libs, GetFilter() != nullptr, &loadedSymbolMap,
+    SYMBOL_ASYNC_LOADER loader( aNicknames, m_libs, GetFilter() != nullptr, nullptr,
                                 progressReporter.get() );
+    loader.SetIndexOutput( &loadedSymbolMap );
 
     LOCALE_IO toggle;
 
@@ -121,7 +124,7 @@ bool SYMBOL_TREE_MODEL_ADAPTER::AddLibraries( const std::vector<wxString>& aNick
         PROJECT_FILE&    project = aFrame->Prj().GetProjectFile();
 
         auto addFunc =
-                [&]( const wxString& aLibName, const std::vector<LIB_SYMBOL*>& aSymbolList,
+                [&]( const wxString& aLibName, std::vector<SYMBOL_INDEX_ENTRY*>& aSymbolList,
                      const wxString& aDescription )
                 {
                     std::vector<LIB_TREE_ITEM*> treeItems( aSymbolList.begin(), aSymbolList.end() );
@@ -131,8 +134,13 @@ bool SYMBOL_TREE_MODEL_ADAPTER::AddLibraries( const std::vector<wxString>& aNick
                     DoAddLibrary( aLibName, aDescription, treeItems, pinned, false );
                 };
 
-        for( const auto& [libNickname, libSymbols] : loadedSymbolMap )
+        for( auto& [libNickname, libEntries] : loadedSymbolMap )
         {
+            std::vector<SYMBOL_INDEX_ENTRY*> libSymbols;
+
+            for( SYMBOL_INDEX_ENTRY& entry : libEntries )
+                libSymbols.push_back( &entry );
+
             SYMBOL_LIB_TABLE_ROW* row = m_libs->FindRow( libNickname );
 
             wxCHECK2( row, continue );
@@ -169,13 +177,13 @@ bool SYMBOL_TREE_MODEL_ADAPTER::AddLibraries( const std::vector<wxString>& aNick
 
                     UTF8 utf8Lib( lib );
 
-                    std::vector<LIB_SYMBOL*> symbols;
+                    std::vector<SYMBOL_INDEX_ENTRY*> symbols;
 
                     std::copy_if( libSymbols.begin(), libSymbols.end(),
                                   std::back_inserter( symbols ),
-                                  [&utf8Lib]( LIB_SYMBOL* aSym )
+                                  [&utf8Lib]( SYMBOL_INDEX_ENTRY* aSym )
                                   {
-                                      return utf8Lib == aSym->GetLibId().GetSubLibraryName();
+                                      return utf8Lib == aSym->GetLIB_ID().GetSubLibraryName();
                                   } );
 
                     addFunc( name, symbols, desc );
@@ -176,6 +176,26 @@ public:
      */
     double m_SliverAngleTolerance;
 
+    /**
+     * Run independent DRC test providers at the same time rather than one after another.
+     * Violations are still reported in provider order.
+     *
+     * Setting name: "DRCParallelProviders"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_DRCParallelProviders;
+
+    /**
+     * Find the candidate pairs for the copper clearance tests of tracks and pads with a sweep
+     * over each layer, rather than searching the copper item tree once for every item.
+     *
+     * Setting name: "DRCBatchBroadPhase"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_DRCBatchBroadPhase;
+
 
     /**
      * Dimension used to calculate the actual hole size from the finish hole size.
@@ -255,6 +275,26 @@ public:
      */
     bool m_CompactSave;
 
+    /**
+     * Parse the footprints, tracks, vias and zones of a board file on several threads when
+     * loading it.
+     *
+     * Setting name: "ParallelBoardLoad"
+     * Valid values: 0 or 1
+     * Default value: 0
+     */
+    bool m_ParallelBoardLoad;
+
+    /**
+     * Format the items of a board on several threads when saving it.  The output is identical
+     * to formatting them one after the other.
+     *
+     * Setting name: "ParallelBoardSave"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_ParallelBoardSave;
+
     /**
      * Enable drawing the triangulation outlines with a visible color.
      *
@@ -288,6 +328,26 @@ public:
      */
     double m_MinPlotPenWidth;
 
+    /**
+     * Plot the layers of a Gerber export job at the same time, each into its own file, rather
+     * than one after another.
+     *
+     * Setting name: "ParallelGerberPlot"
+     * Valid values: 0 or 1
+     * Default value: 0
+     */
+    bool m_ParallelGerberPlot;
+
+    /**
+     * Build and write the feature files of the layers of an ODB++ export at the same time,
+     * alongside the netlist, rather than one after another.
+     *
+     * Setting name: "ParallelODBPPExport"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_ParallelODBPPExport;
+
     /**
      * A mode that dumps the various stages of a F_Cu fill into In1_Cu through In9_Cu.
      *
@@ -297,6 +357,27 @@ public:
      */
     bool m_DebugZoneFiller;
 
+    /**
+     * When true, automatic zone refills after an edit only recalculate the region around the
+     * changed items and splice it into the previous fill, rather than refilling whole zones.
+     *
+     * Setting name: "IncrementalZoneFill"
+     * Valid values: 0 or 1
+     * Default value: 0
+     */
+    bool m_IncrementalZoneFill;
+
+    /**
+     * The number of pads and tracks within a copper zone above which each of its layers is
+     * split into tiles that are filled concurrently.  Set to 0 to always fill zones in one
+     * piece.
+     *
+     * Setting name: "ZoneFillTileThreshold"
+     * Valid values: 0 to 10000000
+     * Default value: 0
+     */
+    int m_ZoneFillTileThreshold;
+
     /**
      * A mode that writes PDFs without compression.
      *
@@ -461,6 +542,38 @@ public:
      */
     bool m_IncrementalConnectivity;
 
+    /**
+     * Follow every incremental connectivity update with a full rebuild, and report any item
+     * whose net differs between the two.  This is slow and only meant for debugging.
+     *
+     * Setting name: "IncrementalConnectivityVerify"
+     * Valid values: 0 or 1
+     * Default value: 0
+     */
+    bool m_IncrementalConnectivityVerify;
+
+    /**
+     * Fill the symbol chooser from a stored index of each KiCad symbol library, and only parse
+     * the symbols which are previewed or placed.  Libraries are indexed the first time they
+     * are loaded and again whenever they change.
+     *
+     * Setting name: "SymbolLibraryIndex"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_SymbolLibraryIndex;
+
+    /**
+     * Keep a stored index of the footprint names, descriptions, keywords and pad counts of
+     * each footprint library, so that the footprint list only parses libraries which changed
+     * since they were last indexed.
+     *
+     * Setting name: "FootprintLibraryIndex"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_FootprintLibraryIndex;
+
     /**
      * The number of milliseconds to wait in a click before showing a disambiguation menu.
      *
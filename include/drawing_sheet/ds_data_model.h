@@ -57,6 +57,19 @@ public:
      */
     static void SetAltInstance( DS_DATA_MODEL* aLayout = nullptr );
 
+    /**
+     * Set the instance of #DS_DATA_MODEL used by the calling thread, ahead of any alternate
+     * instance.  Jobs run at the same time each give their thread the drawing sheet of the job.
+     *
+     * @param aLayout the thread's drawing sheet; if null use the application's drawing sheet.
+     */
+    static void SetThreadInstance( DS_DATA_MODEL* aLayout = nullptr );
+
+    /**
+     * Return the instance set by SetThreadInstance() for the calling thread, or null.
+     */
+    static DS_DATA_MODEL* GetThreadInstance();
+
     int GetFileFormatVersionAtLoad() { return m_fileFormatVersionAtLoad; }
     void SetFileFormatVersionAtLoad( int aVersion ) { m_fileFormatVersionAtLoad = aVersion; }
 
@@ -26,9 +26,11 @@
 #define DSNLEXER_H_
 
 #include <kicommon.h>
+#include <cstdint>
 #include <cstdio>
 #include <hashtables.h>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <richio.h>
@@ -42,6 +44,71 @@ struct KICOMMON_API KEYWORD
     const char* name;       ///< unique keyword.
     int         token;      ///< a zero based index into an array of KEYWORDs
 };
+
+
+/**
+ * A perfect hash of a keyword table, built once from the table generated by CMake.
+ *
+ * Each keyword falls into a bucket, and each bucket has a displacement chosen so that all of
+ * its keywords land in distinct slots.  A lookup is then a hash of the text, a displacement
+ * and a single comparison, with no probing or chaining.
+ */
+class KICOMMON_API KEYWORD_PERFECT_HASH
+{
+public:
+    /**
+     * @param aKeywords is a table of \a aCount keywords with unique names, which must outlive
+     *                  the hash.
+     */
+    KEYWORD_PERFECT_HASH( const KEYWORD* aKeywords, unsigned aCount );
+
+    /**
+     * @return the token of the keyword named \a aText, or -1 if there is none.
+     */
+    int Find( std::string_view aText ) const
+    {
+        if( m_slots.empty() )
+            return -1;
+
+        uint64_t       hash = hashText( aText );
+        uint32_t       displacement = m_displacements[hash & ( m_displacements.size() - 1 )];
+        const KEYWORD* keyword = m_slots[slotOf( hash, displacement )];
+
+        if( keyword && aText == keyword->name )
+            return keyword->token;
+
+        return -1;
+    }
+
+private:
+    /// FNV-1a, as for the old hashtable, but over a view and 64 bits wide.
+    static uint64_t hashText( std::string_view aText )
+    {
+        uint64_t hash = 14695981039346656037ull;
+
+        for( char c : aText )
+        {
+            hash ^= (unsigned char) c;
+            hash *= 1099511628211ull;
+        }
+
+        return hash;
+    }
+
+    /// Scatter \a aHash differently for each displacement (the splitmix64 finalizer).
+    size_t slotOf( uint64_t aHash, uint32_t aDisplacement ) const
+    {
+        uint64_t x = aHash + ( aDisplacement + 1 ) * 0x9E3779B97F4A7C15ull;
+
+        x = ( x ^ ( x >> 30 ) ) * 0xBF58476D1CE4E5B9ull;
+        x = ( x ^ ( x >> 27 ) ) * 0x94D049BB133111EBull;
+
+        return ( x ^ ( x >> 31 ) ) & ( m_slots.size() - 1 );
+    }
+
+    std::vector<uint32_t>       m_displacements;    ///< Per bucket, a power of two of them.
+    std::vector<const KEYWORD*> m_slots;            ///< A power of two of them.
+};
 #endif // SWIG
 
 // something like this macro can be used to help initialize a KEYWORD table.
@@ -91,7 +158,8 @@ public:
      * @param aFile is an open file, which will be closed when this is destructed.
      * @param aFileName is the name of the file
      */
-    DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount, const KEYWORD_MAP* aKeywordMap,
+    DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount,
+              const KEYWORD_PERFECT_HASH* aKeywordMap,
               FILE* aFile, const wxString& aFileName );
 
     /**
@@ -103,7 +171,8 @@ public:
      * @param aSExpression is text to feed through a STRING_LINE_READER
      * @param aSource is a description of aSExpression, used for error reporting.
      */
-    DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount, const KEYWORD_MAP* aKeywordMap,
+    DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount,
+              const KEYWORD_PERFECT_HASH* aKeywordMap,
               const std::string& aSExpression, const wxString& aSource = wxEmptyString );
 
     /**
@@ -128,7 +197,8 @@ public:
      * @param aLineReader is any subclassed instance of LINE_READER, such as
      *  #STRING_LINE_READER or #FILE_LINE_READER.  No ownership is taken.
      */
-    DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount, const KEYWORD_MAP* aKeywordMap,
+    DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount,
+              const KEYWORD_PERFECT_HASH* aKeywordMap,
               LINE_READER* aLineReader = nullptr );
 
     virtual ~DSNLEXER();
@@ -254,7 +324,7 @@ public:
      */
     int GetCurStrAsToken() const
     {
-        return findToken( curText );
+        return findToken( curView );
     }
 
     /**
@@ -406,7 +476,7 @@ public:
      */
     const char* CurText() const
     {
-        return curText.c_str();
+        return CurStr().c_str();
     }
 
     /**
@@ -414,16 +484,31 @@ public:
      */
     const std::string& CurStr() const
     {
+        if( !curTextValid )
+        {
+            curText.assign( curView );
+            curTextValid = true;
+        }
+
         return curText;
     }
 
+    /**
+     * Return the current token's text without copying it.  The view is only valid until the
+     * next call to #NextTok().
+     */
+    std::string_view CurView() const
+    {
+        return curView;
+    }
+
     /**
      * Return the current token text as a wxString, assuming that the input byte stream
      * is UTF8 encoded.
      */
     wxString FromUTF8() const
     {
-        return wxString::FromUTF8( curText.c_str() );
+        return wxString::FromUTF8( curView.data(), curView.size() );
     }
 
     /**
@@ -439,6 +524,10 @@ public:
      */
     const char* CurLine() const
     {
+        // Lines read from a mapped file aren't copied unless they're needed here
+        if( mappedReader )
+            return mappedReader->CurLine();
+
         return (const char*)(*reader);
     }
 
@@ -469,7 +558,21 @@ protected:
 
     int readLine()
     {
-        if( reader )
+        // The current token may be a view of the line buffer, which is about to be reused
+        keepCurText();
+
+        if( mappedReader )
+        {
+            // Tokenize the line where it is in the mapped file rather than copying it
+            std::string_view line = mappedReader->ReadLineView();
+
+            start = line.data();
+            next  = start;
+            limit = next + line.size();
+
+            return line.size();
+        }
+        else if( reader )
         {
             reader->ReadLine();
 
@@ -487,6 +590,29 @@ protected:
         return 0;
     }
 
+    /**
+     * Copy the current token's text into #curText if it is still a view of the current line.
+     */
+    void keepCurText()
+    {
+        if( !curTextValid )
+        {
+            curText.assign( curView );
+            curTextValid = true;
+        }
+
+        curView = curText;
+    }
+
+    /**
+     * Set the current token's text to the part of the current line from \a aBegin to \a aEnd.
+     */
+    void setCurView( const char* aBegin, const char* aEnd )
+    {
+        curView = std::string_view( aBegin, aEnd - aBegin );
+        curTextValid = false;
+    }
+
     /**
      * Take @a aToken string and looks up the string in the keywords table.
      *
@@ -494,7 +620,7 @@ protected:
      * @return with a value from the enum #DSN_T matching the keyword text,
      *         or #DSN_SYMBOL if @a aToken is not in the keywords table.
      */
-    int findToken( const std::string& aToken ) const;
+    int findToken( std::string_view aToken ) const;
 
     bool isStringTerminator( char cc ) const
     {
@@ -541,6 +667,9 @@ protected:
     /// No ownership. ownership is via readerStack, maybe, if #iOwnReaders.
     LINE_READER*        reader;
 
+    /// #reader, if it is a #MAPPED_FILE_LINE_READER whose lines can be tokenized in place.
+    MAPPED_FILE_LINE_READER* mappedReader;
+
     bool                specctraMode;           ///< if true, then:
                                                 ///< 1) stringDelimiter can be changed
                                                 ///< 2) Kicad quoting protocol is not in effect
@@ -556,11 +685,16 @@ protected:
     int                 curOffset;              ///< Offset within current line of the current token
 
     int                 curTok;                 ///< The current token obtained on last NextTok().
-    std::string         curText;                ///< The text of the current token.
+
+    /// The text of the current token: a view of the current line, or of #curText for a quoted
+    /// string holding escapes.
+    std::string_view    curView;
+    mutable std::string curText;                ///< Copy of #curView, made on demand.
+    mutable bool        curTextValid;           ///< True if #curText holds #curView.
 
     const KEYWORD*      keywords;               ///< Table sorted by CMake for bsearch().
     unsigned            keywordCount;           ///< Count of keywords table.
-    const KEYWORD_MAP*  keywordsLookup;         ///< Fast, specialized "C string" hashtable.
+    const KEYWORD_PERFECT_HASH* keywordsLookup; ///< Perfect hash of the keywords table.
 #endif // SWIG
 };
 
@@ -69,7 +69,7 @@ public:
 
     bool LibraryExists() const override;
 
-    PCB_IO_MGR::PCB_FILE_T GetFileType() { return type; }
+    PCB_IO_MGR::PCB_FILE_T GetFileType() const { return type; }
 
 protected:
     FP_LIB_TABLE_ROW( const FP_LIB_TABLE_ROW& aRow ) :
@@ -20,6 +20,7 @@
 #pragma once
 
 #include <optional>
+#include <string>
 
 #include <wx/stream.h>
 #include <wx/string.h>
@@ -61,4 +62,53 @@ KICOMMON_API void FormatStreamData( OUTPUTFORMATTER& aOut, const wxStreamBuffer&
 
 KICOMMON_API void Prettify( std::string& aSource, bool aCompactSave );
 
+/**
+ * Incremental form of Prettify(), for formatting output as it is produced rather than
+ * collecting all of it first.
+ *
+ * The input may be split at any point.  Feeding all of a string and then calling Finish()
+ * gives exactly the same result as Prettify().
+ */
+class KICOMMON_API PRETTIFIER
+{
+public:
+    PRETTIFIER( bool aCompactSave );
+
+    /**
+     * Format @a aCount bytes of @a aInput, appending to @a aOutput as much as can be output
+     * before more input is seen.
+     */
+    void Feed( const char* aInput, size_t aCount, std::string& aOutput );
+
+    /**
+     * Format the remaining input and append the final newline to @a aOutput.
+     */
+    void Finish( std::string& aOutput );
+
+private:
+    /**
+     * Format as much of @a aData as possible.
+     *
+     * @param aAtEnd is true if no more input follows @a aData.
+     * @return the number of bytes consumed.
+     */
+    size_t process( const char* aData, size_t aSize, bool aAtEnd, std::string& aOutput );
+
+    void newLine( std::string& aOutput );
+
+    bool        m_compactSave;
+    std::string m_pending;            ///< input held back until what follows it is known
+    bool        m_started;            ///< true once anything has been output
+    int         m_listDepth;
+    char        m_lastNonWhitespace;
+    bool        m_inQuote;
+    bool        m_hasInsertedSpace;
+    bool        m_inMultiLineList;
+    bool        m_inXY;
+    bool        m_inShortForm;
+    int         m_shortFormDepth;
+    int         m_column;
+    int         m_backslashCount;     ///< successive backslashes read since any other char
+};
+
 } // namespace KICAD_FORMAT
@@ -24,6 +24,7 @@
 #include <cstddef>
 #include <functional>
 #include <map>
+#include <new>
 #include <string>
 #include <stack>
 
@@ -315,21 +316,33 @@ class KICOMMON_API CONTEXT
 public:
     CONTEXT() :
         m_stack(),
-        m_stackPtr( 0 )
+        m_stackPtr( 0 ),
+        m_inlineCount( 0 )
     {
         m_ownedValues.reserve( 20 );
     }
 
     virtual ~CONTEXT()
     {
+        for( int ii = 0; ii < m_inlineCount; ++ii )
+            inlineValue( ii )->~VALUE();
+
         for( VALUE* v : m_ownedValues )
         {
             delete v;
         }
     }
 
+    CONTEXT( const CONTEXT& ) = delete;
+    CONTEXT& operator=( const CONTEXT& ) = delete;
+
     VALUE* AllocValue()
     {
+        // Intermediate results come from storage inside the context, so that evaluating a
+        // typical expression doesn't touch the heap.
+        if( m_inlineCount < INLINE_VALUE_COUNT )
+            return new( m_inlineValues[ m_inlineCount++ ] ) VALUE;
+
         m_ownedValues.emplace_back( new VALUE );
         return m_ownedValues.back();
     }
@@ -371,10 +384,21 @@ public:
     void ReportError( const wxString& aErrorMsg );
 
 private:
+    VALUE* inlineValue( int aIndex )
+    {
+        return std::launder( reinterpret_cast<VALUE*>( m_inlineValues[ aIndex ] ) );
+    }
+
+private:
+    static constexpr int INLINE_VALUE_COUNT = 16;
+
     std::vector<VALUE*> m_ownedValues;
     VALUE*              m_stack[100];       // std::stack not performant enough
     int                 m_stackPtr;
 
+    alignas( VALUE ) unsigned char m_inlineValues[INLINE_VALUE_COUNT][sizeof( VALUE )];
+    int                 m_inlineCount;
+
     std::function<void( const wxString& aMessage, int aOffset )> m_errorCallback;
 };
 
@@ -392,6 +416,14 @@ public:
     VALUE* Run( CONTEXT* ctx );
     wxString Dump() const;
 
+    /**
+     * Replace operations whose operands are all numeric constants with their result, so that
+     * (for instance) unit conversions and constant comparisons aren't recalculated on every
+     * evaluation.  Called by the compiler once code generation is complete, unless folding
+     * has been turned off with COMPILER::SetFoldConstants().
+     */
+    void FoldConstants();
+
     virtual std::unique_ptr<VAR_REF> CreateVarRef( const wxString& var, const wxString& field )
     {
         return nullptr;
@@ -438,6 +470,14 @@ public:
 
     wxString Format() const;
 
+    int GetOp() const { return m_op; }
+    VALUE* GetValue() const { return m_value.get(); }
+
+    bool IsNumericConstant() const
+    {
+        return m_op == TR_UOP_PUSH_VALUE && m_value && m_value->GetType() == VT_NUMERIC;
+    }
+
 private:
     int                      m_op;
 
@@ -528,6 +568,12 @@ public:
     bool IsErrorPending() const { return m_errorStatus.pendingError; }
     const ERROR_STATUS& GetError() const { return m_errorStatus; }
 
+    /**
+     * Turn constant folding of the generated code on (the default) or off.  Folded and unfolded
+     * code give the same results; turning it off is only useful to check that they do.
+     */
+    void SetFoldConstants( bool aFold ) { m_foldConstants = aFold; }
+
     void GcItem( TREE_NODE* aItem ) { m_gcItems.push_back( aItem ); }
     void GcItem( wxString* aItem ) { m_gcStrings.push_back( aItem ); }
 
@@ -565,6 +611,7 @@ protected:
     int          m_sourcePos;
     bool         m_parseFinished;
     ERROR_STATUS m_errorStatus;
+    bool         m_foldConstants;
 
     std::function<void( const wxString& aMessage, int aOffset )> m_errorCallback;
 
@@ -375,6 +375,10 @@ protected:
     void writeApertureList();
 
     std::vector<APERTURE> m_apertures;  // The list of available apertures
+
+    // Indices in m_apertures, by a hash of the aperture parameters.  Apertures defined by a
+    // corner list are hashed by the position of their first corner.
+    std::unordered_map<size_t, std::vector<int>> m_apertureIndex;
     int     m_currentApertureIdx;       // The index of the current aperture in m_apertures
     bool    m_hasApertureRoundRect;     // true is at least one round rect aperture is in use
     bool    m_hasApertureRotOval;       // true is at least one oval rotated aperture is in use
@@ -22,6 +22,7 @@
 
 #include <nlohmann/json.hpp>
 #include <wx/string.h>
+#include <optional>
 #include <vector>
 #include <json_conversions.h>
 
@@ -87,6 +88,59 @@ struct REPORT_BASE
     wxString coordinate_units;
 };
 
+struct DRC_PROVIDER_PROFILE
+{
+    wxString name;
+    double   wall_ms;
+    int64_t  violations;
+    int64_t  rule_evaluations;
+    int64_t  cache_hits;
+    int64_t  cache_misses;
+};
+
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE( DRC_PROVIDER_PROFILE, name, wall_ms, violations,
+                                    rule_evaluations, cache_hits, cache_misses )
+
+struct DRC_RULE_PROFILE
+{
+    wxString name;
+    bool     implicit;
+    int64_t  evaluations;
+    double   ms;
+};
+
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE( DRC_RULE_PROFILE, name, implicit, evaluations, ms )
+
+struct DRC_LAYER_PROFILE
+{
+    wxString layer;
+    int64_t  rule_evaluations;
+};
+
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE( DRC_LAYER_PROFILE, layer, rule_evaluations )
+
+struct DRC_CACHE_PROFILE
+{
+    wxString name;
+    int64_t  hits;
+    int64_t  misses;
+};
+
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE( DRC_CACHE_PROFILE, name, hits, misses )
+
+struct DRC_PROFILE
+{
+    double                            total_ms;
+    double                            cache_generation_ms;
+    std::vector<DRC_PROVIDER_PROFILE> providers;
+    std::vector<DRC_RULE_PROFILE>     rules;
+    std::vector<DRC_LAYER_PROFILE>    layers;
+    std::vector<DRC_CACHE_PROFILE>    caches;
+};
+
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE( DRC_PROFILE, total_ms, cache_generation_ms, providers, rules,
+                                    layers, caches )
+
 struct DRC_REPORT : REPORT_BASE
 {
     DRC_REPORT() { type = wxS( "drc" ); }
@@ -94,10 +148,38 @@ struct DRC_REPORT : REPORT_BASE
     std::vector<VIOLATION>                 violations;
     std::vector<VIOLATION>                 unconnected_items;
     std::vector<VIOLATION>                 schematic_parity;
+    std::optional<DRC_PROFILE>             profile;
 };
 
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE( DRC_REPORT, $schema, source, date, kicad_version, violations,
-                                    unconnected_items, schematic_parity, coordinate_units )
+inline void to_json( nlohmann::json& aJson, const DRC_REPORT& aReport )
+{
+    aJson["$schema"] = aReport.$schema;
+    aJson["source"] = aReport.source;
+    aJson["date"] = aReport.date;
+    aJson["kicad_version"] = aReport.kicad_version;
+    aJson["violations"] = aReport.violations;
+    aJson["unconnected_items"] = aReport.unconnected_items;
+    aJson["schematic_parity"] = aReport.schematic_parity;
+    aJson["coordinate_units"] = aReport.coordinate_units;
+
+    if( aReport.profile )
+        aJson["profile"] = *aReport.profile;
+}
+
+inline void from_json( const nlohmann::json& aJson, DRC_REPORT& aReport )
+{
+    aJson.at( "$schema" ).get_to( aReport.$schema );
+    aJson.at( "source" ).get_to( aReport.source );
+    aJson.at( "date" ).get_to( aReport.date );
+    aJson.at( "kicad_version" ).get_to( aReport.kicad_version );
+    aJson.at( "violations" ).get_to( aReport.violations );
+    aJson.at( "unconnected_items" ).get_to( aReport.unconnected_items );
+    aJson.at( "schematic_parity" ).get_to( aReport.schematic_parity );
+    aJson.at( "coordinate_units" ).get_to( aReport.coordinate_units );
+
+    if( aJson.contains( "profile" ) )
+        aReport.profile = aJson.at( "profile" ).get<DRC_PROFILE>();
+}
 
 struct ERC_SHEET
 {
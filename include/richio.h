@@ -29,6 +29,8 @@
 // "richio" after its author, Richard Hollenbeck, aka Dick Hollenbeck.
 
 
+#include <algorithm>
+#include <string_view>
 #include <vector>
 #include <core/utf8.h>
 
@@ -40,6 +42,7 @@
 
 #include <ki_exception.h>
 #include <kicommon.h>
+#include <io/kicad/kicad_io_utils.h>
 
 /**
  * This is like sprintf() but the output is appended to a std::string instead of to a
@@ -246,6 +249,106 @@ protected:
 };
 
 
+/**
+ * A #LINE_READER that maps a whole file into memory and reads lines out of the mapping.
+ *
+ * This avoids the per-character stdio calls of #FILE_LINE_READER, which is worthwhile for large
+ * files such as boards.  ReadLine() copies each line into the line buffer so that it is nul
+ * terminated; #DSNLEXER instead reads lines with ReadLineView() and tokenizes them in place,
+ * copying a line only when CurLine() is needed for an error message.
+ *
+ * If the file cannot be mapped (e.g. it is empty or on a filesystem without mmap support) it
+ * is read into memory instead.  The file must not be truncated while it is being read: on
+ * most platforms this raises SIGBUS rather than an IO_ERROR.  See KIPLATFORM::IO::MapFile().
+ */
+class KICOMMON_API MAPPED_FILE_LINE_READER : public LINE_READER
+{
+public:
+    /**
+     * @param aFileName is the name of the file to open and to use for error reporting purposes.
+     * @param aStartingLineNumber is the initial line number to report on error.
+     * @param aMaxLineLength is the maximum allowed line length.
+     *
+     * @throw IO_ERROR if @a aFileName cannot be opened.
+     */
+    MAPPED_FILE_LINE_READER( const wxString& aFileName, unsigned aStartingLineNumber = 0,
+                             unsigned aMaxLineLength = LINE_READER_LINE_DEFAULT_MAX );
+
+    /**
+     * Construct a second reader over the file contents of @a aParent, starting at its current
+     * position.  @a aParent must outlive the new reader.
+     *
+     * This allows several threads to read different parts of the same file at once.
+     */
+    MAPPED_FILE_LINE_READER( const MAPPED_FILE_LINE_READER& aParent );
+
+    ~MAPPED_FILE_LINE_READER();
+
+    char* ReadLine() override;
+
+    /**
+     * Read the next line like ReadLine(), but return it as a view of the file contents rather
+     * than copying it into the line buffer.  The view remains valid for the life of the reader.
+     *
+     * @return the line, including its newline, or an empty view at the end of the file.
+     * @throw IO_ERROR when a line is too long.
+     */
+    std::string_view ReadLineView();
+
+    /**
+     * Return the last line read, copied into the line buffer and nul terminated.  Use this
+     * rather than Line() after ReadLineView().
+     */
+    const char* CurLine();
+
+    /**
+     * Go back to the start of the file and reset the line number back to zero.
+     */
+    void Rewind()
+    {
+        m_ndx = 0;
+        m_lineStart = 0;
+        m_length = 0;
+        m_lineNum = 0;
+    }
+
+    /**
+     * Continue reading from byte offset @a aOffset, which is within line @a aLineNumber.
+     *
+     * The next ReadLine() returns the remainder of that line.
+     */
+    void Seek( size_t aOffset, unsigned aLineNumber )
+    {
+        m_ndx = std::min( aOffset, m_size );
+        m_lineStart = m_ndx;
+        m_length = 0;
+        m_lineNum = aLineNumber - 1;
+    }
+
+    /**
+     * Count the lines in the file without reading them, for progress reporting.
+     */
+    unsigned CountLines() const;
+
+    /**
+     * Return the whole file contents.  These are not nul terminated; see FileLength().
+     */
+    const char* Data() const { return m_data; }
+
+    size_t FileLength() const { return m_size; }
+    size_t CurPos() const { return m_ndx; }
+
+protected:
+    const char*  m_data;      ///< start of the file contents
+    size_t       m_size;      ///< size of the file contents in bytes
+    size_t       m_ndx;       ///< offset of the next line to read
+    size_t       m_lineStart; ///< offset of the last line read
+    void*        m_mapping;   ///< platform handle for the mapping, if any
+    bool         m_mapped;    ///< true if m_data is a mapping rather than m_buffer
+    std::string  m_buffer;    ///< file contents when the file couldn't be mapped
+};
+
+
 /**
  * Is a #LINE_READER that reads from a multiline 8 bit wide std::string
  */
@@ -391,6 +494,13 @@ public:
      */
     int PRINTF_FUNC Print( const char* fmt, ... );
 
+    /**
+     * Write \a aText to the output stream as it is, without any formatting.
+     *
+     * @throw IO_ERROR, if there is a problem outputting, such as a full disk.
+     */
+    void Write( const std::string& aText ) { write( aText.data(), (int) aText.size() ); }
+
     /**
      * Perform quote character need determination.
      *
@@ -512,6 +622,10 @@ protected:
 };
 
 
+/**
+ * An #OUTPUTFORMATTER which prettifies its output (see KICAD_FORMAT::Prettify()) as it is
+ * written, and passes it on to a file through a bounded buffer.
+ */
 class KICOMMON_API PRETTIFIED_FILE_OUTPUTFORMATTER : public OUTPUTFORMATTER
 {
 public:
@@ -521,7 +635,7 @@ public:
     ~PRETTIFIED_FILE_OUTPUTFORMATTER();
 
     /**
-     * Performs prettification and writes the stored buffer to the file.
+     * Writes the remaining output and closes the file.
      * @return true if the write succeeded.
      */
     bool Finish() override;
@@ -530,8 +644,14 @@ protected:
     void write( const char* aOutBuf, int aCount ) override;
 
 private:
-    FILE* m_fp;
-    std::string m_buf;
+    void flush();
+
+    ///< Prettified output is written to the file whenever this much has accumulated.
+    static constexpr size_t PRETTIFIED_BUFFER_SIZE = 1024 * 1024;
+
+    FILE*                    m_fp;
+    std::string              m_buf;
+    KICAD_FORMAT::PRETTIFIER m_prettifier;
 };
 
 
@@ -24,6 +24,7 @@
 #ifndef STRING_UTILS_H
 #define STRING_UTILS_H
 
+#include <cstdarg>
 #include <string>
 #include <vector>
 #include <wx/string.h>
@@ -391,6 +392,31 @@ KICOMMON_API std::string UIDouble2Str( double aValue );
  */
 KICOMMON_API std::string FormatDouble2Str( double aValue );
 
+/**
+ * Parse a floating point number in the "C" locale, whatever the current locale is.
+ *
+ * Leading whitespace is skipped.  This doesn't touch the global locale, so unlike LOCALE_IO
+ * it is safe to use from any thread.
+ *
+ * @param aBegin is the start of the text to parse.
+ * @param aEnd is one past the end of the text to parse.
+ * @param aValue is set to the number parsed.
+ * @return one past the last character of the number, or nullptr if the text doesn't start
+ *         with a number or the number is out of range.
+ */
+KICOMMON_API const char* ParseCDouble( const char* aBegin, const char* aEnd, double& aValue );
+
+/**
+ * vsnprintf() in the "C" locale, whatever the current locale is.
+ *
+ * Only the calling thread is affected, so unlike LOCALE_IO it is safe to use from any thread.
+ *
+ * @return the length of the formatted text, which can be larger than \a aSize if the text was
+ *         truncated, or a negative value on an error; the same as C99 vsnprintf().
+ */
+KICOMMON_API int CLocaleVsnprintf( char* aBuffer, size_t aSize, const char* aFormat,
+                                   va_list aArgs );
+
 /**
  * Convert a wxString to a UTF8 encoded C string for all wxWidgets build modes.
  *
@@ -37,6 +37,7 @@
 #define ARG_STOP_ON_ERROR "--stop-on-error"
 #define ARG_JOB_FILE "--file"
 #define ARG_OUTPUT "--output"
+#define ARG_PARALLEL "--parallel"
 
 CLI::JOBSET_RUN_COMMAND::JOBSET_RUN_COMMAND() : COMMAND( "run" )
 {
@@ -58,6 +59,16 @@ CLI::JOBSET_RUN_COMMAND::JOBSET_RUN_COMMAND() : COMMAND( "run" )
             .help( UTF8STDSTR( _( "Jobset file output to generate, leave blank for all outputs defined in the jobset" ) ) )
             .default_value( std::string( "" ) )
             .metavar( "OUTPUT" );
+
+    m_argParser.add_argument( ARG_PARALLEL )
+            .help( UTF8STDSTR( _( "Run independent jobs at the same time.  Board outputs which "
+                                  "only read the board (Gerbers without refilling zones, drill, "
+                                  "position, PDF and STEP files) run side by side, and alongside "
+                                  "schematic jobs.  Other jobs of an editor, such as DRC, wait "
+                                  "for its jobs before them and its jobs after them wait for "
+                                  "them.  Special jobs wait for all jobs before them.  A job's "
+                                  "depends_on list names other jobs it must run after" ) ) )
+            .flag();
 }
 
 
@@ -83,6 +94,8 @@ int CLI::JOBSET_RUN_COMMAND::doPerform( KIWAY& aKiway )
     JOBS_RUNNER jobsRunner( &aKiway, &jobFile, project,
                             &CLI_REPORTER::GetInstance() );
 
+    jobsRunner.SetParallel( m_argParser.get<bool>( ARG_PARALLEL ) );
+
     int return_code = CLI::EXIT_CODES::SUCCESS;
 
     if( !outputKey.IsEmpty() )
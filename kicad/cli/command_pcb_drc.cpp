@@ -38,6 +38,8 @@
 #define ARG_SEVERITY_EXCLUSIONS "--severity-exclusions"
 #define ARG_EXIT_CODE_VIOLATIONS "--exit-code-violations"
 #define ARG_PARITY "--schematic-parity"
+#define ARG_REFILL_ZONES "--refill-zones"
+#define ARG_PROFILE "--profile"
 
 CLI::PCB_DRC_COMMAND::PCB_DRC_COMMAND() : COMMAND( "drc" )
 {
@@ -60,6 +62,16 @@ CLI::PCB_DRC_COMMAND::PCB_DRC_COMMAND() : COMMAND( "drc" )
             .help( UTF8STDSTR( _( "Test for parity between PCB and schematic" ) ) )
             .flag();
 
+    m_argParser.add_argument( ARG_REFILL_ZONES )
+            .help( UTF8STDSTR( _( "Refill zones before running DRC; unchanged zone fills are "
+                                  "reused from the user cache directory" ) ) )
+            .flag();
+
+    m_argParser.add_argument( ARG_PROFILE )
+            .help( UTF8STDSTR( _( "Report the time taken by each DRC test provider and rule; "
+                                  "included in the report when using the json format" ) ) )
+            .flag();
+
     m_argParser.add_argument( ARG_UNITS )
             .default_value( std::string( "mm" ) )
             .help( UTF8STDSTR( _( "Report units; valid options: in, mm, mils" ) ) )
@@ -163,6 +175,8 @@ int CLI::PCB_DRC_COMMAND::doPerform( KIWAY& aKiway )
     }
 
     drcJob->m_parity = m_argParser.get<bool>( ARG_PARITY );
+    drcJob->m_refillZones = m_argParser.get<bool>( ARG_REFILL_ZONES );
+    drcJob->m_profile = m_argParser.get<bool>( ARG_PROFILE );
 
     int exitCode = aKiway.ProcessJob( KIWAY::FACE_PCB, drcJob.get() );
 
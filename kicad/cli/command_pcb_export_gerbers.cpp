@@ -27,6 +27,7 @@
 #include <locale_io.h>
 
 #define ARG_USE_BOARD_PLOT_PARAMS "--board-plot-params"
+#define ARG_REFILL_ZONES "--refill-zones"
 
 
 CLI::PCB_EXPORT_GERBERS_COMMAND::PCB_EXPORT_GERBERS_COMMAND() :
@@ -41,6 +42,11 @@ CLI::PCB_EXPORT_GERBERS_COMMAND::PCB_EXPORT_GERBERS_COMMAND() :
             .help( UTF8STDSTR( _( "Use the Gerber plot settings already configured in the "
                                   "board file" ) ) )
             .flag();
+
+    m_argParser.add_argument( ARG_REFILL_ZONES )
+            .help( UTF8STDSTR( _( "Refill zones before plotting; unchanged zone fills are "
+                                  "reused from the user cache directory" ) ) )
+            .flag();
 }
 
 
@@ -56,6 +62,7 @@ int CLI::PCB_EXPORT_GERBERS_COMMAND::doPerform( KIWAY& aKiway )
     gerberJob->m_argLayers = From_UTF8( m_argParser.get<std::string>( ARG_LAYERS ).c_str() );
     gerberJob->m_argCommonLayers = From_UTF8( m_argParser.get<std::string>( ARG_COMMON_LAYERS ).c_str() );
     gerberJob->m_useBoardPlotParams = m_argParser.get<bool>( ARG_USE_BOARD_PLOT_PARAMS );
+    gerberJob->m_refillZones = m_argParser.get<bool>( ARG_REFILL_ZONES );
 
     LOCALE_IO dummy;
     return aKiway.ProcessJob( KIWAY::FACE_PCB, gerberJob.get() );
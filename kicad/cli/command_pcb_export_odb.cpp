@@ -29,6 +29,7 @@
 
 #define ARG_COMPRESS "--compression"
 #define ARG_UNITS "--units"
+#define ARG_REFILL_ZONES "--refill-zones"
 
 CLI::PCB_EXPORT_ODB_COMMAND::PCB_EXPORT_ODB_COMMAND() :
         PCB_EXPORT_BASE_COMMAND( "odb" )
@@ -53,6 +54,11 @@ CLI::PCB_EXPORT_ODB_COMMAND::PCB_EXPORT_ODB_COMMAND() :
             .default_value( std::string( "mm" ) )
             .help( std::string( "Units" ) )
             .choices( "mm", "in" );
+
+    m_argParser.add_argument( ARG_REFILL_ZONES )
+            .help( std::string( "Refill zones before exporting; unchanged zone fills are reused "
+                                "from the user cache directory" ) )
+            .flag();
 }
 
 
@@ -72,6 +78,7 @@ int CLI::PCB_EXPORT_ODB_COMMAND::doPerform( KIWAY& aKiway )
     }
 
     job->m_precision = m_argParser.get<int>( ARG_PRECISION );
+    job->m_refillZones = m_argParser.get<bool>( ARG_REFILL_ZONES );
 
     wxString units = From_UTF8( m_argParser.get<std::string>( ARG_UNITS ).c_str() );
 
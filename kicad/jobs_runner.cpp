@@ -20,6 +20,7 @@
 
 #include <common.h>
 #include <cli/exit_codes.h>
+#include <core/profile.h>
 #include <jobs_runner.h>
 #include <jobs/job_registry.h>
 #include <jobs/jobset.h>
@@ -33,13 +34,23 @@
 #include <wx/sstream.h>
 #include <wx/wfstream.h>
 #include <gestfich.h>
+#include <locale_io.h>
+#include <thread_pool.h>
+
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <map>
+#include <optional>
+#include <set>
 
 JOBS_RUNNER::JOBS_RUNNER( KIWAY* aKiway, JOBSET* aJobsFile, PROJECT* aProject,
                           REPORTER* aReporter ) :
         m_kiway( aKiway ),
         m_jobsFile( aJobsFile ),
         m_reporter( aReporter ),
-        m_project( aProject )
+        m_project( aProject ),
+        m_parallel( false )
 {
     if( !m_reporter )
     {
@@ -59,6 +70,23 @@ bool JOBS_RUNNER::RunJobsAllDestinations( bool aBail )
 }
 
 
+int JOBS_RUNNER::runJob( const JOBSET_JOB& aJob, REPORTER* aReporter )
+{
+    KIWAY::FACE_T iface = JOB_REGISTRY::GetKifaceType( aJob.m_type );
+
+    if( iface < KIWAY::KIWAY_FACE_COUNT )
+        return m_kiway->ProcessJob( iface, aJob.m_job.get(), aReporter );
+
+    // special jobs
+    if( aJob.m_job->GetType() == "special_execute" )
+        return runSpecialExecute( &aJob, m_project );
+    else if( aJob.m_job->GetType() == "special_copyfiles" )
+        return runSpecialCopyFiles( &aJob, m_project );
+
+    return CLI::EXIT_CODES::SUCCESS;
+}
+
+
 int JOBS_RUNNER::runSpecialExecute( const JOBSET_JOB* aJob, PROJECT* aProject )
 {
     JOB_SPECIAL_EXECUTE* specialJob = static_cast<JOB_SPECIAL_EXECUTE*>( aJob->m_job.get() );
@@ -163,6 +191,117 @@ private:
 };
 
 
+/**
+ * Holds the messages of a job run alongside others until they can be passed on in order.
+ */
+class JOBSET_BUFFERED_REPORTER : public REPORTER
+{
+public:
+    REPORTER& Report( const wxString& aText, SEVERITY aSeverity ) override
+    {
+        m_messages.emplace_back( aText, aSeverity );
+        return *this;
+    }
+
+    bool HasMessage() const override { return !m_messages.empty(); }
+
+    void Replay( REPORTER* aReporter ) const
+    {
+        for( const auto& [text, severity] : m_messages )
+            aReporter->Report( text, severity );
+    }
+
+private:
+    std::vector<std::pair<wxString, SEVERITY>> m_messages;
+};
+
+
+/**
+ * Work out which jobs must finish before each job starts when jobs are run side by side.
+ *
+ * A job waits for the earlier jobs named in its m_dependsOn, such as a DRC run before the fab
+ * outputs.  Special jobs may use the outputs of any job before them, so each waits for all jobs
+ * before it and all jobs after it wait for it.  The jobs of one kiface share its loaded board or
+ * schematic: jobs which only read it may run together, but a job which changes it waits for all
+ * the kiface's jobs before it, and all the kiface's jobs after it wait for it.
+ *
+ * @return the jobs waiting for each job.
+ */
+static std::vector<std::set<size_t>> planDependents( const std::vector<JOBSET_JOB>& aJobs,
+                                                     REPORTER* aReporter )
+{
+    std::vector<std::set<size_t>> dependents( aJobs.size() );
+    std::map<wxString, size_t>    jobIdxs;
+    std::optional<size_t>         lastSpecial;
+
+    struct KIFACE_JOBS
+    {
+        std::optional<size_t> lastWriter;
+        std::vector<size_t>   readersSinceWriter;
+    };
+
+    std::map<KIWAY::FACE_T, KIFACE_JOBS> kifaceJobs;
+
+    for( size_t ii = 0; ii < aJobs.size(); ++ii )
+    {
+        const JOBSET_JOB& job = aJobs[ii];
+        KIWAY::FACE_T     iface = JOB_REGISTRY::GetKifaceType( job.m_type );
+
+        for( const wxString& id : job.m_dependsOn )
+        {
+            auto it = jobIdxs.find( id );
+
+            if( it != jobIdxs.end() )
+            {
+                dependents[it->second].insert( ii );
+            }
+            else
+            {
+                aReporter->Report( wxString::Format( wxT( "Job %s depends on %s, which is not an "
+                                                          "earlier job of this output; ignored\n" ),
+                                                     job.m_id, id ),
+                                   RPT_SEVERITY_WARNING );
+            }
+        }
+
+        if( iface >= KIWAY::KIWAY_FACE_COUNT )
+        {
+            for( size_t jj = 0; jj < ii; ++jj )
+                dependents[jj].insert( ii );
+
+            lastSpecial = ii;
+        }
+        else
+        {
+            KIFACE_JOBS& kiface = kifaceJobs[iface];
+
+            if( lastSpecial )
+                dependents[*lastSpecial].insert( ii );
+
+            if( kiface.lastWriter )
+                dependents[*kiface.lastWriter].insert( ii );
+
+            if( job.m_job->ReadsDocumentOnly() && job.m_job->GetVarOverrides().empty() )
+            {
+                kiface.readersSinceWriter.push_back( ii );
+            }
+            else
+            {
+                for( size_t reader : kiface.readersSinceWriter )
+                    dependents[reader].insert( ii );
+
+                kiface.lastWriter = ii;
+                kiface.readersSinceWriter.clear();
+            }
+        }
+
+        jobIdxs[job.m_id] = ii;
+    }
+
+    return dependents;
+}
+
+
 bool JOBS_RUNNER::RunJobsForDestination( JOBSET_DESTINATION* aDestination, bool aBail )
 {
     bool                    genOutputs = true;
@@ -238,26 +377,84 @@ bool JOBS_RUNNER::RunJobsForDestination( JOBSET_DESTINATION* aDestination, bool
 
     std::vector<JOB_OUTPUT> outputs;
 
-    int jobNum = 1;
+    struct JOB_RUN
+    {
+        REPORTER*                                 reporter = nullptr;
+        std::unique_ptr<JOBSET_BUFFERED_REPORTER> buffer;
+        int                                       result = CLI::EXIT_CODES::SUCCESS;
+        double                                    msecs = 0.0;
+    };
+
+    std::vector<JOB_RUN> runs( jobsForDestination.size() );
+    PROF_TIMER           totalTimer;
+
     int failCount = 0;
     int successCount = 0;
 
-    for( const JOBSET_JOB& job : jobsForDestination )
-    {
-        if( m_reporter != nullptr )
-        {
-            msg = wxT( "|--------------------------------\n" );
+    auto reportJobStart =
+            [&]( size_t aJobIdx )
+            {
+                if( m_reporter != nullptr )
+                {
+                    msg = wxT( "|--------------------------------\n" );
 
-            msg += wxString::Format( wxT( "| Running job %d, %s" ), jobNum, job.GetDescription() );
-            jobNum++;
+                    msg += wxString::Format( wxT( "| Running job %d, %s" ),
+                                             static_cast<int>( aJobIdx + 1 ),
+                                             jobsForDestination[aJobIdx].GetDescription() );
 
-            msg += wxT( "\n" );
-            msg += wxT( "|--------------------------------\n" );
+                    msg += wxT( "\n" );
+                    msg += wxT( "|--------------------------------\n" );
 
-            m_reporter->Report( msg, RPT_SEVERITY_INFO );
-        }
+                    m_reporter->Report( msg, RPT_SEVERITY_INFO );
+                }
+            };
 
-        KIWAY::FACE_T iface = JOB_REGISTRY::GetKifaceType( job.m_type );
+    auto finishJob =
+            [&]( size_t aJobIdx )
+            {
+                const JOBSET_JOB& job = jobsForDestination[aJobIdx];
+                int               result = runs[aJobIdx].result;
+
+                aDestination->m_lastRunSuccessMap[job.m_id] =
+                        ( result == CLI::EXIT_CODES::SUCCESS );
+
+                if( m_reporter )
+                {
+                    if( result == CLI::EXIT_CODES::SUCCESS )
+                    {
+                        wxString msg_fmt = wxT( "\033[32;1m%s\033[0m (%.2f s)\n" );
+                        msg = wxString::Format( msg_fmt, _( "Job successful" ),
+                                                runs[aJobIdx].msecs / 1000.0 );
+
+                        successCount++;
+                    }
+                    else
+                    {
+                        wxString msg_fmt = wxT( "\033[31;1m%s\033[0m (%.2f s)\n" );
+                        msg = wxString::Format( msg_fmt, _( "Job failed" ),
+                                                runs[aJobIdx].msecs / 1000.0 );
+
+                        failCount++;
+                    }
+
+                    msg += wxT( "\n\n" );
+                    m_reporter->Report( msg, RPT_SEVERITY_INFO );
+                }
+
+                if( result == CLI::EXIT_CODES::ERR_RC_VIOLATIONS )
+                {
+                    success = false;
+                }
+                else if( result != CLI::EXIT_CODES::SUCCESS )
+                {
+                    genOutputs = false;
+                    success = false;
+                }
+            };
+
+    for( size_t jobIdx = 0; jobIdx < jobsForDestination.size(); ++jobIdx )
+    {
+        const JOBSET_JOB& job = jobsForDestination[jobIdx];
 
         job.m_job->SetTempOutputDirectory( tempDirPath );
 
@@ -268,63 +465,177 @@ bool JOBS_RUNNER::RunJobsForDestination( JOBSET_DESTINATION* aDestination, bool
             reporterToUse = new JOBSET_OUTPUT_REPORTER( tempDirPath );
             aDestination->m_lastRunReporters[job.m_id] = reporterToUse;
         }
+        else if( m_parallel )
+        {
+            // Jobs run side by side report to buffers, which are passed on in job order
+            runs[jobIdx].buffer = std::make_unique<JOBSET_BUFFERED_REPORTER>();
+            reporterToUse = runs[jobIdx].buffer.get();
+        }
 
-        int result = CLI::EXIT_CODES::SUCCESS;
+        runs[jobIdx].reporter = reporterToUse;
+    }
+
+    auto runJobAt =
+            [&]( size_t aJobIdx )
+            {
+                JOB_RUN&   run = runs[aJobIdx];
+                PROF_TIMER timer;
+
+                try
+                {
+                    run.result = runJob( jobsForDestination[aJobIdx], run.reporter );
+                }
+                catch( const std::exception& e )
+                {
+                    run.reporter->Report( e.what(), RPT_SEVERITY_ERROR );
+                    run.result = CLI::EXIT_CODES::ERR_UNKNOWN;
+                }
 
-        if( iface < KIWAY::KIWAY_FACE_COUNT )
+                run.msecs = timer.msecs();
+            };
+
+    std::vector<std::set<size_t>> dependents = planDependents( jobsForDestination, m_reporter );
+
+    if( !m_parallel )
+    {
+        for( size_t jobIdx = 0; jobIdx < jobsForDestination.size(); ++jobIdx )
         {
-            result = m_kiway->ProcessJob( iface, job.m_job.get(), reporterToUse );
+            reportJobStart( jobIdx );
+            runJobAt( jobIdx );
+            finishJob( jobIdx );
+
+            if( runs[jobIdx].result != CLI::EXIT_CODES::SUCCESS && aBail )
+                break;
         }
-        else
+    }
+    else
+    {
+        const size_t count = jobsForDestination.size();
+
+        std::vector<size_t> waitingOn( count, 0 );
+
+        for( size_t ii = 0; ii < count; ++ii )
         {
-            // special jobs
-            if( job.m_job->GetType() == "special_execute" )
-			{
-                result = runSpecialExecute( &job, m_project );
-            }
-            else if( job.m_job->GetType() == "special_copyfiles" )
-            {
-                result = runSpecialCopyFiles( &job, m_project );
-            }
+            for( size_t dependent : dependents[ii] )
+                waitingOn[dependent]++;
+
+            // Load the kifaces up front rather than from several threads at once
+            KIWAY::FACE_T iface = JOB_REGISTRY::GetKifaceType( jobsForDestination[ii].m_type );
+
+            if( iface < KIWAY::KIWAY_FACE_COUNT )
+                m_kiway->KiFACE( iface );
         }
 
-        aDestination->m_lastRunSuccessMap[job.m_id] = ( result == CLI::EXIT_CODES::SUCCESS );
+        // Jobs don't run as thread pool tasks as some of them wait on tasks of their own.
+        const size_t maxRunning = std::max<size_t>( 1, GetKiCadThreadPool().get_thread_count() );
 
-        if( m_reporter )
+        std::set<size_t>               ready;
+        std::vector<bool>              finished( count, false );
+        std::vector<std::future<void>> running( count );
+        size_t                         runningCount = 0;
+        size_t                         nextToReport = 0;
+        bool                           bailed = false;
+
+        // Held for the whole run so that jobs on different threads don't switch the locale
+        LOCALE_IO dummy;
+
+        for( size_t ii = 0; ii < count; ++ii )
         {
-            if( result == CLI::EXIT_CODES::SUCCESS )
-            {
-                wxString msg_fmt = wxT( "\033[32;1m%s\033[0m\n" );
-                msg = wxString::Format( msg_fmt, _( "Job successful" ) );
+            if( waitingOn[ii] == 0 )
+                ready.insert( ii );
+        }
 
-                successCount++;
-            }
-            else
-            {
-                wxString msg_fmt = wxT( "\033[31;1m%s\033[0m\n" );
-                msg = wxString::Format( msg_fmt, _( "Job failed" ) );
+        auto reportJob =
+                [&]( size_t aJobIdx )
+                {
+                    reportJobStart( aJobIdx );
 
-                failCount++;
-            }
+                    if( runs[aJobIdx].buffer )
+                        runs[aJobIdx].buffer->Replay( m_reporter );
 
-            msg += wxT( "\n\n" );
-            m_reporter->Report( msg, RPT_SEVERITY_INFO );
-        }
+                    finishJob( aJobIdx );
+                };
+
+        auto completeJob =
+                [&]( size_t aJobIdx )
+                {
+                    finished[aJobIdx] = true;
 
-        if( result == CLI::EXIT_CODES::ERR_RC_VIOLATIONS )
+                    if( runs[aJobIdx].result != CLI::EXIT_CODES::SUCCESS && aBail )
+                        bailed = true;
+
+                    for( size_t dependent : dependents[aJobIdx] )
+                    {
+                        if( --waitingOn[dependent] == 0 )
+                            ready.insert( dependent );
+                    }
+
+                    // Each job is reported once it and all the jobs before it have finished
+                    for( ; nextToReport < count && finished[nextToReport]; ++nextToReport )
+                        reportJob( nextToReport );
+                };
+
+        while( true )
         {
-            success = false;
+            while( !bailed && !ready.empty() && runningCount < maxRunning )
+            {
+                size_t jobIdx = *ready.begin();
+                ready.erase( ready.begin() );
+
+                KIWAY::FACE_T iface =
+                        JOB_REGISTRY::GetKifaceType( jobsForDestination[jobIdx].m_type );
+
+                if( iface >= KIWAY::KIWAY_FACE_COUNT )
+                {
+                    // Special jobs wait for all other jobs, and may start processes, so they
+                    // run on this thread
+                    runJobAt( jobIdx );
+                    completeJob( jobIdx );
+                    continue;
+                }
+
+                runningCount++;
+                running[jobIdx] = std::async( std::launch::async, runJobAt, jobIdx );
+            }
 
-            if( aBail )
+            if( runningCount == 0 && ( bailed || ready.empty() ) )
                 break;
+
+            bool finishedAny = false;
+
+            for( size_t ii = 0; ii < count; ++ii )
+            {
+                if( !running[ii].valid()
+                        || running[ii].wait_for( std::chrono::seconds( 0 ) )
+                                   != std::future_status::ready )
+                {
+                    continue;
+                }
+
+                running[ii].get();
+                runningCount--;
+                finishedAny = true;
+                completeJob( ii );
+            }
+
+            if( !finishedAny )
+            {
+                for( std::future<void>& task : running )
+                {
+                    if( task.valid() )
+                    {
+                        task.wait_for( std::chrono::milliseconds( 100 ) );
+                        break;
+                    }
+                }
+            }
         }
-        else if( result != CLI::EXIT_CODES::SUCCESS )
-        {
-            genOutputs = false;
-            success = false;
 
-            if( aBail )
-                break;
+        // After bailing, the jobs which finished after one which wasn't started
+        for( size_t jobIdx = nextToReport; jobIdx < count; ++jobIdx )
+        {
+            if( finished[jobIdx] )
+                reportJob( jobIdx );
         }
     }
 
@@ -335,11 +646,12 @@ bool JOBS_RUNNER::RunJobsForDestination( JOBSET_DESTINATION* aDestination, bool
 
     if( m_reporter )
     {
-        msg = wxString::Format( wxT( "\n\n\033[33;1m%d %s, %d %s\033[0m\n" ),
+        msg = wxString::Format( wxT( "\n\n\033[33;1m%d %s, %d %s (%.2f s)\033[0m\n" ),
                                 successCount,
                                 wxT( "jobs succeeded" ),
                                 failCount,
-                                wxT( "job failed" ) );
+                                wxT( "job failed" ),
+                                totalTimer.msecs() / 1000.0 );
 
         m_reporter->Report( msg, RPT_SEVERITY_INFO );
     }
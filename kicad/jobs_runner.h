@@ -36,7 +36,20 @@ public:
     bool RunJobsAllDestinations( bool aBail = false );
     bool RunJobsForDestination( JOBSET_DESTINATION* aDestination, bool aBail = false );
 
+    /**
+     * Run jobs which don't depend on each other at the same time, each on its own thread.
+     *
+     * Jobs which only read their board or schematic (see JOB::ReadsDocumentOnly()) run side by
+     * side with each other and with the jobs of other editors.  A job which changes its document,
+     * such as DRC, waits for the jobs of its editor before it, and those after it wait for it.
+     * Special jobs wait for all jobs before them, and jobs also wait for the earlier jobs named
+     * in their JOBSET_JOB::m_dependsOn.  Job handlers must not need the UI thread, so this is
+     * only for use from the command line.
+     */
+    void SetParallel( bool aParallel ) { m_parallel = aParallel; }
+
 private:
+    int runJob( const JOBSET_JOB& aJob, REPORTER* aReporter );
     int runSpecialExecute( const JOBSET_JOB* aJob, PROJECT* aProject );
     int runSpecialCopyFiles( const JOBSET_JOB* aJob, PROJECT* aProject );
 
@@ -45,4 +58,5 @@ private:
     JOBSET*         m_jobsFile;
     REPORTER*       m_reporter;
     PROJECT*        m_project;
+    bool            m_parallel;
 };
\ No newline at end of file
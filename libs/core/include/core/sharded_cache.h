@@ -0,0 +1,256 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SHARDED_CACHE_H
+#define SHARDED_CACHE_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+/**
+ * A thread-safe hash map for memoizing results computed by many threads at once.
+ *
+ * Entries are spread over a number of independently locked shards, so that readers and writers
+ * working on different keys rarely wait on each other.  Lookups take a shared lock on a single
+ * shard; insertions take an exclusive lock on a single shard.
+ *
+ * A cache may be given a maximum size.  Each shard then keeps its entries in two generations:
+ * when the current generation is full the previous one is dropped and the current one takes
+ * its place.  Entries found in the previous generation move back to the current one, so
+ * entries in use are kept while the rest are eventually evicted, much as with an LRU list
+ * but without having to update one on every lookup.
+ *
+ * Values are copied in and out, so they should be cheap to copy.
+ */
+template <typename KEY, typename VALUE, typename HASH = std::hash<KEY>, size_t SHARD_COUNT = 64>
+class SHARDED_CACHE
+{
+public:
+    /**
+     * @param aMaxSize is the most entries the cache holds, or 0 for no limit.
+     */
+    SHARDED_CACHE( size_t aMaxSize = 0 ) :
+            m_generationSize( aMaxSize ? std::max<size_t>( 1, aMaxSize / ( 2 * SHARD_COUNT ) )
+                                       : 0 ),
+            m_size( 0 )
+    {
+    }
+
+    SHARDED_CACHE( const SHARDED_CACHE& ) = delete;
+    SHARDED_CACHE& operator=( const SHARDED_CACHE& ) = delete;
+
+    /**
+     * Look up \a aKey.
+     *
+     * @return true and fill \a aValue if the key is present.
+     */
+    bool Get( const KEY& aKey, VALUE& aValue ) const
+    {
+        size_t       hash = HASH()( aKey );
+        const SHARD& shard = m_shards[ shardIndex( hash ) ];
+
+        std::shared_lock<std::shared_mutex> readLock( shard.m_mutex );
+
+        auto it = shard.m_map.find( aKey );
+
+        if( it == shard.m_map.end() )
+        {
+            it = shard.m_previous.find( aKey );
+
+            if( it == shard.m_previous.end() )
+                return false;
+        }
+
+        aValue = it->second;
+        return true;
+    }
+
+    /**
+     * Insert or replace the value for \a aKey.
+     */
+    void Set( const KEY& aKey, const VALUE& aValue )
+    {
+        size_t hash = HASH()( aKey );
+        SHARD& shard = m_shards[ shardIndex( hash ) ];
+
+        std::unique_lock<std::shared_mutex> writeLock( shard.m_mutex );
+
+        auto it = shard.m_map.find( aKey );
+
+        if( it != shard.m_map.end() )
+            it->second = aValue;
+        else if( !promote( shard, aKey, &aValue ) )
+            insert( shard, aKey, aValue );
+    }
+
+    /**
+     * Return the value for \a aKey, calling \a aCompute to create it if it isn't present.
+     *
+     * \a aCompute is called without any lock held, so it may itself use the cache.  If two
+     * threads miss on the same key at once both will compute it, and the first result stored
+     * wins.
+     */
+    template <typename FUNC>
+    VALUE GetOrCompute( const KEY& aKey, FUNC&& aCompute, bool* aHit = nullptr )
+    {
+        size_t hash = HASH()( aKey );
+        SHARD& shard = m_shards[ shardIndex( hash ) ];
+        bool   inPrevious = false;
+
+        {
+            std::shared_lock<std::shared_mutex> readLock( shard.m_mutex );
+
+            auto it = shard.m_map.find( aKey );
+
+            if( it != shard.m_map.end() )
+            {
+                if( aHit )
+                    *aHit = true;
+
+                return it->second;
+            }
+
+            inPrevious = shard.m_previous.count( aKey ) > 0;
+        }
+
+        if( inPrevious )
+        {
+            std::unique_lock<std::shared_mutex> writeLock( shard.m_mutex );
+
+            auto it = shard.m_map.find( aKey );
+
+            if( it != shard.m_map.end() || promote( shard, aKey, nullptr, &it ) )
+            {
+                if( aHit )
+                    *aHit = true;
+
+                return it->second;
+            }
+        }
+
+        if( aHit )
+            *aHit = false;
+
+        VALUE value = aCompute();
+
+        std::unique_lock<std::shared_mutex> writeLock( shard.m_mutex );
+
+        auto it = shard.m_map.find( aKey );
+
+        if( it != shard.m_map.end() || promote( shard, aKey, nullptr, &it ) )
+            return it->second;
+
+        return insert( shard, aKey, std::move( value ) )->second;
+    }
+
+    /**
+     * Remove all entries.  Must not be called while other threads are using the cache if
+     * they expect to see a consistent view across shards.
+     */
+    void Clear()
+    {
+        for( SHARD& shard : m_shards )
+        {
+            std::unique_lock<std::shared_mutex> writeLock( shard.m_mutex );
+            shard.m_map.clear();
+            shard.m_previous.clear();
+        }
+
+        m_size.store( 0, std::memory_order_relaxed );
+    }
+
+    bool Empty() const { return m_size.load( std::memory_order_relaxed ) == 0; }
+
+    size_t Size() const { return m_size.load( std::memory_order_relaxed ); }
+
+private:
+    using MAP = std::unordered_map<KEY, VALUE, HASH>;
+
+    // Keep each shard on its own cache line so that locking one doesn't invalidate another.
+    struct alignas( 64 ) SHARD
+    {
+        mutable std::shared_mutex m_mutex;
+        MAP                       m_map;         // the current generation
+        MAP                       m_previous;    // only used for caches with a maximum size
+    };
+
+    static size_t shardIndex( size_t aHash )
+    {
+        // The low bits also pick the bucket inside the shard's map; mix in higher bits so that
+        // the two don't correlate.
+        return ( aHash ^ ( aHash >> 16 ) ) % SHARD_COUNT;
+    }
+
+    /**
+     * Add a key which is in neither generation of \a aShard, starting a new generation if the
+     * current one is full.  The shard's write lock must be held.
+     */
+    template <typename V>
+    typename MAP::iterator insert( SHARD& aShard, const KEY& aKey, V&& aValue )
+    {
+        if( m_generationSize && aShard.m_map.size() >= m_generationSize )
+        {
+            m_size.fetch_sub( aShard.m_previous.size(), std::memory_order_relaxed );
+            aShard.m_previous.clear();
+            std::swap( aShard.m_previous, aShard.m_map );
+        }
+
+        m_size.fetch_add( 1, std::memory_order_relaxed );
+        return aShard.m_map.emplace( aKey, std::forward<V>( aValue ) ).first;
+    }
+
+    /**
+     * Move \a aKey from the previous generation of \a aShard to the current one, replacing its
+     * value with \a aValue if given.  The shard's write lock must be held.
+     *
+     * @return false if the key isn't in the previous generation.
+     */
+    bool promote( SHARD& aShard, const KEY& aKey, const VALUE* aValue,
+                  typename MAP::iterator* aResult = nullptr )
+    {
+        auto node = aShard.m_previous.extract( aKey );
+
+        if( node.empty() )
+            return false;
+
+        if( aValue )
+            node.mapped() = *aValue;
+
+        m_size.fetch_sub( 1, std::memory_order_relaxed );
+
+        typename MAP::iterator it = insert( aShard, aKey, std::move( node.mapped() ) );
+
+        if( aResult )
+            *aResult = it;
+
+        return true;
+    }
+
+    std::array<SHARD, SHARD_COUNT> m_shards;
+    const size_t                   m_generationSize;
+    std::atomic<size_t>            m_size;
+};
+
+#endif // SHARDED_CACHE_H
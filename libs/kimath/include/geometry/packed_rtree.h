@@ -0,0 +1,421 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef PACKED_RTREE_H
+#define PACKED_RTREE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+
+/**
+ * A static R-tree of integer boxes, bulk loaded in Hilbert curve order.
+ *
+ * Boxes are stored as separate arrays of coordinates, level by level, and each node holds up
+ * to #NODE_SIZE children in consecutive slots.  A search walks the arrays rather than chasing
+ * node pointers, and the children of a node are tested in one branch-free loop which the
+ * compiler can vectorize.
+ *
+ * Items inserted after the tree is built go into an overlay which is searched linearly.  The
+ * tree is rebuilt on the next search or iteration once the overlay grows past a fraction of
+ * the tree, so the cost of a rebuild is spread over many insertions.  Call Build() once all
+ * items are inserted to avoid rebuilding from a search at all.
+ *
+ * Like the RTree it replaces, inserting isn't thread safe but concurrent searches and
+ * iterations are.
+ */
+template <class DATA>
+class PACKED_RTREE
+{
+public:
+    static constexpr int NODE_SIZE = 16;
+
+    PACKED_RTREE() :
+            m_packedCount( 0 ),
+            m_needsBuild( false )
+    {}
+
+    PACKED_RTREE( const PACKED_RTREE& ) = delete;
+    PACKED_RTREE& operator=( const PACKED_RTREE& ) = delete;
+
+    /**
+     * Add an item with the box from \a aMin to \a aMax (inclusive).
+     */
+    void Insert( const int aMin[2], const int aMax[2], const DATA& aData )
+    {
+        m_items.push_back( aData );
+        m_minX.push_back( aMin[0] );
+        m_minY.push_back( aMin[1] );
+        m_maxX.push_back( aMax[0] );
+        m_maxY.push_back( aMax[1] );
+
+        size_t overlay = m_items.size() - m_packedCount;
+
+        if( overlay > MIN_OVERLAY && overlay * OVERLAY_RATIO > m_packedCount )
+            m_needsBuild.store( true, std::memory_order_release );
+    }
+
+    /**
+     * Pack all items inserted so far into the tree.
+     */
+    void Build()
+    {
+        if( m_packedCount < m_items.size() )
+        {
+            m_needsBuild.store( true, std::memory_order_release );
+            build();
+        }
+    }
+
+    /**
+     * Remove all items.
+     */
+    void RemoveAll()
+    {
+        m_items.clear();
+        m_minX.clear();
+        m_minY.clear();
+        m_maxX.clear();
+        m_maxY.clear();
+        m_levels.clear();
+        m_nodeMinX.clear();
+        m_nodeMinY.clear();
+        m_nodeMaxX.clear();
+        m_nodeMaxY.clear();
+        m_packedCount = 0;
+        m_needsBuild.store( false, std::memory_order_release );
+    }
+
+    /**
+     * Visit each item whose box overlaps the box from \a aMin to \a aMax.
+     *
+     * @param aVisitor is called with each item and returns false to stop the search.
+     * @return the number of items visited.
+     */
+    template <class VISITOR>
+    int Search( const int aMin[2], const int aMax[2], VISITOR&& aVisitor ) const
+    {
+        ensureBuilt();
+
+        int  count = 0;
+        bool stop = false;
+
+        auto visitItems =
+                [&]( size_t aFirst, size_t aLast )
+                {
+                    for( size_t ii = aFirst; ii < aLast && !stop; ++ii )
+                    {
+                        if( m_minX[ii] <= aMax[0] && m_maxX[ii] >= aMin[0]
+                                && m_minY[ii] <= aMax[1] && m_maxY[ii] >= aMin[1] )
+                        {
+                            count++;
+
+                            if( !aVisitor( m_items[ii] ) )
+                                stop = true;
+                        }
+                    }
+                };
+
+        if( m_packedCount > 0 )
+        {
+            struct STACK_ENTRY
+            {
+                size_t level;
+                size_t node;
+            };
+
+            std::vector<STACK_ENTRY> stack;
+            stack.reserve( 64 );
+            stack.push_back( { m_levels.size() - 1, 0 } );
+
+            while( !stack.empty() && !stop )
+            {
+                STACK_ENTRY entry = stack.back();
+                stack.pop_back();
+
+                size_t first = entry.node * NODE_SIZE;
+
+                if( entry.level == 0 )
+                {
+                    visitItems( first, std::min( first + NODE_SIZE, m_packedCount ) );
+                    continue;
+                }
+
+                const LEVEL& children = m_levels[entry.level - 1];
+                size_t       last = std::min( first + NODE_SIZE, children.count );
+                size_t       base = children.offset + first;
+                size_t       width = last - first;
+                bool         hit[NODE_SIZE];
+
+                for( size_t ii = 0; ii < width; ++ii )
+                {
+                    hit[ii] = ( m_nodeMinX[base + ii] <= aMax[0] )
+                              & ( m_nodeMaxX[base + ii] >= aMin[0] )
+                              & ( m_nodeMinY[base + ii] <= aMax[1] )
+                              & ( m_nodeMaxY[base + ii] >= aMin[1] );
+                }
+
+                // Push in reverse so that children are visited in order
+                for( size_t ii = width; ii > 0; --ii )
+                {
+                    if( hit[ii - 1] )
+                        stack.push_back( { entry.level - 1, first + ii - 1 } );
+                }
+            }
+        }
+
+        visitItems( m_packedCount, m_items.size() );
+
+        return count;
+    }
+
+    size_t size() const { return m_items.size(); }
+
+    bool empty() const { return m_items.empty(); }
+
+    using iterator = typename std::vector<DATA>::const_iterator;
+
+    /**
+     * Iterators stay valid while only searches are made, as the tree is built before the first
+     * one is returned.
+     */
+    iterator begin() const
+    {
+        ensureBuilt();
+        return m_items.begin();
+    }
+
+    iterator end() const
+    {
+        ensureBuilt();
+        return m_items.end();
+    }
+
+private:
+    /// The overlay is small enough to scan until it holds this many items...
+    static constexpr size_t MIN_OVERLAY = 32;
+
+    /// ... and this fraction of the packed items.
+    static constexpr size_t OVERLAY_RATIO = 8;
+
+    /// Nodes of one level of the tree, which start at \a offset in the node arrays.
+    struct LEVEL
+    {
+        size_t offset;
+        size_t count;
+    };
+
+    static uint32_t hilbertIndex( uint32_t aX, uint32_t aY )
+    {
+        uint32_t index = 0;
+
+        for( uint32_t s = 1U << 15; s > 0; s >>= 1 )
+        {
+            uint32_t rx = ( aX & s ) > 0;
+            uint32_t ry = ( aY & s ) > 0;
+
+            index += s * s * ( ( 3 * rx ) ^ ry );
+
+            // Rotate the quadrant so that the curve is continuous
+            if( ry == 0 )
+            {
+                if( rx == 1 )
+                {
+                    aX = s - 1 - ( aX & ( s - 1 ) );
+                    aY = s - 1 - ( aY & ( s - 1 ) );
+                }
+
+                std::swap( aX, aY );
+            }
+        }
+
+        return index;
+    }
+
+    void ensureBuilt() const
+    {
+        if( m_needsBuild.load( std::memory_order_acquire ) )
+            const_cast<PACKED_RTREE*>( this )->build();
+    }
+
+    void build()
+    {
+        std::lock_guard<std::mutex> lock( m_buildMutex );
+
+        // Another thread may have built the tree while we waited
+        if( !m_needsBuild.load( std::memory_order_relaxed ) )
+            return;
+
+        const size_t count = m_items.size();
+
+        int64_t minX = INT32_MAX, minY = INT32_MAX;
+        int64_t maxX = INT32_MIN, maxY = INT32_MIN;
+
+        for( size_t ii = 0; ii < count; ++ii )
+        {
+            minX = std::min<int64_t>( minX, m_minX[ii] );
+            minY = std::min<int64_t>( minY, m_minY[ii] );
+            maxX = std::max<int64_t>( maxX, m_maxX[ii] );
+            maxY = std::max<int64_t>( maxY, m_maxY[ii] );
+        }
+
+        // Order the items along a Hilbert curve through their centres
+        const int64_t         spanX = std::max<int64_t>( 1, maxX - minX );
+        const int64_t         spanY = std::max<int64_t>( 1, maxY - minY );
+        std::vector<uint32_t> keys( count );
+        std::vector<size_t>   order( count );
+
+        for( size_t ii = 0; ii < count; ++ii )
+        {
+            int64_t cx = ( int64_t( m_minX[ii] ) + m_maxX[ii] ) / 2 - minX;
+            int64_t cy = ( int64_t( m_minY[ii] ) + m_maxY[ii] ) / 2 - minY;
+
+            keys[ii] = hilbertIndex( static_cast<uint32_t>( cx * 0xFFFF / spanX ),
+                                     static_cast<uint32_t>( cy * 0xFFFF / spanY ) );
+        }
+
+        std::iota( order.begin(), order.end(), 0 );
+        std::stable_sort( order.begin(), order.end(),
+                          [&]( size_t aLhs, size_t aRhs )
+                          {
+                              return keys[aLhs] < keys[aRhs];
+                          } );
+
+        auto permute =
+                [&]( auto& aArray )
+                {
+                    std::remove_reference_t<decltype( aArray )> sorted;
+                    sorted.reserve( count );
+
+                    for( size_t ii : order )
+                        sorted.push_back( aArray[ii] );
+
+                    aArray.swap( sorted );
+                };
+
+        permute( m_items );
+        permute( m_minX );
+        permute( m_minY );
+        permute( m_maxX );
+        permute( m_maxY );
+
+        // Build the levels bottom up, each node covering NODE_SIZE consecutive children
+        m_levels.clear();
+        m_nodeMinX.clear();
+        m_nodeMinY.clear();
+        m_nodeMaxX.clear();
+        m_nodeMaxY.clear();
+
+        // The upper levels read their children from the node arrays as they are appended to,
+        // so room for every level is reserved first
+        size_t nodeCount = 0;
+        size_t levelCount = count;
+
+        do
+        {
+            levelCount = ( levelCount + NODE_SIZE - 1 ) / NODE_SIZE;
+            nodeCount += levelCount;
+        } while( levelCount > 1 );
+
+        m_nodeMinX.reserve( nodeCount );
+        m_nodeMinY.reserve( nodeCount );
+        m_nodeMaxX.reserve( nodeCount );
+        m_nodeMaxY.reserve( nodeCount );
+
+        const int* childMinX = m_minX.data();
+        const int* childMinY = m_minY.data();
+        const int* childMaxX = m_maxX.data();
+        const int* childMaxY = m_maxY.data();
+        size_t     childCount = count;
+        size_t     childOffset = 0;
+
+        while( true )
+        {
+            LEVEL level;
+            level.offset = m_nodeMinX.size();
+            level.count = ( childCount + NODE_SIZE - 1 ) / NODE_SIZE;
+
+            for( size_t node = 0; node < level.count; ++node )
+            {
+                size_t first = childOffset + node * NODE_SIZE;
+                size_t last = std::min( first + NODE_SIZE, childOffset + childCount );
+
+                int nMinX = INT32_MAX, nMinY = INT32_MAX;
+                int nMaxX = INT32_MIN, nMaxY = INT32_MIN;
+
+                for( size_t ii = first; ii < last; ++ii )
+                {
+                    nMinX = std::min( nMinX, childMinX[ii] );
+                    nMinY = std::min( nMinY, childMinY[ii] );
+                    nMaxX = std::max( nMaxX, childMaxX[ii] );
+                    nMaxY = std::max( nMaxY, childMaxY[ii] );
+                }
+
+                m_nodeMinX.push_back( nMinX );
+                m_nodeMinY.push_back( nMinY );
+                m_nodeMaxX.push_back( nMaxX );
+                m_nodeMaxY.push_back( nMaxY );
+            }
+
+            m_levels.push_back( level );
+
+            if( level.count <= 1 )
+                break;
+
+            childOffset = level.offset;
+            childCount = level.count;
+            childMinX = m_nodeMinX.data();
+            childMinY = m_nodeMinY.data();
+            childMaxX = m_nodeMaxX.data();
+            childMaxY = m_nodeMaxY.data();
+        }
+
+        m_packedCount = count;
+        m_needsBuild.store( false, std::memory_order_release );
+    }
+
+private:
+    // Items in tree order, followed by the overlay
+    std::vector<DATA> m_items;
+    std::vector<int>  m_minX;
+    std::vector<int>  m_minY;
+    std::vector<int>  m_maxX;
+    std::vector<int>  m_maxY;
+    size_t            m_packedCount;
+
+    // Boxes of the nodes above the items, level by level from the bottom up
+    std::vector<LEVEL> m_levels;
+    std::vector<int>   m_nodeMinX;
+    std::vector<int>   m_nodeMinY;
+    std::vector<int>   m_nodeMaxX;
+    std::vector<int>   m_nodeMaxY;
+
+    std::atomic<bool>  m_needsBuild;
+    std::mutex         m_buildMutex;
+};
+
+#endif // PACKED_RTREE_H
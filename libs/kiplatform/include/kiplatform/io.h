@@ -20,6 +20,7 @@
 #ifndef KIPLATFORM_IO_H_
 #define KIPLATFORM_IO_H_
 
+#include <cstddef>
 #include <stdio.h>
 
 class wxString;
@@ -52,6 +53,28 @@ namespace IO
     */
     bool IsFileHidden( const wxString& aFileName );
 
+    /**
+     * Map the whole of a file read-only into memory.
+     *
+     * The size of the file is checked again once it is mapped, and the mapping fails if the
+     * file changed size in between.  On Windows a mapped file can't be truncated.  Elsewhere,
+     * truncating the file while it is mapped makes reading the pages past its new end raise
+     * SIGBUS, which can't be turned into an IO_ERROR.  Keep a file mapped only for as long as
+     * it is being read.
+     *
+     * @param aPath is the file to map.
+     * @param aSize is set to the size of the file in bytes.
+     * @param aHandle is set to a platform handle which must be passed to UnmapFile().
+     * @return the start of the mapped file, or nullptr if the file couldn't be mapped
+     *         (including if it is empty or changed size while being mapped).
+     */
+    const char* MapFile( const wxString& aPath, size_t& aSize, void*& aHandle );
+
+    /**
+     * Release a mapping made by MapFile().
+     */
+    void UnmapFile( const char* aData, size_t aSize, void* aHandle );
+
     /**
      * Adjusts a filename to be a long path compatible.
      * This is a no-op on non-Windows platforms.
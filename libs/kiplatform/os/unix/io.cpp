@@ -25,6 +25,7 @@
 #include <wx/filename.h>
 
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -75,6 +76,60 @@ bool KIPLATFORM::IO::IsFileHidden( const wxString& aFileName )
 }
 
 
+const char* KIPLATFORM::IO::MapFile( const wxString& aPath, size_t& aSize, void*& aHandle )
+{
+    aSize = 0;
+    aHandle = nullptr;
+
+    int fd = open( aPath.fn_str(), O_RDONLY );
+
+    if( fd < 0 )
+        return nullptr;
+
+    struct stat fileStat;
+
+    if( fstat( fd, &fileStat ) != 0 || fileStat.st_size <= 0 )
+    {
+        close( fd );
+        return nullptr;
+    }
+
+    void* data = mmap( nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+
+    if( data == MAP_FAILED )
+    {
+        close( fd );
+        return nullptr;
+    }
+
+    // A file being written to may have changed size since it was measured.  Pages past its
+    // end would raise SIGBUS when read, so let the caller read it the ordinary way instead.
+    struct stat mappedStat;
+
+    if( fstat( fd, &mappedStat ) != 0 || mappedStat.st_size != fileStat.st_size )
+    {
+        munmap( data, fileStat.st_size );
+        close( fd );
+        return nullptr;
+    }
+
+    // The mapping holds its own reference to the file
+    close( fd );
+
+    posix_madvise( data, fileStat.st_size, POSIX_MADV_SEQUENTIAL );
+
+    aSize = fileStat.st_size;
+    return static_cast<const char*>( data );
+}
+
+
+void KIPLATFORM::IO::UnmapFile( const char* aData, size_t aSize, void* aHandle )
+{
+    if( aData )
+        munmap( const_cast<char*>( aData ), aSize );
+}
+
+
 void KIPLATFORM::IO::LongPathAdjustment( wxFileName& aFilename )
 {
     // no-op
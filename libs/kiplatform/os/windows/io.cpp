@@ -126,6 +126,68 @@ bool KIPLATFORM::IO::IsFileHidden( const wxString& aFileName )
 }
 
 
+const char* KIPLATFORM::IO::MapFile( const wxString& aPath, size_t& aSize, void*& aHandle )
+{
+    aSize = 0;
+    aHandle = nullptr;
+
+    HANDLE hFile = CreateFileW( aPath.wc_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                                OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL );
+
+    if( hFile == INVALID_HANDLE_VALUE )
+        return nullptr;
+
+    LARGE_INTEGER fileSize;
+
+    if( !GetFileSizeEx( hFile, &fileSize ) || fileSize.QuadPart <= 0 )
+    {
+        CloseHandle( hFile );
+        return nullptr;
+    }
+
+    HANDLE hMapping = CreateFileMappingW( hFile, NULL, PAGE_READONLY, 0, 0, NULL );
+
+    // A file being written to may have changed size since it was measured.  Once mapped it
+    // can no longer be truncated, so this is the last point at which it can change.
+    LARGE_INTEGER mappedSize;
+
+    if( hMapping
+        && ( !GetFileSizeEx( hFile, &mappedSize ) || mappedSize.QuadPart != fileSize.QuadPart ) )
+    {
+        CloseHandle( hMapping );
+        hMapping = NULL;
+    }
+
+    // The mapping object holds its own reference to the file
+    CloseHandle( hFile );
+
+    if( !hMapping )
+        return nullptr;
+
+    void* data = MapViewOfFile( hMapping, FILE_MAP_READ, 0, 0, 0 );
+
+    if( !data )
+    {
+        CloseHandle( hMapping );
+        return nullptr;
+    }
+
+    aSize = static_cast<size_t>( fileSize.QuadPart );
+    aHandle = hMapping;
+    return static_cast<const char*>( data );
+}
+
+
+void KIPLATFORM::IO::UnmapFile( const char* aData, size_t aSize, void* aHandle )
+{
+    if( aData )
+        UnmapViewOfFile( aData );
+
+    if( aHandle )
+        CloseHandle( static_cast<HANDLE>( aHandle ) );
+}
+
+
 void KIPLATFORM::IO::LongPathAdjustment( wxFileName& aFilename )
 {
     // dont shortcut this for shorter lengths as there are uses like directory
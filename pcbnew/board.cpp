@@ -29,6 +29,7 @@
 
 #include <wx/log.h>
 
+#include <drc/drc_engine.h>
 #include <drc/drc_rtree.h>
 #include <board_design_settings.h>
 #include <board_commit.h>
@@ -255,26 +256,32 @@ void BOARD::IncrementTimeStamp()
 {
     m_timeStamp++;
 
-    if( !m_IntersectsAreaCache.empty()
-        || !m_EnclosedByAreaCache.empty()
-        || !m_IntersectsCourtyardCache.empty()
-        || !m_IntersectsFCourtyardCache.empty()
-        || !m_IntersectsBCourtyardCache.empty()
-        || !m_LayerExpressionCache.empty()
-        || !m_ZoneBBoxCache.empty()
+    InvalidateCaches();
+}
+
+
+void BOARD::InvalidateCaches()
+{
+    if( !m_IntersectsAreaCache.Empty()
+        || !m_EnclosedByAreaCache.Empty()
+        || !m_IntersectsCourtyardCache.Empty()
+        || !m_IntersectsFCourtyardCache.Empty()
+        || !m_IntersectsBCourtyardCache.Empty()
+        || !m_LayerExpressionCache.Empty()
+        || !m_ZoneBBoxCache.Empty()
         || m_CopperItemRTreeCache
         || m_maxClearanceValue.has_value() )
     {
-        std::unique_lock<std::shared_mutex> writeLock( m_CachesMutex );
+        m_IntersectsAreaCache.Clear();
+        m_EnclosedByAreaCache.Clear();
+        m_IntersectsCourtyardCache.Clear();
+        m_IntersectsFCourtyardCache.Clear();
+        m_IntersectsBCourtyardCache.Clear();
+        m_LayerExpressionCache.Clear();
 
-        m_IntersectsAreaCache.clear();
-        m_EnclosedByAreaCache.clear();
-        m_IntersectsCourtyardCache.clear();
-        m_IntersectsFCourtyardCache.clear();
-        m_IntersectsBCourtyardCache.clear();
-        m_LayerExpressionCache.clear();
+        m_ZoneBBoxCache.Clear();
 
-        m_ZoneBBoxCache.clear();
+        std::unique_lock<std::shared_mutex> writeLock( m_CachesMutex );
 
         m_CopperItemRTreeCache = nullptr;
 
@@ -2129,7 +2136,9 @@ void BOARD::SynchronizeProperties()
 {
     wxCHECK( m_project, /*void*/ );
 
-    if( !m_project->IsNullProject() )
+    // Jobs run at the same time as each other synchronize properties which are already in sync,
+    // so only write them when they have changed
+    if( !m_project->IsNullProject() && m_properties != m_project->GetTextVars() )
         SetProperties( m_project->GetTextVars() );
 }
 
@@ -2147,6 +2156,11 @@ void BOARD::SynchronizeNetsAndNetClasses( bool aResetTrackAndViaSizes )
     for( NETINFO_ITEM* net : m_NetInfo )
         net->SetNetClass( bds.m_NetSettings->GetEffectiveNetClass( net->GetNetname() ) );
 
+    // Net classes can change without a commit, so constraints resolved for the old ones
+    // are no longer valid
+    if( bds.m_DRCEngine )
+        bds.m_DRCEngine->ClearConstraintCache();
+
     if( aResetTrackAndViaSizes )
     {
         // Set initial values for custom track width & via size to match the default
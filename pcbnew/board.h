@@ -31,6 +31,7 @@
 #include <embedded_files.h>
 #include <common.h> // Needed for stl hash extensions
 #include <convert_shape_list_to_polygon.h> // for OUTLINE_ERROR_HANDLER
+#include <core/sharded_cache.h>
 #include <hash.h>
 #include <layer_ids.h>
 #include <lset.h>
@@ -40,6 +41,7 @@
 #include <title_block.h>
 #include <tools/pcb_selection.h>
 #include <shared_mutex>
+#include <atomic>
 #include <project.h>
 #include <list>
 
@@ -115,6 +117,18 @@ struct PTR_PTR_LAYER_CACHE_KEY
     }
 };
 
+/**
+ * Hit and miss counts for one of the board's run-time caches, reported by DRC profiling.
+ */
+struct BOARD_CACHE_STATS
+{
+    std::atomic<int64_t> m_Hits{ 0 };
+    std::atomic<int64_t> m_Misses{ 0 };
+
+    void Hit() { m_Hits.fetch_add( 1, std::memory_order_relaxed ); }
+    void Miss() { m_Misses.fetch_add( 1, std::memory_order_relaxed ); }
+};
+
 namespace std
 {
     template <>
@@ -314,8 +328,17 @@ public:
      */
     BOARD_USE GetBoardUse() const { return m_boardUse; }
 
+    /**
+     * Mark the board as modified, invalidating all run-time caches (see InvalidateCaches()).
+     */
     void IncrementTimeStamp();
 
+    /**
+     * Discard the run-time caches (rule function results, zone bounding boxes, DRC R-trees,
+     * etc.).  Must not be called while DRC or zone filling is running.
+     */
+    void InvalidateCaches();
+
     int GetTimeStamp() const { return m_timeStamp; }
 
     /**
@@ -480,6 +503,14 @@ public:
      */
     BOARD_ITEM* GetItem( const KIID& aID ) const;
 
+    /**
+     * @return the map of every item owned by the board (including footprint children) by ID.
+     */
+    const std::unordered_map<KIID, BOARD_ITEM*>& GetItemByIdCache() const
+    {
+        return m_itemByIdCache;
+    }
+
     void FillItemMap( std::map<KIID, EDA_ITEM*>& aMap );
 
     /**
@@ -1326,18 +1357,25 @@ public:
 
 public:
     // ------------ Run-time caches -------------
+    // The memoization caches below are filled concurrently by DRC worker threads, so each is
+    // sharded with its own locks.  m_CachesMutex guards only the R-tree caches (which are
+    // built before the workers start) and m_maxClearanceValue.
     mutable std::shared_mutex                             m_CachesMutex;
-    std::unordered_map<PTR_PTR_CACHE_KEY, bool>           m_IntersectsCourtyardCache;
-    std::unordered_map<PTR_PTR_CACHE_KEY, bool>           m_IntersectsFCourtyardCache;
-    std::unordered_map<PTR_PTR_CACHE_KEY, bool>           m_IntersectsBCourtyardCache;
-    std::unordered_map<PTR_PTR_LAYER_CACHE_KEY, bool>     m_IntersectsAreaCache;
-    std::unordered_map<PTR_PTR_LAYER_CACHE_KEY, bool>     m_EnclosedByAreaCache;
-    std::unordered_map< wxString, LSET >                  m_LayerExpressionCache;
+    SHARDED_CACHE<PTR_PTR_CACHE_KEY, bool>                m_IntersectsCourtyardCache;
+    SHARDED_CACHE<PTR_PTR_CACHE_KEY, bool>                m_IntersectsFCourtyardCache;
+    SHARDED_CACHE<PTR_PTR_CACHE_KEY, bool>                m_IntersectsBCourtyardCache;
+    SHARDED_CACHE<PTR_PTR_LAYER_CACHE_KEY, bool>          m_IntersectsAreaCache;
+    SHARDED_CACHE<PTR_PTR_LAYER_CACHE_KEY, bool>          m_EnclosedByAreaCache;
+    SHARDED_CACHE<wxString, LSET, std::hash<wxString>, 8> m_LayerExpressionCache;
     std::unordered_map<ZONE*, std::unique_ptr<DRC_RTREE>> m_CopperZoneRTreeCache;
     std::shared_ptr<DRC_RTREE>                            m_CopperItemRTreeCache;
-    mutable std::unordered_map<const ZONE*, BOX2I>        m_ZoneBBoxCache;
+    mutable SHARDED_CACHE<const ZONE*, BOX2I>             m_ZoneBBoxCache;
     mutable std::optional<int>                            m_maxClearanceValue;
 
+    BOARD_CACHE_STATS                                     m_IntersectsCourtyardCacheStats;
+    BOARD_CACHE_STATS                                     m_IntersectsAreaCacheStats;
+    BOARD_CACHE_STATS                                     m_EnclosedByAreaCacheStats;
+
     // ------------ DRC caches -------------
     std::vector<ZONE*>    m_DRCZones;
     std::vector<ZONE*>    m_DRCCopperZones;
@@ -128,13 +128,18 @@ COMMIT& BOARD_COMMIT::Stage( const PICKED_ITEMS_LIST& aItems, UNDO_REDO aModFlag
 }
 
 
-void BOARD_COMMIT::propagateDamage( BOARD_ITEM* aChangedItem, std::vector<ZONE*>* aStaleZones,
+void BOARD_COMMIT::propagateDamage( BOARD_ITEM* aChangedItem,
+                                    std::vector<std::pair<ZONE*, BOX2I>>* aStaleZones,
                                     std::vector<PCB_SHAPE*>* aStaleHatchedShapes )
 {
     wxCHECK( aChangedItem, /* void */ );
 
+    // A changed zone damages the whole of its own fill
     if( aStaleZones && aChangedItem->Type() == PCB_ZONE_T )
-        aStaleZones->push_back( static_cast<ZONE*>( aChangedItem ) );
+    {
+        ZONE* zone = static_cast<ZONE*>( aChangedItem );
+        aStaleZones->emplace_back( zone, zone->GetBoundingBox() );
+    }
 
     aChangedItem->RunOnChildren( std::bind( &BOARD_COMMIT::propagateDamage, this, _1, aStaleZones,
                                             aStaleHatchedShapes ) );
@@ -160,7 +165,7 @@ void BOARD_COMMIT::propagateDamage( BOARD_ITEM* aChangedItem, std::vector<ZONE*>
                 if( ( zone->GetLayerSet() & damageLayers ).any()
                         && zone->GetBoundingBox().Intersects( damageBBox ) )
                 {
-                    aStaleZones->push_back( zone );
+                    aStaleZones->emplace_back( zone, damageBBox );
                 }
             }
         }
@@ -235,8 +240,8 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
     std::vector<BOARD_ITEM*> staleTeardropPadsAndVias;
     std::set<PCB_TRACK*>     staleTeardropTracks;
     PCB_GROUP*               addedGroup = nullptr;
-    std::vector<ZONE*>       staleZonesStorage;
-    std::vector<ZONE*>*      staleZones = nullptr;
+    std::vector<std::pair<ZONE*, BOX2I>>  staleZonesStorage;
+    std::vector<std::pair<ZONE*, BOX2I>>* staleZones = nullptr;
     std::vector<PCB_SHAPE*>  staleHatchedShapes;
 
     if( Empty() )
@@ -244,6 +249,10 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
 
     undoList.SetDescription( aMessage );
 
+    // Items have already been modified, so clear caches before anything below (such as the
+    // teardrop manager) resolves rules against them.
+    board->IncrementTimeStamp();
+
     TEARDROP_MANAGER                   teardropMgr( board, m_toolMgr );
     std::shared_ptr<CONNECTIVITY_DATA> connectivity = board->GetConnectivity();
 
@@ -648,8 +657,8 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
     {
         ZONE_FILLER_TOOL* zoneFillerTool = m_toolMgr->GetTool<ZONE_FILLER_TOOL>();
 
-        for( ZONE* zone : *staleZones )
-            zoneFillerTool->DirtyZone( zone );
+        for( const auto& [ zone, damageBBox ] : *staleZones )
+            zoneFillerTool->DirtyZone( zone, damageBBox );
 
         m_toolMgr->PostAction( PCB_ACTIONS::zoneFillDirty );
     }
@@ -27,6 +27,7 @@
 #define BOARD_COMMIT_H
 
 #include <commit.h>
+#include <math/box2.h>
 
 class BOARD_ITEM;
 class PCB_SHAPE;
@@ -75,7 +76,11 @@ private:
 
     EDA_ITEM* makeImage( EDA_ITEM* aItem ) const override;
 
-    void propagateDamage( BOARD_ITEM* aItem, std::vector<ZONE*>* aStaleZones,
+    /**
+     * Collect the zones (and the region of each) and hatched shapes damaged by a change to
+     * \a aItem.
+     */
+    void propagateDamage( BOARD_ITEM* aItem, std::vector<std::pair<ZONE*, BOX2I>>* aStaleZones,
                           std::vector<PCB_SHAPE*>* aStaleHatchedShapes );
 
 private:
@@ -23,6 +23,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <mutex>
 #include <unordered_set>
 
 #include <trigo.h>
@@ -774,6 +775,11 @@ bool BuildBoardPolygonOutlines( BOARD* aBoard, SHAPE_POLY_SET& aOutlines, int aE
     SHAPE_POLY_SET     fpHoles;
     bool               success = false;
 
+    // Chaining marks the board's shapes with SKIP_STRUCT, so outlines can't be built by several
+    // threads at once, such as by jobs plotting the same board
+    static std::mutex           outlinesMutex;
+    std::lock_guard<std::mutex> lock( outlinesMutex );
+
     SCOPED_FLAGS_CLEANER cleaner( SKIP_STRUCT );
 
     // Get all the shapes into 'items', then keep only those on layer == Edge_Cuts.
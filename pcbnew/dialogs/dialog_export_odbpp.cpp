@@ -44,10 +44,6 @@
 #include <pcb_io/pcb_io_mgr.h>
 #include <wx/dir.h>
 #include <wx/filedlg.h>
-#include <wx/wfstream.h>
-#include <wx/zipstrm.h>
-#include <wx/tarstrm.h>
-#include <wx/zstream.h>
 
 static wxString s_oemColumn = wxEmptyString;
 
@@ -340,8 +336,6 @@ void DIALOG_EXPORT_ODBPP::GenerateODBPPFiles( const JOB_EXPORT_PCB_ODB& aJob, BO
         return;
     }
 
-    wxFileName tempFile( outputFn.GetFullPath() );
-
     if( aJob.m_compressionMode != JOB_EXPORT_PCB_ODB::ODB_COMPRESSION::NONE )
     {
         if( outputFn.Exists() )
@@ -378,25 +372,11 @@ void DIALOG_EXPORT_ODBPP::GenerateODBPPFiles( const JOB_EXPORT_PCB_ODB& aJob, BO
                 return;
             }
         }
-
-        tempFile.AssignDir( wxFileName::GetTempDir() );
-        tempFile.AppendDir( "kicad" );
-        tempFile.AppendDir( "odb" );
-
-        if( !wxFileName::Mkdir( tempFile.GetFullPath(), wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL ) )
-        {
-            msg.Printf( _( "Cannot create temporary output directory." ) );
-
-            if( aReporter )
-                aReporter->Report( msg, RPT_SEVERITY_ERROR );
-
-            return;
-        }
     }
     else
     {
-        // Test for the output directory of tempFile
-        wxDir testDir( tempFile.GetFullPath() );
+        // Test for the output directory
+        wxDir testDir( outputFn.GetFullPath() );
 
         if( testDir.IsOpened() && ( testDir.HasFiles() || testDir.HasSubDirs() ) )
         {
@@ -404,7 +384,7 @@ void DIALOG_EXPORT_ODBPP::GenerateODBPPFiles( const JOB_EXPORT_PCB_ODB& aJob, BO
             {
                 msg = wxString::Format( _( "Output directory '%s' already exists and is not empty. "
                                            "Do you want to overwrite it?" ),
-                                        tempFile.GetFullPath() );
+                                        outputFn.GetFullPath() );
 
                 KIDIALOG errorDlg( aParentFrame, msg, _( "Confirmation" ),
                                    wxOK | wxCANCEL | wxICON_WARNING );
@@ -413,10 +393,10 @@ void DIALOG_EXPORT_ODBPP::GenerateODBPPFiles( const JOB_EXPORT_PCB_ODB& aJob, BO
                 if( errorDlg.ShowModal() != wxID_OK )
                     return;
 
-                if( !tempFile.Rmdir( wxPATH_RMDIR_RECURSIVE ) )
+                if( !outputFn.Rmdir( wxPATH_RMDIR_RECURSIVE ) )
                 {
                     msg.Printf( _( "Cannot remove existing output directory '%s'." ),
-                                tempFile.GetFullPath() );
+                                outputFn.GetFullPath() );
                     DisplayErrorMessage( aParentFrame, msg );
                     return;
                 }
@@ -424,7 +404,7 @@ void DIALOG_EXPORT_ODBPP::GenerateODBPPFiles( const JOB_EXPORT_PCB_ODB& aJob, BO
             else
             {
                 msg = wxString::Format( _( "Output directory '%s' already exists." ),
-                                        tempFile.GetFullPath() );
+                                        outputFn.GetFullPath() );
 
                 if( aReporter )
                     aReporter->Report( msg, RPT_SEVERITY_ERROR );
@@ -441,6 +421,12 @@ void DIALOG_EXPORT_ODBPP::GenerateODBPPFiles( const JOB_EXPORT_PCB_ODB& aJob, BO
     props["units"] = aJob.m_units == JOB_EXPORT_PCB_ODB::ODB_UNITS::MM ? "mm" : "inch";
     props["sigfig"] = wxString::Format( "%d", aJob.m_precision );
 
+    // Compressed output is written straight into the archive as it is generated
+    if( aJob.m_compressionMode == JOB_EXPORT_PCB_ODB::ODB_COMPRESSION::ZIP )
+        props["compress"] = "zip";
+    else if( aJob.m_compressionMode == JOB_EXPORT_PCB_ODB::ODB_COMPRESSION::TGZ )
+        props["compress"] = "tgz";
+
     auto saveFile = [&]() -> bool
     {
         try
@@ -448,7 +434,7 @@ void DIALOG_EXPORT_ODBPP::GenerateODBPPFiles( const JOB_EXPORT_PCB_ODB& aJob, BO
             IO_RELEASER<PCB_IO> pi( PCB_IO_MGR::PluginFind( PCB_IO_MGR::ODBPP ) );
             pi->SetReporter( aReporter );
             pi->SetProgressReporter( aProgressReporter );
-            pi->SaveBoard( tempFile.GetFullPath(), aBoard, &props );
+            pi->SaveBoard( outputFn.GetFullPath(), aBoard, &props );
             return true;
         }
         catch( const IO_ERROR& ioe )
@@ -456,12 +442,16 @@ void DIALOG_EXPORT_ODBPP::GenerateODBPPFiles( const JOB_EXPORT_PCB_ODB& aJob, BO
             if( aReporter )
             {
                 msg = wxString::Format( _( "Error generating ODBPP files '%s'.\n%s" ),
-                                        tempFile.GetFullPath(), ioe.What() );
+                                        outputFn.GetFullPath(), ioe.What() );
                 aReporter->Report( msg, RPT_SEVERITY_ERROR );
             }
 
             // In case we started a file but didn't fully write it, clean up
-            wxFileName::Rmdir( tempFile.GetFullPath() );
+            if( aJob.m_compressionMode != JOB_EXPORT_PCB_ODB::ODB_COMPRESSION::NONE )
+                wxRemoveFile( outputFn.GetFullPath() );
+            else
+                wxFileName::Rmdir( outputFn.GetFullPath() );
+
             return false;
         }
     };
@@ -495,102 +485,6 @@ void DIALOG_EXPORT_ODBPP::GenerateODBPPFiles( const JOB_EXPORT_PCB_ODB& aJob, BO
         return;
     }
 
-    if( aJob.m_compressionMode == JOB_EXPORT_PCB_ODB::ODB_COMPRESSION::ZIP )
-    {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Compressing output" ) );
-
-        wxFFileOutputStream fnout( outputFn.GetFullPath() );
-        wxZipOutputStream   zipStream( fnout );
-
-        std::function<void( const wxString&, const wxString& )> addDirToZip =
-                [&]( const wxString& dirPath, const wxString& parentPath )
-        {
-            wxDir    dir( dirPath );
-            wxString fileName;
-
-            bool cont = dir.GetFirst( &fileName, wxEmptyString, wxDIR_DEFAULT );
-
-            while( cont )
-            {
-                wxFileName fileInZip( dirPath, fileName );
-                wxString   relativePath =
-                        parentPath.IsEmpty()
-                                  ? fileName
-                                  : parentPath + wxString( wxFileName::GetPathSeparator() )
-                                          + fileName;
-
-                if( wxFileName::DirExists( fileInZip.GetFullPath() ) )
-                {
-                    zipStream.PutNextDirEntry( relativePath );
-                    addDirToZip( fileInZip.GetFullPath(), relativePath );
-                }
-                else
-                {
-                    wxFFileInputStream fileStream( fileInZip.GetFullPath() );
-                    zipStream.PutNextEntry( relativePath );
-                    fileStream.Read( zipStream );
-                }
-                cont = dir.GetNext( &fileName );
-            }
-        };
-
-        addDirToZip( tempFile.GetFullPath(), wxEmptyString );
-
-        zipStream.Close();
-        fnout.Close();
-
-        tempFile.Rmdir( wxPATH_RMDIR_RECURSIVE );
-    }
-    else if( aJob.m_compressionMode == JOB_EXPORT_PCB_ODB::ODB_COMPRESSION::TGZ )
-    {
-        wxFFileOutputStream fnout( outputFn.GetFullPath() );
-        wxZlibOutputStream  zlibStream( fnout, -1, wxZLIB_GZIP );
-        wxTarOutputStream   tarStream( zlibStream );
-
-        std::function<void( const wxString&, const wxString& )> addDirToTar =
-                [&]( const wxString& dirPath, const wxString& parentPath )
-        {
-            wxDir    dir( dirPath );
-            wxString fileName;
-
-            bool cont = dir.GetFirst( &fileName, wxEmptyString, wxDIR_DEFAULT );
-            while( cont )
-            {
-                wxFileName fileInTar( dirPath, fileName );
-                wxString   relativePath =
-                        parentPath.IsEmpty()
-                                  ? fileName
-                                  : parentPath + wxString( wxFileName::GetPathSeparator() )
-                                          + fileName;
-
-                if( wxFileName::DirExists( fileInTar.GetFullPath() ) )
-                {
-                    tarStream.PutNextDirEntry( relativePath );
-                    addDirToTar( fileInTar.GetFullPath(), relativePath );
-                }
-                else
-                {
-                    wxFFileInputStream fileStream( fileInTar.GetFullPath() );
-                    tarStream.PutNextEntry( relativePath, wxDateTime::Now(),
-                                            fileStream.GetLength() );
-                    fileStream.Read( tarStream );
-                }
-                cont = dir.GetNext( &fileName );
-            }
-        };
-
-        addDirToTar(
-                tempFile.GetFullPath(),
-                tempFile.GetPath( wxPATH_NO_SEPARATOR ).AfterLast( tempFile.GetPathSeparator() ) );
-
-        tarStream.Close();
-        zlibStream.Close();
-        fnout.Close();
-
-        tempFile.Rmdir( wxPATH_RMDIR_RECURSIVE );
-    }
-
     if( aProgressReporter )
         aProgressReporter->SetCurrentProgress( 1 );
 }
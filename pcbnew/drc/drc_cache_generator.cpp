@@ -27,10 +27,12 @@
 #include <thread_pool.h>
 #include <zone.h>
 #include <connectivity/connectivity_data.h>
+#include <connectivity/from_to_cache.h>
 #include <drc/drc_engine.h>
 #include <drc/drc_rtree.h>
 #include <drc/drc_cache_generator.h>
 #include <mutex>
+#include <wx/thread.h>
 
 bool DRC_CACHE_GENERATOR::Run()
 {
@@ -144,6 +146,9 @@ bool DRC_CACHE_GENERATOR::Run()
                     m_board->m_CopperItemRTreeCache = std::make_shared<DRC_RTREE>();
 
                 forEachGeometryItem( itemTypes, LSET::AllCuMask(), addToCopperTree );
+
+                // Providers search and iterate over the tree concurrently
+                m_board->m_CopperItemRTreeCache->Build();
             } );
 
     std::future_status status = retn.wait_for( std::chrono::milliseconds( 250 ) );
@@ -190,6 +195,8 @@ bool DRC_CACHE_GENERATOR::Run()
                                    rtree->Insert( aZone, layer );
                            } );
 
+                   rtree->Build();
+
                    {
                        std::unique_lock<std::shared_mutex> writeLock( m_board->m_CachesMutex );
                        m_board->m_CopperZoneRTreeCache[ aZone ] = std::move( rtree );
@@ -233,10 +240,18 @@ bool DRC_CACHE_GENERATOR::Run()
 
     std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_board->GetConnectivity();
 
+    // The connectivity build refreshes the progress reporter's UI, which can only be done from
+    // the main thread; the caches are generated alongside other providers in concurrent runs
+    PROGRESS_REPORTER* reporter = wxIsMainThread() ? m_drcEngine->GetProgressReporter() : nullptr;
+
     connectivity->ClearRatsnest();
-    connectivity->Build( m_board, m_drcEngine->GetProgressReporter() );
+    connectivity->Build( m_board, reporter );
     connectivity->FillIsolatedIslandsMap( m_board->m_ZoneIsolatedIslandsMap, true );
 
+    // fromTo() rule conditions can be evaluated by any provider, so the paths must be known
+    // before providers start running concurrently.
+    connectivity->GetFromToCache()->Rebuild( m_board );
+
     return !m_drcEngine->IsCancelled();
 }
 
@@ -23,8 +23,13 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <algorithm>
 #include <atomic>
+#include <future>
+#include <set>
 #include <wx/log.h>
+#include <wx/thread.h>
+#include <advanced_config.h>
 #include <reporter.h>
 #include <progress_reporter.h>
 #include <string_utils.h>
@@ -37,6 +42,7 @@
 #include <drc/drc_test_provider.h>
 #include <drc/drc_item.h>
 #include <drc/drc_cache_generator.h>
+#include <drawing_sheet/ds_data_model.h>
 #include <footprint.h>
 #include <pad.h>
 #include <pcb_track.h>
@@ -50,6 +56,10 @@
 #define ERROR_LIMIT 199
 #define EXTENDED_ERROR_LIMIT 499
 
+// Most constraint queries are for nearby pairs, so a large board needs far fewer cached
+// resolutions than it has item pairs.  Beyond this, those least recently used are dropped.
+#define CONSTRAINT_CACHE_SIZE 262144
+
 
 /**
  * Flag to enable DRC profile timing logging.
@@ -82,10 +92,19 @@ DRC_ENGINE::DRC_ENGINE( BOARD* aBoard, BOARD_DESIGN_SETTINGS *aSettings ) :
         m_drawingSheet( nullptr ),
         m_schematicNetlist( nullptr ),
         m_rulesValid( false ),
+        m_errorCounts( DRCE_LAST + 1 ),
         m_reportAllTrackErrors( false ),
         m_testFootprints( false ),
         m_reporter( nullptr ),
-        m_progressReporter( nullptr )
+        m_progressReporter( nullptr ),
+        m_holdViolations( false ),
+        m_profiling( false ),
+        m_ruleEvaluations( 0 ),
+        m_violationCount( 0 ),
+        m_constraintCache( CONSTRAINT_CACHE_SIZE ),
+        m_constraintCacheTimeStamp( -1 ),
+        m_constraintCacheHits( 0 ),
+        m_constraintCacheMisses( 0 )
 {
     m_errorLimits.resize( DRCE_LAST + 1 );
 
@@ -620,40 +639,507 @@ void DRC_ENGINE::RunTests( EDA_UNITS aUnits, bool aReportAllTrackErrors, bool aT
             m_errorLimits[ ii ] = EXTENDED_ERROR_LIMIT;
         else
             m_errorLimits[ ii ] = ERROR_LIMIT;
+
+        m_errorCounts[ ii ] = 0;
     }
 
     DRC_TEST_PROVIDER::Init();
 
     m_board->IncrementTimeStamp();      // Invalidate all caches...
 
+    int timestamp = m_board->GetTimeStamp();
+
     DRC_CACHE_GENERATOR cacheGenerator;
     cacheGenerator.SetDRCEngine( this );
 
-    if( !cacheGenerator.Run() )         // ... and regenerate them.
-        return;
+    auto generateCaches =
+            [&]() -> bool
+            {
+                if( !cacheGenerator.Run() )         // ... and regenerate them.
+                    return false;
 
-    // Recompute component classes
-    m_board->GetComponentClassManager().ForceComponentClassRecalculation();
+                if( m_profiling )
+                    m_profile.m_CacheGenerationMs = timer.msecs();
 
-    int timestamp = m_board->GetTimeStamp();
+                // Recompute component classes
+                m_board->GetComponentClassManager().ForceComponentClassRecalculation();
+                return true;
+            };
 
-    for( DRC_TEST_PROVIDER* provider : m_testProviders )
+    if( m_profiling )
+        startProfile();
+
+    // Both sequential and concurrent runs hold violations back and report them in provider
+    // order once all the providers have finished, so they apply the error limits the same way.
+    holdViolations();
+
+    bool cachesGenerated = false;
+
+    try
     {
-        ReportAux( wxString::Format( wxT( "Run DRC provider: '%s'" ), provider->GetName() ) );
+        // Per-provider profiles are measured from board-wide counters, so need providers to
+        // run on their own.
+        if( m_profiling || !ADVANCED_CFG::GetCfg().m_DRCParallelProviders
+                || m_testProviders.size() < 2 || GetKiCadThreadPool().get_thread_count() < 2 )
+        {
+            cachesGenerated = generateCaches();
 
-        if( !provider->RunTests( aUnits ) )
-            break;
+            if( cachesGenerated )
+                runProvidersSequentially( aUnits );
+        }
+        else
+        {
+            cachesGenerated = runProvidersConcurrently( aUnits, generateCaches );
+        }
+    }
+    catch( ... )
+    {
+        reportHeldViolations();
+        throw;
     }
 
+    reportHeldViolations();
+
+    if( !cachesGenerated )
+        return;
+
     timer.Stop();
     wxLogTrace( traceDrcProfile, "DRC took %0.3f ms", timer.msecs() );
 
+    if( m_profiling )
+        finishProfile( timer.msecs() );
+
     // DRC tests are multi-threaded; anything that causes us to attempt to re-generate the
     // caches while DRC is running is problematic.
     wxASSERT( timestamp == m_board->GetTimeStamp() );
 }
 
 
+bool DRC_ENGINE::RunProvider( DRC_TEST_PROVIDER* aProvider, EDA_UNITS aUnits )
+{
+    SetUserUnits( aUnits );
+
+    for( int ii = DRCE_FIRST; ii <= DRCE_LAST; ++ii )
+        m_errorCounts[ ii ] = 0;
+
+    holdViolations();
+
+    bool ok = false;
+
+    try
+    {
+        ok = aProvider->RunTests( aUnits );
+    }
+    catch( ... )
+    {
+        reportHeldViolations();
+        throw;
+    }
+
+    reportHeldViolations();
+
+    return ok;
+}
+
+
+void DRC_ENGINE::runProvidersSequentially( EDA_UNITS aUnits )
+{
+    auto cacheCounts =
+            [&]( int64_t& aHits, int64_t& aMisses )
+            {
+                aHits = m_board->m_IntersectsCourtyardCacheStats.m_Hits
+                            + m_board->m_IntersectsAreaCacheStats.m_Hits
+                            + m_board->m_EnclosedByAreaCacheStats.m_Hits
+                            + m_constraintCacheHits;
+                aMisses = m_board->m_IntersectsCourtyardCacheStats.m_Misses
+                            + m_board->m_IntersectsAreaCacheStats.m_Misses
+                            + m_board->m_EnclosedByAreaCacheStats.m_Misses
+                            + m_constraintCacheMisses;
+            };
+
+    for( DRC_TEST_PROVIDER* provider : m_testProviders )
+    {
+        ReportAux( wxString::Format( wxT( "Run DRC provider: '%s'" ), provider->GetName() ) );
+
+        DRC_PROVIDER_PROFILE profile;
+        PROF_TIMER           providerTimer;
+
+        if( m_profiling )
+        {
+            profile.m_Name = provider->GetName();
+            profile.m_Violations = -m_violationCount;
+            profile.m_RuleEvaluations = -m_ruleEvaluations;
+            cacheCounts( profile.m_CacheHits, profile.m_CacheMisses );
+            profile.m_CacheHits = -profile.m_CacheHits;
+            profile.m_CacheMisses = -profile.m_CacheMisses;
+        }
+
+        bool ok = provider->RunTests( aUnits );
+
+        if( m_profiling )
+        {
+            int64_t hits, misses;
+            cacheCounts( hits, misses );
+
+            profile.m_WallMs = providerTimer.msecs();
+            profile.m_Violations += m_violationCount;
+            profile.m_RuleEvaluations += m_ruleEvaluations;
+            profile.m_CacheHits += hits;
+            profile.m_CacheMisses += misses;
+            m_profile.m_Providers.push_back( profile );
+
+            wxLogTrace( traceDrcProfile, "DRC provider '%s' took %0.3f ms",
+                        profile.m_Name, profile.m_WallMs );
+        }
+
+        if( !ok )
+            break;
+    }
+}
+
+
+bool DRC_ENGINE::runProvidersConcurrently( EDA_UNITS aUnits,
+                                           const std::function<bool()>& aGenerateCaches )
+{
+    const size_t count = m_testProviders.size();
+    const size_t cacheTask = count;
+
+    // The DRC caches are generated as one more task, which the providers reading them wait
+    // for.  Providers otherwise only read the board, so they can all run at once, except that
+    // an exclusive provider modifies items which the providers reading the caches also read.
+    // It waits for all those before it, and all those after it wait for it.
+    std::vector<std::set<size_t>> dependents( count + 1 );
+    std::vector<size_t>           waitingOn( count + 1, 0 );
+
+    for( size_t ii = 0; ii < count; ++ii )
+    {
+        if( m_testProviders[ii]->UsesDRCCaches() )
+            dependents[ cacheTask ].insert( ii );
+
+        if( m_testProviders[ii]->IsExclusive() )
+        {
+            for( size_t jj = 0; jj < count; ++jj )
+            {
+                if( !m_testProviders[jj]->UsesDRCCaches() )
+                    continue;
+
+                if( jj < ii )
+                    dependents[jj].insert( ii );
+                else if( jj > ii )
+                    dependents[ii].insert( jj );
+            }
+        }
+    }
+
+    for( size_t ii = 0; ii <= count; ++ii )
+    {
+        for( size_t dependent : dependents[ii] )
+            waitingOn[ dependent ]++;
+    }
+
+    // Providers don't run as thread pool tasks as many of them wait on tasks of their own.
+    const size_t maxRunning = GetKiCadThreadPool().get_thread_count();
+
+    std::set<size_t>               ready;
+    std::vector<bool>              started( count + 1, false );
+    std::vector<std::future<bool>> running( count + 1 );
+    size_t                         runningCount = 0;
+    bool                           cachesGenerated = false;
+    bool                           stop = false;
+    std::exception_ptr             exception;
+
+    // Providers checking the drawing sheet must see the one of the thread running the DRC
+    DS_DATA_MODEL* drawingSheet = DS_DATA_MODEL::GetThreadInstance();
+
+    for( size_t ii = 0; ii < count; ++ii )
+    {
+        if( waitingOn[ii] == 0 )
+            ready.insert( ii );
+    }
+
+    // Start on the caches first, as most providers wait for them
+    started[ cacheTask ] = true;
+    runningCount++;
+    running[ cacheTask ] = std::async( std::launch::async, aGenerateCaches );
+
+    while( true )
+    {
+        while( !stop && !ready.empty() && runningCount < maxRunning )
+        {
+            size_t             ii = *ready.begin();
+            DRC_TEST_PROVIDER* provider = m_testProviders[ii];
+
+            ready.erase( ready.begin() );
+            started[ii] = true;
+            runningCount++;
+
+            ReportAux( wxString::Format( wxT( "Run DRC provider: '%s'" ), provider->GetName() ) );
+
+            running[ii] = std::async( std::launch::async,
+                                      [provider, aUnits, drawingSheet]()
+                                      {
+                                          DS_DATA_MODEL::SetThreadInstance( drawingSheet );
+                                          bool result = provider->RunTests( aUnits );
+                                          DS_DATA_MODEL::SetThreadInstance( nullptr );
+
+                                          return result;
+                                      } );
+        }
+
+        if( runningCount == 0 )
+        {
+            auto notStarted = std::find( started.begin(), started.end(), false );
+
+            if( stop || notStarted == started.end() )
+                break;
+
+            // Only a dependency cycle leaves providers which can never start
+            size_t ii = notStarted - started.begin();
+
+            wxFAIL_MSG( wxString::Format( wxT( "DRC provider '%s' has circular dependencies" ),
+                                          m_testProviders[ii]->GetName() ) );
+            ready.insert( ii );
+            continue;
+        }
+
+        if( !KeepRefreshing( false ) )
+            stop = true;
+
+        bool finishedAny = false;
+
+        for( size_t ii = 0; ii <= count; ++ii )
+        {
+            if( !running[ii].valid()
+                    || running[ii].wait_for( std::chrono::seconds( 0 ) )
+                               != std::future_status::ready )
+            {
+                continue;
+            }
+
+            try
+            {
+                if( running[ii].get() )
+                {
+                    if( ii == cacheTask )
+                        cachesGenerated = true;
+                }
+                else
+                {
+                    stop = true;
+                }
+            }
+            catch( ... )
+            {
+                // Let the other providers finish before passing the exception on
+                if( !exception )
+                    exception = std::current_exception();
+
+                stop = true;
+            }
+
+            runningCount--;
+            finishedAny = true;
+
+            for( size_t dependent : dependents[ii] )
+            {
+                if( --waitingOn[ dependent ] == 0 )
+                    ready.insert( dependent );
+            }
+        }
+
+        if( !finishedAny )
+        {
+            for( std::future<bool>& ret : running )
+            {
+                if( ret.valid() )
+                {
+                    ret.wait_for( std::chrono::milliseconds( 100 ) );
+                    break;
+                }
+            }
+        }
+    }
+
+    if( exception )
+        std::rethrow_exception( exception );
+
+    return cachesGenerated;
+}
+
+
+void DRC_ENGINE::holdViolations()
+{
+    std::lock_guard<std::mutex> guard( m_pendingViolationsMutex );
+    m_pendingViolations.clear();
+    m_heldErrorCounts.clear();
+
+    for( DRC_TEST_PROVIDER* provider : m_testProviders )
+        m_heldErrorCounts.try_emplace( provider, DRCE_LAST + 1 );
+
+    m_holdViolations = true;
+}
+
+
+void DRC_ENGINE::reportHeldViolations()
+{
+    std::map<const DRC_TEST_PROVIDER*, std::vector<PENDING_VIOLATION>> pending;
+
+    {
+        std::lock_guard<std::mutex> guard( m_pendingViolationsMutex );
+        pending.swap( m_pendingViolations );
+        m_holdViolations = false;
+    }
+
+    auto dispatchAll =
+            [&]( std::vector<PENDING_VIOLATION>& aViolations )
+            {
+                for( PENDING_VIOLATION& violation : aViolations )
+                {
+                    // Each provider was held to the whole limit on its own, so apply the
+                    // limit across providers here, in provider order
+                    if( m_errorCounts[ violation.m_Item->GetErrorCode() ]++
+                            >= m_errorLimits[ violation.m_Item->GetErrorCode() ] )
+                    {
+                        continue;
+                    }
+
+                    DRC_CUSTOM_MARKER_HANDLER* handler = nullptr;
+
+                    if( violation.m_CustomHandler )
+                        handler = &violation.m_CustomHandler.value();
+
+                    dispatchViolation( violation.m_Item, violation.m_Pos, violation.m_Layer,
+                                       handler );
+                }
+            };
+
+    for( DRC_TEST_PROVIDER* provider : m_testProviders )
+    {
+        auto it = pending.find( provider );
+
+        if( it != pending.end() )
+        {
+            dispatchAll( it->second );
+            pending.erase( it );
+        }
+    }
+
+    // Anything reported on behalf of a provider which isn't registered
+    for( auto& [provider, violations] : pending )
+        dispatchAll( violations );
+
+    m_heldErrorCounts.clear();
+}
+
+
+void DRC_ENGINE::startProfile()
+{
+    m_profile = DRC_PROFILE();
+    m_ruleCounters.clear();
+
+    for( const std::shared_ptr<DRC_RULE>& rule : m_rules )
+        m_ruleCounters[ rule.get() ] = std::make_unique<RULE_COUNTERS>();
+
+    m_ruleEvaluations = 0;
+    m_violationCount = 0;
+
+    for( std::atomic<int64_t>& count : m_layerEvaluations )
+        count = 0;
+
+    // Board cache counters accumulate over the board's lifetime; record where they start.
+    auto addCache =
+            [&]( const wxString& aName, const BOARD_CACHE_STATS& aStats )
+            {
+                m_profile.m_Caches.push_back( { aName, -aStats.m_Hits, -aStats.m_Misses } );
+            };
+
+    addCache( wxT( "intersects_courtyard" ), m_board->m_IntersectsCourtyardCacheStats );
+    addCache( wxT( "intersects_area" ), m_board->m_IntersectsAreaCacheStats );
+    addCache( wxT( "enclosed_by_area" ), m_board->m_EnclosedByAreaCacheStats );
+
+    m_constraintCacheHits = 0;
+    m_constraintCacheMisses = 0;
+}
+
+
+void DRC_ENGINE::finishProfile( double aTotalMs )
+{
+    m_profile.m_TotalMs = aTotalMs;
+
+    const BOARD_CACHE_STATS* stats[] = { &m_board->m_IntersectsCourtyardCacheStats,
+                                         &m_board->m_IntersectsAreaCacheStats,
+                                         &m_board->m_EnclosedByAreaCacheStats };
+
+    for( size_t ii = 0; ii < m_profile.m_Caches.size(); ++ii )
+    {
+        m_profile.m_Caches[ii].m_Hits += stats[ii]->m_Hits;
+        m_profile.m_Caches[ii].m_Misses += stats[ii]->m_Misses;
+    }
+
+    m_profile.m_Caches.push_back( { wxT( "constraint_resolution" ), m_constraintCacheHits,
+                                    m_constraintCacheMisses } );
+
+    for( const std::shared_ptr<DRC_RULE>& rule : m_rules )
+    {
+        const RULE_COUNTERS& counters = *m_ruleCounters.at( rule.get() );
+
+        if( counters.m_Evaluations == 0 )
+            continue;
+
+        m_profile.m_Rules.push_back( { rule->m_Name, rule->m_Implicit, counters.m_Evaluations,
+                                       counters.m_Nanoseconds / 1e6 } );
+    }
+
+    std::sort( m_profile.m_Rules.begin(), m_profile.m_Rules.end(),
+               []( const DRC_RULE_PROFILE& a, const DRC_RULE_PROFILE& b )
+               {
+                   return a.m_Ms > b.m_Ms;
+               } );
+
+    for( size_t ii = 0; ii < m_layerEvaluations.size(); ++ii )
+    {
+        if( m_layerEvaluations[ii] > 0 )
+        {
+            PCB_LAYER_ID layer = static_cast<PCB_LAYER_ID>( static_cast<int>( ii ) - 1 );
+            m_profile.m_RuleEvaluationsByLayer[ layer ] = m_layerEvaluations[ii];
+        }
+    }
+}
+
+
+bool DRC_ENGINE::evalCondition( DRC_ENGINE_CONSTRAINT* aConstraint, const BOARD_ITEM* a,
+                                const BOARD_ITEM* b, PCB_LAYER_ID aLayer, REPORTER* aReporter )
+{
+    DRC_RULE_CONDITION* condition = aConstraint->condition;
+    DRC_CONSTRAINT_T    type = aConstraint->constraint.m_Type;
+
+    if( !m_profiling )
+        return condition->EvaluateFor( a, b, type, aLayer, aReporter );
+
+    auto it = m_ruleCounters.find( aConstraint->parentRule.get() );
+
+    // Evaluations from outside RunTests() (such as zone filling) aren't profiled
+    if( it == m_ruleCounters.end() )
+        return condition->EvaluateFor( a, b, type, aLayer, aReporter );
+
+    auto start = std::chrono::steady_clock::now();
+    bool result = condition->EvaluateFor( a, b, type, aLayer, aReporter );
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    it->second->m_Evaluations.fetch_add( 1, std::memory_order_relaxed );
+    it->second->m_Nanoseconds.fetch_add(
+            std::chrono::duration_cast<std::chrono::nanoseconds>( elapsed ).count(),
+            std::memory_order_relaxed );
+
+    m_ruleEvaluations.fetch_add( 1, std::memory_order_relaxed );
+
+    if( aLayer >= UNDEFINED_LAYER && aLayer < PCB_LAYER_ID_COUNT )
+        m_layerEvaluations[ aLayer + 1 ].fetch_add( 1, std::memory_order_relaxed );
+
+    return result;
+}
+
+
 #define REPORT( s ) { if( aReporter ) { aReporter->Report( s ); } }
 
 DRC_CONSTRAINT DRC_ENGINE::EvalZoneConnection( const BOARD_ITEM* a, const BOARD_ITEM* b,
@@ -690,9 +1176,70 @@ DRC_CONSTRAINT DRC_ENGINE::EvalZoneConnection( const BOARD_ITEM* a, const BOARD_
 }
 
 
+bool DRC_ENGINE::isBoardResident( const BOARD_ITEM* aItem ) const
+{
+    if( !aItem )
+        return true;
+
+    const std::unordered_map<KIID, BOARD_ITEM*>& items = m_board->GetItemByIdCache();
+    auto                                         it = items.find( aItem->m_Uuid );
+
+    return it != items.end() && it->second == aItem;
+}
+
+
 DRC_CONSTRAINT DRC_ENGINE::EvalRules( DRC_CONSTRAINT_T aConstraintType, const BOARD_ITEM* a,
                                       const BOARD_ITEM* b, PCB_LAYER_ID aLayer,
                                       REPORTER* aReporter )
+{
+    // Items standing in for their holes resolve differently, but are the same items as far as
+    // the cache key goes
+    auto isHoleProxy =
+            []( const BOARD_ITEM* aItem )
+            {
+                return aItem && ( aItem->GetFlags() & HOLE_PROXY );
+            };
+
+    if( aReporter || !m_board || !isBoardResident( a ) || !isBoardResident( b )
+            || isHoleProxy( a ) || isHoleProxy( b ) )
+    {
+        return evalRules( aConstraintType, a, b, aLayer, aReporter );
+    }
+
+    int timeStamp = m_board->GetTimeStamp();
+
+    if( m_constraintCacheTimeStamp.load( std::memory_order_acquire ) != timeStamp )
+    {
+        std::lock_guard<std::mutex> lock( m_constraintCacheMutex );
+
+        if( m_constraintCacheTimeStamp.load( std::memory_order_relaxed ) != timeStamp )
+        {
+            m_constraintCache.Clear();
+            m_constraintCacheTimeStamp.store( timeStamp, std::memory_order_release );
+        }
+    }
+
+    bool hit = false;
+
+    DRC_CONSTRAINT constraint = m_constraintCache.GetOrCompute( { a, b, aLayer, aConstraintType },
+            [&]()
+            {
+                return evalRules( aConstraintType, a, b, aLayer, nullptr );
+            },
+            &hit );
+
+    if( hit )
+        m_constraintCacheHits.fetch_add( 1, std::memory_order_relaxed );
+    else
+        m_constraintCacheMisses.fetch_add( 1, std::memory_order_relaxed );
+
+    return constraint;
+}
+
+
+DRC_CONSTRAINT DRC_ENGINE::evalRules( DRC_CONSTRAINT_T aConstraintType, const BOARD_ITEM* a,
+                                      const BOARD_ITEM* b, PCB_LAYER_ID aLayer,
+                                      REPORTER* aReporter )
 {
     /*
      * NOTE: all string manipulation MUST BE KEPT INSIDE the REPORT macro.  It absolutely
@@ -1337,7 +1884,7 @@ DRC_CONSTRAINT DRC_ENGINE::EvalRules( DRC_CONSTRAINT_T aConstraintType, const BO
                                                   EscapeHTML( c->condition->GetExpression() ) ) )
                     }
 
-                    if( c->condition->EvaluateFor( a, b, c->constraint.m_Type, aLayer, aReporter ) )
+                    if( evalCondition( c, a, b, aLayer, aReporter ) )
                     {
                         if( aReporter )
                         {
@@ -1654,19 +2201,66 @@ void DRC_ENGINE::ProcessAssertions( const BOARD_ITEM* a,
 #undef REPORT
 
 
-bool DRC_ENGINE::IsErrorLimitExceeded( int error_code )
+bool DRC_ENGINE::IsErrorLimitExceeded( int aErrorCode, const DRC_TEST_PROVIDER* aProvider )
 {
-    assert( error_code >= 0 && error_code <= DRCE_LAST );
-    return m_errorLimits[ error_code ] <= 0;
+    assert( aErrorCode >= 0 && aErrorCode <= DRCE_LAST );
+
+    int count = m_errorCounts[ aErrorCode ];
+
+    // During a run each provider is held to the whole limit on its own, so that what it finds
+    // doesn't depend on which providers ran before it or how far the others have got.  The
+    // limit is then applied across providers when the violations are reported.
+    if( m_holdViolations && aProvider )
+    {
+        auto it = m_heldErrorCounts.find( aProvider );
+
+        if( it != m_heldErrorCounts.end() )
+            count += it->second[ aErrorCode ];
+    }
+
+    return count >= m_errorLimits[ aErrorCode ];
 }
 
 
 void DRC_ENGINE::ReportViolation( const std::shared_ptr<DRC_ITEM>& aItem, const VECTOR2I& aPos,
                                   int aMarkerLayer, DRC_CUSTOM_MARKER_HANDLER* aCustomHandler )
 {
-    static std::mutex globalLock;
+    if( m_profiling )
+        m_violationCount++;
+
+    if( m_holdViolations )
+    {
+        auto it = m_heldErrorCounts.find( aItem->GetViolatingTest() );
+
+        if( it != m_heldErrorCounts.end() )
+            it->second[ aItem->GetErrorCode() ]++;
+
+        std::lock_guard<std::mutex> guard( m_pendingViolationsMutex );
+
+        std::vector<PENDING_VIOLATION>& pending = m_pendingViolations[ aItem->GetViolatingTest() ];
+        PENDING_VIOLATION&              violation = pending.emplace_back();
 
-    m_errorLimits[ aItem->GetErrorCode() ] -= 1;
+        violation.m_Item = aItem;
+        violation.m_Pos = aPos;
+        violation.m_Layer = aMarkerLayer;
+
+        // The handler usually lives on the reporting provider's stack
+        if( aCustomHandler )
+            violation.m_CustomHandler = *aCustomHandler;
+
+        return;
+    }
+
+    m_errorCounts[ aItem->GetErrorCode() ]++;
+
+    dispatchViolation( aItem, aPos, aMarkerLayer, aCustomHandler );
+}
+
+
+void DRC_ENGINE::dispatchViolation( const std::shared_ptr<DRC_ITEM>& aItem, const VECTOR2I& aPos,
+                                    int aMarkerLayer, DRC_CUSTOM_MARKER_HANDLER* aCustomHandler )
+{
+    static std::mutex globalLock;
 
     if( m_violationHandler )
     {
@@ -1699,9 +2293,12 @@ void DRC_ENGINE::ReportViolation( const std::shared_ptr<DRC_ITEM>& aItem, const
 
 void DRC_ENGINE::ReportAux ( const wxString& aStr )
 {
+    static std::mutex globalLock;
+
     if( !m_reporter )
         return;
 
+    std::lock_guard<std::mutex> guard( globalLock );
     m_reporter->Report( aStr, RPT_SEVERITY_INFO );
 }
 
@@ -1735,6 +2332,11 @@ bool DRC_ENGINE::ReportProgress( double aProgress )
         return true;
 
     m_progressReporter->SetCurrentProgress( aProgress );
+
+    // Providers running concurrently can't update the UI; RunTests() does it for them.
+    if( !wxIsMainThread() )
+        return !m_progressReporter->IsCancelled();
+
     return m_progressReporter->KeepRefreshing( false );
 }
 
@@ -1745,6 +2347,10 @@ bool DRC_ENGINE::ReportPhase( const wxString& aMessage )
         return true;
 
     m_progressReporter->AdvancePhase( aMessage );
+
+    if( !wxIsMainThread() )
+        return !m_progressReporter->IsCancelled();
+
     bool retval = m_progressReporter->KeepRefreshing( false );
     wxSafeYield( nullptr, true ); // Force an update for the message
     return retval;
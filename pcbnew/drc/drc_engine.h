@@ -24,10 +24,18 @@
 #ifndef DRC_ENGINE_H
 #define DRC_ENGINE_H
 
+#include <array>
+#include <atomic>
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <vector>
 #include <unordered_map>
 
+#include <core/sharded_cache.h>
+#include <hash.h>
 #include <units_provider.h>
 #include <geometry/shape.h>
 #include <lset.h>
@@ -72,6 +80,82 @@ typedef std::function<void( const std::shared_ptr<DRC_ITEM>& aItem, const VECTOR
                             int aLayer, DRC_CUSTOM_MARKER_HANDLER* aCustomHandler )>
         DRC_VIOLATION_HANDLER;
 
+
+struct DRC_CONSTRAINT_CACHE_KEY
+{
+    const BOARD_ITEM* A;
+    const BOARD_ITEM* B;
+    PCB_LAYER_ID      Layer;
+    DRC_CONSTRAINT_T  Type;
+
+    bool operator==( const DRC_CONSTRAINT_CACHE_KEY& other ) const
+    {
+        return A == other.A && B == other.B && Layer == other.Layer && Type == other.Type;
+    }
+};
+
+namespace std
+{
+    template <>
+    struct hash<DRC_CONSTRAINT_CACHE_KEY>
+    {
+        std::size_t operator()( const DRC_CONSTRAINT_CACHE_KEY& k ) const
+        {
+            std::size_t seed = 0xa82de1c0;
+            hash_combine( seed, k.A, k.B, static_cast<int>( k.Layer ),
+                          static_cast<int>( k.Type ) );
+            return seed;
+        }
+    };
+}
+
+/**
+ * Timing and counters gathered for a single test provider while profiling.
+ *
+ * Providers run one after another, so rule evaluations and cache lookups are attributed to
+ * the provider which was running when they happened.
+ */
+struct DRC_PROVIDER_PROFILE
+{
+    wxString m_Name;
+    double   m_WallMs = 0.0;
+    int64_t  m_Violations = 0;
+    int64_t  m_RuleEvaluations = 0;
+    int64_t  m_CacheHits = 0;
+    int64_t  m_CacheMisses = 0;
+};
+
+/**
+ * Number of times a rule's condition was evaluated while profiling, and the time it took.
+ */
+struct DRC_RULE_PROFILE
+{
+    wxString m_Name;
+    bool     m_Implicit = false;
+    int64_t  m_Evaluations = 0;
+    double   m_Ms = 0.0;
+};
+
+/**
+ * Hit/miss totals for one of the board's run-time caches while profiling.
+ */
+struct DRC_CACHE_PROFILE
+{
+    wxString m_Name;
+    int64_t  m_Hits = 0;
+    int64_t  m_Misses = 0;
+};
+
+struct DRC_PROFILE
+{
+    double                            m_TotalMs = 0.0;
+    double                            m_CacheGenerationMs = 0.0;
+    std::vector<DRC_PROVIDER_PROFILE> m_Providers;
+    std::vector<DRC_RULE_PROFILE>     m_Rules;
+    std::vector<DRC_CACHE_PROFILE>    m_Caches;
+    std::map<PCB_LAYER_ID, int64_t>   m_RuleEvaluationsByLayer;
+};
+
 /**
  * Design Rule Checker object that performs all the DRC tests.
  *
@@ -92,7 +176,11 @@ public:
     DRC_ENGINE( BOARD* aBoard = nullptr, BOARD_DESIGN_SETTINGS* aSettings = nullptr );
     virtual ~DRC_ENGINE();
 
-    void SetBoard( BOARD* aBoard ) { m_board = aBoard; }
+    void SetBoard( BOARD* aBoard )
+    {
+        m_board = aBoard;
+        m_constraintCache.Clear();
+    }
     BOARD* GetBoard() const { return m_board; }
 
     void SetDesignSettings( BOARD_DESIGN_SETTINGS* aSettings ) { m_designSettings = aSettings; }
@@ -146,18 +234,62 @@ public:
      */
     void InitEngine( const wxFileName& aRulePath );
 
+    /**
+     * Gather per-provider, per-rule and per-layer timings and counters during RunTests().
+     *
+     * Profiling adds a small overhead to each rule evaluation, so it is off by default.
+     */
+    void SetProfiling( bool aEnable ) { m_profiling = aEnable; }
+    bool IsProfiling() const { return m_profiling; }
+
+    /**
+     * @return the profile of the last RunTests() made with profiling enabled.
+     */
+    const DRC_PROFILE& GetProfile() const { return m_profile; }
+
     /**
      * Run the DRC tests.
      */
     void RunTests( EDA_UNITS aUnits, bool aReportAllTrackErrors, bool aTestFootprints,
                    BOARD_COMMIT* aCommit = nullptr );
 
-    bool IsErrorLimitExceeded( int error_code );
+    /**
+     * Run \a aProvider on its own, against the caches generated by the last RunTests().  The
+     * error counts are reset first, so the provider is held to the limits of the last run just
+     * as it was during that run.  Used to time providers in isolation.
+     *
+     * @return false if the provider was cancelled.
+     */
+    bool RunProvider( DRC_TEST_PROVIDER* aProvider, EDA_UNITS aUnits );
+
+    /**
+     * @return true if no more violations of \a aErrorCode will be reported in this run.
+     *
+     * Providers should pass themselves as \a aProvider: during a run each one is allowed the
+     * whole limit, and the limit is applied across them in provider order once they have all
+     * finished.
+     */
+    bool IsErrorLimitExceeded( int aErrorCode, const DRC_TEST_PROVIDER* aProvider = nullptr );
 
+    /**
+     * Resolve the constraint of type \a aConstraintType which applies between \a a and \a b
+     * (or to \a a alone if \a b is null) on \a aLayer.
+     *
+     * Results for items which belong to the board are memoized until the board's timestamp
+     * changes (i.e. until the next commit) or the rules are reloaded, so repeated queries for
+     * the same pair from different test providers, the zone filler or the router are resolved
+     * only once.  Queries with a reporter, or with temporary items, always walk the rules.
+     */
     DRC_CONSTRAINT EvalRules( DRC_CONSTRAINT_T aConstraintType, const BOARD_ITEM* a,
                               const BOARD_ITEM* b, PCB_LAYER_ID aLayer,
                               REPORTER* aReporter = nullptr );
 
+    /**
+     * Discard all memoized constraint resolutions.  Only needed if items or their net classes
+     * are modified outside of a commit.
+     */
+    void ClearConstraintCache() { m_constraintCache.Clear(); }
+
     DRC_CONSTRAINT EvalZoneConnection( const BOARD_ITEM* a, const BOARD_ITEM* b,
                                        PCB_LAYER_ID aLayer, REPORTER* aReporter = nullptr );
 
@@ -235,6 +367,66 @@ private:
     void loadImplicitRules();
     std::shared_ptr<DRC_RULE> createImplicitRule( const wxString& name );
 
+    struct RULE_COUNTERS
+    {
+        std::atomic<int64_t> m_Evaluations{ 0 };
+        std::atomic<int64_t> m_Nanoseconds{ 0 };
+    };
+
+    void startProfile();
+    void finishProfile( double aTotalMs );
+
+    /**
+     * Run the providers one after another, in registration order.
+     */
+    void runProvidersSequentially( EDA_UNITS aUnits );
+
+    /**
+     * Run the providers on separate threads, starting each as soon as the providers it depends
+     * on have finished.  \a aGenerateCaches runs alongside them, and providers which use the
+     * DRC caches wait for it.
+     *
+     * @return false if the caches weren't generated, i.e. if the run was cancelled.
+     */
+    bool runProvidersConcurrently( EDA_UNITS aUnits,
+                                   const std::function<bool()>& aGenerateCaches );
+
+    /**
+     * Hold violations back from now on, each provider being allowed the whole error limit.
+     */
+    void holdViolations();
+
+    /**
+     * Report the held violations in provider order, applying the error limits across
+     * providers, and stop holding them.  Reporting in provider order makes the results
+     * independent of whether the providers ran sequentially or concurrently.
+     */
+    void reportHeldViolations();
+
+    void dispatchViolation( const std::shared_ptr<DRC_ITEM>& aItem, const VECTOR2I& aPos,
+                            int aMarkerLayer, DRC_CUSTOM_MARKER_HANDLER* aCustomHandler );
+
+    struct PENDING_VIOLATION
+    {
+        std::shared_ptr<DRC_ITEM>                m_Item;
+        VECTOR2I                                 m_Pos;
+        int                                      m_Layer;
+        std::optional<DRC_CUSTOM_MARKER_HANDLER> m_CustomHandler;
+    };
+
+    bool evalCondition( DRC_ENGINE_CONSTRAINT* aConstraint, const BOARD_ITEM* a,
+                        const BOARD_ITEM* b, PCB_LAYER_ID aLayer, REPORTER* aReporter );
+
+    DRC_CONSTRAINT evalRules( DRC_CONSTRAINT_T aConstraintType, const BOARD_ITEM* a,
+                              const BOARD_ITEM* b, PCB_LAYER_ID aLayer, REPORTER* aReporter );
+
+    /**
+     * @return true if \a aItem is null or is owned by the board, in which case it can only
+     *         change through a commit.  Temporary items are often reused with different
+     *         properties, so their constraints can't be memoized.
+     */
+    bool isBoardResident( const BOARD_ITEM* aItem ) const;
+
 protected:
     BOARD_DESIGN_SETTINGS*     m_designSettings;
     BOARD*                     m_board;
@@ -245,7 +437,8 @@ protected:
     bool                                    m_rulesValid;
     std::vector<DRC_TEST_PROVIDER*>         m_testProviders;
 
-    std::vector<int>           m_errorLimits;
+    std::vector<int>               m_errorLimits;
+    std::vector<std::atomic<int>>  m_errorCounts;     // violations reported in this run
     bool                       m_reportAllTrackErrors;
     bool                       m_testFootprints;
 
@@ -256,7 +449,32 @@ protected:
     REPORTER*                  m_reporter;
     PROGRESS_REPORTER*         m_progressReporter;
 
+    // Violations held back while the providers run, keyed by the provider which found them.
+    bool                                                                 m_holdViolations;
+    std::map<const DRC_TEST_PROVIDER*, std::vector<PENDING_VIOLATION>>   m_pendingViolations;
+    std::mutex                                                           m_pendingViolationsMutex;
+
+    // Per-provider counts of the held violations; the map is only modified between runs.
+    std::map<const DRC_TEST_PROVIDER*, std::vector<std::atomic<int>>>    m_heldErrorCounts;
+
     std::shared_ptr<KIGFX::VIEW_OVERLAY> m_debugOverlay;
+
+    bool                       m_profiling;
+    DRC_PROFILE                m_profile;
+
+    // Profiling counters; the map is only modified between runs so lookups need no lock.
+    std::unordered_map<const DRC_RULE*, std::unique_ptr<RULE_COUNTERS>> m_ruleCounters;
+    std::atomic<int64_t>                                                m_ruleEvaluations;
+    std::atomic<int64_t>                                                m_violationCount;
+    std::array<std::atomic<int64_t>, PCB_LAYER_ID_COUNT + 1>            m_layerEvaluations;
+
+    // Memoized EvalRules() results, valid for m_constraintCacheTimeStamp of the board.  The
+    // cache is bounded, dropping the entries least recently used.
+    SHARDED_CACHE<DRC_CONSTRAINT_CACHE_KEY, DRC_CONSTRAINT> m_constraintCache;
+    std::atomic<int>                                        m_constraintCacheTimeStamp;
+    std::mutex                                              m_constraintCacheMutex;
+    std::atomic<int64_t>                                    m_constraintCacheHits;
+    std::atomic<int64_t>                                    m_constraintCacheMisses;
 };
 
 #endif // DRC_H
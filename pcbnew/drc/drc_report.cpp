@@ -23,6 +23,7 @@
 #include <board_design_settings.h>
 #include <build_version.h>
 #include "drc_report.h"
+#include <drc/drc_engine.h>
 #include <drc/drc_item.h>
 #include <fstream>
 #include <macros.h>
@@ -38,7 +39,8 @@ DRC_REPORT::DRC_REPORT( BOARD* aBoard, EDA_UNITS aReportUnits,
         m_reportUnits( aReportUnits ),
         m_markersProvider( std::move( aMarkersProvider ) ),
         m_ratsnestProvider( std::move( aRatsnestProvider ) ),
-        m_fpWarningsProvider( std::move( aFpWarningsProvider ) )
+        m_fpWarningsProvider( std::move( aFpWarningsProvider ) ),
+        m_profile( nullptr )
 {
 
 }
@@ -166,6 +168,39 @@ bool DRC_REPORT::WriteJsonReport( const wxString& aFullFileName )
         reportHead.schematic_parity.push_back( violation );
     }
 
+    if( m_profile )
+    {
+        RC_JSON::DRC_PROFILE profile;
+
+        profile.total_ms = m_profile->m_TotalMs;
+        profile.cache_generation_ms = m_profile->m_CacheGenerationMs;
+
+        for( const DRC_PROVIDER_PROFILE& provider : m_profile->m_Providers )
+        {
+            profile.providers.push_back( { provider.m_Name, provider.m_WallMs,
+                                           provider.m_Violations, provider.m_RuleEvaluations,
+                                           provider.m_CacheHits, provider.m_CacheMisses } );
+        }
+
+        for( const DRC_RULE_PROFILE& rule : m_profile->m_Rules )
+        {
+            profile.rules.push_back( { rule.m_Name, rule.m_Implicit, rule.m_Evaluations,
+                                       rule.m_Ms } );
+        }
+
+        for( const auto& [ layer, count ] : m_profile->m_RuleEvaluationsByLayer )
+        {
+            wxString layerName = layer == UNDEFINED_LAYER ? wxString( wxS( "any" ) )
+                                                          : m_board->GetLayerName( layer );
+
+            profile.layers.push_back( { layerName, count } );
+        }
+
+        for( const DRC_CACHE_PROFILE& cache : m_profile->m_Caches )
+            profile.caches.push_back( { cache.m_Name, cache.m_Hits, cache.m_Misses } );
+
+        reportHead.profile = profile;
+    }
 
     nlohmann::json saveJson = nlohmann::json( reportHead );
     jsonFileStream << std::setw( 4 ) << saveJson << std::endl;
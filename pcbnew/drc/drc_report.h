@@ -26,6 +26,7 @@
 
 class BOARD;
 class RC_ITEMS_PROVIDER;
+struct DRC_PROFILE;
 
 class DRC_REPORT
 {
@@ -36,6 +37,11 @@ public:
                 std::shared_ptr<RC_ITEMS_PROVIDER> aRatsnestProvider,
                 std::shared_ptr<RC_ITEMS_PROVIDER> aFpWarningsProvider );
 
+    /**
+     * Include DRC profiling results (see DRC_ENGINE::SetProfiling()) in the JSON report.
+     */
+    void SetProfile( const DRC_PROFILE* aProfile ) { m_profile = aProfile; }
+
     bool WriteTextReport( const wxString& aFullFileName );
     bool WriteJsonReport( const wxString& aFullFileName );
 
@@ -45,6 +51,7 @@ private:
     std::shared_ptr<RC_ITEMS_PROVIDER> m_markersProvider;
     std::shared_ptr<RC_ITEMS_PROVIDER> m_ratsnestProvider;
     std::shared_ptr<RC_ITEMS_PROVIDER> m_fpWarningsProvider;
+    const DRC_PROFILE*                 m_profile;
 };
 
 
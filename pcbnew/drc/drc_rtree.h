@@ -28,12 +28,13 @@
 #include <board_item.h>
 #include <pad.h>
 #include <pcb_field.h>
+#include <algorithm>
 #include <memory>
 #include <unordered_set>
 #include <set>
 #include <vector>
 
-#include <geometry/rtree.h>
+#include <geometry/packed_rtree.h>
 #include <geometry/shape.h>
 #include <geometry/shape_segment.h>
 #include <math/vector2d.h>
@@ -75,7 +76,7 @@ public:
 
 private:
 
-    using drc_rtree = RTree<ITEM_WITH_SHAPE*, int, 2, double>;
+    using drc_rtree = PACKED_RTREE<ITEM_WITH_SHAPE*>;
 
 public:
 
@@ -161,6 +162,16 @@ public:
         }
     }
 
+    /**
+     * Pack the items inserted so far, so that the first search doesn't rebuild the tree while
+     * other threads may be iterating over it.  Call once all items are inserted.
+     */
+    void Build()
+    {
+        for( auto& [_, tree] : m_tree )
+            tree->Build();
+    }
+
     /**
      * Remove all items from the RTree.
      */
@@ -527,6 +538,193 @@ public:
         return 0;
     }
 
+    /**
+     * Candidate colliders for the items on a single layer, found in bulk by SweepColliding().
+     */
+    class SWEPT_PAIRS
+    {
+    public:
+        SWEPT_PAIRS() :
+                m_clearance( 0 )
+        {}
+
+        /**
+         * Equivalent to DRC_RTREE::QueryColliding() for an item selected by the reference
+         * filter given to SweepColliding(), but only visits the candidates found by the sweep
+         * rather than searching the tree again.
+         */
+        int QueryColliding( BOARD_ITEM* aRefItem, PCB_LAYER_ID aRefLayer,
+                            const std::function<bool( BOARD_ITEM* )>& aFilter,
+                            const std::function<bool( BOARD_ITEM* )>& aVisitor,
+                            int aClearance ) const
+        {
+            wxASSERT( aClearance <= m_clearance );
+
+            auto range = std::equal_range( m_pairs.begin(), m_pairs.end(),
+                                           PAIR( aRefItem, nullptr ),
+                                           []( const PAIR& aLhs, const PAIR& aRhs )
+                                           {
+                                               return aLhs.first < aRhs.first;
+                                           } );
+
+            if( range.first == range.second )
+                return 0;
+
+            std::shared_ptr<SHAPE> refShape = aRefItem->GetEffectiveShape( aRefLayer );
+
+            BOARD_ITEM* parent = nullptr;
+            bool        skipParent = false;
+            int         count = 0;
+
+            // Subshapes of the same item are adjacent, so the filter runs once per item and
+            // the first colliding subshape is enough.
+            for( auto it = range.first; it != range.second; ++it )
+            {
+                ITEM_WITH_SHAPE* item = it->second;
+
+                if( item->parent != parent )
+                {
+                    parent = item->parent;
+                    skipParent = aFilter && !aFilter( parent );
+                }
+
+                if( skipParent )
+                    continue;
+
+                wxCHECK( item->shape, count );
+
+                if( refShape->Collide( item->shape, aClearance ) )
+                {
+                    skipParent = true;
+                    count++;
+
+                    if( aVisitor && !aVisitor( parent ) )
+                        break;
+                }
+            }
+
+            return count;
+        }
+
+        size_t size() const { return m_pairs.size(); }
+
+    private:
+        friend class DRC_RTREE;
+
+        using PAIR = std::pair<BOARD_ITEM*, ITEM_WITH_SHAPE*>;
+
+        std::vector<PAIR> m_pairs;          ///< sorted by reference item, then by collider
+        int               m_clearance;
+    };
+
+    /**
+     * Broad phase for testing many items on \a aLayer at once.
+     *
+     * Rather than searching the tree once for each item, the layer's entries are sorted along
+     * one axis and swept, giving every pair whose bounding boxes come within \a aClearance of
+     * each other in a single pass.  The narrow phase is then run through
+     * SWEPT_PAIRS::QueryColliding() for each item.
+     *
+     * @param aRefFilter selects the items which will be queried; pairs are only kept for them.
+     */
+    SWEPT_PAIRS SweepColliding( PCB_LAYER_ID aLayer, int aClearance,
+                                const std::function<bool( BOARD_ITEM* )>& aRefFilter ) const
+    {
+        struct SWEEP_ENTRY
+        {
+            int64_t          min[2];
+            int64_t          max[2];
+            ITEM_WITH_SHAPE* item;
+            bool             isRef;
+        };
+
+        SWEPT_PAIRS              result;
+        std::vector<SWEEP_ENTRY> entries;
+        int64_t                  extent[2] = { 0, 0 };
+
+        result.m_clearance = aClearance;
+
+        for( ITEM_WITH_SHAPE* item : OnLayer( aLayer ) )
+        {
+            BOX2I       bbox = item->shape->BBox();
+            SWEEP_ENTRY entry;
+
+            entry.min[0] = bbox.GetX();
+            entry.min[1] = bbox.GetY();
+            entry.max[0] = bbox.GetRight();
+            entry.max[1] = bbox.GetBottom();
+            entry.item = item;
+            entry.isRef = aRefFilter( item->parent );
+
+            extent[0] += entry.max[0] - entry.min[0];
+            extent[1] += entry.max[1] - entry.min[1];
+
+            entries.push_back( entry );
+        }
+
+        // Sweep across the axis along which items are shortest, so that fewer of them overlap
+        // the sweep line at once.
+        const int axis = extent[0] <= extent[1] ? 0 : 1;
+        const int other = 1 - axis;
+
+        std::sort( entries.begin(), entries.end(),
+                   [axis]( const SWEEP_ENTRY& aLhs, const SWEEP_ENTRY& aRhs )
+                   {
+                       return aLhs.min[axis] < aRhs.min[axis];
+                   } );
+
+        std::vector<const SWEEP_ENTRY*> active;
+
+        for( const SWEEP_ENTRY& entry : entries )
+        {
+            size_t kept = 0;
+
+            for( const SWEEP_ENTRY* candidate : active )
+            {
+                // Entries are sorted, so anything ending before this one starts can't reach
+                // any later entry either.
+                if( candidate->max[axis] + aClearance < entry.min[axis] )
+                    continue;
+
+                active[kept++] = candidate;
+
+                if( candidate->item->parent == entry.item->parent
+                        || candidate->max[other] + aClearance < entry.min[other]
+                        || entry.max[other] + aClearance < candidate->min[other] )
+                {
+                    continue;
+                }
+
+                if( candidate->isRef )
+                    result.m_pairs.emplace_back( candidate->item->parent, entry.item );
+
+                if( entry.isRef )
+                    result.m_pairs.emplace_back( entry.item->parent, candidate->item );
+            }
+
+            active.resize( kept );
+            active.push_back( &entry );
+        }
+
+        std::sort( result.m_pairs.begin(), result.m_pairs.end(),
+                   []( const SWEPT_PAIRS::PAIR& aLhs, const SWEPT_PAIRS::PAIR& aRhs )
+                   {
+                       if( aLhs.first != aRhs.first )
+                           return aLhs.first < aRhs.first;
+
+                       if( aLhs.second->parent != aRhs.second->parent )
+                           return aLhs.second->parent < aRhs.second->parent;
+
+                       return aLhs.second < aRhs.second;
+                   } );
+
+        // An item with several subshapes can meet the same collider more than once
+        result.m_pairs.erase( std::unique( result.m_pairs.begin(), result.m_pairs.end() ),
+                              result.m_pairs.end() );
+
+        return result;
+    }
+
     /**
      * Return the number of items in the tree.
      *
@@ -542,7 +740,7 @@ public:
         return m_count == 0;
     }
 
-    using iterator = typename drc_rtree::Iterator;
+    using iterator = typename drc_rtree::iterator;
 
     /**
      * The DRC_LAYER struct provides a layer-specific auto-range iterator to the RTree.  Using
@@ -554,28 +752,39 @@ public:
      */
     struct DRC_LAYER
     {
-        DRC_LAYER( drc_rtree* aTree ) : layer_tree( aTree )
-        {
-            m_rect = { { INT_MIN, INT_MIN }, { INT_MAX, INT_MAX } };
-        };
+        DRC_LAYER( const drc_rtree* aTree ) :
+                layer_tree( aTree )
+        {}
 
-        DRC_LAYER( drc_rtree* aTree, const BOX2I& aRect ) : layer_tree( aTree )
+        DRC_LAYER( const drc_rtree* aTree, const BOX2I& aRect ) :
+                layer_tree( nullptr )
         {
-            m_rect = { { aRect.GetX(), aRect.GetY() },
-                       { aRect.GetRight(), aRect.GetBottom() } };
-        };
+            // The packed tree has no rectangle iterator, so collect the overlapping items
+            if( aTree )
+            {
+                const int min[2] = { aRect.GetX(), aRect.GetY() };
+                const int max[2] = { aRect.GetRight(), aRect.GetBottom() };
+
+                aTree->Search( min, max,
+                               [&]( ITEM_WITH_SHAPE* aItem )
+                               {
+                                   m_overlapping.push_back( aItem );
+                                   return true;
+                               } );
+            }
+        }
 
-        drc_rtree::Rect m_rect;
-        drc_rtree*      layer_tree;
+        const drc_rtree*              layer_tree;
+        std::vector<ITEM_WITH_SHAPE*> m_overlapping;
 
-        iterator begin()
+        iterator begin() const
         {
-            return layer_tree->begin( m_rect );
+            return layer_tree ? layer_tree->begin() : m_overlapping.begin();
         }
 
-        iterator end()
+        iterator end() const
         {
-            return layer_tree->end( m_rect );
+            return layer_tree ? layer_tree->end() : m_overlapping.end();
         }
     };
 
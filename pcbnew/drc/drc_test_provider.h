@@ -101,6 +101,20 @@ public:
     virtual const wxString GetName() const;
     virtual const wxString GetDescription() const;
 
+    /**
+     * Return true if this provider modifies board items or caches which other providers read,
+     * and so must not run alongside any other provider.
+     */
+    virtual bool IsExclusive() const { return false; }
+
+    /**
+     * Return true if this provider reads anything built by the #DRC_CACHE_GENERATOR (the item
+     * and zone trees, courtyard and net-tie caches, connectivity or component classes), either
+     * directly or through rule conditions.  Other providers can start while the caches are
+     * built, and can run alongside exclusive providers.
+     */
+    virtual bool UsesDRCCaches() const { return true; }
+
 protected:
     int forEachGeometryItem( const std::vector<KICAD_T>& aTypes, LSET aLayers,
                              const std::function<bool(BOARD_ITEM*)>& aFunc );
@@ -116,6 +130,11 @@ protected:
     virtual bool reportProgress( size_t aCount, size_t aSize, size_t aDelta = 1 );
     virtual bool reportPhase( const wxString& aStageName );
 
+    bool isErrorLimitExceeded( int aErrorCode ) const
+    {
+        return m_drcEngine->IsErrorLimitExceeded( aErrorCode, this );
+    }
+
     virtual void reportRuleStatistics();
     virtual void accountCheck( const DRC_RULE* ruleToTest );
     virtual void accountCheck( const DRC_CONSTRAINT& constraintToTest );
@@ -71,7 +71,7 @@ public:
 
 bool DRC_TEST_PROVIDER_ANNULAR_WIDTH::Run()
 {
-    if( m_drcEngine->IsErrorLimitExceeded( DRCE_ANNULAR_WIDTH ) )
+    if( isErrorLimitExceeded( DRCE_ANNULAR_WIDTH ) )
     {
         reportAux( wxT( "Annular width violations ignored. Skipping check." ) );
         return true;    // continue with other tests
@@ -259,7 +259,7 @@ bool DRC_TEST_PROVIDER_ANNULAR_WIDTH::Run()
     auto checkAnnularWidth =
             [&]( BOARD_ITEM* item ) -> bool
             {
-                if( m_drcEngine->IsErrorLimitExceeded( DRCE_ANNULAR_WIDTH ) )
+                if( isErrorLimitExceeded( DRCE_ANNULAR_WIDTH ) )
                     return false;
 
                 auto constraint = m_drcEngine->EvalRules( ANNULAR_WIDTH_CONSTRAINT, item, nullptr,
@@ -311,7 +311,7 @@ wxString DRC_TEST_PROVIDER_CONNECTION_WIDTH::layerDesc( PCB_LAYER_ID aLayer )
 
 bool DRC_TEST_PROVIDER_CONNECTION_WIDTH::Run()
 {
-    if( m_drcEngine->IsErrorLimitExceeded( DRCE_CONNECTION_WIDTH ) )
+    if( isErrorLimitExceeded( DRCE_CONNECTION_WIDTH ) )
         return true;    // Continue with other tests
 
     if( !reportPhase( _( "Checking nets for minimum connection width..." ) ) )
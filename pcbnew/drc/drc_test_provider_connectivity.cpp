@@ -83,8 +83,8 @@ bool DRC_TEST_PROVIDER_CONNECTIVITY::Run()
 
     for( PCB_TRACK* track : board->Tracks() )
     {
-        bool exceedT = m_drcEngine->IsErrorLimitExceeded( DRCE_DANGLING_TRACK );
-        bool exceedV = m_drcEngine->IsErrorLimitExceeded( DRCE_DANGLING_VIA );
+        bool exceedT = isErrorLimitExceeded( DRCE_DANGLING_TRACK );
+        bool exceedV = isErrorLimitExceeded( DRCE_DANGLING_VIA );
 
         if( exceedV && exceedT )
             break;
@@ -111,7 +111,7 @@ bool DRC_TEST_PROVIDER_CONNECTIVITY::Run()
     /* test starved zones */
     for( const auto& [ zone, zoneIslands ] : board->m_ZoneIsolatedIslandsMap )
     {
-        if( m_drcEngine->IsErrorLimitExceeded( DRCE_ISOLATED_COPPER ) )
+        if( isErrorLimitExceeded( DRCE_ISOLATED_COPPER ) )
             break;
 
         if( !reportProgress( ii++, count, progressDelta ) )
@@ -121,7 +121,7 @@ bool DRC_TEST_PROVIDER_CONNECTIVITY::Run()
         {
             for( int polyIdx : layerIslands.m_IsolatedOutlines )
             {
-                if( m_drcEngine->IsErrorLimitExceeded( DRCE_ISOLATED_COPPER ) )
+                if( isErrorLimitExceeded( DRCE_ISOLATED_COPPER ) )
                     break;
 
                 std::shared_ptr<SHAPE_POLY_SET> poly = zone->GetFilledPolysList( layer );
@@ -133,7 +133,7 @@ bool DRC_TEST_PROVIDER_CONNECTIVITY::Run()
         }
     }
 
-    if( m_drcEngine->IsErrorLimitExceeded( DRCE_UNCONNECTED_ITEMS ) )
+    if( isErrorLimitExceeded( DRCE_UNCONNECTED_ITEMS ) )
         return true;    // continue with other tests
 
     if( !reportPhase( _( "Checking net connections..." ) ) )
@@ -145,7 +145,7 @@ bool DRC_TEST_PROVIDER_CONNECTIVITY::Run()
     connectivity->RunOnUnconnectedEdges(
             [&]( CN_EDGE& edge )
             {
-                if( m_drcEngine->IsErrorLimitExceeded( DRCE_UNCONNECTED_ITEMS ) )
+                if( isErrorLimitExceeded( DRCE_UNCONNECTED_ITEMS ) )
                     return false;
 
                 if( !reportProgress( ii++, count, progressDelta ) )
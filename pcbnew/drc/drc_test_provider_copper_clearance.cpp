@@ -22,6 +22,7 @@
  */
 
 #include <common.h>
+#include <advanced_config.h>
 #include <math_for_graphics.h>
 #include <board_design_settings.h>
 #include <footprint.h>
@@ -95,6 +96,15 @@ private:
     bool testSingleLayerItemAgainstItem( BOARD_ITEM* item, SHAPE* itemShape, PCB_LAYER_ID layer,
                                          BOARD_ITEM* other );
 
+    /**
+     * Find the candidate colliders of the items accepted by \a aRefFilter on every copper
+     * layer in one pass per layer, rather than searching the copper item tree for each item.
+     *
+     * @return nothing if the batch broad phase is disabled.
+     */
+    std::map<PCB_LAYER_ID, DRC_RTREE::SWEPT_PAIRS>
+    sweepCopperLayers( const std::function<bool( BOARD_ITEM* )>& aRefFilter );
+
     void testTrackClearances();
 
     void testPadAgainstItem( PAD* pad, SHAPE* padShape, PCB_LAYER_ID layer, BOARD_ITEM* other );
@@ -138,14 +148,14 @@ bool DRC_TEST_PROVIDER_COPPER_CLEARANCE::Run()
 
     m_drcEpsilon = m_board->GetDesignSettings().GetDRCEpsilon();
 
-    if( !m_drcEngine->IsErrorLimitExceeded( DRCE_CLEARANCE ) )
+    if( !isErrorLimitExceeded( DRCE_CLEARANCE ) )
     {
         if( !reportPhase( _( "Checking track & via clearances..." ) ) )
             return false;   // DRC cancelled
 
         testTrackClearances();
     }
-    else if( !m_drcEngine->IsErrorLimitExceeded( DRCE_HOLE_CLEARANCE ) )
+    else if( !isErrorLimitExceeded( DRCE_HOLE_CLEARANCE ) )
     {
         if( !reportPhase( _( "Checking hole clearances..." ) ) )
             return false;   // DRC cancelled
@@ -153,15 +163,15 @@ bool DRC_TEST_PROVIDER_COPPER_CLEARANCE::Run()
         testTrackClearances();
     }
 
-    if( !m_drcEngine->IsErrorLimitExceeded( DRCE_CLEARANCE ) )
+    if( !isErrorLimitExceeded( DRCE_CLEARANCE ) )
     {
         if( !reportPhase( _( "Checking pad clearances..." ) ) )
             return false;   // DRC cancelled
 
         testPadClearances();
     }
-    else if( !m_drcEngine->IsErrorLimitExceeded( DRCE_SHORTING_ITEMS )
-            || !m_drcEngine->IsErrorLimitExceeded( DRCE_HOLE_CLEARANCE ) )
+    else if( !isErrorLimitExceeded( DRCE_SHORTING_ITEMS )
+            || !isErrorLimitExceeded( DRCE_HOLE_CLEARANCE ) )
     {
         if( !reportPhase( _( "Checking pads..." ) ) )
             return false;   // DRC cancelled
@@ -169,7 +179,7 @@ bool DRC_TEST_PROVIDER_COPPER_CLEARANCE::Run()
         testPadClearances();
     }
 
-    if( !m_drcEngine->IsErrorLimitExceeded( DRCE_CLEARANCE ) )
+    if( !isErrorLimitExceeded( DRCE_CLEARANCE ) )
     {
         if( !reportPhase( _( "Checking copper graphic clearances..." ) ) )
             return false;   // DRC cancelled
@@ -177,14 +187,14 @@ bool DRC_TEST_PROVIDER_COPPER_CLEARANCE::Run()
         testGraphicClearances();
     }
 
-    if( !m_drcEngine->IsErrorLimitExceeded( DRCE_CLEARANCE ) )
+    if( !isErrorLimitExceeded( DRCE_CLEARANCE ) )
     {
         if( !reportPhase( _( "Checking copper zone clearances..." ) ) )
             return false;   // DRC cancelled
 
         testZonesToZones();
     }
-    else if( !m_drcEngine->IsErrorLimitExceeded( DRCE_ZONES_INTERSECT ) )
+    else if( !isErrorLimitExceeded( DRCE_ZONES_INTERSECT ) )
     {
         if( !reportPhase( _( "Checking zones..." ) ) )
             return false;   // DRC cancelled
@@ -203,9 +213,9 @@ bool DRC_TEST_PROVIDER_COPPER_CLEARANCE::testSingleLayerItemAgainstItem( BOARD_I
                                                                          PCB_LAYER_ID layer,
                                                                          BOARD_ITEM* other )
 {
-    bool           testClearance = !m_drcEngine->IsErrorLimitExceeded( DRCE_CLEARANCE );
-    bool           testShorting = !m_drcEngine->IsErrorLimitExceeded( DRCE_SHORTING_ITEMS );
-    bool           testHoles = !m_drcEngine->IsErrorLimitExceeded( DRCE_HOLE_CLEARANCE );
+    bool           testClearance = !isErrorLimitExceeded( DRCE_CLEARANCE );
+    bool           testShorting = !isErrorLimitExceeded( DRCE_SHORTING_ITEMS );
+    bool           testHoles = !isErrorLimitExceeded( DRCE_HOLE_CLEARANCE );
     DRC_CONSTRAINT constraint;
     int            clearance = -1;
     int            actual;
@@ -433,8 +443,8 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testItemAgainstZone( BOARD_ITEM* aItem,
         }
     }
 
-    bool testClearance = !m_drcEngine->IsErrorLimitExceeded( DRCE_CLEARANCE );
-    bool testHoles = !m_drcEngine->IsErrorLimitExceeded( DRCE_HOLE_CLEARANCE );
+    bool testClearance = !isErrorLimitExceeded( DRCE_CLEARANCE );
+    bool testHoles = !isErrorLimitExceeded( DRCE_HOLE_CLEARANCE );
 
     if( !testClearance && !testHoles )
         return;
@@ -536,8 +546,8 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testKnockoutTextAgainstZone( BOARD_ITEM
                                                                       NETINFO_ITEM** aInheritedNet,
                                                                       ZONE* aZone )
 {
-    bool testClearance = !m_drcEngine->IsErrorLimitExceeded( DRCE_CLEARANCE );
-    bool testShorts = !m_drcEngine->IsErrorLimitExceeded( DRCE_SHORTING_ITEMS );
+    bool testClearance = !isErrorLimitExceeded( DRCE_CLEARANCE );
+    bool testShorts = !isErrorLimitExceeded( DRCE_SHORTING_ITEMS );
 
     if( !testClearance && !testShorts )
         return;
@@ -609,6 +619,37 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testKnockoutTextAgainstZone( BOARD_ITEM
 }
 
 
+std::map<PCB_LAYER_ID, DRC_RTREE::SWEPT_PAIRS>
+DRC_TEST_PROVIDER_COPPER_CLEARANCE::sweepCopperLayers(
+        const std::function<bool( BOARD_ITEM* )>& aRefFilter )
+{
+    std::map<PCB_LAYER_ID, DRC_RTREE::SWEPT_PAIRS> sweptPairs;
+
+    if( !ADVANCED_CFG::GetCfg().m_DRCBatchBroadPhase )
+        return sweptPairs;
+
+    thread_pool&                                     tp = GetKiCadThreadPool();
+    std::vector<PCB_LAYER_ID>                        layers;
+    std::vector<std::future<DRC_RTREE::SWEPT_PAIRS>> returns;
+
+    for( PCB_LAYER_ID layer : LSET::AllCuMask( m_board->GetCopperLayerCount() ).Seq() )
+    {
+        layers.push_back( layer );
+        returns.push_back( tp.submit(
+                [this, layer, &aRefFilter]()
+                {
+                    return m_board->m_CopperItemRTreeCache->SweepColliding(
+                            layer, m_board->m_DRCMaxClearance, aRefFilter );
+                } ) );
+    }
+
+    for( size_t ii = 0; ii < layers.size(); ++ii )
+        sweptPairs[ layers[ii] ] = returns[ii].get();
+
+    return sweptPairs;
+}
+
+
 void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testTrackClearances()
 {
     std::map<BOARD_ITEM*, int>                            freePadsUsageMap;
@@ -622,6 +663,13 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testTrackClearances()
 
     LSET boardCopperLayers = LSET::AllCuMask( m_board->GetCopperLayerCount() );
 
+    std::map<PCB_LAYER_ID, DRC_RTREE::SWEPT_PAIRS> sweptPairs = sweepCopperLayers(
+            []( BOARD_ITEM* item )
+            {
+                return item->Type() == PCB_TRACE_T || item->Type() == PCB_ARC_T
+                        || item->Type() == PCB_VIA_T;
+            } );
+
     auto testTrack = [&]( const int start_idx, const int end_idx )
     {
         for( int trackIdx = start_idx; trackIdx < end_idx; ++trackIdx )
@@ -632,8 +680,7 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testTrackClearances()
             {
                 std::shared_ptr<SHAPE> trackShape = track->GetEffectiveShape( layer );
 
-                m_board->m_CopperItemRTreeCache->QueryColliding( track, layer, layer,
-                        // Filter:
+                auto filter =
                         [&]( BOARD_ITEM* other ) -> bool
                         {
                             auto otherCItem = dynamic_cast<BOARD_CONNECTED_ITEM*>( other );
@@ -662,8 +709,9 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testTrackClearances()
                                 checkedPairs[ { a, b } ].layers.set( layer );
                                 return true;
                             }
-                        },
-                        // Visitor:
+                        };
+
+                auto visitor =
                         [&]( BOARD_ITEM* other ) -> bool
                         {
                             if( m_drcEngine->IsCancelled() )
@@ -710,8 +758,19 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testTrackClearances()
                             }
 
                             return !m_drcEngine->IsCancelled();
-                        },
-                        m_board->m_DRCMaxClearance );
+                        };
+
+                if( auto it = sweptPairs.find( layer ); it != sweptPairs.end() )
+                {
+                    it->second.QueryColliding( track, layer, filter, visitor,
+                                               m_board->m_DRCMaxClearance );
+                }
+                else
+                {
+                    m_board->m_CopperItemRTreeCache->QueryColliding( track, layer, layer, filter,
+                                                                     visitor,
+                                                                     m_board->m_DRCMaxClearance );
+                }
 
                 for( ZONE* zone : m_board->m_DRCCopperZones )
                 {
@@ -749,9 +808,9 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testPadAgainstItem( PAD* pad, SHAPE* pa
                                                              PCB_LAYER_ID aLayer,
                                                              BOARD_ITEM* other )
 {
-    bool testClearance = !m_drcEngine->IsErrorLimitExceeded( DRCE_CLEARANCE );
-    bool testShorting = !m_drcEngine->IsErrorLimitExceeded( DRCE_SHORTING_ITEMS );
-    bool testHoles = !m_drcEngine->IsErrorLimitExceeded( DRCE_HOLE_CLEARANCE );
+    bool testClearance = !isErrorLimitExceeded( DRCE_CLEARANCE );
+    bool testShorting = !isErrorLimitExceeded( DRCE_SHORTING_ITEMS );
+    bool testHoles = !isErrorLimitExceeded( DRCE_HOLE_CLEARANCE );
 
     // Disable some tests for net-tie objects in a footprint
     if( other->GetParent() == pad->GetParent() )
@@ -993,6 +1052,12 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testPadClearances( )
 
     LSET boardCopperLayers = LSET::AllCuMask( m_board->GetCopperLayerCount() );
 
+    std::map<PCB_LAYER_ID, DRC_RTREE::SWEPT_PAIRS> sweptPairs = sweepCopperLayers(
+            []( BOARD_ITEM* item )
+            {
+                return item->Type() == PCB_PAD_T;
+            } );
+
     std::future<void> retn = tp.submit(
             [&]()
             {
@@ -1007,8 +1072,7 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testPadClearances( )
 
                             std::shared_ptr<SHAPE> padShape = pad->GetEffectiveShape( layer );
 
-                            m_board->m_CopperItemRTreeCache->QueryColliding( pad, layer, layer,
-                                    // Filter:
+                            auto filter =
                                     [&]( BOARD_ITEM* other ) -> bool
                                     {
                                         BOARD_ITEM* a = pad;
@@ -1028,15 +1092,27 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testPadClearances( )
                                             checkedPairs[ { a, b } ] = 1;
                                             return true;
                                         }
-                                    },
-                                    // Visitor
+                                    };
+
+                            auto visitor =
                                     [&]( BOARD_ITEM* other ) -> bool
                                     {
                                         testPadAgainstItem( pad, padShape.get(), layer, other );
 
                                         return !m_drcEngine->IsCancelled();
-                                    },
-                                    m_board->m_DRCMaxClearance );
+                                    };
+
+                            if( auto it = sweptPairs.find( layer ); it != sweptPairs.end() )
+                            {
+                                it->second.QueryColliding( pad, layer, filter, visitor,
+                                                           m_board->m_DRCMaxClearance );
+                            }
+                            else
+                            {
+                                m_board->m_CopperItemRTreeCache->QueryColliding(
+                                        pad, layer, layer, filter, visitor,
+                                        m_board->m_DRCMaxClearance );
+                            }
 
                             for( ZONE* zone : m_board->m_DRCCopperZones )
                             {
@@ -1216,8 +1292,8 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testGraphicClearances( )
 
 void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testZonesToZones()
 {
-    bool           testClearance = !m_drcEngine->IsErrorLimitExceeded( DRCE_CLEARANCE );
-    bool           testIntersects = !m_drcEngine->IsErrorLimitExceeded( DRCE_ZONES_INTERSECT );
+    bool           testClearance = !isErrorLimitExceeded( DRCE_CLEARANCE );
+    bool           testIntersects = !isErrorLimitExceeded( DRCE_ZONES_INTERSECT );
     DRC_CONSTRAINT constraint;
 
     std::vector<std::map<PCB_LAYER_ID, std::vector<SEG>>> poly_segments;
@@ -66,6 +66,9 @@ public:
         return wxT( "Tests footprints' courtyard clearance" );
     }
 
+    // Rebuilds the footprint courtyard caches which rule conditions read
+    virtual bool IsExclusive() const override { return true; }
+
 private:
     bool testFootprintCourtyardDefinitions();
 
@@ -79,13 +82,13 @@ private:
 bool DRC_TEST_PROVIDER_COURTYARD_CLEARANCE::testFootprintCourtyardDefinitions()
 {
     // Detects missing (or malformed) footprint courtyards
-    if( !m_drcEngine->IsErrorLimitExceeded( DRCE_MALFORMED_COURTYARD)
-            || !m_drcEngine->IsErrorLimitExceeded( DRCE_MISSING_COURTYARD) )
+    if( !isErrorLimitExceeded( DRCE_MALFORMED_COURTYARD)
+            || !isErrorLimitExceeded( DRCE_MISSING_COURTYARD) )
     {
         if( !reportPhase( _( "Checking footprint courtyard definitions..." ) ) )
             return false;   // DRC cancelled
     }
-    else if( !m_drcEngine->IsErrorLimitExceeded( DRCE_OVERLAPPING_FOOTPRINTS) )
+    else if( !isErrorLimitExceeded( DRCE_OVERLAPPING_FOOTPRINTS) )
     {
         if( !reportPhase( _( "Gathering footprint courtyards..." ) ) )
             return false;   // DRC cancelled
@@ -106,7 +109,7 @@ bool DRC_TEST_PROVIDER_COURTYARD_CLEARANCE::testFootprintCourtyardDefinitions()
 
         if( ( footprint->GetFlags() & MALFORMED_COURTYARDS ) != 0 )
         {
-            if( m_drcEngine->IsErrorLimitExceeded( DRCE_MALFORMED_COURTYARD) )
+            if( isErrorLimitExceeded( DRCE_MALFORMED_COURTYARD) )
                 continue;
 
             OUTLINE_ERROR_HANDLER errorHandler =
@@ -124,7 +127,7 @@ bool DRC_TEST_PROVIDER_COURTYARD_CLEARANCE::testFootprintCourtyardDefinitions()
         else if( footprint->GetCourtyard( F_CrtYd ).OutlineCount() == 0
                 && footprint->GetCourtyard( B_CrtYd ).OutlineCount() == 0 )
         {
-            if( m_drcEngine->IsErrorLimitExceeded( DRCE_MISSING_COURTYARD ) )
+            if( isErrorLimitExceeded( DRCE_MISSING_COURTYARD ) )
                 continue;
 
             if( footprint->GetAttributes() & FP_ALLOW_MISSING_COURTYARD )
@@ -172,9 +175,9 @@ bool DRC_TEST_PROVIDER_COURTYARD_CLEARANCE::testCourtyardClearances()
             return false;   // DRC cancelled
 
         // Ensure tests realted to courtyard constraints are not fully disabled:
-        if( m_drcEngine->IsErrorLimitExceeded( DRCE_OVERLAPPING_FOOTPRINTS)
-            && m_drcEngine->IsErrorLimitExceeded( DRCE_PTH_IN_COURTYARD )
-            && m_drcEngine->IsErrorLimitExceeded( DRCE_NPTH_IN_COURTYARD ) )
+        if( isErrorLimitExceeded( DRCE_OVERLAPPING_FOOTPRINTS)
+            && isErrorLimitExceeded( DRCE_PTH_IN_COURTYARD )
+            && isErrorLimitExceeded( DRCE_NPTH_IN_COURTYARD ) )
         {
             return true;   // continue with other tests
         }
@@ -184,8 +187,8 @@ bool DRC_TEST_PROVIDER_COURTYARD_CLEARANCE::testCourtyardClearances()
         const SHAPE_POLY_SET& backA = fpA->GetCourtyard( B_CrtYd );
 
         if( frontA.OutlineCount() == 0 && backA.OutlineCount() == 0
-             && m_drcEngine->IsErrorLimitExceeded( DRCE_PTH_IN_COURTYARD )
-             && m_drcEngine->IsErrorLimitExceeded( DRCE_NPTH_IN_COURTYARD ) )
+             && isErrorLimitExceeded( DRCE_PTH_IN_COURTYARD )
+             && isErrorLimitExceeded( DRCE_NPTH_IN_COURTYARD ) )
         {
             // No courtyards defined and no hole testing against other footprint's courtyards
             continue;
@@ -206,8 +209,8 @@ bool DRC_TEST_PROVIDER_COURTYARD_CLEARANCE::testCourtyardClearances()
             const SHAPE_POLY_SET& backB = fpB->GetCourtyard( B_CrtYd );
 
             if( frontB.OutlineCount() == 0 && backB.OutlineCount() == 0
-                 && m_drcEngine->IsErrorLimitExceeded( DRCE_PTH_IN_COURTYARD )
-                 && m_drcEngine->IsErrorLimitExceeded( DRCE_NPTH_IN_COURTYARD ) )
+                 && isErrorLimitExceeded( DRCE_PTH_IN_COURTYARD )
+                 && isErrorLimitExceeded( DRCE_NPTH_IN_COURTYARD ) )
             {
                 // No courtyards defined and no hole testing against other footprint's courtyards
                 continue;
@@ -229,7 +232,7 @@ bool DRC_TEST_PROVIDER_COURTYARD_CLEARANCE::testCourtyardClearances()
             // if DRCE_OVERLAPPING_FOOTPRINTS is not diasbled
             if( frontA.OutlineCount() > 0 && frontB.OutlineCount() > 0
                     && frontA_worstCaseBBox.Intersects( frontB.BBoxFromCaches() )
-                    && !m_drcEngine->IsErrorLimitExceeded( DRCE_OVERLAPPING_FOOTPRINTS ) )
+                    && !isErrorLimitExceeded( DRCE_OVERLAPPING_FOOTPRINTS ) )
             {
                 constraint = m_drcEngine->EvalRules( COURTYARD_CLEARANCE_CONSTRAINT, fpA, fpB, F_Cu );
                 clearance = constraint.GetValue().Min();
@@ -261,7 +264,7 @@ bool DRC_TEST_PROVIDER_COURTYARD_CLEARANCE::testCourtyardClearances()
             // if DRCE_OVERLAPPING_FOOTPRINTS is not disabled
             if( backA.OutlineCount() > 0 && backB.OutlineCount() > 0
                     && backA_worstCaseBBox.Intersects( backB.BBoxFromCaches() )
-                    && !m_drcEngine->IsErrorLimitExceeded( DRCE_OVERLAPPING_FOOTPRINTS ) )
+                    && !isErrorLimitExceeded( DRCE_OVERLAPPING_FOOTPRINTS ) )
             {
                 constraint = m_drcEngine->EvalRules( COURTYARD_CLEARANCE_CONSTRAINT, fpA, fpB, B_Cu );
                 clearance = constraint.GetValue().Min();
@@ -334,7 +337,7 @@ bool DRC_TEST_PROVIDER_COURTYARD_CLEARANCE::testCourtyardClearances()
                         else
                             return;
 
-                        if( m_drcEngine->IsErrorLimitExceeded( errorCode ) )
+                        if( isErrorLimitExceeded( errorCode ) )
                             return;
 
                         if( pad->HasHole() )
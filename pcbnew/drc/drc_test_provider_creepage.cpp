@@ -78,7 +78,7 @@ bool DRC_TEST_PROVIDER_CREEPAGE::Run()
     m_board = m_drcEngine->GetBoard();
     m_reportedPairs.clear();
 
-    if( !m_drcEngine->IsErrorLimitExceeded( DRCE_CREEPAGE ) )
+    if( !isErrorLimitExceeded( DRCE_CREEPAGE ) )
     {
         if( !reportPhase( _( "Checking creepage..." ) ) )
             return false; // DRC cancelled
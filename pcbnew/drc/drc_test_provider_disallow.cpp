@@ -66,6 +66,10 @@ public:
     {
         return wxT( "Tests for disallowed items (e.g. keepouts)" );
     }
+
+    // Sets HOLE_PROXY on board items to test their holes, which rule conditions and the
+    // area caches read
+    virtual bool IsExclusive() const override { return true; }
 };
 
 
@@ -169,10 +173,7 @@ bool DRC_TEST_PROVIDER_DISALLOW::Run()
 
                 PTR_PTR_LAYER_CACHE_KEY key = { ruleArea, copperZone, UNDEFINED_LAYER };
 
-                {
-                    std::unique_lock<std::shared_mutex> writeLock( board->m_CachesMutex );
-                    board->m_IntersectsAreaCache[ key ] = isInside;
-                }
+                board->m_IntersectsAreaCache.Set( key, isInside );
 
                 done.fetch_add( 1 );
 
@@ -270,10 +271,10 @@ bool DRC_TEST_PROVIDER_DISALLOW::Run()
     forEachGeometryItem( {}, LSET::AllLayersMask(),
             [&]( BOARD_ITEM* item ) -> bool
             {
-                if( !m_drcEngine->IsErrorLimitExceeded( DRCE_TEXT_ON_EDGECUTS ) )
+                if( !isErrorLimitExceeded( DRCE_TEXT_ON_EDGECUTS ) )
                     checkTextOnEdgeCuts( item );
 
-                if( !m_drcEngine->IsErrorLimitExceeded( DRCE_ALLOWED_ITEMS ) )
+                if( !isErrorLimitExceeded( DRCE_ALLOWED_ITEMS ) )
                 {
                     if( ZONE* zone = dynamic_cast<ZONE*>( item ) )
                     {
@@ -145,12 +145,12 @@ bool DRC_TEST_PROVIDER_EDGE_CLEARANCE::testAgainstEdge( BOARD_ITEM* item, SHAPE*
 
 bool DRC_TEST_PROVIDER_EDGE_CLEARANCE::Run()
 {
-    if( !m_drcEngine->IsErrorLimitExceeded( DRCE_EDGE_CLEARANCE ) )
+    if( !isErrorLimitExceeded( DRCE_EDGE_CLEARANCE ) )
     {
         if( !reportPhase( _( "Checking copper to board edge clearances..." ) ) )
             return false;    // DRC cancelled
     }
-    else if( m_drcEngine->IsErrorLimitExceeded( DRCE_SILK_EDGE_CLEARANCE ) )
+    else if( isErrorLimitExceeded( DRCE_SILK_EDGE_CLEARANCE ) )
     {
         if( !reportPhase( _( "Checking silk to board edge clearances..." ) ) )
             return false;    // DRC cancelled
@@ -281,8 +281,8 @@ bool DRC_TEST_PROVIDER_EDGE_CLEARANCE::Run()
     forEachGeometryItem( s_allBasicItemsButZones, LSET::AllLayersMask(),
             [&]( BOARD_ITEM *item ) -> bool
             {
-                bool testCopper = !m_drcEngine->IsErrorLimitExceeded( DRCE_EDGE_CLEARANCE );
-                bool testSilk = !m_drcEngine->IsErrorLimitExceeded( DRCE_SILK_EDGE_CLEARANCE );
+                bool testCopper = !isErrorLimitExceeded( DRCE_EDGE_CLEARANCE );
+                bool testSilk = !isErrorLimitExceeded( DRCE_SILK_EDGE_CLEARANCE );
 
                 if( !testCopper && !testSilk )
                     return false;       // All limits exceeded; we're done
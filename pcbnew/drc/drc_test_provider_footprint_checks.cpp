@@ -85,7 +85,7 @@ bool DRC_TEST_PROVIDER_FOOTPRINT_CHECKS::Run()
 
     for( FOOTPRINT* footprint : m_drcEngine->GetBoard()->Footprints() )
     {
-        if( !m_drcEngine->IsErrorLimitExceeded( DRCE_FOOTPRINT_TYPE_MISMATCH ) )
+        if( !isErrorLimitExceeded( DRCE_FOOTPRINT_TYPE_MISMATCH ) )
         {
             footprint->CheckFootprintAttributes(
                     [&]( const wxString& aMsg )
@@ -95,13 +95,13 @@ bool DRC_TEST_PROVIDER_FOOTPRINT_CHECKS::Run()
                     } );
         }
 
-        if( !m_drcEngine->IsErrorLimitExceeded( DRCE_PAD_TH_WITH_NO_HOLE )
-                || !m_drcEngine->IsErrorLimitExceeded( DRCE_PADSTACK ) )
+        if( !isErrorLimitExceeded( DRCE_PAD_TH_WITH_NO_HOLE )
+                || !isErrorLimitExceeded( DRCE_PADSTACK ) )
         {
             footprint->CheckPads( m_drcEngine,
                     [&]( const PAD* aPad, int aErrorCode, const wxString& aMsg )
                     {
-                        if( !m_drcEngine->IsErrorLimitExceeded( aErrorCode ) )
+                        if( !isErrorLimitExceeded( aErrorCode ) )
                         {
                             errorHandler( aPad, nullptr, nullptr, aErrorCode, aMsg,
                                           aPad->GetPosition(), aPad->GetPrincipalLayer() );
@@ -114,7 +114,7 @@ bool DRC_TEST_PROVIDER_FOOTPRINT_CHECKS::Run()
 
         if( footprint->IsNetTie() )
         {
-            if( !m_drcEngine->IsErrorLimitExceeded( DRCE_SHORTING_ITEMS ) )
+            if( !isErrorLimitExceeded( DRCE_SHORTING_ITEMS ) )
             {
                 footprint->CheckNetTies(
                         [&]( const BOARD_ITEM* aItemA, const BOARD_ITEM* aItemB,
@@ -70,7 +70,7 @@ private:
 
 bool DRC_TEST_PROVIDER_HOLE_SIZE::Run()
 {
-    if( !m_drcEngine->IsErrorLimitExceeded( DRCE_DRILL_OUT_OF_RANGE ) )
+    if( !isErrorLimitExceeded( DRCE_DRILL_OUT_OF_RANGE ) )
     {
         if( !reportPhase( _( "Checking pad holes..." ) ) )
             return false;   // DRC cancelled
@@ -79,16 +79,16 @@ bool DRC_TEST_PROVIDER_HOLE_SIZE::Run()
         {
             for( PAD* pad : footprint->Pads() )
             {
-                if( !m_drcEngine->IsErrorLimitExceeded( DRCE_DRILL_OUT_OF_RANGE ) )
+                if( !isErrorLimitExceeded( DRCE_DRILL_OUT_OF_RANGE ) )
                     checkPadHole( pad );
             }
         }
     }
 
-    if( !m_drcEngine->IsErrorLimitExceeded( DRCE_MICROVIA_DRILL_OUT_OF_RANGE )
-            || !m_drcEngine->IsErrorLimitExceeded( DRCE_DRILL_OUT_OF_RANGE ) )
+    if( !isErrorLimitExceeded( DRCE_MICROVIA_DRILL_OUT_OF_RANGE )
+            || !isErrorLimitExceeded( DRCE_DRILL_OUT_OF_RANGE ) )
     {
-        if( !m_drcEngine->IsErrorLimitExceeded( DRCE_DRILL_OUT_OF_RANGE ) )
+        if( !isErrorLimitExceeded( DRCE_DRILL_OUT_OF_RANGE ) )
         {
             if( !reportPhase( _( "Checking via holes..." ) ) )
                 return false;   // DRC cancelled
@@ -103,8 +103,8 @@ bool DRC_TEST_PROVIDER_HOLE_SIZE::Run()
         {
             if( track->Type() == PCB_VIA_T )
             {
-                bool exceedMicro = m_drcEngine->IsErrorLimitExceeded( DRCE_MICROVIA_DRILL_OUT_OF_RANGE );
-                bool exceedStd = m_drcEngine->IsErrorLimitExceeded( DRCE_DRILL_OUT_OF_RANGE );
+                bool exceedMicro = isErrorLimitExceeded( DRCE_MICROVIA_DRILL_OUT_OF_RANGE );
+                bool exceedStd = isErrorLimitExceeded( DRCE_DRILL_OUT_OF_RANGE );
 
                 if( exceedMicro && exceedStd )
                     break;
@@ -95,8 +95,8 @@ static std::shared_ptr<SHAPE_CIRCLE> getHoleShape( BOARD_ITEM* aItem )
 
 bool DRC_TEST_PROVIDER_HOLE_TO_HOLE::Run()
 {
-    if( m_drcEngine->IsErrorLimitExceeded( DRCE_DRILLED_HOLES_TOO_CLOSE )
-            && m_drcEngine->IsErrorLimitExceeded( DRCE_DRILLED_HOLES_COLOCATED ) )
+    if( isErrorLimitExceeded( DRCE_DRILLED_HOLES_TOO_CLOSE )
+            && isErrorLimitExceeded( DRCE_DRILLED_HOLES_COLOCATED ) )
     {
         reportAux( wxT( "Hole to hole violations ignored. Tests not run." ) );
         return true;        // continue with other tests
@@ -267,8 +267,8 @@ bool DRC_TEST_PROVIDER_HOLE_TO_HOLE::Run()
 bool DRC_TEST_PROVIDER_HOLE_TO_HOLE::testHoleAgainstHole( BOARD_ITEM* aItem, SHAPE_CIRCLE* aHole,
                                                           BOARD_ITEM* aOther )
 {
-    bool reportCoLocation = !m_drcEngine->IsErrorLimitExceeded( DRCE_DRILLED_HOLES_COLOCATED );
-    bool reportHole2Hole = !m_drcEngine->IsErrorLimitExceeded( DRCE_DRILLED_HOLES_TOO_CLOSE );
+    bool reportCoLocation = !isErrorLimitExceeded( DRCE_DRILLED_HOLES_COLOCATED );
+    bool reportHole2Hole = !isErrorLimitExceeded( DRCE_DRILLED_HOLES_TOO_CLOSE );
 
     if( !reportCoLocation && !reportHole2Hole )
         return false;
@@ -66,6 +66,9 @@ public:
     {
         return wxT( "Performs board footprint vs library integity checks" );
     }
+
+    // Only compares footprints' own properties with the library footprints
+    virtual bool UsesDRCCaches() const override { return false; }
 };
 
 
@@ -826,8 +829,8 @@ bool DRC_TEST_PROVIDER_LIBRARY_PARITY::Run()
 
     for( FOOTPRINT* footprint : board->Footprints() )
     {
-        if( m_drcEngine->IsErrorLimitExceeded( DRCE_LIB_FOOTPRINT_ISSUES )
-                && m_drcEngine->IsErrorLimitExceeded( DRCE_LIB_FOOTPRINT_MISMATCH ) )
+        if( isErrorLimitExceeded( DRCE_LIB_FOOTPRINT_ISSUES )
+                && isErrorLimitExceeded( DRCE_LIB_FOOTPRINT_MISMATCH ) )
         {
             return true;    // Continue with other tests
         }
@@ -856,7 +859,7 @@ bool DRC_TEST_PROVIDER_LIBRARY_PARITY::Run()
 
         if( !libTableRow )
         {
-            if( !m_drcEngine->IsErrorLimitExceeded( DRCE_LIB_FOOTPRINT_ISSUES ) )
+            if( !isErrorLimitExceeded( DRCE_LIB_FOOTPRINT_ISSUES ) )
             {
                 std::shared_ptr<DRC_ITEM> drcItem = DRC_ITEM::Create( DRCE_LIB_FOOTPRINT_ISSUES );
                 msg.Printf( _( "The current configuration does not include the footprint library '%s'." ),
@@ -870,7 +873,7 @@ bool DRC_TEST_PROVIDER_LIBRARY_PARITY::Run()
         }
         else if( !libTable->HasLibrary( libName, true ) )
         {
-            if( !m_drcEngine->IsErrorLimitExceeded( DRCE_LIB_FOOTPRINT_ISSUES ) )
+            if( !isErrorLimitExceeded( DRCE_LIB_FOOTPRINT_ISSUES ) )
             {
                 std::shared_ptr<DRC_ITEM> drcItem = DRC_ITEM::Create( DRCE_LIB_FOOTPRINT_ISSUES );
                 msg.Printf( _( "The footprint library '%s' is not enabled in the current configuration." ),
@@ -884,7 +887,7 @@ bool DRC_TEST_PROVIDER_LIBRARY_PARITY::Run()
         }
         else if( !libTableRow->LibraryExists() )
         {
-            if( !m_drcEngine->IsErrorLimitExceeded( DRCE_LIB_FOOTPRINT_ISSUES ) )
+            if( !isErrorLimitExceeded( DRCE_LIB_FOOTPRINT_ISSUES ) )
             {
                 std::shared_ptr<DRC_ITEM> drcItem = DRC_ITEM::Create( DRCE_LIB_FOOTPRINT_ISSUES );
                 msg.Printf( _( "The footprint library '%s' was not found at '%s'." ),
@@ -921,7 +924,7 @@ bool DRC_TEST_PROVIDER_LIBRARY_PARITY::Run()
 
         if( !libFootprint )
         {
-            if( !m_drcEngine->IsErrorLimitExceeded( DRCE_LIB_FOOTPRINT_ISSUES ) )
+            if( !isErrorLimitExceeded( DRCE_LIB_FOOTPRINT_ISSUES ) )
             {
                 std::shared_ptr<DRC_ITEM> drcItem = DRC_ITEM::Create( DRCE_LIB_FOOTPRINT_ISSUES );
                 msg.Printf( _( "Footprint '%s' not found in library '%s'." ),
@@ -934,7 +937,7 @@ bool DRC_TEST_PROVIDER_LIBRARY_PARITY::Run()
         }
         else if( footprint->FootprintNeedsUpdate( libFootprint.get(), BOARD_ITEM::COMPARE_FLAGS::DRC ) )
         {
-            if( !m_drcEngine->IsErrorLimitExceeded( DRCE_LIB_FOOTPRINT_MISMATCH ) )
+            if( !isErrorLimitExceeded( DRCE_LIB_FOOTPRINT_MISMATCH ) )
             {
                 std::shared_ptr<DRC_ITEM> drcItem = DRC_ITEM::Create( DRCE_LIB_FOOTPRINT_MISMATCH );
                 msg.Printf( _( "Footprint '%s' does not match copy in library '%s'." ),
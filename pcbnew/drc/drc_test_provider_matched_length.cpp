@@ -302,10 +302,9 @@ bool DRC_TEST_PROVIDER_MATCHED_LENGTH::runInternal( bool aDelayReportMode )
 
     std::map<DRC_RULE*, std::set<BOARD_CONNECTED_ITEM*> > itemSets;
 
+    // Rebuilt by DRC_CACHE_GENERATOR
     std::shared_ptr<FROM_TO_CACHE> ftCache = m_board->GetConnectivity()->GetFromToCache();
 
-    ftCache->Rebuild( m_board );
-
     const size_t progressDelta = 100;
     size_t       count = 0;
     size_t       ii = 0;
@@ -89,7 +89,7 @@ void DRC_TEST_PROVIDER_MISC::testOutline()
             {
                 errorHandled = true;
 
-                if( m_drcEngine->IsErrorLimitExceeded( DRCE_INVALID_OUTLINE ) )
+                if( isErrorLimitExceeded( DRCE_INVALID_OUTLINE ) )
                     return;
 
                 if( !itemA )        // If we only have a single item, make sure it's A
@@ -176,7 +176,7 @@ void DRC_TEST_PROVIDER_MISC::testDisabledLayers()
     auto checkDisabledLayers =
             [&]( BOARD_ITEM* item ) -> bool
             {
-                if( m_drcEngine->IsErrorLimitExceeded( DRCE_DISABLED_LAYER_ITEM ) )
+                if( isErrorLimitExceeded( DRCE_DISABLED_LAYER_ITEM ) )
                     return false;
 
                 if( !reportProgress( ii++, items, progressDelta ) )
@@ -265,7 +265,7 @@ void DRC_TEST_PROVIDER_MISC::testAssertions()
                 if( !reportProgress( ii++, items, progressDelta ) )
                     return false;
 
-                if( !m_drcEngine->IsErrorLimitExceeded( DRCE_ASSERTION_FAILURE ) )
+                if( !isErrorLimitExceeded( DRCE_ASSERTION_FAILURE ) )
                 {
                     m_drcEngine->ProcessAssertions( item,
                             [&]( const DRC_CONSTRAINT* c )
@@ -308,7 +308,7 @@ void DRC_TEST_PROVIDER_MISC::testTextVars()
 
                 if( warningExpr.Matches( text ) )
                 {
-                    if( !m_drcEngine->IsErrorLimitExceeded( DRCE_GENERIC_WARNING ) )
+                    if( !isErrorLimitExceeded( DRCE_GENERIC_WARNING ) )
                     {
                         std::shared_ptr<DRC_ITEM> drcItem = DRC_ITEM::Create( DRCE_GENERIC_WARNING );
                         wxString                  drcText = warningExpr.GetMatch( text, 1 );
@@ -328,7 +328,7 @@ void DRC_TEST_PROVIDER_MISC::testTextVars()
 
                 if( errorExpr.Matches( text ) )
                 {
-                    if( !m_drcEngine->IsErrorLimitExceeded( DRCE_GENERIC_ERROR ) )
+                    if( !isErrorLimitExceeded( DRCE_GENERIC_ERROR ) )
                     {
                         std::shared_ptr<DRC_ITEM> drcItem = DRC_ITEM::Create( DRCE_GENERIC_ERROR );
                         wxString                  drcText = errorExpr.GetMatch( text, 1 );
@@ -359,7 +359,7 @@ void DRC_TEST_PROVIDER_MISC::testTextVars()
     forEachGeometryItem( itemTypes, LSET::AllLayersMask(),
             [&]( BOARD_ITEM* item ) -> bool
             {
-                if( m_drcEngine->IsErrorLimitExceeded( DRCE_UNRESOLVED_VARIABLE ) )
+                if( isErrorLimitExceeded( DRCE_UNRESOLVED_VARIABLE ) )
                     return false;
 
                 if( !reportProgress( ii++, items, progressDelta ) )
@@ -387,7 +387,7 @@ void DRC_TEST_PROVIDER_MISC::testTextVars()
     DS_PROXY_VIEW_ITEM* drawingSheet = m_drcEngine->GetDrawingSheet();
     DS_DRAW_ITEM_LIST   drawItems( pcbIUScale, FOR_ERC_DRC );
 
-    if( !drawingSheet || m_drcEngine->IsErrorLimitExceeded( DRCE_UNRESOLVED_VARIABLE ) )
+    if( !drawingSheet || isErrorLimitExceeded( DRCE_UNRESOLVED_VARIABLE ) )
         return;
 
     drawItems.SetPageNumber( wxT( "1" ) );
@@ -400,7 +400,7 @@ void DRC_TEST_PROVIDER_MISC::testTextVars()
 
     for( DS_DRAW_ITEM_BASE* item = drawItems.GetFirst(); item; item = drawItems.GetNext() )
     {
-        if( m_drcEngine->IsErrorLimitExceeded( DRCE_UNRESOLVED_VARIABLE ) )
+        if( isErrorLimitExceeded( DRCE_UNRESOLVED_VARIABLE ) )
             break;
 
         if( m_drcEngine->IsCancelled() )
@@ -428,7 +428,7 @@ bool DRC_TEST_PROVIDER_MISC::Run()
 {
     m_board = m_drcEngine->GetBoard();
 
-    if( !m_drcEngine->IsErrorLimitExceeded( DRCE_INVALID_OUTLINE ) )
+    if( !isErrorLimitExceeded( DRCE_INVALID_OUTLINE ) )
     {
         if( !reportPhase( _( "Checking board outline..." ) ) )
             return false;   // DRC cancelled
@@ -436,7 +436,7 @@ bool DRC_TEST_PROVIDER_MISC::Run()
         testOutline();
     }
 
-    if( !m_drcEngine->IsErrorLimitExceeded( DRCE_DISABLED_LAYER_ITEM ) )
+    if( !isErrorLimitExceeded( DRCE_DISABLED_LAYER_ITEM ) )
     {
         if( !reportPhase( _( "Checking disabled layers..." ) ) )
             return false;   // DRC cancelled
@@ -444,7 +444,7 @@ bool DRC_TEST_PROVIDER_MISC::Run()
         testDisabledLayers();
     }
 
-    if( !m_drcEngine->IsErrorLimitExceeded( DRCE_UNRESOLVED_VARIABLE ) )
+    if( !isErrorLimitExceeded( DRCE_UNRESOLVED_VARIABLE ) )
     {
         if( !reportPhase( _( "Checking text variables..." ) ) )
             return false;   // DRC cancelled
@@ -452,9 +452,9 @@ bool DRC_TEST_PROVIDER_MISC::Run()
         testTextVars();
     }
 
-    if( !m_drcEngine->IsErrorLimitExceeded( DRCE_ASSERTION_FAILURE )
-            || !m_drcEngine->IsErrorLimitExceeded( DRCE_GENERIC_WARNING )
-            || !m_drcEngine->IsErrorLimitExceeded( DRCE_GENERIC_ERROR ) )
+    if( !isErrorLimitExceeded( DRCE_ASSERTION_FAILURE )
+            || !isErrorLimitExceeded( DRCE_GENERIC_WARNING )
+            || !isErrorLimitExceeded( DRCE_GENERIC_ERROR ) )
     {
         if( !reportPhase( _( "Checking assertions..." ) ) )
             return false;   // DRC cancelled
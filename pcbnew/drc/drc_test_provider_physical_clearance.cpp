@@ -30,6 +30,7 @@
 #include <pcb_shape.h>
 #include <zone.h>
 #include <advanced_config.h>
+#include <bezier_curves.h>
 #include <geometry/geometry_utils.h>
 #include <geometry/seg.h>
 #include <geometry/shape_segment.h>
@@ -179,8 +180,8 @@ bool DRC_TEST_PROVIDER_PHYSICAL_CLEARANCE::Run()
     // Run clearance checks -between- items.
     //
 
-    if( !m_drcEngine->IsErrorLimitExceeded( DRCE_CLEARANCE )
-            || !m_drcEngine->IsErrorLimitExceeded( DRCE_HOLE_CLEARANCE ) )
+    if( !isErrorLimitExceeded( DRCE_CLEARANCE )
+            || !isErrorLimitExceeded( DRCE_HOLE_CLEARANCE ) )
     {
         if( !reportPhase( _( "Checking physical clearances..." ) ) )
             return false;   // DRC cancelled
@@ -310,11 +311,16 @@ bool DRC_TEST_PROVIDER_PHYSICAL_CLEARANCE::Run()
 
                             case SHAPE_T::BEZIER:
                             {
-                                SHAPE_LINE_CHAIN asPoly;
+                                SHAPE_LINE_CHAIN      asPoly;
+                                std::vector<VECTOR2I> bezierPoints;
 
-                                shape->RebuildBezierToSegmentsPointsList( ARC_HIGH_DEF );
+                                // Don't rebuild the shape's own points: other providers may be
+                                // reading them.
+                                BEZIER_POLY converter( shape->GetStart(), shape->GetBezierC1(),
+                                                       shape->GetBezierC2(), shape->GetEnd() );
+                                converter.GetPoly( bezierPoints, ARC_HIGH_DEF );
 
-                                for( const VECTOR2I& pt : shape->GetBezierPoints() )
+                                for( const VECTOR2I& pt : bezierPoints )
                                     asPoly.Append( pt );
 
                                 testShapeLineChain( asPoly, shape->GetWidth(), layer, item, c );
@@ -616,8 +622,8 @@ int DRC_TEST_PROVIDER_PHYSICAL_CLEARANCE::testItemAgainstItem( BOARD_ITEM* aItem
                                                                PCB_LAYER_ID aLayer,
                                                                BOARD_ITEM* aOther )
 {
-    bool           testClearance = !m_drcEngine->IsErrorLimitExceeded( DRCE_CLEARANCE );
-    bool           testHoles = !m_drcEngine->IsErrorLimitExceeded( DRCE_HOLE_CLEARANCE );
+    bool           testClearance = !isErrorLimitExceeded( DRCE_CLEARANCE );
+    bool           testHoles = !isErrorLimitExceeded( DRCE_HOLE_CLEARANCE );
     DRC_CONSTRAINT constraint;
     int            clearance = 0;
     int            actual;
@@ -775,8 +781,8 @@ void DRC_TEST_PROVIDER_PHYSICAL_CLEARANCE::testItemAgainstZones( BOARD_ITEM* aIt
         if( !worstCaseBBox.Intersects( zone->GetBoundingBox() ) )
             continue;
 
-        bool testClearance = !m_drcEngine->IsErrorLimitExceeded( DRCE_CLEARANCE );
-        bool testHoles = !m_drcEngine->IsErrorLimitExceeded( DRCE_HOLE_CLEARANCE );
+        bool testClearance = !isErrorLimitExceeded( DRCE_CLEARANCE );
+        bool testHoles = !isErrorLimitExceeded( DRCE_HOLE_CLEARANCE );
 
         if( !testClearance && !testHoles )
             return;
@@ -70,6 +70,9 @@ public:
         return wxT( "Performs layout-vs-schematics integity check" );
     }
 
+    // Only compares footprints and their pads' nets with the schematic netlist
+    virtual bool UsesDRCCaches() const override { return false; }
+
 private:
     void testNetlist( NETLIST& aNetlist );
 };
@@ -89,7 +92,7 @@ void DRC_TEST_PROVIDER_SCHEMATIC_PARITY::testNetlist( NETLIST& aNetlist )
     // Search for duplicate footprints on the board
     for( FOOTPRINT* footprint : board->Footprints() )
     {
-        if( m_drcEngine->IsErrorLimitExceeded( DRCE_DUPLICATE_FOOTPRINT ) )
+        if( isErrorLimitExceeded( DRCE_DUPLICATE_FOOTPRINT ) )
             break;
 
         auto ins = footprints.insert( footprint );
@@ -111,7 +114,7 @@ void DRC_TEST_PROVIDER_SCHEMATIC_PARITY::testNetlist( NETLIST& aNetlist )
 
         if( footprint == nullptr )
         {
-            if( !m_drcEngine->IsErrorLimitExceeded( DRCE_MISSING_FOOTPRINT ) )
+            if( !isErrorLimitExceeded( DRCE_MISSING_FOOTPRINT ) )
             {
                 wxString msg;
                 msg.Printf( _( "Missing footprint %s (%s)" ),
@@ -127,7 +130,7 @@ void DRC_TEST_PROVIDER_SCHEMATIC_PARITY::testNetlist( NETLIST& aNetlist )
         else
         {
             if( component->GetValue() != footprint->GetValue()
-                && !m_drcEngine->IsErrorLimitExceeded( DRCE_SCHEMATIC_PARITY ) )
+                && !isErrorLimitExceeded( DRCE_SCHEMATIC_PARITY ) )
             {
                 wxString msg;
                 msg.Printf( _( "Value (%s) doesn't match symbol value (%s)." ),
@@ -141,7 +144,7 @@ void DRC_TEST_PROVIDER_SCHEMATIC_PARITY::testNetlist( NETLIST& aNetlist )
             }
 
             if( component->GetFPID().GetUniStringLibId() != footprint->GetFPID().GetUniStringLibId()
-                && !m_drcEngine->IsErrorLimitExceeded( DRCE_SCHEMATIC_PARITY ) )
+                && !isErrorLimitExceeded( DRCE_SCHEMATIC_PARITY ) )
             {
                 wxString msg;
                 msg.Printf( _( "%s doesn't match footprint given by symbol (%s)." ),
@@ -154,7 +157,7 @@ void DRC_TEST_PROVIDER_SCHEMATIC_PARITY::testNetlist( NETLIST& aNetlist )
                 reportViolation( drcItem, footprint->GetPosition(), UNDEFINED_LAYER );
             }
 
-            if( !m_drcEngine->IsErrorLimitExceeded( DRCE_FOOTPRINT_FILTERS ) )
+            if( !isErrorLimitExceeded( DRCE_FOOTPRINT_FILTERS ) )
             {
                 wxString libIdLower = footprint->GetFPID().GetUniStringLibId().Lower();
                 wxString fpNameLower = footprint->GetFPID().GetUniStringLibItemName().Lower();
@@ -187,7 +190,7 @@ void DRC_TEST_PROVIDER_SCHEMATIC_PARITY::testNetlist( NETLIST& aNetlist )
 
             if( ( component->GetProperties().count( "dnp" ) > 0 )
                 != ( ( footprint->GetAttributes() & FP_DNP ) > 0 )
-                && !m_drcEngine->IsErrorLimitExceeded( DRCE_SCHEMATIC_PARITY ) )
+                && !isErrorLimitExceeded( DRCE_SCHEMATIC_PARITY ) )
             {
                 wxString msg;
                 msg.Printf( _( "'%s' settings differ." ), _( "Do not populate" ) );
@@ -200,7 +203,7 @@ void DRC_TEST_PROVIDER_SCHEMATIC_PARITY::testNetlist( NETLIST& aNetlist )
 
             if( ( component->GetProperties().count( "exclude_from_bom" ) > 0 )
                 != ( (footprint->GetAttributes() & FP_EXCLUDE_FROM_BOM ) > 0 )
-                && !m_drcEngine->IsErrorLimitExceeded( DRCE_SCHEMATIC_PARITY ) )
+                && !isErrorLimitExceeded( DRCE_SCHEMATIC_PARITY ) )
             {
                 wxString msg;
                 msg.Printf( _( "'%s' settings differ." ), _( "Exclude from bill of materials" ) );
@@ -213,7 +216,7 @@ void DRC_TEST_PROVIDER_SCHEMATIC_PARITY::testNetlist( NETLIST& aNetlist )
 
             for( PAD* pad : footprint->Pads() )
             {
-                if( m_drcEngine->IsErrorLimitExceeded( DRCE_NET_CONFLICT ) )
+                if( isErrorLimitExceeded( DRCE_NET_CONFLICT ) )
                     break;
 
                 if( !pad->CanHaveNumber() )
@@ -262,7 +265,7 @@ void DRC_TEST_PROVIDER_SCHEMATIC_PARITY::testNetlist( NETLIST& aNetlist )
 
             for( unsigned jj = 0; jj < component->GetNetCount(); ++jj )
             {
-                if( m_drcEngine->IsErrorLimitExceeded( DRCE_NET_CONFLICT ) )
+                if( isErrorLimitExceeded( DRCE_NET_CONFLICT ) )
                     break;
 
                 const COMPONENT_NET& sch_net = component->GetNet( jj );
@@ -296,7 +299,7 @@ void DRC_TEST_PROVIDER_SCHEMATIC_PARITY::testNetlist( NETLIST& aNetlist )
     // Search for component footprints found on board but not in netlist.
     for( FOOTPRINT* footprint : board->Footprints() )
     {
-        if( m_drcEngine->IsErrorLimitExceeded( DRCE_EXTRA_FOOTPRINT ) )
+        if( isErrorLimitExceeded( DRCE_EXTRA_FOOTPRINT ) )
             break;
 
         if( footprint->GetAttributes() & FP_BOARD_ONLY )
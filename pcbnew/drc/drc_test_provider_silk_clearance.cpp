@@ -75,7 +75,7 @@ bool DRC_TEST_PROVIDER_SILK_CLEARANCE::Run()
 {
     const int progressDelta = 500;
 
-    if( m_drcEngine->IsErrorLimitExceeded( DRCE_OVERLAPPING_SILK ) )
+    if( isErrorLimitExceeded( DRCE_OVERLAPPING_SILK ) )
     {
         reportAux( wxT( "Overlapping silk violations ignored.  Tests not run." ) );
         return true;    // continue with other tests
@@ -182,7 +182,7 @@ bool DRC_TEST_PROVIDER_SILK_CLEARANCE::Run()
 
                 std::shared_ptr<SHAPE> hole;
 
-                if( m_drcEngine->IsErrorLimitExceeded( DRCE_OVERLAPPING_SILK ) )
+                if( isErrorLimitExceeded( DRCE_OVERLAPPING_SILK ) )
                     return false;
 
                 if( isInvisibleText( refItem ) || isInvisibleText( testItem ) )
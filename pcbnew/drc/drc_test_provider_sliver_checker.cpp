@@ -78,7 +78,7 @@ wxString DRC_TEST_PROVIDER_SLIVER_CHECKER::layerDesc( PCB_LAYER_ID aLayer )
 
 bool DRC_TEST_PROVIDER_SLIVER_CHECKER::Run()
 {
-    if( m_drcEngine->IsErrorLimitExceeded( DRCE_COPPER_SLIVER ) )
+    if( isErrorLimitExceeded( DRCE_COPPER_SLIVER ) )
         return true;    // Continue with other tests
 
     if( !reportPhase( _( "Running sliver detection on copper layers..." ) ) )
@@ -184,7 +184,7 @@ bool DRC_TEST_PROVIDER_SLIVER_CHECKER::Run()
         PCB_LAYER_ID    layer = copperLayers[ii];
         SHAPE_POLY_SET& poly = layerPolys[ii];
 
-        if( m_drcEngine->IsErrorLimitExceeded( DRCE_COPPER_SLIVER ) )
+        if( isErrorLimitExceeded( DRCE_COPPER_SLIVER ) )
             continue;
 
         // Frequently, in filled areas, some points of the polygons are very near (dist is only
@@ -260,7 +260,7 @@ void DRC_TEST_PROVIDER_SOLDER_MASK::testSilkToMaskClearance()
     forEachGeometryItem( s_allBasicItems, silkLayers,
             [&]( BOARD_ITEM* item ) -> bool
             {
-                if( m_drcEngine->IsErrorLimitExceeded( DRCE_SILK_CLEARANCE ) )
+                if( isErrorLimitExceeded( DRCE_SILK_CLEARANCE ) )
                     return false;
 
                 if( !reportProgress( ii++, count, progressDelta ) )
@@ -715,7 +715,7 @@ void DRC_TEST_PROVIDER_SOLDER_MASK::testMaskBridges()
     forEachGeometryItem( s_allBasicItemsButZones, copperAndMaskLayers,
             [&]( BOARD_ITEM* item ) -> bool
             {
-                if( m_drcEngine->IsErrorLimitExceeded( DRCE_SOLDERMASK_BRIDGE ) )
+                if( isErrorLimitExceeded( DRCE_SOLDERMASK_BRIDGE ) )
                     return false;
 
                 if( !reportProgress( ii++, count, progressDelta ) )
@@ -758,8 +758,8 @@ void DRC_TEST_PROVIDER_SOLDER_MASK::testMaskBridges()
 
 bool DRC_TEST_PROVIDER_SOLDER_MASK::Run()
 {
-    if( m_drcEngine->IsErrorLimitExceeded( DRCE_SILK_CLEARANCE )
-            && m_drcEngine->IsErrorLimitExceeded( DRCE_SOLDERMASK_BRIDGE ) )
+    if( isErrorLimitExceeded( DRCE_SILK_CLEARANCE )
+            && isErrorLimitExceeded( DRCE_SOLDERMASK_BRIDGE ) )
     {
         reportAux( wxT( "Solder mask violations ignored. Tests not run." ) );
         return true;    // continue with other tests
@@ -71,8 +71,8 @@ bool DRC_TEST_PROVIDER_TEXT_DIMS::Run()
     int       count = 0;
     int       ii = 0;
 
-    if( m_drcEngine->IsErrorLimitExceeded( DRCE_TEXT_HEIGHT )
-            && m_drcEngine->IsErrorLimitExceeded( DRCE_TEXT_THICKNESS ) )
+    if( isErrorLimitExceeded( DRCE_TEXT_HEIGHT )
+            && isErrorLimitExceeded( DRCE_TEXT_THICKNESS ) )
     {
         reportAux( wxT( "Text dimension violations ignored. Tests not run." ) );
         return true;        // continue with other tests
@@ -91,7 +91,7 @@ bool DRC_TEST_PROVIDER_TEXT_DIMS::Run()
     auto checkTextHeight =
             [&]( BOARD_ITEM* item, EDA_TEXT* text ) -> bool
             {
-                if( m_drcEngine->IsErrorLimitExceeded( DRCE_TEXT_HEIGHT ) )
+                if( isErrorLimitExceeded( DRCE_TEXT_HEIGHT ) )
                     return false;
 
                 DRC_CONSTRAINT constraint = m_drcEngine->EvalRules( TEXT_HEIGHT_CONSTRAINT, item,
@@ -288,12 +288,12 @@ bool DRC_TEST_PROVIDER_TEXT_DIMS::Run()
                     if( !text->IsVisible() )
                         return true;
 
-                    if( m_drcEngine->IsErrorLimitExceeded( DRCE_TEXT_THICKNESS ) )
+                    if( isErrorLimitExceeded( DRCE_TEXT_THICKNESS ) )
                         strikes++;
                     else
                         checkTextThickness( item, text );
 
-                    if( m_drcEngine->IsErrorLimitExceeded( DRCE_TEXT_HEIGHT ) )
+                    if( isErrorLimitExceeded( DRCE_TEXT_HEIGHT ) )
                         strikes++;
                     else
                         checkTextHeight( item, text );
@@ -68,8 +68,8 @@ public:
 
 bool DRC_TEST_PROVIDER_TEXT_MIRRORING::Run()
 {
-    if( m_drcEngine->IsErrorLimitExceeded( DRCE_MIRRORED_TEXT_ON_FRONT_LAYER )
-            && m_drcEngine->IsErrorLimitExceeded( DRCE_NONMIRRORED_TEXT_ON_BACK_LAYER ) )
+    if( isErrorLimitExceeded( DRCE_MIRRORED_TEXT_ON_FRONT_LAYER )
+            && isErrorLimitExceeded( DRCE_NONMIRRORED_TEXT_ON_BACK_LAYER ) )
     {
         reportAux( wxT( "Text mirroring violations ignored. Tests not run." ) );
         return true;        // continue with other tests
@@ -84,7 +84,7 @@ bool DRC_TEST_PROVIDER_TEXT_MIRRORING::Run()
     auto checkTextMirroring =
             [&]( BOARD_ITEM* item, EDA_TEXT* text, bool isMirrored, int errorCode )
             {
-                if( m_drcEngine->IsErrorLimitExceeded( errorCode ) )
+                if( isErrorLimitExceeded( errorCode ) )
                     return;
 
                 bool layerMatch = ( isMirrored && topLayers.Contains( item->GetLayer() ) )
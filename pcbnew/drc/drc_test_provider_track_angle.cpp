@@ -63,7 +63,7 @@ public:
 
 bool DRC_TEST_PROVIDER_TRACK_ANGLE::Run()
 {
-    if( m_drcEngine->IsErrorLimitExceeded( DRCE_TRACK_ANGLE ) )
+    if( isErrorLimitExceeded( DRCE_TRACK_ANGLE ) )
     {
         reportAux( wxT( "Track angle violations ignored. Tests not run." ) );
         return true;        // continue with other tests
@@ -81,7 +81,7 @@ bool DRC_TEST_PROVIDER_TRACK_ANGLE::Run()
     auto checkTrackAngle =
             [&]( PCB_TRACK* item ) -> bool
             {
-                if( m_drcEngine->IsErrorLimitExceeded( DRCE_TRACK_ANGLE ) )
+                if( isErrorLimitExceeded( DRCE_TRACK_ANGLE ) )
                 {
                     return false;
                 }
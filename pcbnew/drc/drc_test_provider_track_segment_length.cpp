@@ -60,7 +60,7 @@ public:
 
 bool DRC_TEST_PROVIDER_TRACK_SEGMENT_LENGTH::Run()
 {
-    if( m_drcEngine->IsErrorLimitExceeded( DRCE_TRACK_SEGMENT_LENGTH ) )
+    if( isErrorLimitExceeded( DRCE_TRACK_SEGMENT_LENGTH ) )
     {
         reportAux( wxT( "Track segment length violations ignored. Tests not run." ) );
         return true;        // continue with other tests
@@ -78,7 +78,7 @@ bool DRC_TEST_PROVIDER_TRACK_SEGMENT_LENGTH::Run()
     auto checkTrackSegmentLength =
             [&]( BOARD_ITEM* item ) -> bool
             {
-                if( m_drcEngine->IsErrorLimitExceeded( DRCE_TRACK_SEGMENT_LENGTH ) )
+                if( isErrorLimitExceeded( DRCE_TRACK_SEGMENT_LENGTH ) )
                     return false;
 
                 int      actual;
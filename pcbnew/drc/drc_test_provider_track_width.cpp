@@ -59,7 +59,7 @@ public:
 
 bool DRC_TEST_PROVIDER_TRACK_WIDTH::Run()
 {
-    if( m_drcEngine->IsErrorLimitExceeded( DRCE_TRACK_WIDTH ) )
+    if( isErrorLimitExceeded( DRCE_TRACK_WIDTH ) )
     {
         reportAux( wxT( "Track width violations ignored. Tests not run." ) );
         return true;        // continue with other tests
@@ -77,7 +77,7 @@ bool DRC_TEST_PROVIDER_TRACK_WIDTH::Run()
     auto checkTrackWidth =
             [&]( BOARD_ITEM* item ) -> bool
             {
-                if( m_drcEngine->IsErrorLimitExceeded( DRCE_TRACK_WIDTH ) )
+                if( isErrorLimitExceeded( DRCE_TRACK_WIDTH ) )
                     return false;
 
                 int      actual;
@@ -59,7 +59,7 @@ public:
 
 bool DRC_TEST_PROVIDER_VIA_DIAMETER::Run()
 {
-    if( m_drcEngine->IsErrorLimitExceeded( DRCE_VIA_DIAMETER ) )
+    if( isErrorLimitExceeded( DRCE_VIA_DIAMETER ) )
     {
         reportAux( wxT( "Via diameter violations ignored. Tests not run." ) );
         return true;        // continue with other tests
@@ -77,7 +77,7 @@ bool DRC_TEST_PROVIDER_VIA_DIAMETER::Run()
     auto checkViaDiameter =
             [&]( BOARD_ITEM* item ) -> bool
             {
-                if( m_drcEngine->IsErrorLimitExceeded( DRCE_VIA_DIAMETER ) )
+                if( isErrorLimitExceeded( DRCE_VIA_DIAMETER ) )
                     return false;
 
                 if( item->Type() != PCB_VIA_T )
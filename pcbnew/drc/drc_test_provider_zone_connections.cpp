@@ -98,7 +98,7 @@ void DRC_TEST_PROVIDER_ZONE_CONNECTIONS::testZoneLayer( ZONE* aZone, PCB_LAYER_I
     {
         for( PAD* pad : footprint->Pads() )
         {
-            if( m_drcEngine->IsErrorLimitExceeded( DRCE_STARVED_THERMAL ) )
+            if( isErrorLimitExceeded( DRCE_STARVED_THERMAL ) )
                 return;
 
             if( m_drcEngine->IsCancelled() )
@@ -61,6 +61,17 @@
 #include <Message_Messenger.hxx>
 #endif
 
+#include <mutex>
+
+
+/**
+ * Guards the OpenCascade state shared by every export: the application holding the documents,
+ * the messenger printers, the reader and writer settings in Interface_Static and the working
+ * directory the files are written from.  Exports of boards by jobs run at the same time are
+ * made one at a time.
+ */
+static std::mutex s_exportMutex;
+
 
 void ReportMessage( const wxString& aMessage )
 {
@@ -154,6 +165,9 @@ EXPORTER_STEP::EXPORTER_STEP( BOARD* aBoard, const EXPORTER_STEP_PARAMS& aParams
 
 EXPORTER_STEP::~EXPORTER_STEP()
 {
+    // Closing the model's document changes the shared application
+    std::lock_guard<std::mutex> lock( s_exportMutex );
+    m_pcbModel.reset();
 }
 
 
@@ -726,6 +740,8 @@ bool EXPORTER_STEP::buildBoard3DShapes()
 
 bool EXPORTER_STEP::Export()
 {
+    std::lock_guard<std::mutex> lock( s_exportMutex );
+
     // Display the export time, for statistics
     int64_t stats_startExportTime = GetRunningMicroSecs();
 
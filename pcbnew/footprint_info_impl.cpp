@@ -22,6 +22,7 @@
 
 #include <footprint_info_impl.h>
 
+#include <advanced_config.h>
 #include <dialogs/html_message_box.h>
 #include <footprint.h>
 #include <footprint_info.h>
@@ -29,6 +30,8 @@
 #include <kiway.h>
 #include <locale_io.h>
 #include <lib_id.h>
+#include <mmh3_hash.h>
+#include <paths.h>
 #include <progress_reporter.h>
 #include <string_utils.h>
 #include <thread_pool.h>
@@ -36,10 +39,24 @@
 
 #include <kiplatform/io.h>
 
+#include <wx/dir.h>
+#include <wx/filename.h>
 #include <wx/textfile.h>
 #include <wx/txtstrm.h>
 #include <wx/wfstream.h>
 
+#include <mutex>
+
+
+// An index written with another format version is treated as out of date and rewritten.
+static const int      FP_INDEX_VERSION = 1;
+static const uint32_t FP_INDEX_SEED = 0x58444946;      // "FIDX"
+static const wxString FP_INDEX_HEADER = wxS( "kicad_footprint_index" );
+
+// Indexes which haven't been read or written for this long belong to libraries which are no
+// longer used, or to old copies of libraries which have moved.
+static const int      FP_INDEX_MAX_AGE_DAYS = 60;
+
 
 void FOOTPRINT_INFO_IMPL::load()
 {
@@ -133,14 +150,35 @@ bool FOOTPRINT_LIST_IMPL::ReadFootprintFiles( FP_LIB_TABLE* aTable, const wxStri
     m_list.clear();
     m_queue.clear();
 
+    bool needsCLocale = false;
+
+    // The KiCad plugin reads numbers without the global locale, but other plugins don't
+    auto queueLibrary =
+            [&]( const wxString& aLibNickname )
+            {
+                m_queue.push( aLibNickname );
+
+                try
+                {
+                    const FP_LIB_TABLE_ROW* row = aTable->FindRow( aLibNickname, true );
+
+                    if( row && row->GetFileType() != PCB_IO_MGR::KICAD_SEXP )
+                        needsCLocale = true;
+                }
+                catch( const IO_ERROR& )
+                {
+                    // Reported when the library is loaded
+                }
+            };
+
     if( aNickname )
     {
-        m_queue.push( *aNickname );
+        queueLibrary( *aNickname );
     }
     else
     {
         for( const wxString& nickname : aTable->GetLogicalLibs() )
-            m_queue.push( nickname );
+            queueLibrary( nickname );
     }
 
     if( m_progress_reporter )
@@ -149,7 +187,7 @@ bool FOOTPRINT_LIST_IMPL::ReadFootprintFiles( FP_LIB_TABLE* aTable, const wxStri
         m_progress_reporter->Report( _( "Loading footprints..." ) );
     }
 
-    loadFootprints();
+    loadFootprints( needsCLocale );
 
     if( m_progress_reporter )
         m_progress_reporter->AdvancePhase();
@@ -163,51 +201,99 @@ bool FOOTPRINT_LIST_IMPL::ReadFootprintFiles( FP_LIB_TABLE* aTable, const wxStri
 }
 
 
-void FOOTPRINT_LIST_IMPL::loadFootprints()
+void FOOTPRINT_LIST_IMPL::loadFootprints( bool aNeedsCLocale )
 {
-    LOCALE_IO toggle_locale;
+    std::optional<LOCALE_IO> toggle_locale;
 
-    // Parse the footprints in parallel. WARNING! This requires changing the locale, which is
-    // GLOBAL. It is only thread safe to construct the LOCALE_IO before the threads are created,
-    // destroy it after they finish, and block the main (GUI) thread while they work. Any deviation
-    // from this will cause nasal demons.
-    //
-    // TODO: blast LOCALE_IO into the sun
+    // Parse the footprints in parallel. WARNING! Plugins other than the KiCad one require
+    // changing the locale, which is GLOBAL. It is only thread safe to construct the LOCALE_IO
+    // before the threads are created, destroy it after they finish, and block the main (GUI)
+    // thread while they work. Any deviation from this will cause nasal demons.
+    if( aNeedsCLocale )
+        toggle_locale.emplace();
 
     SYNC_QUEUE<std::unique_ptr<FOOTPRINT_INFO>> queue_parsed;
     thread_pool&                                tp = GetKiCadThreadPool();
     size_t                                      num_elements = m_queue.size();
     std::vector<std::future<size_t>>            returns( num_elements );
 
+    bool useIndex = ADVANCED_CFG::GetCfg().m_FootprintLibraryIndex;
+
+    if( useIndex )
+    {
+        static std::once_flag pruned;
+
+        std::call_once( pruned,
+                        []()
+                        {
+                            PruneLibraryIndexes( FP_INDEX_MAX_AGE_DAYS );
+                        } );
+    }
+
     auto fp_thread =
-            [ this, &queue_parsed ]() -> size_t
+            [ this, &queue_parsed, useIndex ]() -> size_t
             {
                 wxString nickname;
 
                 if( m_cancelled || !m_queue.pop( nickname ) )
                     return 0;
 
-                wxArrayString fpnames;
+                std::vector<std::unique_ptr<FOOTPRINT_INFO>> footprints;
+                wxString                                     uri;
+                long long                                    timestamp = 0;
 
-                CatchErrors(
-                        [&]()
+                // KiCad libraries which haven't changed since they were last indexed aren't
+                // parsed.  Other plugins don't all have a usable library timestamp (several
+                // always return 0), so their libraries are always read.
+                if( useIndex )
+                {
+                    try
+                    {
+                        const FP_LIB_TABLE_ROW* row = m_lib_table->FindRow( nickname, true );
+
+                        if( row && row->GetFileType() == PCB_IO_MGR::KICAD_SEXP )
                         {
-                            m_lib_table->FootprintEnumerate( fpnames, nickname, false );
-                        } );
+                            uri = row->GetFullURI( true );
+                            timestamp = m_lib_table->GenerateTimestamp( &nickname );
+                        }
+                    }
+                    catch( const IO_ERROR& )
+                    {
+                        // Reported when the library is enumerated below
+                        uri.clear();
+                    }
+                }
 
-                for( wxString fpname : fpnames )
+                if( uri.IsEmpty() || !readLibraryIndex( nickname, uri, timestamp, footprints ) )
                 {
-                    CatchErrors(
+                    wxArrayString fpnames;
+                    bool          ok = CatchErrors(
                             [&]()
                             {
-                                auto* fpinfo = new FOOTPRINT_INFO_IMPL( this, nickname, fpname );
-                                queue_parsed.move_push( std::unique_ptr<FOOTPRINT_INFO>( fpinfo ) );
+                                m_lib_table->FootprintEnumerate( fpnames, nickname, false );
                             } );
 
-                    if( m_cancelled )
-                        return 0;
+                    for( wxString fpname : fpnames )
+                    {
+                        ok &= CatchErrors(
+                                [&]()
+                                {
+                                    footprints.emplace_back(
+                                            new FOOTPRINT_INFO_IMPL( this, nickname, fpname ) );
+                                } );
+
+                        if( m_cancelled )
+                            return 0;
+                    }
+
+                    // Don't index a library which could only be partly read
+                    if( ok && !uri.IsEmpty() )
+                        writeLibraryIndex( nickname, uri, timestamp, footprints );
                 }
 
+                for( std::unique_ptr<FOOTPRINT_INFO>& fpinfo : footprints )
+                    queue_parsed.move_push( std::move( fpinfo ) );
+
                 if( m_progress_reporter )
                     m_progress_reporter->AdvanceProgress();
 
@@ -335,3 +421,177 @@ void FOOTPRINT_LIST_IMPL::ReadCacheFromFile( const wxString& aFilePath )
     if( cacheFile.IsOpened() )
         cacheFile.Close();
 }
+
+
+static wxString libraryIndexDir()
+{
+    wxFileName fn;
+    fn.AssignDir( PATHS::GetUserCachePath() );
+    fn.AppendDir( wxT( "footprint_index" ) );
+
+    return fn.GetPath();
+}
+
+
+wxString FOOTPRINT_LIST_IMPL::libraryIndexPath( const wxString& aNickname,
+                                                const wxString& aLibraryURI )
+{
+    // The library timestamp depends on the nickname as well as the files
+    MMH3_HASH hash( FP_INDEX_SEED );
+    hash.add( std::string( aLibraryURI.utf8_str() ) );
+    hash.add( std::string( aNickname.utf8_str() ) );
+
+    wxFileName fn( libraryIndexDir(), wxString( hash.digest().ToString() ) );
+    fn.SetExt( wxT( "idx" ) );
+
+    return fn.GetFullPath();
+}
+
+
+void FOOTPRINT_LIST_IMPL::writeLibraryIndex(
+        const wxString& aNickname, const wxString& aLibraryURI, long long aTimestamp,
+        const std::vector<std::unique_ptr<FOOTPRINT_INFO>>& aFootprints )
+{
+    wxString   path = libraryIndexPath( aNickname, aLibraryURI );
+    wxFileName fn( path );
+
+    if( !PATHS::EnsurePathExists( fn.GetPath() ) )
+        return;
+
+    // Several KiCad instances may share the cache directory, and one of them could be reading
+    // this index right now.  It is only renamed into place once completely written.
+    wxString tmpPath = wxFileName::CreateTempFileName( path );
+
+    if( tmpPath.IsEmpty() )
+        return;
+
+    {
+        wxFFileOutputStream outStream( tmpPath );
+        wxTextOutputStream  txtStream( outStream );
+
+        if( !outStream.IsOk() )
+        {
+            wxRemoveFile( tmpPath );
+            return;
+        }
+
+        txtStream << FP_INDEX_HEADER << wxString::Format( wxT( " %d" ), FP_INDEX_VERSION )
+                  << endl;
+        txtStream << EscapeString( aLibraryURI, CTX_LINE ) << endl;
+        txtStream << EscapeString( aNickname, CTX_LINE ) << endl;
+        txtStream << wxString::Format( wxT( "%lld" ), aTimestamp ) << endl;
+        txtStream << wxString::Format( wxT( "%zu" ), aFootprints.size() ) << endl;
+
+        for( const std::unique_ptr<FOOTPRINT_INFO>& fpinfo : aFootprints )
+        {
+            txtStream << fpinfo->GetName() << endl;
+            txtStream << EscapeString( fpinfo->GetDesc(), CTX_LINE ) << endl;
+            txtStream << EscapeString( fpinfo->GetKeywords(), CTX_LINE ) << endl;
+            txtStream << wxString::Format( wxT( "%u" ), fpinfo->GetPadCount() ) << endl;
+            txtStream << wxString::Format( wxT( "%u" ), fpinfo->GetUniquePadCount() ) << endl;
+        }
+
+        txtStream.Flush();
+
+        if( !outStream.Close() )
+        {
+            wxRemoveFile( tmpPath );
+            return;
+        }
+    }
+
+    if( !wxRenameFile( tmpPath, path, true ) )
+        wxRemoveFile( tmpPath );
+}
+
+
+bool FOOTPRINT_LIST_IMPL::readLibraryIndex(
+        const wxString& aNickname, const wxString& aLibraryURI, long long aTimestamp,
+        std::vector<std::unique_ptr<FOOTPRINT_INFO>>& aFootprints )
+{
+    wxString   path = libraryIndexPath( aNickname, aLibraryURI );
+    wxTextFile indexFile( path );
+
+    if( !wxFileName::FileExists( path ) || !indexFile.Open() )
+        return false;
+
+    // Header, URI, nickname, timestamp and count, then five lines per footprint
+    const size_t headerLines = 5;
+    const size_t linesPerFootprint = 5;
+
+    long long timestamp = 0;
+    long long count = 0;
+
+    if( indexFile.GetLineCount() < headerLines
+            || indexFile.GetLine( 0 ) != FP_INDEX_HEADER
+                                                + wxString::Format( wxT( " %d" ), FP_INDEX_VERSION )
+            || UnescapeString( indexFile.GetLine( 1 ) ) != aLibraryURI
+            || UnescapeString( indexFile.GetLine( 2 ) ) != aNickname
+            || !indexFile.GetLine( 3 ).ToLongLong( &timestamp ) || timestamp != aTimestamp
+            || !indexFile.GetLine( 4 ).ToLongLong( &count ) || count < 0
+            || indexFile.GetLineCount() != headerLines + count * linesPerFootprint )
+    {
+        return false;
+    }
+
+    std::vector<std::unique_ptr<FOOTPRINT_INFO>> footprints;
+    size_t                                       lineNo = headerLines;
+
+    footprints.reserve( count );
+
+    for( long long ii = 0; ii < count; ++ii )
+    {
+        wxString      name = indexFile.GetLine( lineNo++ );
+        wxString      desc = UnescapeString( indexFile.GetLine( lineNo++ ) );
+        wxString      keywords = UnescapeString( indexFile.GetLine( lineNo++ ) );
+        unsigned long padCount = 0;
+        unsigned long uniquePadCount = 0;
+
+        if( !indexFile.GetLine( lineNo++ ).ToULong( &padCount )
+                || !indexFile.GetLine( lineNo++ ).ToULong( &uniquePadCount ) )
+        {
+            return false;
+        }
+
+        footprints.emplace_back( new FOOTPRINT_INFO_IMPL( aNickname, name, desc, keywords, 0,
+                                                          padCount, uniquePadCount ) );
+    }
+
+    for( std::unique_ptr<FOOTPRINT_INFO>& fpinfo : footprints )
+        aFootprints.push_back( std::move( fpinfo ) );
+
+    indexFile.Close();
+
+    // Keep indexes in use from being pruned
+    wxFileName( path ).Touch();
+
+    return true;
+}
+
+
+void FOOTPRINT_LIST_IMPL::PruneLibraryIndexes( int aMaxAgeDays )
+{
+    wxString dirPath = libraryIndexDir();
+    wxDir    dir;
+
+    if( !wxDirExists( dirPath ) || !dir.Open( dirPath ) )
+        return;
+
+    wxDateTime    threshold = wxDateTime::Now() - wxDateSpan::Days( aMaxAgeDays );
+    wxString      fileName;
+    wxArrayString stale;
+
+    // Also catches temporary files left behind by an instance which stopped while writing
+    for( bool cont = dir.GetFirst( &fileName, wxEmptyString, wxDIR_FILES ); cont;
+         cont = dir.GetNext( &fileName ) )
+    {
+        wxFileName fn( dirPath, fileName );
+        wxDateTime modified;
+
+        if( fn.GetTimes( nullptr, &modified, nullptr ) && modified.IsEarlierThan( threshold ) )
+            stale.Add( fn.GetFullPath() );
+    }
+
+    for( const wxString& path : stale )
+        wxRemoveFile( path );
+}
@@ -23,6 +23,7 @@
 #include <atomic>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <thread>
 #include <vector>
 
@@ -95,10 +96,43 @@ public:
 
     void Clear() override;
 
+    /**
+     * Remove stored library indexes which haven't been read or written for \a aMaxAgeDays.
+     * Called once per session when the first libraries are loaded.
+     */
+    static void PruneLibraryIndexes( int aMaxAgeDays );
+
 protected:
-    void loadFootprints();
+    /**
+     * Load the libraries in m_queue on the thread pool.
+     *
+     * @param aNeedsCLocale must be set if any of the libraries is read by a plugin which
+     *                      still depends on the global C locale.
+     */
+    void loadFootprints( bool aNeedsCLocale );
 
 private:
+    /**
+     * Read the stored index of library \a aNickname into \a aFootprints.
+     *
+     * @param aTimestamp is the library's current timestamp; an index with any other timestamp
+     *                   is out of date.
+     * @return true if the index was current and read.
+     */
+    bool readLibraryIndex( const wxString& aNickname, const wxString& aLibraryURI,
+                           long long aTimestamp,
+                           std::vector<std::unique_ptr<FOOTPRINT_INFO>>& aFootprints );
+
+    /**
+     * Store an index of library \a aNickname in the user cache directory so that it doesn't
+     * need to be parsed again until it changes.  Failures are silently ignored.
+     */
+    void writeLibraryIndex( const wxString& aNickname, const wxString& aLibraryURI,
+                            long long aTimestamp,
+                            const std::vector<std::unique_ptr<FOOTPRINT_INFO>>& aFootprints );
+
+    static wxString libraryIndexPath( const wxString& aNickname, const wxString& aLibraryURI );
+
     /**
      * Call aFunc, pushing any IO_ERRORs and std::exceptions it throws onto m_errors.
      *
@@ -35,6 +35,7 @@
 #include <pcb_textbox.h>
 #include <pgm_base.h>
 #include <progress_reporter.h>
+#include <scoped_set_reset.h>
 #include <settings/settings_manager.h>
 #include <wx_fstream_progress.h>
 
@@ -55,6 +56,95 @@
 static const wxChar traceIpc2581[] = wxT( "KICAD_IPC_2581" );
 
 
+/**
+ * Writes XML text to a stream through a small buffer, so that the text of a whole section
+ * is never held in memory.
+ */
+class XML_STREAM_WRITER
+{
+public:
+    static constexpr size_t BUFFER_SIZE = 64 * 1024;
+
+    XML_STREAM_WRITER( wxOutputStream& aStream ) :
+            m_stream( aStream )
+    {
+        m_buffer.reserve( BUFFER_SIZE );
+    }
+
+    ~XML_STREAM_WRITER()
+    {
+        Flush();
+    }
+
+    void Write( const char* aData, size_t aSize )
+    {
+        m_buffer.append( aData, aSize );
+
+        if( m_buffer.size() >= BUFFER_SIZE )
+            Flush();
+    }
+
+    void Write( const char* aStr )
+    {
+        Write( aStr, strlen( aStr ) );
+    }
+
+    void Write( const wxString& aStr )
+    {
+        wxScopedCharBuffer utf8 = aStr.utf8_str();
+        Write( utf8.data(), utf8.length() );
+    }
+
+    /**
+     * Write \a aStr with the characters that cannot appear in an attribute value escaped.
+     */
+    void WriteEscaped( const wxString& aStr )
+    {
+        wxScopedCharBuffer utf8 = aStr.utf8_str();
+        const char*        str = utf8.data();
+
+        for( size_t ii = 0; ii < utf8.length(); ++ii )
+        {
+            switch( str[ii] )
+            {
+            case '<':  m_buffer += "&lt;";    break;
+            case '>':  m_buffer += "&gt;";    break;
+            case '&':  m_buffer += "&amp;";   break;
+            case '"':  m_buffer += "&quot;";  break;
+            case '\t': m_buffer += "&#x9;";   break;
+            case '\n': m_buffer += "&#xA;";   break;
+            case '\r': m_buffer += "&#xD;";   break;
+            default:   m_buffer += str[ii];   break;
+            }
+        }
+
+        if( m_buffer.size() >= BUFFER_SIZE )
+            Flush();
+    }
+
+    void WriteIndent( int aIndent )
+    {
+        m_buffer += '\n';
+        m_buffer.append( aIndent, ' ' );
+    }
+
+    bool Flush()
+    {
+        if( !m_buffer.empty() )
+        {
+            m_stream.Write( m_buffer.data(), m_buffer.size() );
+            m_buffer.clear();
+        }
+
+        return m_stream.IsOk();
+    }
+
+private:
+    wxOutputStream& m_stream;
+    std::string     m_buffer;
+};
+
+
 PCB_IO_IPC2581::~PCB_IO_IPC2581()
 {
     clearLoadedFootprints();
@@ -123,19 +213,18 @@ void PCB_IO_IPC2581::appendNode( wxXmlNode* aParent, wxXmlNode* aNode )
     // that if possible.  When we share a parent and our next sibling is null,
     // then we are the last child and can just append to the end of the list.
 
-    static wxXmlNode* lastNode = nullptr;
-
-    if( lastNode && lastNode->GetParent() == aParent && lastNode->GetNext() == nullptr )
+    if( m_last_appended && m_last_appended->GetParent() == aParent
+            && m_last_appended->GetNext() == nullptr )
     {
         aNode->SetParent( aParent );
-        lastNode->SetNext( aNode );
+        m_last_appended->SetNext( aNode );
     }
     else
     {
         aParent->AddChild( aNode );
     }
 
-    lastNode = aNode;
+    m_last_appended = aNode;
 
     // Opening tag, closing tag, brackets and the closing slash
     m_total_bytes += 2 * aNode->GetName().size() + 5;
@@ -2790,6 +2879,11 @@ void PCB_IO_IPC2581::generateLayerFeatures( wxXmlNode* aStepNode )
         {
             aStepNode->RemoveChild( layerNode );
             delete layerNode;
+            m_last_appended = nullptr;
+        }
+        else
+        {
+            spoolNode( layerNode );
         }
     }
 }
@@ -2858,6 +2952,8 @@ void PCB_IO_IPC2581::generateLayerSetDrill( wxXmlNode* aLayerNode )
                 addXY( holeNode, pad->GetPosition() );
             }
         }
+
+        spoolNode( layerNode );
     }
 
     hole_count = 1;
@@ -2876,6 +2972,8 @@ void PCB_IO_IPC2581::generateLayerSetDrill( wxXmlNode* aLayerNode )
 
             addSlotCavity( padNode, *pad, wxString::Format( "SLOT%d", hole_count++ ) );
         }
+
+        spoolNode( layerNode );
     }
 }
 
@@ -3233,7 +3331,106 @@ void PCB_IO_IPC2581::generateLayerSetAuxilliary( wxXmlNode* aStepNode )
                 addShape( padNode, shape );
             }
         }
+
+        spoolNode( layerNode );
+    }
+}
+
+
+void PCB_IO_IPC2581::spoolNode( wxXmlNode* aNode )
+{
+    if( !m_spool.IsOpened() )
+        return;
+
+    // Indent the text as it will be in the final file
+    int indent = 0;
+
+    for( wxXmlNode* parent = aNode->GetParent();
+         parent && parent->GetType() == wxXML_ELEMENT_NODE; parent = parent->GetParent() )
+    {
+        indent += 2;
+    }
+
+    wxFileOffset start = m_spool.Tell();
+    bool         ok;
+
+    {
+        wxFFileOutputStream spoolStream( m_spool );
+        XML_STREAM_WRITER   writer( spoolStream );
+
+        writeNode( writer, aNode, indent );
+        ok = writer.Flush();
+    }
+
+    // Keep the node in memory rather than lose it.  Whatever was written is never read back.
+    if( !ok || start == wxInvalidOffset )
+        return;
+
+    m_spooled_nodes[aNode] = { start, static_cast<size_t>( m_spool.Tell() - start ) };
+
+    while( wxXmlNode* child = aNode->GetChildren() )
+    {
+        aNode->RemoveChild( child );
+        delete child;
+    }
+
+    m_last_appended = nullptr;
+}
+
+
+void PCB_IO_IPC2581::writeNode( XML_STREAM_WRITER& aWriter, const wxXmlNode* aNode, int aIndent )
+{
+    if( auto it = m_spooled_nodes.find( aNode ); it != m_spooled_nodes.end() )
+    {
+        std::vector<char> chunk( XML_STREAM_WRITER::BUFFER_SIZE );
+        size_t            remaining = it->second.second;
+
+        m_spool.Seek( it->second.first );
+
+        while( remaining > 0 )
+        {
+            size_t count = m_spool.Read( chunk.data(), std::min( remaining, chunk.size() ) );
+
+            if( count == 0 )
+                break;
+
+            aWriter.Write( chunk.data(), count );
+            remaining -= count;
+        }
+
+        return;
+    }
+
+    aWriter.Write( "<" );
+    aWriter.Write( aNode->GetName() );
+
+    for( wxXmlAttribute* attr = aNode->GetAttributes(); attr; attr = attr->GetNext() )
+    {
+        aWriter.Write( " " );
+        aWriter.Write( attr->GetName() );
+        aWriter.Write( "=\"" );
+        aWriter.WriteEscaped( attr->GetValue() );
+        aWriter.Write( "\"" );
+    }
+
+    if( !aNode->GetChildren() )
+    {
+        aWriter.Write( "/>" );
+        return;
     }
+
+    aWriter.Write( ">" );
+
+    for( const wxXmlNode* child = aNode->GetChildren(); child; child = child->GetNext() )
+    {
+        aWriter.WriteIndent( aIndent + 2 );
+        writeNode( aWriter, child, aIndent + 2 );
+    }
+
+    aWriter.WriteIndent( aIndent );
+    aWriter.Write( "</" );
+    aWriter.Write( aNode->GetName() );
+    aWriter.Write( ">" );
 }
 
 
@@ -3386,7 +3583,36 @@ void PCB_IO_IPC2581::SaveBoard( const wxString& aFileName, BOARD* aBoard,
             m_acceptable_chars.insert( c );
     }
 
-    m_xml_doc = new wxXmlDocument();
+    // Finished layers are moved to a temporary file as they are generated, so that only one
+    // layer's nodes are held in memory at a time.  Without it, they all stay in memory.
+    wxString spoolName = wxFileName::CreateTempFileName( wxS( "kicad_ipc2581" ) );
+
+    if( !spoolName.IsEmpty() )
+        m_spool.Open( spoolName, wxS( "w+b" ) );
+
+    m_spooled_nodes.clear();
+    m_last_appended = nullptr;
+
+    // The document and the spool file must go even when a generator throws
+    SCOPED_EXECUTION<std::function<void()>> cleanup(
+            []()
+            {
+            },
+            [&]()
+            {
+                m_xml_doc.reset();
+                m_xml_root = nullptr;
+                m_last_appended = nullptr;
+                m_spooled_nodes.clear();
+
+                if( m_spool.IsOpened() )
+                    m_spool.Close();
+
+                if( !spoolName.IsEmpty() )
+                    wxRemoveFile( spoolName );
+            } );
+
+    m_xml_doc = std::make_unique<wxXmlDocument>();
     m_xml_root = generateXmlHeader();
 
     generateContentSection();
@@ -3437,11 +3663,17 @@ void PCB_IO_IPC2581::SaveBoard( const wxString& aFileName, BOARD* aBoard,
 
     out_stream.SetProgressCallback( update_progress );
 
-    if( !m_xml_doc->Save( out_stream ) )
+    bool ok;
+
     {
-        wxLogError( _( "Failed to save file to buffer" ) );
-        return;
+        XML_STREAM_WRITER writer( out_stream );
+
+        writer.Write( "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n" );
+        writeNode( writer, m_xml_root, 0 );
+        writer.Write( "\n" );
+        ok = writer.Flush();
     }
 
-    size_t size = out_stream.GetSize();
+    if( !ok || !out_stream.Close() )
+        wxLogError( _( "Failed to save file to buffer" ) );
 }
@@ -32,6 +32,7 @@
 #include <geometry/shape_segment.h>
 #include <stroke_params.h>
 
+#include <wx/ffile.h>
 #include <wx/xml/xml.h>
 #include <memory>
 
@@ -48,6 +49,7 @@ class PCB_TEXT;
 class PROGRESS_REPORTER;
 class SHAPE_POLY_SET;
 class SHAPE_SEGMENT;
+class XML_STREAM_WRITER;
 
 class PCB_IO_IPC2581 : public PCB_IO
 {
@@ -68,6 +70,7 @@ public:
         m_progress_reporter = nullptr;
         m_xml_doc = nullptr;
         m_xml_root = nullptr;
+        m_last_appended = nullptr;
     }
 
     ~PCB_IO_IPC2581() override;
@@ -192,6 +195,17 @@ private:
 
     void generateLayerSetAuxilliary( wxXmlNode* aStepNode );
 
+    /**
+     * Write a finished LayerFeature node to the spool file and free its children.  The node is
+     * left in the tree as a placeholder, which #writeNode replaces with the spooled text.
+     */
+    void spoolNode( wxXmlNode* aNode );
+
+    /**
+     * Write \a aNode and its children to \a aWriter in the layout of wxXmlDocument::Save().
+     */
+    void writeNode( XML_STREAM_WRITER& aWriter, const wxXmlNode* aNode, int aIndent );
+
     wxXmlNode* generateContentStackup( wxXmlNode* aContentNode );
 
     void generateComponents( wxXmlNode* aStepNode );
@@ -339,8 +353,13 @@ private:
 
     std::set<wxUniChar>     m_acceptable_chars;     //<! IPC2581B and C have differing sets of allowed characters in names
 
-    wxXmlDocument*          m_xml_doc;
-    wxXmlNode*              m_xml_root;
+    std::unique_ptr<wxXmlDocument> m_xml_doc;
+    wxXmlNode*                     m_xml_root;
+    wxXmlNode*                     m_last_appended;    //<! Last node added by appendNode()
+
+    wxFFile                        m_spool;            //<! Temporary file holding finished layers
+    std::map<const wxXmlNode*, std::pair<wxFileOffset, size_t>>
+            m_spooled_nodes; //<! Offset and size of the spooled text of each placeholder node
 };
 
 #endif // PCB_IO_IPC2581_H_
\ No newline at end of file
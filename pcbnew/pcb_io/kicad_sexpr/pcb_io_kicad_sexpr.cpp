@@ -22,12 +22,18 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <atomic>
+#include <future>
+#include <limits>
+#include <mutex>
+
 #include <wx/dir.h>
 #include <wx/ffile.h>
 #include <wx/log.h>
 #include <wx/msgdlg.h>
 #include <wx/mstream.h>
 
+#include <advanced_config.h>
 #include <board.h>
 #include <board_design_settings.h>
 #include <callback_gal.h>
@@ -39,7 +45,6 @@
 #include <io/kicad/kicad_io_utils.h>
 #include <kiface_base.h>
 #include <layer_range.h>
-#include <locale_io.h>
 #include <macros.h>
 #include <pad.h>
 #include <pcb_dimension.h>
@@ -60,6 +65,7 @@
 #include <progress_reporter.h>
 #include <reporter.h>
 #include <string_utils.h>
+#include <thread_pool.h>
 #include <trace_helpers.h>
 #include <wildcards_and_files_ext.h>
 #include <zone.h>
@@ -308,8 +314,6 @@ bool PCB_IO_KICAD_SEXPR::CanReadBoard( const wxString& aFileName ) const
 void PCB_IO_KICAD_SEXPR::SaveBoard( const wxString& aFileName, BOARD* aBoard,
                                     const std::map<std::string, UTF8>* aProperties )
 {
-    LOCALE_IO   toggle;     // toggles on, then off, the C locale.
-
     wxString sanityResult = aBoard->GroupsSanityCheck();
 
     if( sanityResult != wxEmptyString && m_queryUserCallback )
@@ -378,8 +382,6 @@ BOARD_ITEM* PCB_IO_KICAD_SEXPR::Parse( const wxString& aClipboardSourceInput )
 
 void PCB_IO_KICAD_SEXPR::Format( const BOARD_ITEM* aItem ) const
 {
-    LOCALE_IO   toggle;     // public API function, perform anything convenient for caller
-
     switch( aItem->Type() )
     {
     case PCB_T:
@@ -795,31 +797,32 @@ void PCB_IO_KICAD_SEXPR::format( const BOARD* aBoard ) const
                                                                    aBoard->Generators().end() );
     formatHeader( aBoard );
 
+    std::vector<const BOARD_ITEM*> items;
+
+    items.reserve( sorted_footprints.size() + sorted_drawings.size() + sorted_tracks.size()
+                   + sorted_zones.size() + sorted_groups.size() + sorted_generators.size() );
+
     // Save the footprints.
-    for( BOARD_ITEM* footprint : sorted_footprints )
-        Format( footprint );
+    items.insert( items.end(), sorted_footprints.begin(), sorted_footprints.end() );
 
     // Save the graphical items on the board (not owned by a footprint)
-    for( BOARD_ITEM* item : sorted_drawings )
-        Format( item );
+    items.insert( items.end(), sorted_drawings.begin(), sorted_drawings.end() );
 
     // Do not save PCB_MARKERs, they can be regenerated easily.
 
     // Save the tracks and vias.
-    for( PCB_TRACK* track : sorted_tracks )
-        Format( track );
+    items.insert( items.end(), sorted_tracks.begin(), sorted_tracks.end() );
 
     // Save the polygon (which are the newer technology) zones.
-    for( auto zone : sorted_zones )
-        Format( zone );
+    items.insert( items.end(), sorted_zones.begin(), sorted_zones.end() );
 
     // Save the groups
-    for( BOARD_ITEM* group : sorted_groups )
-        Format( group );
+    items.insert( items.end(), sorted_groups.begin(), sorted_groups.end() );
 
     // Save the generators
-    for( BOARD_ITEM* gen : sorted_generators )
-        Format( gen );
+    items.insert( items.end(), sorted_generators.begin(), sorted_generators.end() );
+
+    formatItems( items );
 
     // Save any embedded files
     // Consolidate the embedded models in footprints into a single map
@@ -848,6 +851,161 @@ void PCB_IO_KICAD_SEXPR::format( const BOARD* aBoard ) const
 }
 
 
+void PCB_IO_KICAD_SEXPR::formatItems( const std::vector<const BOARD_ITEM*>& aItems ) const
+{
+    // Items are formatted in blocks, each into its own buffer, to keep the shared counter and
+    // the per-buffer overhead small on boards with hundreds of thousands of track segments.
+    const size_t blockSize = 64;
+    const size_t count = aItems.size();
+    const size_t blockCount = ( count + blockSize - 1 ) / blockSize;
+    thread_pool& tp = GetKiCadThreadPool();
+
+    if( !ADVANCED_CFG::GetCfg().m_ParallelBoardSave || blockCount < 2
+            || tp.get_thread_count() < 2 )
+    {
+        for( const BOARD_ITEM* item : aItems )
+            Format( item );
+
+        return;
+    }
+
+    // State shared with the helper tasks, which may only get to run after we have returned
+    struct SHARED_STATE
+    {
+        std::atomic<size_t> m_next = 0;
+        std::atomic<bool>   m_cancelled = false;
+
+        std::vector<std::unique_ptr<STRING_FORMATTER>> m_blocks;
+        std::vector<std::promise<void>>                m_ready;
+
+        std::mutex          m_mutex;                ///< guards the members below
+        size_t              m_errorIndex = std::numeric_limits<size_t>::max();
+        std::exception_ptr  m_error;
+    };
+
+    std::shared_ptr<SHARED_STATE> state = std::make_shared<SHARED_STATE>();
+
+    state->m_blocks.resize( blockCount );
+    state->m_ready.resize( blockCount );
+
+    std::vector<std::future<void>> ready;
+
+    for( std::promise<void>& blockReady : state->m_ready )
+        ready.push_back( blockReady.get_future() );
+
+    // Format the next unclaimed block with the given formatter, creating it if necessary.
+    // Returns false once all blocks have been claimed.  After a failure the remaining blocks
+    // are claimed without being formatted, so that every block is still marked ready.
+    auto formatNextBlock =
+            [this, state, &aItems, count, blockSize,
+             blockCount]( std::unique_ptr<PCB_IO_KICAD_SEXPR>& aFormatter ) -> bool
+            {
+                size_t block = state->m_next.fetch_add( 1 );
+
+                if( block >= blockCount )
+                    return false;
+
+                if( !state->m_cancelled )
+                {
+                    try
+                    {
+                        auto output = std::make_unique<STRING_FORMATTER>();
+
+                        if( !aFormatter )
+                            aFormatter.reset( new PCB_IO_KICAD_SEXPR( *this, output.get() ) );
+                        else
+                            aFormatter->SetOutputFormatter( output.get() );
+
+                        size_t last = std::min( ( block + 1 ) * blockSize, count );
+
+                        for( size_t ii = block * blockSize; ii < last; ++ii )
+                            aFormatter->Format( aItems[ii] );
+
+                        state->m_blocks[block] = std::move( output );
+                    }
+                    catch( ... )
+                    {
+                        std::lock_guard<std::mutex> lock( state->m_mutex );
+
+                        if( block < state->m_errorIndex )
+                        {
+                            state->m_errorIndex = block;
+                            state->m_error = std::current_exception();
+                        }
+
+                        state->m_cancelled = true;
+                    }
+                }
+
+                state->m_ready[block].set_value();
+                return true;
+            };
+
+    size_t helperCount = std::min<size_t>( tp.get_thread_count(), blockCount ) - 1;
+
+    for( size_t ii = 0; ii < helperCount; ++ii )
+    {
+        tp.push_task(
+                [formatNextBlock]()
+                {
+                    std::unique_ptr<PCB_IO_KICAD_SEXPR> formatter;
+
+                    while( formatNextBlock( formatter ) )
+                    {
+                    }
+                } );
+    }
+
+    // The calling thread writes the blocks out in order as they become ready, and formats
+    // blocks itself while it waits.  Once every block has been claimed, any block not ready
+    // yet is being formatted by a running thread, so waiting on it can't stall on a helper
+    // that hasn't been scheduled.
+    std::unique_ptr<PCB_IO_KICAD_SEXPR> formatter;
+    std::exception_ptr                  writeError;
+    size_t                              written = 0;
+
+    try
+    {
+        while( written < blockCount && !state->m_cancelled )
+        {
+            if( ready[written].wait_for( std::chrono::seconds( 0 ) ) == std::future_status::ready )
+            {
+                if( !state->m_blocks[written] )
+                    break;
+
+                m_out->Write( state->m_blocks[written]->GetString() );
+                state->m_blocks[written].reset();
+                ++written;
+            }
+            else if( !formatNextBlock( formatter ) )
+            {
+                ready[written].wait();
+            }
+        }
+    }
+    catch( ... )
+    {
+        writeError = std::current_exception();
+        state->m_cancelled = true;
+    }
+
+    // The helpers refer to aItems and to this object, so they must all be finished before we
+    // can return, even when giving up early.
+    while( formatNextBlock( formatter ) )
+    {
+    }
+
+    for( std::future<void>& blockReady : ready )
+        blockReady.wait();
+
+    if( writeError )
+        std::rethrow_exception( writeError );
+
+    if( state->m_error )
+        std::rethrow_exception( state->m_error );
+}
+
+
 void PCB_IO_KICAD_SEXPR::format( const PCB_DIMENSION_BASE* aDimension ) const
 {
     const PCB_DIM_ALIGNED*    aligned = dynamic_cast<const PCB_DIM_ALIGNED*>( aDimension );
@@ -2735,17 +2893,34 @@ void PCB_IO_KICAD_SEXPR::format( const ZONE_LAYER_PROPERTIES& aZoneLayerProperti
 PCB_IO_KICAD_SEXPR::PCB_IO_KICAD_SEXPR( int aControlFlags ) : PCB_IO( wxS( "KiCad" ) ),
     m_cache( nullptr ),
     m_ctl( aControlFlags ),
-    m_mapping( new NETINFO_MAPPING() )
+    m_mapping( new NETINFO_MAPPING() ),
+    m_ownsMapping( true )
 {
     init( nullptr );
     m_out = &m_sf;
 }
 
 
+PCB_IO_KICAD_SEXPR::PCB_IO_KICAD_SEXPR( const PCB_IO_KICAD_SEXPR& aParent,
+                                        OUTPUTFORMATTER* aOut ) :
+    PCB_IO( wxS( "KiCad" ) ),
+    m_cache( nullptr ),
+    m_ctl( aParent.m_ctl ),
+    m_mapping( aParent.m_mapping ),
+    m_ownsMapping( false )
+{
+    init( aParent.m_props );
+    m_board = aParent.m_board;
+    m_out = aOut;
+}
+
+
 PCB_IO_KICAD_SEXPR::~PCB_IO_KICAD_SEXPR()
 {
     delete m_cache;
-    delete m_mapping;
+
+    if( m_ownsMapping )
+        delete m_mapping;
 }
 
 
@@ -2753,7 +2928,7 @@ BOARD* PCB_IO_KICAD_SEXPR::LoadBoard( const wxString& aFileName, BOARD* aAppendT
                                       const std::map<std::string, UTF8>* aProperties,
                                       PROJECT* aProject )
 {
-    FILE_LINE_READER reader( aFileName );
+    MAPPED_FILE_LINE_READER reader( aFileName );
 
     unsigned lineCount = 0;
 
@@ -2766,10 +2941,7 @@ BOARD* PCB_IO_KICAD_SEXPR::LoadBoard( const wxString& aFileName, BOARD* aAppendT
         if( !m_progressReporter->KeepRefreshing() )
             THROW_IO_ERROR( _( "Open cancelled by user." ) );
 
-        while( reader.ReadLine() )
-            lineCount++;
-
-        reader.Rewind();
+        lineCount = reader.CountLines();
     }
 
     BOARD* board = DoLoad( reader, aAppendToMe, aProperties, m_progressReporter, lineCount );
@@ -2846,7 +3018,6 @@ void PCB_IO_KICAD_SEXPR::FootprintEnumerate( wxArrayString& aFootprintNames,
                                              const wxString& aLibPath, bool aBestEfforts,
                                              const std::map<std::string, UTF8>* aProperties )
 {
-    LOCALE_IO toggle;     // toggles on, then off, the C locale.
     wxDir     dir( aLibPath );
     wxString  errorMsg;
 
@@ -2877,8 +3048,6 @@ const FOOTPRINT* PCB_IO_KICAD_SEXPR::getFootprint( const wxString& aLibraryPath,
                                                    const std::map<std::string, UTF8>* aProperties,
                                                    bool checkModified )
 {
-    LOCALE_IO   toggle;     // toggles on, then off, the C locale.
-
     init( aProperties );
 
     try
@@ -2973,8 +3142,6 @@ FOOTPRINT* PCB_IO_KICAD_SEXPR::FootprintLoad( const wxString& aLibraryPath,
 void PCB_IO_KICAD_SEXPR::FootprintSave( const wxString& aLibraryPath, const FOOTPRINT* aFootprint,
                                         const std::map<std::string, UTF8>* aProperties )
 {
-    LOCALE_IO   toggle;     // toggles on, then off, the C locale.
-
     init( aProperties );
 
     // In this public PLUGIN API function, we can safely assume it was
@@ -3072,8 +3239,6 @@ void PCB_IO_KICAD_SEXPR::FootprintDelete( const wxString& aLibraryPath,
                                           const wxString& aFootprintName,
                                           const std::map<std::string, UTF8>* aProperties )
 {
-    LOCALE_IO   toggle;     // toggles on, then off, the C locale.
-
     init( aProperties );
 
     validateCache( aLibraryPath );
@@ -3104,8 +3269,6 @@ void PCB_IO_KICAD_SEXPR::CreateLibrary( const wxString& aLibraryPath,
                                           aLibraryPath.GetData() ) );
     }
 
-    LOCALE_IO   toggle;
-
     init( aProperties );
 
     delete m_cache;
@@ -3194,8 +3357,6 @@ bool PCB_IO_KICAD_SEXPR::DeleteLibrary( const wxString& aLibraryPath,
 
 bool PCB_IO_KICAD_SEXPR::IsLibraryWritable( const wxString& aLibraryPath )
 {
-    LOCALE_IO   toggle;
-
     init( nullptr );
 
     validateCache( aLibraryPath );
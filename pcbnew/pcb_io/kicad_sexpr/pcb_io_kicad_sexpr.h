@@ -32,6 +32,7 @@
 #include <richio.h>
 #include <string>
 #include <optional>
+#include <vector>
 #include <layer_ids.h>
 #include <zone_settings.h>
 #include <lset.h>
@@ -428,8 +429,20 @@ protected:
     void formatTeardropParameters( const TEARDROP_PARAMETERS& tdParams ) const;
 
 private:
+    /**
+     * Create a formatter for one of the helper threads of formatItems().  It writes to \a aOut
+     * and shares the board, control flags and net mapping of \a aParent.
+     */
+    PCB_IO_KICAD_SEXPR( const PCB_IO_KICAD_SEXPR& aParent, OUTPUTFORMATTER* aOut );
+
     void format( const BOARD* aBoard ) const;
 
+    /**
+     * Format \a aItems in order.  Large lists are split into blocks which are formatted into
+     * separate buffers on the thread pool and then written out in sequence.
+     */
+    void formatItems( const std::vector<const BOARD_ITEM*>& aItems ) const;
+
     void format( const PCB_DIMENSION_BASE* aDimension ) const;
 
     void format( const PCB_REFERENCE_IMAGE* aBitmap ) const;
@@ -482,6 +495,7 @@ protected:
     int                    m_ctl;
     NETINFO_MAPPING*       m_mapping;    ///< mapping for net codes, so only not empty net codes
                                          ///< are stored with consecutive integers as net codes
+    bool                   m_ownsMapping;
 
     std::function<bool( wxString aTitle, int aIcon, wxString aMsg, wxString aAction )> m_queryUserCallback;
 };
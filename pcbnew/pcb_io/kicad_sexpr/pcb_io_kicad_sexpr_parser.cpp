@@ -28,8 +28,11 @@
  */
 
 #include "layer_ids.h"
+#include <atomic>
 #include <cerrno>
 #include <charconv>
+#include <future>
+#include <mutex>
 #include <confirm.h>
 #include <macros.h>
 #include <fmt/format.h>
@@ -61,7 +64,6 @@
 #include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr.h>
 #include <pcb_plot_params_parser.h>
 #include <pcb_plot_params.h>
-#include <locale_io.h>
 #include <zones.h>
 #include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr_parser.h>
 #include <convert_basic_shapes_to_polygon.h>    // for RECT_CHAMFER_POSITIONS definition
@@ -70,6 +72,8 @@
 #include <stroke_params_parser.h>
 #include <wx/log.h>
 #include <progress_reporter.h>
+#include <advanced_config.h>
+#include <thread_pool.h>
 #include <board_stackup_manager/stackup_predefined_prms.h>
 #include <pgm_base.h>
 
@@ -831,8 +835,6 @@ FP_3DMODEL* PCB_IO_KICAD_SEXPR_PARSER::parse3DModel()
 
 bool PCB_IO_KICAD_SEXPR_PARSER::IsValidBoardHeader()
 {
-    LOCALE_IO       toggle;
-
     m_groupInfos.clear();
 
     // See Parse() - FOOTPRINTS can be prefixed with an initial block of single line comments,
@@ -853,8 +855,6 @@ BOARD_ITEM* PCB_IO_KICAD_SEXPR_PARSER::Parse()
 {
     T               token;
     BOARD_ITEM*     item;
-    LOCALE_IO       toggle;
-
     m_groupInfos.clear();
 
     // FOOTPRINTS can be prefixed with an initial block of single line comments and these are
@@ -944,6 +944,19 @@ BOARD* PCB_IO_KICAD_SEXPR_PARSER::parseBOARD_unchecked()
     std::vector<BOARD_ITEM*> bulkAddedItems;
     BOARD_ITEM* item = nullptr;
 
+    // Footprints, tracks, vias and zones don't depend on each other until they are added to the
+    // board, so when reading a whole file they are set aside and parsed concurrently once the
+    // layers, nets and setup (which all precede them) are known.  Files from before V7 can need
+    // legacy conversions which warn the user once per file, so they are read sequentially.
+    MAPPED_FILE_LINE_READER*   mappedReader = nullptr;
+    std::vector<DEFERRED_ITEM> deferredItems;
+
+    if( ADVANCED_CFG::GetCfg().m_ParallelBoardLoad && !m_appendToExisting
+            && m_requiredVersion >= 20220211 )
+    {
+        mappedReader = dynamic_cast<MAPPED_FILE_LINE_READER*>( reader );
+    }
+
     for( token = NextTok();  token != T_RIGHT;  token = NextTok() )
     {
         checkpoint();
@@ -956,6 +969,26 @@ BOARD* PCB_IO_KICAD_SEXPR_PARSER::parseBOARD_unchecked()
         if( token == T_page && m_requiredVersion <= 20200119 )
             token = T_paper;
 
+        if( mappedReader )
+        {
+            switch( token )
+            {
+            case T_module:
+            case T_footprint:
+            case T_segment:
+            case T_arc:
+            case T_via:
+            case T_zone:
+                if( deferItem( *mappedReader, deferredItems ) )
+                    continue;
+
+                break;
+
+            default:
+                break;
+            }
+        }
+
         switch( token )
         {
         case T_host:            // legacy token
@@ -1142,6 +1175,17 @@ BOARD* PCB_IO_KICAD_SEXPR_PARSER::parseBOARD_unchecked()
         }
     }
 
+    if( !deferredItems.empty() )
+    {
+        parseDeferredItems( *mappedReader, deferredItems );
+
+        for( DEFERRED_ITEM& deferred : deferredItems )
+        {
+            m_board->Add( deferred.item, ADD_MODE::BULK_APPEND, true );
+            bulkAddedItems.push_back( deferred.item );
+        }
+    }
+
     if( bulkAddedItems.size() > 0 )
         m_board->FinalizeBulkAdd( bulkAddedItems );
 
@@ -1267,6 +1311,292 @@ BOARD* PCB_IO_KICAD_SEXPR_PARSER::parseBOARD_unchecked()
 }
 
 
+bool PCB_IO_KICAD_SEXPR_PARSER::deferItem( MAPPED_FILE_LINE_READER& aReader,
+                                           std::vector<DEFERRED_ITEM>& aItems )
+{
+    // Find where the keyword is in the file from its offset in the current line
+    const char* data = aReader.Data();
+    size_t      size = aReader.FileLength();
+    size_t      start = aReader.CurPos() - aReader.Length() + curOffset;
+    unsigned    line = aReader.LineNumber();
+    size_t      pos = start;
+    int         depth = 1;
+    bool        inString = false;
+
+    // Find the parenthesis closing the item, ignoring any inside quoted strings or comments
+    while( pos < size && depth > 0 )
+    {
+        char cc = data[pos++];
+
+        if( cc == '\n' )
+        {
+            // The lexer doesn't allow strings to span lines; let it report the error
+            if( inString )
+                return false;
+
+            ++line;
+
+            // As in the lexer, a line whose first non-blank character is '#' is a comment
+            size_t first = pos;
+
+            while( first < size && ( data[first] == ' ' || data[first] == '\t'
+                                     || data[first] == '\r' || data[first] == '\0' ) )
+            {
+                ++first;
+            }
+
+            if( first < size && data[first] == '#' )
+            {
+                pos = first;
+
+                while( pos < size && data[pos] != '\n' )
+                    ++pos;
+            }
+        }
+        else if( inString )
+        {
+            if( cc == '\\' && pos < size && data[pos] != '\n' )
+                ++pos;
+            else if( cc == '"' )
+                inString = false;
+        }
+        else if( cc == '"' )
+        {
+            inString = true;
+        }
+        else if( cc == '(' )
+        {
+            ++depth;
+        }
+        else if( cc == ')' )
+        {
+            --depth;
+        }
+    }
+
+    if( depth > 0 )
+        return false;
+
+    aItems.push_back( { start, aReader.LineNumber(), nullptr } );
+
+    // Carry on reading just after the item
+    aReader.Seek( pos, line );
+    next = limit;
+
+    return true;
+}
+
+
+BOARD_ITEM* PCB_IO_KICAD_SEXPR_PARSER::parseDeferredItem( MAPPED_FILE_LINE_READER& aReader,
+                                                          DEFERRED_ITEM& aItem )
+{
+    aReader.Seek( aItem.start, aItem.line );
+    next = limit;
+    curTok = DSN_NONE;
+
+    BOARD_ITEM* item = nullptr;
+
+    switch( NextTok() )
+    {
+    case T_module:      // legacy token
+    case T_footprint:   item = parseFOOTPRINT();        break;
+    case T_segment:     item = parsePCB_TRACK();        break;
+    case T_arc:         item = parseARC();              break;
+    case T_via:         item = parsePCB_VIA();          break;
+    case T_zone:        item = parseZONE( m_board );    break;
+    default:            Expecting( "footprint, segment, arc, via or zone" );
+    }
+
+    aItem.groupInfos = std::move( m_groupInfos );
+    aItem.generatorInfos = std::move( m_generatorInfos );
+    aItem.zoneNets = std::move( m_deferredZoneNets );
+    aItem.componentClasses = std::move( m_deferredComponentClasses );
+
+    m_groupInfos.clear();
+    m_generatorInfos.clear();
+    m_deferredZoneNets.clear();
+    m_deferredComponentClasses.clear();
+
+    return item;
+}
+
+
+void PCB_IO_KICAD_SEXPR_PARSER::inheritState( const PCB_IO_KICAD_SEXPR_PARSER& aParent )
+{
+    m_layerIndices = aParent.m_layerIndices;
+    m_layerMasks = aParent.m_layerMasks;
+    m_netCodes = aParent.m_netCodes;
+    m_tooRecent = aParent.m_tooRecent;
+    m_requiredVersion = aParent.m_requiredVersion;
+    m_generatorVersion = aParent.m_generatorVersion;
+    m_appendToExisting = aParent.m_appendToExisting;
+    m_showLegacySegmentZoneWarning = aParent.m_showLegacySegmentZoneWarning;
+    m_showLegacy5ZoneWarning = aParent.m_showLegacy5ZoneWarning;
+    m_deferBoardChanges = true;
+}
+
+
+void PCB_IO_KICAD_SEXPR_PARSER::parseDeferredItems( const MAPPED_FILE_LINE_READER& aReader,
+                                                    std::vector<DEFERRED_ITEM>& aItems )
+{
+    // State shared with the helper tasks, which may only get to run after we have returned
+    struct SHARED_STATE
+    {
+        std::atomic<size_t> m_next = 0;
+        std::atomic<size_t> m_done = 0;
+        std::atomic<bool>   m_cancelled = false;
+        std::promise<void>  m_finished;             ///< set by whoever completes the last item
+
+        std::mutex          m_mutex;                ///< guards the members below
+        size_t              m_errorIndex = std::numeric_limits<size_t>::max();
+        std::exception_ptr  m_error;
+        std::set<wxString>  m_undefinedLayers;
+        bool                m_legacyTeardrops = false;
+    };
+
+    // Items are handed out in blocks to keep the shared counter from becoming a bottleneck
+    // on boards with hundreds of thousands of track segments.
+    const size_t                  blockSize = 32;
+    const size_t                  count = aItems.size();
+    std::shared_ptr<SHARED_STATE> state = std::make_shared<SHARED_STATE>();
+    thread_pool&                  tp = GetKiCadThreadPool();
+
+    auto reportProgress =
+            [&]()
+            {
+                TIME_PT curTime = CLOCK::now();
+
+                if( curTime - m_lastProgressTime < std::chrono::milliseconds( 250 ) )
+                    return;
+
+                m_progressReporter->SetCurrentProgress( (double) state->m_done / count );
+                m_lastProgressTime = curTime;
+
+                if( !m_progressReporter->KeepRefreshing() && !state->m_cancelled )
+                {
+                    std::lock_guard<std::mutex> lock( state->m_mutex );
+
+                    state->m_errorIndex = 0;
+                    state->m_error = std::make_exception_ptr(
+                            IO_ERROR( _( "Open cancelled by user." ), __FILE__, __FUNCTION__,
+                                      __LINE__ ) );
+                    state->m_cancelled = true;
+                }
+            };
+
+    // The calling thread works through the items too, so loading never waits on a helper that
+    // hasn't been scheduled yet; helpers which start after the items are gone simply return.
+    // Only the calling thread reports progress.
+    auto parseBlocks =
+            [this, state, &aReader, &aItems, count, blockSize, &reportProgress]( bool aIsCaller )
+            {
+                std::unique_ptr<MAPPED_FILE_LINE_READER>   reader;
+                std::unique_ptr<PCB_IO_KICAD_SEXPR_PARSER> parser;
+
+                for( size_t first = state->m_next.fetch_add( blockSize ); first < count;
+                     first = state->m_next.fetch_add( blockSize ) )
+                {
+                    size_t last = std::min( first + blockSize, count );
+
+                    if( !state->m_cancelled )
+                    {
+                        if( !parser )
+                        {
+                            reader = std::make_unique<MAPPED_FILE_LINE_READER>( aReader );
+                            parser = std::make_unique<PCB_IO_KICAD_SEXPR_PARSER>( reader.get(),
+                                                                                  m_board,
+                                                                                  nullptr );
+                            parser->inheritState( *this );
+                        }
+
+                        for( size_t ii = first; ii < last && !state->m_cancelled; ++ii )
+                        {
+                            try
+                            {
+                                aItems[ii].item = parser->parseDeferredItem( *reader, aItems[ii] );
+                            }
+                            catch( ... )
+                            {
+                                std::lock_guard<std::mutex> lock( state->m_mutex );
+
+                                if( ii < state->m_errorIndex )
+                                {
+                                    state->m_errorIndex = ii;
+                                    state->m_error = std::current_exception();
+                                }
+
+                                state->m_cancelled = true;
+                            }
+                        }
+
+                        std::lock_guard<std::mutex> lock( state->m_mutex );
+
+                        state->m_undefinedLayers.merge( parser->m_undefinedLayers );
+                        state->m_legacyTeardrops |= parser->m_legacyTeardrops;
+                        parser->m_undefinedLayers.clear();
+                    }
+
+                    if( state->m_done.fetch_add( last - first ) + ( last - first ) == count )
+                        state->m_finished.set_value();
+
+                    if( aIsCaller && m_progressReporter )
+                        reportProgress();
+                }
+            };
+
+    if( count == 0 )
+        return;
+
+    std::future<void> finished = state->m_finished.get_future();
+    size_t            blockCount = ( count + blockSize - 1 ) / blockSize;
+    size_t            helperCount = std::min<size_t>( tp.get_thread_count(), blockCount - 1 );
+
+    for( size_t ii = 0; ii < helperCount; ++ii )
+        tp.push_task( [parseBlocks]() { parseBlocks( false ); } );
+
+    parseBlocks( true );
+
+    // Every block has been claimed by now, so only blocks already being parsed are left
+    while( finished.wait_for( std::chrono::milliseconds( 250 ) ) != std::future_status::ready )
+    {
+        if( m_progressReporter )
+            reportProgress();
+    }
+
+    if( state->m_error )
+    {
+        for( DEFERRED_ITEM& deferred : aItems )
+        {
+            delete deferred.item;
+            deferred.item = nullptr;
+        }
+
+        std::rethrow_exception( state->m_error );
+    }
+
+    m_undefinedLayers.merge( state->m_undefinedLayers );
+
+    if( state->m_legacyTeardrops )
+        m_board->SetLegacyTeardrops( true );
+
+    // Apply the board changes the workers couldn't make, in file order so that any nets added
+    // get the same codes as when reading sequentially.
+    for( DEFERRED_ITEM& deferred : aItems )
+    {
+        for( const auto& [zone, netName] : deferred.zoneNets )
+            fixupZoneNet( zone, netName );
+
+        for( const auto& [footprint, classNames] : deferred.componentClasses )
+            footprint->ResolveComponentClassNames( m_board, classNames );
+
+        std::move( deferred.groupInfos.begin(), deferred.groupInfos.end(),
+                   std::back_inserter( m_groupInfos ) );
+        std::move( deferred.generatorInfos.begin(), deferred.generatorInfos.end(),
+                   std::back_inserter( m_generatorInfos ) );
+    }
+}
+
+
 void PCB_IO_KICAD_SEXPR_PARSER::resolveGroups( BOARD_ITEM* aParent )
 {
     auto getItem =
@@ -2071,7 +2401,7 @@ void PCB_IO_KICAD_SEXPR_PARSER::parseLayers()
 
 LSET PCB_IO_KICAD_SEXPR_PARSER::lookUpLayerSet( const LSET_MAP& aMap )
 {
-    LSET_MAP::const_iterator it = aMap.find( curText );
+    LSET_MAP::const_iterator it = aMap.find( CurStr() );
 
     if( it == aMap.end() )
         return LSET( { Rescue } );
@@ -2083,17 +2413,17 @@ LSET PCB_IO_KICAD_SEXPR_PARSER::lookUpLayerSet( const LSET_MAP& aMap )
 PCB_LAYER_ID PCB_IO_KICAD_SEXPR_PARSER::lookUpLayer( const LAYER_ID_MAP& aMap )
 {
     // avoid constructing another std::string, use lexer's directly
-    LAYER_ID_MAP::const_iterator it = aMap.find( curText );
+    LAYER_ID_MAP::const_iterator it = aMap.find( CurStr() );
 
     if( it == aMap.end() )
     {
-        m_undefinedLayers.insert( curText );
+        m_undefinedLayers.insert( CurStr() );
         return Rescue;
     }
 
     // Some files may have saved items to the Rescue Layer due to an issue in v5
     if( it->second == Rescue )
-        m_undefinedLayers.insert( curText );
+        m_undefinedLayers.insert( CurStr() );
 
     return it->second;
 }
@@ -5033,7 +5363,9 @@ FOOTPRINT* PCB_IO_KICAD_SEXPR_PARSER::parseFOOTPRINT_unchecked( wxArrayString* a
 
             footprint->SetTransientComponentClassNames( componentClassNames );
 
-            if( m_board )
+            if( m_board && m_deferBoardChanges )
+                m_deferredComponentClasses.emplace_back( footprint.get(), componentClassNames );
+            else if( m_board )
                 footprint->ResolveComponentClassNames( m_board, componentClassNames );
 
             break;
@@ -5761,7 +6093,7 @@ void PCB_IO_KICAD_SEXPR_PARSER::parsePadstack( PAD* aPad )
             NextTok();
             PCB_LAYER_ID curLayer = UNDEFINED_LAYER;
 
-            if( curText == "Inner" )
+            if( curView == "Inner" )
             {
                 if( padstack.Mode() != PADSTACK::MODE::FRONT_INNER_BACK )
                 {
@@ -5781,7 +6113,7 @@ void PCB_IO_KICAD_SEXPR_PARSER::parsePadstack( PAD* aPad )
             {
                 wxString error;
                 error.Printf( _( "Invalid padstack layer '%s' in file '%s' at line %d, offset %d." ),
-                              curText, CurSource().GetData(), CurLineNumber(), CurOffset() );
+                              CurStr(), CurSource().GetData(), CurLineNumber(), CurOffset() );
                 THROW_IO_ERROR( error );
             }
 
@@ -6774,7 +7106,7 @@ void PCB_IO_KICAD_SEXPR_PARSER::parseViastack( PCB_VIA* aVia )
             NextTok();
             PCB_LAYER_ID curLayer = UNDEFINED_LAYER;
 
-            if( curText == "Inner" )
+            if( curView == "Inner" )
             {
                 if( padstack.Mode() != PADSTACK::MODE::FRONT_INNER_BACK )
                 {
@@ -6794,7 +7126,7 @@ void PCB_IO_KICAD_SEXPR_PARSER::parseViastack( PCB_VIA* aVia )
             {
                 wxString error;
                 error.Printf( _( "Invalid padstack layer '%s' in file '%s' at line %d, offset %d." ),
-                              curText, CurSource().GetData(), CurLineNumber(), CurOffset() );
+                              CurStr(), CurSource().GetData(), CurLineNumber(), CurOffset() );
                 THROW_IO_ERROR( error );
             }
 
@@ -7525,31 +7857,19 @@ ZONE* PCB_IO_KICAD_SEXPR_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
     if( zone_has_net
         && ( !zone->GetNet() || zone->GetNet()->GetNetname() != netnameFromfile ) )
     {
-        // Can happens which old boards, with nonexistent nets ...
-        // or after being edited by hand
-        // We try to fix the mismatch.
-        NETINFO_ITEM* net = m_board->FindNet( netnameFromfile );
-
-        if( net )   // An existing net has the same net name. use it for the zone
-        {
-            zone->SetNetCode( net->GetNetCode() );
-        }
-        else    // Not existing net: add a new net to keep trace of the zone netname
-        {
-            int newnetcode = m_board->GetNetCount();
-            net = new NETINFO_ITEM( m_board, netnameFromfile, newnetcode );
-            m_board->Add( net, ADD_MODE::INSERT, true );
-
-            // Store the new code mapping
-            pushValueIntoMap( newnetcode, net->GetNetCode() );
-
-            // and update the zone netcode
-            zone->SetNetCode( net->GetNetCode() );
-        }
+        if( m_deferBoardChanges )
+            m_deferredZoneNets.emplace_back( zone.get(), netnameFromfile );
+        else
+            fixupZoneNet( zone.get(), netnameFromfile );
     }
 
     if( zone->IsTeardropArea() && m_requiredVersion < 20230517 )
-        m_board->SetLegacyTeardrops( true );
+    {
+        if( m_deferBoardChanges )
+            m_legacyTeardrops = true;
+        else
+            m_board->SetLegacyTeardrops( true );
+    }
 
     // Clear flags used in zone edition:
     zone->SetNeedRefill( false );
@@ -7558,6 +7878,32 @@ ZONE* PCB_IO_KICAD_SEXPR_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
 }
 
 
+void PCB_IO_KICAD_SEXPR_PARSER::fixupZoneNet( ZONE* aZone, const wxString& aNetName )
+{
+    // Can happens which old boards, with nonexistent nets ...
+    // or after being edited by hand
+    // We try to fix the mismatch.
+    NETINFO_ITEM* net = m_board->FindNet( aNetName );
+
+    if( net )   // An existing net has the same net name. use it for the zone
+    {
+        aZone->SetNetCode( net->GetNetCode() );
+    }
+    else    // Not existing net: add a new net to keep trace of the zone netname
+    {
+        int newnetcode = m_board->GetNetCount();
+        net = new NETINFO_ITEM( m_board, aNetName, newnetcode );
+        m_board->Add( net, ADD_MODE::INSERT, true );
+
+        // Store the new code mapping
+        pushValueIntoMap( newnetcode, net->GetNetCode() );
+
+        // and update the zone netcode
+        aZone->SetNetCode( net->GetNetCode() );
+    }
+}
+
+
 PCB_TARGET* PCB_IO_KICAD_SEXPR_PARSER::parsePCB_TARGET()
 {
     wxCHECK_MSG( CurTok() == T_target, nullptr,
@@ -39,8 +39,10 @@
 #include <math/box2.h>
 #include <string_any_map.h>
 
+#include <charconv>
 #include <chrono>
 #include <unordered_map>
+#include <unordered_set>
 
 
 class PCB_ARC;
@@ -67,6 +69,7 @@ class SHAPE_LINE_CHAIN;
 struct LAYER;
 class PROGRESS_REPORTER;
 class TEARDROP_PARAMETERS;
+class MAPPED_FILE_LINE_READER;
 
 
 /**
@@ -90,7 +93,9 @@ public:
         m_progressReporter( aProgressReporter ),
         m_lastProgressTime( std::chrono::steady_clock::now() ),
         m_lineCount( aLineCount ),
-        m_queryUserCallback( std::move( aQueryUserCallback ) )
+        m_queryUserCallback( std::move( aQueryUserCallback ) ),
+        m_deferBoardChanges( false ),
+        m_legacyTeardrops( false )
     {
         init();
     }
@@ -151,6 +156,22 @@ private:
         STRING_ANY_MAP properties;
     };
 
+    /**
+     * A top-level footprint, track, via or zone whose parsing is deferred until the rest of the
+     * board has been read, so that all such items can be parsed concurrently.
+     */
+    struct DEFERRED_ITEM
+    {
+        size_t      start;  ///< offset of the item's keyword in the file
+        unsigned    line;   ///< line number of \a start
+        BOARD_ITEM* item;   ///< the parsed item, or nullptr
+
+        std::vector<GROUP_INFO>                 groupInfos;
+        std::vector<GENERATOR_INFO>             generatorInfos;
+        std::vector<std::pair<ZONE*, wxString>> zoneNets;
+        std::vector<std::pair<FOOTPRINT*, std::unordered_set<wxString>>> componentClasses;
+    };
+
     ///< Convert net code using the mapping table if available,
     ///< otherwise returns unchanged net code if < 0 or if it's out of range
     inline int getNetCode( int aNetCode )
@@ -248,6 +269,32 @@ private:
     // Parse a board, but do not replace PARSE_ERROR with FUTURE_FORMAT_ERROR automatically.
     BOARD*      parseBOARD_unchecked();
 
+    /**
+     * Record the footprint, track, via or zone whose keyword was just read for parsing later,
+     * and move the lexer past it.
+     *
+     * @return false if the end of the item couldn't be found, in which case nothing was
+     *         consumed and it should be parsed in place.
+     */
+    bool deferItem( MAPPED_FILE_LINE_READER& aReader, std::vector<DEFERRED_ITEM>& aItems );
+
+    /**
+     * Parse the deferred items on the thread pool and apply any board changes they require.
+     * On return every item has been parsed, or all of them have been deleted and the first
+     * error (in file order) rethrown.
+     */
+    void parseDeferredItems( const MAPPED_FILE_LINE_READER& aReader,
+                             std::vector<DEFERRED_ITEM>& aItems );
+
+    ///< Parse a single deferred item, from a worker parser.
+    BOARD_ITEM* parseDeferredItem( MAPPED_FILE_LINE_READER& aReader, DEFERRED_ITEM& aItem );
+
+    ///< Give a worker parser the layer, net and version information read so far by this one.
+    void inheritState( const PCB_IO_KICAD_SEXPR_PARSER& aParent );
+
+    ///< Make a copper zone's net match the net name saved with it, adding the net if need be.
+    void fixupZoneNet( ZONE* aZone, const wxString& aNetName );
+
     /**
      * Parse the current token for the layer definition of a #BOARD_ITEM object.
      *
@@ -355,7 +402,16 @@ private:
 
     inline int parseInt()
     {
-        return (int)strtol( CurText(), nullptr, 10 );
+        // Parsed from the token in place, as strtol() would but without copying it
+        std::string_view text = CurView();
+        long             value = 0;
+
+        if( !text.empty() && text.front() == '+' )
+            text.remove_prefix( 1 );
+
+        std::from_chars( text.data(), text.data() + text.size(), value );
+
+        return (int) value;
     }
 
     inline int parseInt( const char* aExpected )
@@ -433,6 +489,14 @@ private:
     std::vector<GENERATOR_INFO> m_generatorInfos;
 
     std::function<bool( wxString aTitle, int aIcon, wxString aMsg, wxString aAction )> m_queryUserCallback;
+
+    ///< Set in worker parsers, which mustn't modify the board.  Changes they would make are
+    ///< recorded below and applied by the main parser.
+    bool                m_deferBoardChanges;
+
+    std::vector<std::pair<ZONE*, wxString>>                          m_deferredZoneNets;
+    std::vector<std::pair<FOOTPRINT*, std::unordered_set<wxString>>> m_deferredComponentClasses;
+    bool                                                             m_legacyTeardrops;
 };
 
 
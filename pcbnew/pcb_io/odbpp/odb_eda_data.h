@@ -264,6 +264,42 @@ private:
     std::vector<std::shared_ptr<FOOTPRINT>> m_eda_footprints;
 };
 
+
+/**
+ * The subnet feature IDs of one layer, collected while its features are built.
+ *
+ * Subnets are shared by all layers, which are built concurrently.  So the IDs are only added
+ * to the subnets once every layer is built, one layer after another, which keeps the subnet
+ * and layer order of the EDA data file independent of the order the layers finish in.
+ */
+class ODB_SUBNET_FEATURES
+{
+public:
+    void Add( EDA_DATA::SUB_NET* aSubnet, EDA_DATA::FEATURE_ID::TYPE aType, size_t aFeatureId )
+    {
+        m_featureIds.push_back( { aSubnet, aType, aFeatureId } );
+    }
+
+    void AddToSubnets( const wxString& aLayerName )
+    {
+        for( const FEATURE& feature : m_featureIds )
+            feature.m_subnet->AddFeatureID( feature.m_type, aLayerName, feature.m_featureId );
+
+        m_featureIds.clear();
+    }
+
+private:
+    struct FEATURE
+    {
+        EDA_DATA::SUB_NET*         m_subnet;
+        EDA_DATA::FEATURE_ID::TYPE m_type;
+        size_t                     m_featureId;
+    };
+
+    std::vector<FEATURE> m_featureIds;
+};
+
+
 class PKG_OUTLINE
 {
 public:
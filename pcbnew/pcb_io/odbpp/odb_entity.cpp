@@ -19,6 +19,11 @@
  */
 
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+#include <advanced_config.h>
 #include <base_units.h>
 #include <board_stackup_manager/stackup_predefined_prms.h>
 #include <build_version.h>
@@ -40,6 +45,7 @@
 #include <pgm_base.h>
 #include <progress_reporter.h>
 #include <settings/settings_manager.h>
+#include <thread_pool.h>
 #include <wx_fstream_progress.h>
 
 #include <geometry/shape_circle.h>
@@ -556,10 +562,8 @@ void ODB_MATRIX_ENTITY::GenerateFiles( ODB_TREE_WRITER& writer )
 
 
 ODB_LAYER_ENTITY::ODB_LAYER_ENTITY( BOARD* aBoard, PCB_IO_ODBPP* aPlugin,
-                                    std::map<int, std::vector<BOARD_ITEM*>>& aMap,
                                     const PCB_LAYER_ID& aLayerID, const wxString& aLayerName ) :
-        ODB_ENTITY_BASE( aBoard, aPlugin ), m_layerItems( aMap ), m_layerID( aLayerID ),
-        m_matrixLayerName( aLayerName )
+        ODB_ENTITY_BASE( aBoard, aPlugin ), m_layerID( aLayerID ), m_matrixLayerName( aLayerName )
 {
     m_featuresMgr = std::make_unique<FEATURES_MANAGER>( aBoard, aPlugin, aLayerName );
 }
@@ -567,6 +571,10 @@ ODB_LAYER_ENTITY::ODB_LAYER_ENTITY( BOARD* aBoard, PCB_IO_ODBPP* aPlugin,
 
 void ODB_LAYER_ENTITY::InitEntityData()
 {
+    // Layers are built concurrently, so each one collects its items into its own map.  The
+    // plugin's maps are shared by all layers and are only read here.
+    m_layerItems.clear();
+
     if( m_matrixLayerName.Contains( "drill" ) )
     {
         InitDrillData();
@@ -585,6 +593,12 @@ void ODB_LAYER_ENTITY::InitEntityData()
 
     if( m_layerID != PCB_LAYER_ID::UNDEFINED_LAYER )
     {
+        const auto& elements = m_plugin->GetLayerElementsMap();
+        auto        it = elements.find( m_layerID );
+
+        if( it != elements.end() )
+            m_layerItems = it->second;
+
         InitFeatureData();
     }
 }
@@ -612,7 +626,7 @@ void ODB_LAYER_ENTITY::InitFeatureData()
         if( vec.empty() )
             continue;
 
-        m_featuresMgr->InitFeatureList( m_layerID, vec );
+        m_featuresMgr->InitFeatureList( m_layerID, vec, m_subnetFeatures );
     }
 }
 
@@ -642,16 +656,11 @@ ODB_COMPONENT& ODB_LAYER_ENTITY::InitComponentData( const FOOTPRINT*         aFp
 
 void ODB_LAYER_ENTITY::InitDrillData()
 {
-    std::map<std::pair<PCB_LAYER_ID, PCB_LAYER_ID>, std::vector<BOARD_ITEM*>>& drill_layers =
-            m_plugin->GetDrillLayerItemsMap();
+    const std::map<std::pair<PCB_LAYER_ID, PCB_LAYER_ID>, std::vector<BOARD_ITEM*>>&
+            drill_layers = m_plugin->GetDrillLayerItemsMap();
 
-    std::map<std::pair<PCB_LAYER_ID, PCB_LAYER_ID>, std::vector<BOARD_ITEM*>>& slot_holes =
-            m_plugin->GetSlotHolesMap();
-
-    if( !m_layerItems.empty() )
-    {
-        m_layerItems.clear();
-    }
+    const std::map<std::pair<PCB_LAYER_ID, PCB_LAYER_ID>, std::vector<BOARD_ITEM*>>&
+            slot_holes = m_plugin->GetSlotHolesMap();
 
     m_tools.emplace( PCB_IO_ODBPP::m_unitsStr );
 
@@ -745,12 +754,7 @@ void ODB_LAYER_ENTITY::InitDrillData()
 
 void ODB_LAYER_ENTITY::InitAuxilliaryData()
 {
-    auto& auxilliary_layers = m_plugin->GetAuxilliaryLayerItemsMap();
-
-    if( !m_layerItems.empty() )
-    {
-        m_layerItems.clear();
-    }
+    const auto& auxilliary_layers = m_plugin->GetAuxilliaryLayerItemsMap();
 
     for( const auto& [layer_pair, vec] : auxilliary_layers )
     {
@@ -808,11 +812,7 @@ void ODB_STEP_ENTITY::InitEntityData()
 
     InitEdaData();
 
-    // Init Layer Entity Data
-    for( const auto& [layerName, layer_entity_ptr] : m_layerEntityMap )
-    {
-        layer_entity_ptr->InitEntityData();
-    }
+    // The data of each layer is only built when its files are written, see GenerateFiles()
 }
 
 
@@ -834,6 +834,22 @@ void ODB_LAYER_ENTITY::GenerateFiles( ODB_TREE_WRITER& writer )
 }
 
 
+void ODB_LAYER_ENTITY::AddSubnetFeatureIDs()
+{
+    m_subnetFeatures.AddToSubnets( m_matrixLayerName );
+}
+
+
+void ODB_LAYER_ENTITY::ClearLayerData()
+{
+    m_layerItems.clear();
+    m_featuresMgr.reset();
+    m_tools.reset();
+    m_compTop.reset();
+    m_compBot.reset();
+}
+
+
 void ODB_LAYER_ENTITY::GenComponents( ODB_TREE_WRITER& writer )
 {
     auto fileproxy = writer.CreateFileProxy( "components" );
@@ -975,23 +991,135 @@ void ODB_STEP_ENTITY::InitEdaData()
 }
 
 
+/**
+ * Run \a aTasks, on the thread pool if \a aParallel is set, and wait for them all to finish.
+ *
+ * The export may itself be running as a pool task, so the calling thread takes tasks too, and
+ * once none are left to start it only waits for those running on other threads.  A pool thread
+ * which only starts after that finds nothing left to do.  The first exception thrown by a task
+ * is rethrown once all tasks have finished.
+ */
+static void runTasks( std::vector<std::function<void()>> aTasks, bool aParallel )
+{
+    struct SHARED_STATE
+    {
+        std::vector<std::function<void()>> tasks;
+        std::atomic<size_t>                next = 0;
+        size_t                             finished = 0;
+        std::exception_ptr                 error;
+        std::mutex                         mutex;
+        std::condition_variable            allFinished;
+    };
+
+    std::shared_ptr<SHARED_STATE> state = std::make_shared<SHARED_STATE>();
+    state->tasks = std::move( aTasks );
+
+    auto work =
+            [state]()
+            {
+                for( size_t ii = state->next++; ii < state->tasks.size(); ii = state->next++ )
+                {
+                    std::exception_ptr error;
+
+                    try
+                    {
+                        state->tasks[ii]();
+                    }
+                    catch( ... )
+                    {
+                        error = std::current_exception();
+                    }
+
+                    std::lock_guard<std::mutex> lock( state->mutex );
+
+                    if( error && !state->error )
+                        state->error = error;
+
+                    if( ++state->finished == state->tasks.size() )
+                        state->allFinished.notify_all();
+                }
+            };
+
+    if( aParallel )
+    {
+        thread_pool& tp = GetKiCadThreadPool();
+        size_t       workers = std::min<size_t>( tp.get_thread_count(), state->tasks.size() );
+
+        // The calling thread is one of the workers
+        for( size_t ii = 1; ii < workers; ++ii )
+            tp.push_task( work );
+    }
+
+    work();
+
+    std::unique_lock<std::mutex> lock( state->mutex );
+
+    state->allFinished.wait( lock,
+                             [&]()
+                             {
+                                 return state->finished == state->tasks.size();
+                             } );
+
+    if( state->error )
+        std::rethrow_exception( state->error );
+}
+
+
 void ODB_STEP_ENTITY::GenerateFiles( ODB_TREE_WRITER& writer )
 {
     wxString step_root = writer.GetCurrentPath();
 
+    // The netlist and each layer are built and written as separate tasks, each through its
+    // own copy of the tree writer since a writer's current path follows the directory it
+    // writes to.  A layer's features are freed as soon as its files are written.
+    std::vector<std::function<void()>> tasks;
+
+    writer.CreateEntityDirectory( step_root, "netlists/cadnet" );
+
+    tasks.emplace_back(
+            [this, netlistWriter = writer]() mutable
+            {
+                GenerateNetlistsFiles( netlistWriter );
+            } );
+
     writer.CreateEntityDirectory( step_root, "layers" );
-    GenerateLayerFiles( writer );
+    wxString layers_root = writer.GetCurrentPath();
 
-    writer.CreateEntityDirectory( step_root, "eda" );
-    GenerateEdaFiles( writer );
+    for( const auto& entry : m_layerEntityMap )
+    {
+        tasks.emplace_back(
+                [layerWriter = writer, layers_root, layerName = entry.first,
+                 layerEntity = entry.second]() mutable
+                {
+                    layerWriter.CreateEntityDirectory( layers_root, layerName );
 
-    writer.CreateEntityDirectory( step_root, "netlists/cadnet" );
-    GenerateNetlistsFiles( writer );
+                    layerEntity->InitEntityData();
+                    layerEntity->GenerateFiles( layerWriter );
+                    layerEntity->ClearLayerData();
+                } );
+    }
 
     writer.SetCurrentPath( step_root );
-    GenerateProfileFile( writer );
 
-    GenerateStepHeaderFile( writer );
+    tasks.emplace_back(
+            [this, stepWriter = writer]() mutable
+            {
+                GenerateProfileFile( stepWriter );
+                GenerateStepHeaderFile( stepWriter );
+            } );
+
+    runTasks( std::move( tasks ), ADVANCED_CFG::GetCfg().m_ParallelODBPPExport );
+
+    // The EDA data refers to the features of every layer, so it is written last.  Feature IDs
+    // are added layer by layer to keep the order of the file independent of the order the
+    // layers were finished in.
+    for( const auto& [layerName, layerEntity] : m_layerEntityMap )
+        layerEntity->AddSubnetFeatureIDs();
+
+    writer.CreateEntityDirectory( step_root, "eda" );
+    GenerateEdaFiles( writer );
+
+    writer.SetCurrentPath( step_root );
 
     //TODO: system attributes
     // GenerateAttrListFile( writer );
@@ -1047,19 +1175,6 @@ void ODB_STEP_ENTITY::GenerateStepHeaderFile( ODB_TREE_WRITER& writer )
 }
 
 
-void ODB_STEP_ENTITY::GenerateLayerFiles( ODB_TREE_WRITER& writer )
-{
-    wxString layers_root = writer.GetCurrentPath();
-
-    for( auto& [layerName, layerEntity] : m_layerEntityMap )
-    {
-        writer.CreateEntityDirectory( layers_root, layerName );
-
-        layerEntity->GenerateFiles( writer );
-    }
-}
-
-
 void ODB_STEP_ENTITY::GenerateEdaFiles( ODB_TREE_WRITER& writer )
 {
     auto fileproxy = writer.CreateFileProxy( "data" );
@@ -1185,8 +1300,8 @@ void ODB_STEP_ENTITY::MakeLayerEntity()
 
     for( const auto& [layerID, layerName] : m_plugin->GetLayerNameList() )
     {
-        std::shared_ptr<ODB_LAYER_ENTITY> layer_entity_ptr = std::make_shared<ODB_LAYER_ENTITY>(
-                m_board, m_plugin, elements[layerID], layerID, layerName );
+        std::shared_ptr<ODB_LAYER_ENTITY> layer_entity_ptr =
+                std::make_shared<ODB_LAYER_ENTITY>( m_board, m_plugin, layerID, layerName );
 
         m_layerEntityMap.emplace( layerName, layer_entity_ptr );
     }
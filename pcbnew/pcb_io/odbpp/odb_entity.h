@@ -155,7 +155,6 @@ public:
     virtual bool CreateDirectoryTree( ODB_TREE_WRITER& writer ) override;
 
     virtual void InitEntityData() override;
-    void         GenerateLayerFiles( ODB_TREE_WRITER& writer );
     void         GenerateEdaFiles( ODB_TREE_WRITER& writer );
     void         GenerateNetlistsFiles( ODB_TREE_WRITER& writer );
     void         GenerateProfileFile( ODB_TREE_WRITER& writer );
@@ -177,8 +176,7 @@ private:
 class ODB_LAYER_ENTITY : public ODB_ENTITY_BASE
 {
 public:
-    ODB_LAYER_ENTITY( BOARD* aBoard, PCB_IO_ODBPP* aPlugin,
-                      std::map<int, std::vector<BOARD_ITEM*>>& aMap, const PCB_LAYER_ID& aLayerID,
+    ODB_LAYER_ENTITY( BOARD* aBoard, PCB_IO_ODBPP* aPlugin, const PCB_LAYER_ID& aLayerID,
                       const wxString& aLayerName );
 
     virtual ~ODB_LAYER_ENTITY() = default;
@@ -193,6 +191,17 @@ public:
 
     void AddLayerFeatures();
 
+    /**
+     * Add the IDs of this layer's features to the EDA data subnets they belong to.  This must
+     * be done for one layer at a time, once every layer has been built.
+     */
+    void AddSubnetFeatureIDs();
+
+    /**
+     * Free the features and other data of this layer once its files have been written.
+     */
+    void ClearLayerData();
+
 
     void GenAttrList( ODB_TREE_WRITER& writer );
     void GenComponents( ODB_TREE_WRITER& writer );
@@ -211,6 +220,7 @@ private:
     std::optional<COMPONENTS_MANAGER> m_compTop;
     std::optional<COMPONENTS_MANAGER> m_compBot;
     std::unique_ptr<FEATURES_MANAGER> m_featuresMgr;
+    ODB_SUBNET_FEATURES               m_subnetFeatures;
 };
 
 class ODB_SYMBOLS_ENTITY : public ODB_ENTITY_BASE
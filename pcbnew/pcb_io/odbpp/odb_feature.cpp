@@ -364,7 +364,8 @@ void FEATURES_MANAGER::AddPadShape( const PAD& aPad, PCB_LAYER_ID aLayer )
 }
 
 
-void FEATURES_MANAGER::InitFeatureList( PCB_LAYER_ID aLayer, std::vector<BOARD_ITEM*>& aItems )
+void FEATURES_MANAGER::InitFeatureList( PCB_LAYER_ID aLayer, std::vector<BOARD_ITEM*>& aItems,
+                                        ODB_SUBNET_FEATURES& aSubnetFeatures )
 {
     auto add_track = [&]( PCB_TRACK* track )
     {
@@ -386,8 +387,8 @@ void FEATURES_MANAGER::InitFeatureList( PCB_LAYER_ID aLayer, std::vector<BOARD_I
             shape.SetWidth( track->GetWidth() );
 
             AddShape( shape );
-            subnet->AddFeatureID( EDA_DATA::FEATURE_ID::TYPE::COPPER, m_layerName,
-                                  m_featuresList.size() - 1 );
+            aSubnetFeatures.Add( subnet, EDA_DATA::FEATURE_ID::TYPE::COPPER,
+                                 m_featuresList.size() - 1 );
         }
         else if( track->Type() == PCB_ARC_T )
         {
@@ -398,8 +399,8 @@ void FEATURES_MANAGER::InitFeatureList( PCB_LAYER_ID aLayer, std::vector<BOARD_I
 
             AddShape( shape );
 
-            subnet->AddFeatureID( EDA_DATA::FEATURE_ID::TYPE::COPPER, m_layerName,
-                                  m_featuresList.size() - 1 );
+            aSubnetFeatures.Add( subnet, EDA_DATA::FEATURE_ID::TYPE::COPPER,
+                                 m_featuresList.size() - 1 );
         }
         else
         {
@@ -421,8 +422,8 @@ void FEATURES_MANAGER::InitFeatureList( PCB_LAYER_ID aLayer, std::vector<BOARD_I
             if( hole )
             {
                 AddViaDrillHole( via, aLayer );
-                subnet->AddFeatureID( EDA_DATA::FEATURE_ID::TYPE::HOLE, m_layerName,
-                                      m_featuresList.size() - 1 );
+                aSubnetFeatures.Add( subnet, EDA_DATA::FEATURE_ID::TYPE::HOLE,
+                                     m_featuresList.size() - 1 );
 
                 // TODO: confirm TOOLING_HOLE
                 // AddSystemAttribute( *m_featuresList.back(), ODB_ATTR::PAD_USAGE::TOOLING_HOLE );
@@ -440,8 +441,8 @@ void FEATURES_MANAGER::InitFeatureList( PCB_LAYER_ID aLayer, std::vector<BOARD_I
             {
                 // to draw via copper shape on copper layer
                 AddVia( via, aLayer );
-                subnet->AddFeatureID( EDA_DATA::FEATURE_ID::TYPE::COPPER, m_layerName,
-                                      m_featuresList.size() - 1 );
+                aSubnetFeatures.Add( subnet, EDA_DATA::FEATURE_ID::TYPE::COPPER,
+                                     m_featuresList.size() - 1 );
 
                 if( !m_featuresList.empty() )
                 {
@@ -471,8 +472,8 @@ void FEATURES_MANAGER::InitFeatureList( PCB_LAYER_ID aLayer, std::vector<BOARD_I
                 return;
             }
 
-            iter->second->AddFeatureID( EDA_DATA::FEATURE_ID::TYPE::COPPER, m_layerName,
-                                        m_featuresList.size() - 1 );
+            aSubnetFeatures.Add( iter->second, EDA_DATA::FEATURE_ID::TYPE::COPPER,
+                                 m_featuresList.size() - 1 );
 
             if( zone->IsTeardropArea() && !m_featuresList.empty() )
                 AddSystemAttribute( *m_featuresList.back(), ODB_ATTR::TEAR_DROP{ true } );
@@ -696,8 +697,8 @@ void FEATURES_MANAGER::InitFeatureList( PCB_LAYER_ID aLayer, std::vector<BOARD_I
 
             AddPadShape( *pad, aLayer );
 
-            iter->second->AddFeatureID( EDA_DATA::FEATURE_ID::TYPE::COPPER, m_layerName,
-                                        m_featuresList.size() - 1 );
+            aSubnetFeatures.Add( iter->second, EDA_DATA::FEATURE_ID::TYPE::COPPER,
+                                 m_featuresList.size() - 1 );
             if( !m_featuresList.empty() )
                 AddSystemAttribute( *m_featuresList.back(), ODB_ATTR::PAD_USAGE::TOEPRINT );
 
@@ -727,8 +728,8 @@ void FEATURES_MANAGER::InitFeatureList( PCB_LAYER_ID aLayer, std::vector<BOARD_I
                 if( pad->GetAttribute() == PAD_ATTRIB::PTH )
                 {
                     // only plated holes link to subnet
-                    iter->second->AddFeatureID( EDA_DATA::FEATURE_ID::TYPE::HOLE, m_layerName,
-                                                m_featuresList.size() - 1 );
+                    aSubnetFeatures.Add( iter->second, EDA_DATA::FEATURE_ID::TYPE::HOLE,
+                                         m_featuresList.size() - 1 );
 
                     if( !m_featuresList.empty() )
                         AddSystemAttribute( *m_featuresList.back(), ODB_ATTR::DRILL::PLATED );
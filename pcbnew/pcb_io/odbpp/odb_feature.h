@@ -45,6 +45,7 @@ class ODB_SURFACE;
 class ODB_FEATURE;
 class PCB_IO_ODBPP;
 class PCB_VIA;
+class ODB_SUBNET_FEATURES;
 
 class FEATURES_MANAGER : public ATTR_MANAGER
 {
@@ -56,7 +57,13 @@ public:
 
     virtual ~FEATURES_MANAGER() { m_featuresList.clear(); }
 
-    void InitFeatureList( PCB_LAYER_ID aLayer, std::vector<BOARD_ITEM*>& aItems );
+    /**
+     * Build the features of \a aItems on \a aLayer.
+     *
+     * @param aSubnetFeatures receives the IDs of the features which belong to EDA data subnets.
+     */
+    void InitFeatureList( PCB_LAYER_ID aLayer, std::vector<BOARD_ITEM*>& aItems,
+                          ODB_SUBNET_FEATURES& aSubnetFeatures );
 
     void AddFeatureLine( const VECTOR2I& aStart, const VECTOR2I& aEnd, uint64_t aWidth );
 
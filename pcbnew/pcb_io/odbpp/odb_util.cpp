@@ -25,6 +25,10 @@
 #include <wx/chartype.h>
 #include <wx/dir.h>
 #include <wx/regex.h>
+#include <wx/tarstrm.h>
+#include <wx/wfstream.h>
+#include <wx/zipstrm.h>
+#include <wx/zstream.h>
 #include "idf_helpers.h"
 #include "odb_defines.h"
 #include "pcb_io_odbpp.h"
@@ -213,7 +217,11 @@ void ODB_TREE_WRITER::CreateEntityDirectory( const wxString& aPareDir,
     for( size_t i = 0; i < subDirs.GetCount(); i++ )
         path.AppendDir( subDirs[i] );
 
-    if( !path.DirExists() )
+    if( m_archive )
+    {
+        m_archive->AddDirectory( path.GetPath() );
+    }
+    else if( !path.DirExists() )
     {
         if( !path.Mkdir( wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL ) )
         {
@@ -225,6 +233,107 @@ void ODB_TREE_WRITER::CreateEntityDirectory( const wxString& aPareDir,
 }
 
 
+ODB_ARCHIVE_WRITER::ODB_ARCHIVE_WRITER( const wxString& aFileName, FORMAT aFormat,
+                                        const wxString& aRootDir ) :
+        m_rootDir( aRootDir ),
+        m_ok( true )
+{
+    m_file = std::make_unique<wxFFileOutputStream>( aFileName );
+
+    if( !m_file->IsOk() )
+        throw std::runtime_error( "Failed to open file: " + aFileName );
+
+    if( aFormat == FORMAT::ZIP )
+    {
+        m_archive = std::make_unique<wxZipOutputStream>( *m_file );
+    }
+    else
+    {
+        m_zlib = std::make_unique<wxZlibOutputStream>( *m_file, -1, wxZLIB_GZIP );
+        m_archive = std::make_unique<wxTarOutputStream>( *m_zlib );
+    }
+}
+
+
+ODB_ARCHIVE_WRITER::~ODB_ARCHIVE_WRITER()
+{
+    Close();
+}
+
+
+wxString ODB_ARCHIVE_WRITER::archivePath( const wxString& aPath ) const
+{
+    if( m_rootDir.IsEmpty() )
+        return aPath;
+
+    return m_rootDir + wxFileName::GetPathSeparator() + aPath;
+}
+
+
+void ODB_ARCHIVE_WRITER::AddDirectory( const wxString& aPath )
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    if( !m_archive )
+        return;
+
+    wxString path;
+
+    for( const wxString& dir : wxFileName::DirName( aPath ).GetDirs() )
+    {
+        path = path.IsEmpty() ? dir : path + wxFileName::GetPathSeparator() + dir;
+
+        if( !m_directories.insert( path ).second )
+            continue;
+
+        if( !m_archive->PutNextDirEntry( archivePath( path ) ) )
+            m_ok = false;
+    }
+}
+
+
+void ODB_ARCHIVE_WRITER::AddFile( const wxString& aPath, std::string_view aContents )
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    if( !m_archive )
+    {
+        m_ok = false;
+        return;
+    }
+
+    if( !m_archive->PutNextEntry( archivePath( aPath ), wxDateTime::Now(), aContents.size() )
+        || !m_archive->Write( aContents.data(), aContents.size() ).IsOk() )
+    {
+        m_ok = false;
+    }
+}
+
+
+bool ODB_ARCHIVE_WRITER::Close()
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    if( !m_archive )
+        return m_ok;
+
+    if( !m_archive->Close() )
+        m_ok = false;
+
+    if( m_zlib && !m_zlib->Close() )
+        m_ok = false;
+
+    if( !m_file->Close() )
+        m_ok = false;
+
+    m_archive.reset();
+    m_zlib.reset();
+    m_file.reset();
+
+    return m_ok;
+}
+
+
 ODB_FILE_WRITER::ODB_FILE_WRITER( ODB_TREE_WRITER& aTreeWriter, const wxString& aFileName ) :
         m_treeWriter( aTreeWriter )
 {
@@ -234,13 +343,25 @@ ODB_FILE_WRITER::ODB_FILE_WRITER( ODB_TREE_WRITER& aTreeWriter, const wxString&
 
 void ODB_FILE_WRITER::CreateFile( const wxString& aFileName )
 {
-    if( aFileName.IsEmpty() || m_treeWriter.GetCurrentPath().IsEmpty() )
+    if( aFileName.IsEmpty() )
         return;
 
     wxFileName fn;
     fn.SetPath( m_treeWriter.GetCurrentPath() );
     fn.SetFullName( aFileName );
 
+    // Archive paths are relative to the root of the archive, so an empty path is the root
+    if( m_treeWriter.GetArchive() )
+    {
+        m_archivePath = fn.GetFullPath();
+        m_buffer.str( std::string() );
+        m_buffer.imbue( std::locale::classic() );
+        return;
+    }
+
+    if( m_treeWriter.GetCurrentPath().IsEmpty() )
+        return;
+
     wxString dirPath = fn.GetPath();
 
     if( !wxDir::Exists( dirPath ) )
@@ -267,6 +388,14 @@ void ODB_FILE_WRITER::CreateFile( const wxString& aFileName )
 
 bool ODB_FILE_WRITER::CloseFile()
 {
+    if( !m_archivePath.IsEmpty() )
+    {
+        m_treeWriter.GetArchive()->AddFile( m_archivePath, m_buffer.view() );
+        m_archivePath.Clear();
+        m_buffer.str( std::string() );
+        return true;
+    }
+
     if( m_ostream.is_open() )
     {
         m_ostream.close();
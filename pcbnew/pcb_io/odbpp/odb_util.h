@@ -4,8 +4,13 @@
 #include <map>
 #include <iostream>
 #include <fstream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <wx/string.h>
 #include "pcb_shape.h"
 #include <wx/filename.h>
@@ -213,6 +218,63 @@ private:
 
 } // namespace ODB
 
+class wxArchiveOutputStream;
+class wxFFileOutputStream;
+class wxZlibOutputStream;
+
+/**
+ * Writes the directories and files of an ODB++ tree straight into a zip or gzipped tar
+ * archive as they are generated, rather than into a directory tree which is compressed
+ * afterwards.
+ *
+ * Files can be added from several threads; each is written as a whole entry.
+ */
+class ODB_ARCHIVE_WRITER
+{
+public:
+    enum class FORMAT
+    {
+        ZIP,
+        TGZ
+    };
+
+    /**
+     * @param aFileName is the archive to create.
+     * @param aRootDir is a directory to put the whole tree in, or empty for the archive root.
+     */
+    ODB_ARCHIVE_WRITER( const wxString& aFileName, FORMAT aFormat,
+                        const wxString& aRootDir = wxEmptyString );
+
+    ~ODB_ARCHIVE_WRITER();
+
+    /**
+     * Add entries for \a aPath and those of its parents which haven't been added yet.
+     */
+    void AddDirectory( const wxString& aPath );
+
+    void AddFile( const wxString& aPath, std::string_view aContents );
+
+    /**
+     * Finish the archive.
+     *
+     * @return false if anything could not be written.
+     */
+    bool Close();
+
+private:
+    wxString archivePath( const wxString& aPath ) const;
+
+    std::mutex m_mutex;
+    wxString   m_rootDir;
+    bool       m_ok;
+
+    std::unique_ptr<wxFFileOutputStream>   m_file;
+    std::unique_ptr<wxZlibOutputStream>    m_zlib;
+    std::unique_ptr<wxArchiveOutputStream> m_archive;
+    std::set<wxString>                     m_directories;
+};
+
+
 class ODB_TREE_WRITER;
 class ODB_FILE_WRITER
 {
@@ -229,20 +291,36 @@ public:
 
     void                 CreateFile( const wxString& aFileName );
     bool                 CloseFile();
-    inline std::ostream& GetStream() { return m_ostream; }
+
+    inline std::ostream& GetStream()
+    {
+        if( !m_archivePath.IsEmpty() )
+            return m_buffer;
+
+        return m_ostream;
+    }
 
 private:
-    ODB_TREE_WRITER& m_treeWriter;
-    std::ofstream    m_ostream;
+    ODB_TREE_WRITER&   m_treeWriter;
+    std::ofstream      m_ostream;
+
+    // When writing to an archive, the file is built here and added as a whole on closing
+    wxString           m_archivePath;
+    std::ostringstream m_buffer;
 };
 
 
 class ODB_TREE_WRITER
 {
 public:
-    ODB_TREE_WRITER( const wxString& aDir ) : m_currentPath( aDir ) {}
+    ODB_TREE_WRITER( const wxString& aDir ) : m_currentPath( aDir ), m_archive( nullptr ) {}
 
-    ODB_TREE_WRITER( const wxString& aPareDir, const wxString& aSubDir )
+    /**
+     * Write the tree into \a aArchive.  Paths are then relative to the root of the archive.
+     */
+    ODB_TREE_WRITER( ODB_ARCHIVE_WRITER* aArchive ) : m_archive( aArchive ) {}
+
+    ODB_TREE_WRITER( const wxString& aPareDir, const wxString& aSubDir ) : m_archive( nullptr )
     {
         CreateEntityDirectory( aPareDir, aSubDir );
     }
@@ -264,10 +342,13 @@ public:
 
     inline const wxString GetRootPath() const { return m_rootPath; }
 
+    inline ODB_ARCHIVE_WRITER* GetArchive() const { return m_archive; }
+
 
 private:
-    wxString m_currentPath;
-    wxString m_rootPath;
+    wxString            m_currentPath;
+    wxString            m_rootPath;
+    ODB_ARCHIVE_WRITER* m_archive;
 };
 
 
@@ -87,15 +87,31 @@ bool PCB_IO_ODBPP::GenerateFiles( ODB_TREE_WRITER& writer )
 
 bool PCB_IO_ODBPP::ExportODB( const wxString& aFileName )
 {
+    std::unique_ptr<ODB_ARCHIVE_WRITER> archive;
+
     try
     {
-        std::shared_ptr<ODB_TREE_WRITER> writer =
-                std::make_shared<ODB_TREE_WRITER>( aFileName );
+        std::shared_ptr<ODB_TREE_WRITER> writer;
+
+        if( m_archiveFormat )
+        {
+            // A tar archive keeps the tree in a top level directory
+            wxString rootDir = *m_archiveFormat == ODB_ARCHIVE_WRITER::FORMAT::TGZ ? wxS( "odb" )
+                                                                                  : wxString();
+
+            archive = std::make_unique<ODB_ARCHIVE_WRITER>( aFileName, *m_archiveFormat, rootDir );
+            writer = std::make_shared<ODB_TREE_WRITER>( archive.get() );
+        }
+        else
+        {
+            writer = std::make_shared<ODB_TREE_WRITER>( aFileName );
+        }
+
         writer->SetRootPath( writer->GetCurrentPath() );
 
         if( m_progressReporter )
         {
-            m_progressReporter->SetNumPhases( 3 );
+            m_progressReporter->SetNumPhases( 2 );
             m_progressReporter->BeginPhase( 0 );
             m_progressReporter->Report( _( "Creating ODB++ Structure" ) );
         }
@@ -121,12 +137,23 @@ bool PCB_IO_ODBPP::ExportODB( const wxString& aFileName )
         if( !GenerateFiles( *writer ) )
             return false;
 
+        if( archive && !archive->Close() )
+            throw std::runtime_error( "Failed to write archive" );
+
         return true;
     }
     catch( const std::exception& e )
     {
         wxLogError( "Exception in ODB++ ExportODB process: %s", e.what() );
         std::cerr << e.what() << std::endl;
+
+        // Don't leave a partial archive behind
+        if( archive )
+        {
+            archive.reset();
+            wxRemoveFile( aFileName );
+        }
+
         return false;
     }
 }
@@ -170,6 +197,16 @@ void PCB_IO_ODBPP::SaveBoard( const wxString& aFileName, BOARD* aBoard,
     if( auto it = aProperties->find( "sigfig" ); it != aProperties->end() )
         m_sigfig = std::stoi( it->second );
 
+    m_archiveFormat.reset();
+
+    if( auto it = aProperties->find( "compress" ); it != aProperties->end() )
+    {
+        if( it->second == "zip" )
+            m_archiveFormat = ODB_ARCHIVE_WRITER::FORMAT::ZIP;
+        else if( it->second == "tgz" )
+            m_archiveFormat = ODB_ARCHIVE_WRITER::FORMAT::TGZ;
+    }
+
     ExportODB( aFileName );
 
 }
@@ -32,6 +32,7 @@
 #include <geometry/shape_segment.h>
 #include <stroke_params.h>
 #include <memory>
+#include <optional>
 #include "odb_entity.h"
 
 class BOARD;
@@ -163,6 +164,9 @@ private:
 
     BOARD* m_board;
 
+    /// Set to write the output into an archive of this format rather than a directory
+    std::optional<ODB_ARCHIVE_WRITER::FORMAT> m_archiveFormat;
+
     std::vector<std::shared_ptr<FOOTPRINT>> m_loaded_footprints;
 
     std::vector<std::pair<PCB_LAYER_ID, wxString>>
@@ -65,17 +65,11 @@ public:
         const wxString& layerName = b->AsString();
         BOARD*          board = static_cast<PCBEXPR_CONTEXT*>( aCtx )->GetBoard();
 
-        {
-            std::shared_lock<std::shared_mutex> readLock( board->m_CachesMutex );
-
-            auto i = board->m_LayerExpressionCache.find( layerName );
-
-            if( i != board->m_LayerExpressionCache.end() )
-                return i->second.Contains( m_layer );
-        }
-
         LSET mask;
 
+        if( board->m_LayerExpressionCache.Get( layerName, mask ) )
+            return mask.Contains( m_layer );
+
         for( unsigned ii = 0; ii < layerMap.GetCount(); ++ii )
         {
             wxPGChoiceEntry& entry = layerMap[ii];
@@ -84,10 +78,7 @@ public:
                 mask.set( ToLAYER_ID( entry.GetValue() ) );
         }
 
-        {
-            std::unique_lock<std::shared_mutex> writeLock( board->m_CachesMutex );
-            board->m_LayerExpressionCache[ layerName ] = mask;
-        }
+        board->m_LayerExpressionCache.Set( layerName, mask );
 
         return mask.Contains( m_layer );
     }
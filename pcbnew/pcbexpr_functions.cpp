@@ -139,17 +139,11 @@ static void existsOnLayerFunc( LIBEVAL::CONTEXT* aCtx, void *self )
 
                     BOARD* board = item->GetBoard();
 
-                    {
-                        std::shared_lock<std::shared_mutex> readLock( board->m_CachesMutex );
-
-                        auto i = board->m_LayerExpressionCache.find( layerName );
-
-                        if( i != board->m_LayerExpressionCache.end() )
-                            return ( item->GetLayerSet() & i->second ).any() ? 1.0 : 0.0;
-                    }
-
                     LSET mask;
 
+                    if( board->m_LayerExpressionCache.Get( layerName, mask ) )
+                        return ( item->GetLayerSet() & mask ).any() ? 1.0 : 0.0;
+
                     for( unsigned ii = 0; ii < layerMap.GetCount(); ++ii )
                     {
                         wxPGChoiceEntry& entry = layerMap[ ii ];
@@ -158,10 +152,7 @@ static void existsOnLayerFunc( LIBEVAL::CONTEXT* aCtx, void *self )
                             mask.set( ToLAYER_ID( entry.GetValue() ) );
                     }
 
-                    {
-                        std::unique_lock<std::shared_mutex> writeLock( board->m_CachesMutex );
-                        board->m_LayerExpressionCache[ layerName ] = mask;
-                    }
+                    board->m_LayerExpressionCache.Set( layerName, mask );
 
                     return ( item->GetLayerSet() & mask ).any() ? 1.0 : 0.0;
                 }
@@ -308,22 +299,22 @@ static void intersectsCourtyardFunc( LIBEVAL::CONTEXT* aCtx, void* self )
 
                             if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
                             {
-                                std::shared_lock<std::shared_mutex> readLock( board->m_CachesMutex );
-
-                                auto i = board->m_IntersectsCourtyardCache.find( key );
+                                bool cached = false;
 
-                                if( i != board->m_IntersectsCourtyardCache.end() )
-                                    return i->second;
+                                if( board->m_IntersectsCourtyardCache.Get( key, cached ) )
+                                {
+                                    board->m_IntersectsCourtyardCacheStats.Hit();
+                                    return cached;
+                                }
                             }
 
+                            board->m_IntersectsCourtyardCacheStats.Miss();
+
                             bool res = collidesWithCourtyard( item, itemShape, context, fp, F_Cu )
                                     || collidesWithCourtyard( item, itemShape, context, fp, B_Cu );
 
                             if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
-                            {
-                                std::unique_lock<std::shared_mutex> cacheLock( board->m_CachesMutex );
-                                board->m_IntersectsCourtyardCache[ key ] = res;
-                            }
+                                board->m_IntersectsCourtyardCache.Set( key, res );
 
                             return res;
                         } ) )
@@ -372,21 +363,21 @@ static void intersectsFrontCourtyardFunc( LIBEVAL::CONTEXT* aCtx, void* self )
 
                             if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
                             {
-                                std::shared_lock<std::shared_mutex> readLock( board->m_CachesMutex );
+                                bool cached = false;
 
-                                auto i = board->m_IntersectsFCourtyardCache.find( key );
-
-                                if( i != board->m_IntersectsFCourtyardCache.end() )
-                                    return i->second;
+                                if( board->m_IntersectsFCourtyardCache.Get( key, cached ) )
+                                {
+                                    board->m_IntersectsCourtyardCacheStats.Hit();
+                                    return cached;
+                                }
                             }
 
+                            board->m_IntersectsCourtyardCacheStats.Miss();
+
                             bool res = collidesWithCourtyard( item, itemShape, context, fp, F_Cu );
 
                             if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
-                            {
-                                std::unique_lock<std::shared_mutex> writeLock( board->m_CachesMutex );
-                                board->m_IntersectsFCourtyardCache[ key ] = res;
-                            }
+                                board->m_IntersectsFCourtyardCache.Set( key, res );
 
                             return res;
                         } ) )
@@ -435,21 +426,21 @@ static void intersectsBackCourtyardFunc( LIBEVAL::CONTEXT* aCtx, void* self )
 
                             if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
                             {
-                                std::shared_lock<std::shared_mutex> readLock( board->m_CachesMutex );
-
-                                auto i = board->m_IntersectsBCourtyardCache.find( key );
+                                bool cached = false;
 
-                                if( i != board->m_IntersectsBCourtyardCache.end() )
-                                    return i->second;
+                                if( board->m_IntersectsBCourtyardCache.Get( key, cached ) )
+                                {
+                                    board->m_IntersectsCourtyardCacheStats.Hit();
+                                    return cached;
+                                }
                             }
 
+                            board->m_IntersectsCourtyardCacheStats.Miss();
+
                             bool res = collidesWithCourtyard( item, itemShape, context, fp, B_Cu );
 
                             if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
-                            {
-                                std::unique_lock<std::shared_mutex> writeLock( board->m_CachesMutex );
-                                board->m_IntersectsBCourtyardCache[ key ] = res;
-                            }
+                                board->m_IntersectsBCourtyardCache.Set( key, res );
 
                             return res;
                         } ) )
@@ -748,21 +739,21 @@ static void intersectsAreaFunc( LIBEVAL::CONTEXT* aCtx, void* self )
 
                                 if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
                                 {
-                                    std::shared_lock<std::shared_mutex> readLock( board->m_CachesMutex );
-
-                                    auto i = board->m_IntersectsAreaCache.find( key );
+                                    bool cached = false;
 
-                                    if( i != board->m_IntersectsAreaCache.end() && i->second )
+                                    if( board->m_IntersectsAreaCache.Get( key, cached ) && cached )
+                                    {
+                                        board->m_IntersectsAreaCacheStats.Hit();
                                         return true;
+                                    }
                                 }
 
+                                board->m_IntersectsAreaCacheStats.Miss();
+
                                 bool collides = collidesWithArea( item, context, aArea );
 
                                 if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
-                                {
-                                    std::unique_lock<std::shared_mutex> writeLock( board->m_CachesMutex );
-                                    board->m_IntersectsAreaCache[ key ] = collides;
-                                }
+                                    board->m_IntersectsAreaCache.Set( key, collides );
 
                                 if( collides )
                                     return true;
@@ -829,14 +820,17 @@ static void enclosedByAreaFunc( LIBEVAL::CONTEXT* aCtx, void* self )
 
                             if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
                             {
-                                std::shared_lock<std::shared_mutex> readLock( board->m_CachesMutex );
+                                bool cached = false;
 
-                                auto i = board->m_EnclosedByAreaCache.find( key );
-
-                                if( i != board->m_EnclosedByAreaCache.end() )
-                                    return i->second;
+                                if( board->m_EnclosedByAreaCache.Get( key, cached ) )
+                                {
+                                    board->m_EnclosedByAreaCacheStats.Hit();
+                                    return cached;
+                                }
                             }
 
+                            board->m_EnclosedByAreaCacheStats.Miss();
+
                             SHAPE_POLY_SET itemShape;
                             bool           enclosedByArea;
 
@@ -875,10 +869,7 @@ static void enclosedByAreaFunc( LIBEVAL::CONTEXT* aCtx, void* self )
                             }
 
                             if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
-                            {
-                                std::unique_lock<std::shared_mutex> writeLock( board->m_CachesMutex );
-                                board->m_EnclosedByAreaCache[ key ] = enclosedByArea;
-                            }
+                                board->m_EnclosedByAreaCache.Set( key, enclosedByArea );
 
                             return enclosedByArea;
                         } ) )
@@ -26,10 +26,12 @@
 #include <pcbnew_scripting_helpers.h>
 #include <pgm_base.h>
 #include <cli_progress_reporter.h>
+#include <cli/exit_codes.h>
 #include <confirm.h>
 #include <kiface_base.h>
 #include <kiface_ids.h>
 #include <pcb_edit_frame.h>
+#include <drawing_sheet/ds_data_model.h>
 #include <eda_dde.h>
 #include <macros.h>
 #include <wx/snglinst.h>
@@ -646,7 +648,28 @@ void IFACE::SaveFileAs( const wxString& aProjectBasePath, const wxString& aSrcPr
 
 int IFACE::HandleJob( JOB* aJob, REPORTER* aReporter )
 {
-    return m_jobHandler->RunJob( aJob, aReporter );
+    // Each job loads the drawing sheet it plots into its own, so that jobs run at the same time
+    // don't change each other's
+    DS_DATA_MODEL  drawingSheet;
+    DS_DATA_MODEL* existingDrawingSheet = DS_DATA_MODEL::GetThreadInstance();
+
+    DS_DATA_MODEL::SetThreadInstance( &drawingSheet );
+
+    int result = CLI::EXIT_CODES::ERR_UNKNOWN;
+
+    try
+    {
+        result = m_jobHandler->RunJob( aJob, aReporter );
+    }
+    catch( ... )
+    {
+        DS_DATA_MODEL::SetThreadInstance( existingDrawingSheet );
+        throw;
+    }
+
+    DS_DATA_MODEL::SetThreadInstance( existingDrawingSheet );
+
+    return result;
 }
 
 
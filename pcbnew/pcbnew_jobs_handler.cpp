@@ -18,6 +18,7 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <mutex>
 #include <wx/dir.h>
 #include "pcbnew_jobs_handler.h"
 #include <board_commit.h>
@@ -68,6 +69,8 @@
 #include <netlist_reader/netlist_reader.h>
 #include <pcbnew_settings.h>
 #include <pcbplot.h>
+#include <advanced_config.h>
+#include <thread_pool.h>
 #include <pcb_plotter.h>
 #include <pgm_base.h>
 #include <3d_rendering/raytracing/render_3d_raytrace_ram.h>
@@ -90,6 +93,8 @@
 #include <dialogs/dialog_render_job.h>
 #include <dialogs/dialog_gencad_export_options.h>
 #include <paths.h>
+#include <zone_filler.h>
+#include <zone_fill_cache.h>
 
 #include "pcbnew_scripting_helpers.h"
 #include <locale_io.h>
@@ -104,7 +109,9 @@
 
 PCBNEW_JOBS_HANDLER::PCBNEW_JOBS_HANDLER( KIWAY* aKiway ) :
         JOB_DISPATCHER( aKiway ),
-        m_cliBoard( nullptr )
+        m_cliBoard( nullptr ),
+        m_plotCachesBoard( nullptr ),
+        m_plotCachesTimeStamp( 0 )
 {
     Register( "3d", std::bind( &PCBNEW_JOBS_HANDLER::JobExportStep, this, std::placeholders::_1 ),
               [aKiway]( JOB* job, wxWindow* aParent ) -> bool
@@ -306,6 +313,8 @@ BOARD* PCBNEW_JOBS_HANDLER::getBoard( const wxString& aPath )
             pcbPath = path.GetFullPath();
         }
 
+        std::lock_guard<std::mutex> lock( m_boardMutex );
+
         if( !m_cliBoard )
             m_cliBoard = LoadBoard( pcbPath, true );
 
@@ -330,6 +339,49 @@ BOARD* PCBNEW_JOBS_HANDLER::getBoard( const wxString& aPath )
 }
 
 
+void PCBNEW_JOBS_HANDLER::refillZones( BOARD* aBoard )
+{
+    static std::once_flag pruned;
+
+    // Fills of boards which no job has refilled for a month are unlikely to be wanted again
+    std::call_once( pruned,
+                    []()
+                    {
+                        ZONE_FILL_CACHE::Prune( 30 );
+                    } );
+
+    ZONE_FILL_CACHE    cache( aBoard );
+    ZONE_FILLER        filler( aBoard, nullptr );
+    std::vector<ZONE*> toFill( aBoard->Zones().begin(), aBoard->Zones().end() );
+
+    aBoard->IncrementTimeStamp();    // Clear caches
+
+    filler.SetFillCache( &cache );
+    filler.Fill( toFill );
+
+    aBoard->BuildConnectivity();
+}
+
+
+void PCBNEW_JOBS_HANDLER::buildPlotCaches( BOARD* aBoard )
+{
+    std::lock_guard<std::mutex> lock( m_boardMutex );
+
+    // Text is cached as shown, so changed text variables need the caches built again
+    if( aBoard == m_plotCachesBoard && aBoard->GetTimeStamp() == m_plotCachesTimeStamp
+            && aBoard->GetProperties() == m_plotCachesProperties )
+    {
+        return;
+    }
+
+    BuildPlotCaches( aBoard );
+
+    m_plotCachesBoard = aBoard;
+    m_plotCachesTimeStamp = aBoard->GetTimeStamp();
+    m_plotCachesProperties = aBoard->GetProperties();
+}
+
+
 LSEQ PCBNEW_JOBS_HANDLER::convertLayerArg( wxString& aLayerString, BOARD* aBoard ) const
 {
     std::map<wxString, LSET> layerMasks;
@@ -414,6 +466,7 @@ int PCBNEW_JOBS_HANDLER::JobExportStep( JOB* aJob )
     aJob->SetTitleBlock( brd->GetTitleBlock() );
     brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
     brd->SynchronizeProperties();
+    buildPlotCaches( brd );
 
     if( aStepJob->GetConfiguredOutputPath().IsEmpty() )
     {
@@ -819,7 +872,7 @@ int PCBNEW_JOBS_HANDLER::JobExportSvg( JOB* aJob )
         return CLI::EXIT_CODES::ERR_INVALID_OUTPUT_CONFLICT;
     }
 
-    loadOverrideDrawingSheet( brd, aSvgJob->m_drawingSheet );
+    loadDrawingSheet( brd, aSvgJob->m_drawingSheet );
     brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
     brd->SynchronizeProperties();
     aSvgJob->m_plotLayerSequence = convertLayerArg( aSvgJob->m_argLayers, brd );
@@ -876,7 +929,7 @@ int PCBNEW_JOBS_HANDLER::JobExportDxf( JOB* aJob )
         return CLI::EXIT_CODES::ERR_INVALID_INPUT_FILE;
 
     aJob->SetTitleBlock( brd->GetTitleBlock() );
-    loadOverrideDrawingSheet( brd, aDxfJob->m_drawingSheet );
+    loadDrawingSheet( brd, aDxfJob->m_drawingSheet );
     brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
     brd->SynchronizeProperties();
     aDxfJob->m_plotLayerSequence = convertLayerArg( aDxfJob->m_argLayers, brd );
@@ -954,9 +1007,10 @@ int PCBNEW_JOBS_HANDLER::JobExportPdf( JOB* aJob )
         return CLI::EXIT_CODES::ERR_INVALID_INPUT_FILE;
 
     pdfJob->SetTitleBlock( brd->GetTitleBlock() );
-    loadOverrideDrawingSheet( brd, pdfJob->m_drawingSheet );
+    loadDrawingSheet( brd, pdfJob->m_drawingSheet );
     brd->GetProject()->ApplyTextVars( pdfJob->GetVarOverrides() );
     brd->SynchronizeProperties();
+    buildPlotCaches( brd );
     pdfJob->m_plotLayerSequence = convertLayerArg( pdfJob->m_argLayers, brd );
     pdfJob->m_plotOnAllLayersSequence = convertLayerArg( pdfJob->m_argCommonLayers, brd );
 
@@ -1047,10 +1101,18 @@ int PCBNEW_JOBS_HANDLER::JobExportGerbers( JOB* aJob )
     }
 
     aJob->SetTitleBlock( brd->GetTitleBlock() );
-    loadOverrideDrawingSheet( brd, aGerberJob->m_drawingSheet );
+    loadDrawingSheet( brd, aGerberJob->m_drawingSheet );
     brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
     brd->SynchronizeProperties();
 
+    if( aGerberJob->m_refillZones )
+    {
+        m_reporter->Report( _( "Refilling zones...\n" ), RPT_SEVERITY_INFO );
+        refillZones( brd );
+    }
+
+    buildPlotCaches( brd );
+
     if( !aGerberJob->m_argLayers.empty() )
         aGerberJob->m_plotLayerSequence = convertLayerArg( aGerberJob->m_argLayers, nullptr );
     else
@@ -1084,9 +1146,24 @@ int PCBNEW_JOBS_HANDLER::JobExportGerbers( JOB* aJob )
     // Ensure layers to plot are restricted to enabled layers of the board to plot
     LSET layersToPlot = LSET( { aGerberJob->m_plotLayerSequence } ) & brd->GetEnabledLayers();
 
+    // Each layer is plotted by its own plotter into its own file
+    struct LAYER_PLOT
+    {
+        LSEQ            plotSequence;
+        PCB_PLOT_PARAMS plotOpts;
+        GERBER_PLOTTER* plotter = nullptr;
+    };
+
+    std::vector<LAYER_PLOT> layerPlots;
+    layerPlots.reserve( layersToPlot.count() );
+
+    // Held for the whole export so that plotting threads don't switch the locale themselves
+    LOCALE_IO dummy;
+
     for( PCB_LAYER_ID layer : layersToPlot.UIOrder() )
     {
-        LSEQ plotSequence;
+        LAYER_PLOT& layerPlot = layerPlots.emplace_back();
+        LSEQ&       plotSequence = layerPlot.plotSequence;
 
         // Base layer always gets plotted first.
         plotSequence.push_back( layer );
@@ -1102,11 +1179,11 @@ int PCBNEW_JOBS_HANDLER::JobExportGerbers( JOB* aJob )
         }
 
         // Pick the basename from the board file
-        wxFileName      fn( brd->GetFileName() );
-        wxString        layerName = brd->GetLayerName( layer );
-        wxString        sheetName;
-        wxString        sheetPath;
-        PCB_PLOT_PARAMS plotOpts;
+        wxFileName       fn( brd->GetFileName() );
+        wxString         layerName = brd->GetLayerName( layer );
+        wxString         sheetName;
+        wxString         sheetPath;
+        PCB_PLOT_PARAMS& plotOpts = layerPlot.plotOpts;
 
         if( aGerberJob->m_useBoardPlotParams )
             plotOpts = boardPlotOptions;
@@ -1132,21 +1209,16 @@ int PCBNEW_JOBS_HANDLER::JobExportGerbers( JOB* aJob )
         if( aJob->GetVarOverrides().contains( wxT( "SHEETPATH" ) ) )
             sheetPath = aJob->GetVarOverrides().at( wxT( "SHEETPATH" ) );
 
-        // We are feeding it one layer at the start here to silence a logic check
-        GERBER_PLOTTER* plotter;
-        {
-            LOCALE_IO dummy;
-            plotter = (GERBER_PLOTTER*) StartPlotBoard( brd, &plotOpts, layer, layerName,
-                                                        fn.GetFullPath(), sheetName, sheetPath );
-        }
+        // We are feeding it one layer at the start here to silence a logic check.  Starting the
+        // plot also draws the drawing sheet, which isn't thread safe, so it is always done here.
+        layerPlot.plotter = (GERBER_PLOTTER*) StartPlotBoard( brd, &plotOpts, layer, layerName,
+                                                              fn.GetFullPath(), sheetName,
+                                                              sheetPath );
 
-        if( plotter )
+        if( layerPlot.plotter )
         {
             m_reporter->Report( wxString::Format( _( "Plotted to '%s'.\n" ), fn.GetFullPath() ),
                                 RPT_SEVERITY_ACTION );
-            LOCALE_IO dummy;
-            PlotBoardLayers( brd, plotter, plotSequence, plotOpts );
-            plotter->EndPlot();
         }
         else
         {
@@ -1155,18 +1227,67 @@ int PCBNEW_JOBS_HANDLER::JobExportGerbers( JOB* aJob )
                                 RPT_SEVERITY_ERROR );
             exitCode = CLI::EXIT_CODES::ERR_INVALID_OUTPUT_CONFLICT;
         }
-
-        delete plotter;
     }
 
-    if( aGerberJob->m_createJobsFile )
+    auto plotLayer =
+            [brd]( LAYER_PLOT& aLayerPlot )
+            {
+                if( !aLayerPlot.plotter )
+                    return;
+
+                PlotBoardLayers( brd, aLayerPlot.plotter, aLayerPlot.plotSequence,
+                                 aLayerPlot.plotOpts );
+                aLayerPlot.plotter->EndPlot();
+            };
+
+    auto createJobFile =
+            [&]()
+            {
+                wxFileName fn( brd->GetFileName() );
+
+                // Build gerber job file from basename
+                BuildPlotFileName( &fn, outPath, wxT( "job" ), FILEEXT::GerberJobFileExtension );
+                jobfile_writer.CreateJobFile( fn.GetFullPath() );
+            };
+
+    thread_pool& tp = GetKiCadThreadPool();
+
+    if( ADVANCED_CFG::GetCfg().m_ParallelGerberPlot && tp.get_thread_count() > 1
+            && layerPlots.size() > 1 )
     {
-        wxFileName fn( brd->GetFileName() );
+        std::vector<std::future<void>> tasks;
+
+        for( LAYER_PLOT& layerPlot : layerPlots )
+        {
+            tasks.push_back( tp.submit(
+                    [&plotLayer, &layerPlot]()
+                    {
+                        plotLayer( layerPlot );
+                    } ) );
+        }
 
-        // Build gerber job file from basename
-        BuildPlotFileName( &fn, outPath, wxT( "job" ), FILEEXT::GerberJobFileExtension );
-        jobfile_writer.CreateJobFile( fn.GetFullPath() );
+        // The job file only needs the list of files, so it can be written alongside
+        if( aGerberJob->m_createJobsFile )
+            tasks.push_back( tp.submit( createJobFile ) );
+
+        // Every task must be finished before the plotters are deleted, even if one throws
+        for( std::future<void>& task : tasks )
+            task.wait();
+
+        for( std::future<void>& task : tasks )
+            task.get();
     }
+    else
+    {
+        for( LAYER_PLOT& layerPlot : layerPlots )
+            plotLayer( layerPlot );
+
+        if( aGerberJob->m_createJobsFile )
+            createJobFile();
+    }
+
+    for( LAYER_PLOT& layerPlot : layerPlots )
+        delete layerPlot.plotter;
 
     return exitCode;
 }
@@ -1273,6 +1394,7 @@ int PCBNEW_JOBS_HANDLER::JobExportGerber( JOB* aJob )
         return CLI::EXIT_CODES::ERR_INVALID_INPUT_FILE;
 
     aJob->SetTitleBlock( brd->GetTitleBlock() );
+    loadDrawingSheet( brd, aGerberJob->m_drawingSheet );
     brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
     brd->SynchronizeProperties();
     aGerberJob->m_plotLayerSequence = convertLayerArg( aGerberJob->m_argLayers, brd );
@@ -1360,6 +1482,7 @@ int PCBNEW_JOBS_HANDLER::JobExportDrill( JOB* aJob )
         return CLI::EXIT_CODES::ERR_INVALID_INPUT_FILE;
 
     aJob->SetTitleBlock( brd->GetTitleBlock() );
+    buildPlotCaches( brd );
 
     wxString outPath = aDrillJob->GetFullOutputPath( brd->GetProject() );
 
@@ -1479,6 +1602,7 @@ int PCBNEW_JOBS_HANDLER::JobExportPos( JOB* aJob )
         return CLI::EXIT_CODES::ERR_INVALID_INPUT_FILE;
 
     aJob->SetTitleBlock( brd->GetTitleBlock() );
+    buildPlotCaches( brd );
 
     if( aPosJob->GetConfiguredOutputPath().IsEmpty() )
     {
@@ -1897,6 +2021,7 @@ int PCBNEW_JOBS_HANDLER::JobExportDrc( JOB* aJob )
         return CLI::EXIT_CODES::ERR_INVALID_INPUT_FILE;
 
     aJob->SetTitleBlock( brd->GetTitleBlock() );
+    loadDrawingSheet( brd, wxEmptyString );
     brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
     brd->SynchronizeProperties();
 
@@ -1936,6 +2061,12 @@ int PCBNEW_JOBS_HANDLER::JobExportDrc( JOB* aJob )
 
     drcEngine->SetDrawingSheet( getDrawingSheetProxyView( brd ) );
 
+    if( drcJob->m_refillZones )
+    {
+        m_reporter->Report( _( "Refilling zones...\n" ), RPT_SEVERITY_INFO );
+        refillZones( brd );
+    }
+
     // BOARD_COMMIT uses TOOL_MANAGER to grab the board internally so we must give it one
     TOOL_MANAGER* toolManager = new TOOL_MANAGER;
     toolManager->SetEnvironment( brd, nullptr, nullptr, Kiface().KifaceSettings(), nullptr );
@@ -2019,9 +2150,27 @@ int PCBNEW_JOBS_HANDLER::JobExportDrc( JOB* aJob )
 
     brd->RecordDRCExclusions();
     brd->DeleteMARKERs( true, true );
+    drcEngine->SetProfiling( drcJob->m_profile );
     drcEngine->RunTests( units, drcJob->m_reportAllTrackErrors, checkParity );
+    drcEngine->SetProfiling( false );
     drcEngine->ClearViolationHandler();
 
+    if( drcJob->m_profile )
+    {
+        const DRC_PROFILE& profile = drcEngine->GetProfile();
+
+        m_reporter->Report( wxString::Format( _( "DRC took %0.1f ms (%0.1f ms building caches)\n" ),
+                                              profile.m_TotalMs, profile.m_CacheGenerationMs ),
+                            RPT_SEVERITY_INFO );
+
+        for( const DRC_PROVIDER_PROFILE& provider : profile.m_Providers )
+        {
+            m_reporter->Report( wxString::Format( wxS( "  %-32s %10.1f ms\n" ),
+                                                  provider.m_Name, provider.m_WallMs ),
+                                RPT_SEVERITY_INFO );
+        }
+    }
+
     commit.Push( _( "DRC" ), SKIP_UNDO | SKIP_SET_DIRTY );
 
     // Update the exclusion status on any excluded markers that still exist.
@@ -2056,6 +2205,9 @@ int PCBNEW_JOBS_HANDLER::JobExportDrc( JOB* aJob )
 
     DRC_REPORT reportWriter( brd, units, markersProvider, ratsnestProvider, fpWarningsProvider );
 
+    if( drcJob->m_profile )
+        reportWriter.SetProfile( &drcEngine->GetProfile() );
+
     bool wroteReport = false;
 
     if( drcJob->m_format == JOB_PCB_DRC::OUTPUT_FORMAT::JSON )
@@ -2272,6 +2424,12 @@ int PCBNEW_JOBS_HANDLER::JobExportOdb( JOB* aJob )
         }
     }
 
+    if( job->m_refillZones )
+    {
+        m_reporter->Report( _( "Refilling zones...\n" ), RPT_SEVERITY_INFO );
+        refillZones( brd );
+    }
+
     DIALOG_EXPORT_ODBPP::GenerateODBPPFiles( *job, brd, nullptr, m_progressReporter, m_reporter );
 
     return CLI::EXIT_CODES::SUCCESS;
@@ -2296,21 +2454,16 @@ DS_PROXY_VIEW_ITEM* PCBNEW_JOBS_HANDLER::getDrawingSheetProxyView( BOARD* aBrd )
 }
 
 
-void PCBNEW_JOBS_HANDLER::loadOverrideDrawingSheet( BOARD* aBrd, const wxString& aSheetPath )
+void PCBNEW_JOBS_HANDLER::loadDrawingSheet( BOARD* aBrd, const wxString& aSheetPath )
 {
-    // dont bother attempting to load a empty path, if there was one
-    if( aSheetPath.IsEmpty() )
-        return;
-
     auto loadSheet =
             [&]( const wxString& path ) -> bool
             {
-                BASE_SCREEN::m_DrawingSheetFileName = path;
                 FILENAME_RESOLVER resolver;
                 resolver.SetProject( aBrd->GetProject() );
                 resolver.SetProgramBase( &Pgm() );
 
-                wxString filename = resolver.ResolvePath( BASE_SCREEN::m_DrawingSheetFileName,
+                wxString filename = resolver.ResolvePath( path,
                                                           aBrd->GetProject()->GetProjectPath(),
                                                           aBrd->GetEmbeddedFiles() );
                 wxString msg;
@@ -2327,9 +2480,10 @@ void PCBNEW_JOBS_HANDLER::loadOverrideDrawingSheet( BOARD* aBrd, const wxString&
                 return true;
             };
 
-    if( loadSheet( aSheetPath ) )
+    // dont bother attempting to load a empty path, if there was one
+    if( !aSheetPath.IsEmpty() && loadSheet( aSheetPath ) )
         return;
 
-    // failed loading custom path, revert back to default
+    // no custom path, or failed loading it, so use the project's drawing sheet
     loadSheet( aBrd->GetProject()->GetProjectFile().m_BoardDrawingSheetFile );
 }
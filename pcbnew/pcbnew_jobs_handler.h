@@ -21,6 +21,9 @@
 #ifndef PCBNEW_JOBS_HANDLER_H
 #define PCBNEW_JOBS_HANDLER_H
 
+#include <map>
+#include <mutex>
+
 #include <jobs/job_dispatcher.h>
 #include <pcb_plot_params.h>
 
@@ -55,6 +58,19 @@ public:
 
 private:
     BOARD* getBoard( const wxString& aPath = wxEmptyString );
+
+    /**
+     * Refill all zones on \a aBoard, reusing fills from the on-disk zone fill cache for zones
+     * whose inputs are unchanged since they were last filled.
+     */
+    void refillZones( BOARD* aBoard );
+
+    /**
+     * Build the geometry of \a aBoard which is cached on first use, unless it was already built
+     * for the board as it is now.  Jobs which only read the board call this before reading it,
+     * so that several of them can read the same board at once.
+     */
+    void buildPlotCaches( BOARD* aBoard );
     LSEQ convertLayerArg( wxString& aLayerString, BOARD* aBoard ) const;
 
     void populateGerberPlotOptionsFromJob( PCB_PLOT_PARAMS&  aPlotOpts,
@@ -62,11 +78,24 @@ private:
     void populateGerberPlotOptionsFromJob( PCB_PLOT_PARAMS& aPlotOpts,
                                            JOB_EXPORT_PCB_GERBERS* aJob );
     int  doFpExportSvg( JOB_FP_EXPORT_SVG* aSvgJob, const FOOTPRINT* aFootprint );
-    void loadOverrideDrawingSheet( BOARD* brd, const wxString& aSheetPath );
+
+    /**
+     * Load the drawing sheet of a job which plots it: \a aSheetPath if given and found,
+     * otherwise the drawing sheet of the board's project.
+     *
+     * The drawing sheet is loaded into the one the job's thread draws, so that jobs run at the
+     * same time don't change each other's drawing sheet.
+     */
+    void loadDrawingSheet( BOARD* brd, const wxString& aSheetPath );
 
     DS_PROXY_VIEW_ITEM* getDrawingSheetProxyView( BOARD* aBrd );
 
     BOARD* m_cliBoard;
+
+    std::mutex                   m_boardMutex;         // guards loading and caching m_cliBoard
+    BOARD*                       m_plotCachesBoard;
+    int                          m_plotCachesTimeStamp;
+    std::map<wxString, wxString> m_plotCachesProperties;
 };
 
 #endif
@@ -177,6 +177,15 @@ void setupPlotterNewPDFPage( PLOTTER* aPlotter, BOARD* aBoard, const PCB_PLOT_PA
 void PlotBoardLayers( BOARD* aBoard, PLOTTER* aPlotter, const LSEQ& aLayerSequence,
                       const PCB_PLOT_PARAMS& aPlotOptions );
 
+/**
+ * Build the lazily cached geometry (pad shapes, text glyphs and bounding boxes) that plotting
+ * reads.
+ *
+ * Plotting doesn't otherwise modify the board, so once this has been called several layers can
+ * be plotted at the same time, each with its own plotter.
+ */
+void BuildPlotCaches( BOARD* aBoard );
+
 /**
  * Plot interactive items (hypertext links, properties, etc.).
  */
@@ -43,6 +43,7 @@
 #include <plotters/plotter_gerber.h>
 #include <plotters/plotters_pslike.h>
 #include <pcb_painter.h>
+#include <font/font.h>
 #include <gbr_metadata.h>
 #include <advanced_config.h>
 
@@ -151,6 +152,41 @@ void PlotBoardLayers( BOARD* aBoard, PLOTTER* aPlotter, const LSEQ& aLayers,
 }
 
 
+void BuildPlotCaches( BOARD* aBoard )
+{
+    auto cacheItem =
+            []( BOARD_ITEM* aItem )
+            {
+                // Pad shapes and text bounding boxes are built on first use
+                aItem->GetBoundingBox();
+
+                EDA_TEXT* text = dynamic_cast<EDA_TEXT*>( aItem );
+
+                if( !text )
+                    return;
+
+                if( KIFONT::FONT* font = text->GetFont(); font && font->IsOutline() )
+                    text->GetRenderCache( font, text->GetShownText( true ) );
+            };
+
+    for( BOARD_ITEM* item : aBoard->Drawings() )
+    {
+        cacheItem( item );
+        item->RunOnDescendants( cacheItem );
+    }
+
+    for( FOOTPRINT* footprint : aBoard->Footprints() )
+    {
+        footprint->GetBoundingBox( true );
+        footprint->GetBoundingBox( false );
+        footprint->RunOnDescendants( cacheItem );
+    }
+
+    for( ZONE* zone : aBoard->Zones() )
+        zone->CacheBoundingBox();
+}
+
+
 void PlotInteractiveLayer( BOARD* aBoard, PLOTTER* aPlotter, const PCB_PLOT_PARAMS& aPlotOpt )
 {
     for( const FOOTPRINT* fp : aBoard->Footprints() )
@@ -443,13 +479,35 @@ void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
                     VECTOR2I padPlotsSize =
                             pad->GetSize( aLayer ) + margin * 2 + VECTOR2I( width_adj, width_adj );
 
-                    // Store these parameters that can be modified to plot inflated/deflated pads shape
                     PAD_SHAPE padShape = pad->GetShape( aLayer );
                     VECTOR2I  padSize = pad->GetSize( aLayer );
                     VECTOR2I  padDelta = pad->GetDelta( aLayer ); // has meaning only for trapezoidal pads
-                    // CornerRadius and CornerRadiusRatio can be modified
-                    // the radius is built from the ratio, so saving/restoring the ratio is enough
-                    double    padCornerRadiusRatio = pad->GetRoundRectRadiusRatio( aLayer );
+
+                    // Inflated/deflated pads are plotted from a copy, so that plotting never
+                    // modifies the board and several layers can be plotted at the same time
+                    std::unique_ptr<PAD> padCopy;
+                    PAD*                 plotPad = pad;
+
+                    auto copyPad =
+                            [&]()
+                            {
+                                if( !padCopy )
+                                {
+                                    padCopy = std::make_unique<PAD>( *pad );
+                                    padCopy->SetParentGroup( nullptr );
+                                    plotPad = padCopy.get();
+                                }
+                            };
+
+                    auto resizePad =
+                            [&]( const VECTOR2I& aSize )
+                            {
+                                if( aSize != padSize )
+                                {
+                                    copyPad();
+                                    plotPad->SetSize( aLayer, aSize );
+                                }
+                            };
 
                     // Don't draw a 0 sized pad.
                     // Note: a custom pad can have its pad anchor with size = 0
@@ -463,29 +521,30 @@ void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
                     {
                     case PAD_SHAPE::CIRCLE:
                     case PAD_SHAPE::OVAL:
-                        pad->SetSize( aLayer, padPlotsSize );
+                        resizePad( padPlotsSize );
 
                         if( aPlotOpt.GetSkipPlotNPTH_Pads() &&
                             ( aPlotOpt.GetDrillMarksType() == DRILL_MARKS::NO_DRILL_SHAPE ) &&
-                            ( pad->GetSize(aLayer ) == pad->GetDrillSize() ) &&
-                            ( pad->GetAttribute() == PAD_ATTRIB::NPTH ) )
+                            ( plotPad->GetSize( aLayer ) == plotPad->GetDrillSize() ) &&
+                            ( plotPad->GetAttribute() == PAD_ATTRIB::NPTH ) )
                         {
                             break;
                         }
 
-                        itemplotter.PlotPad( pad, aLayer, color, padPlotMode );
+                        itemplotter.PlotPad( plotPad, aLayer, color, padPlotMode );
                         break;
 
                     case PAD_SHAPE::RECTANGLE:
-                        pad->SetSize( aLayer, padPlotsSize );
+                        resizePad( padPlotsSize );
 
                         if( mask_clearance > 0 )
                         {
-                            pad->SetShape( aLayer, PAD_SHAPE::ROUNDRECT );
-                            pad->SetRoundRectCornerRadius( aLayer, mask_clearance );
+                            copyPad();
+                            plotPad->SetShape( aLayer, PAD_SHAPE::ROUNDRECT );
+                            plotPad->SetRoundRectCornerRadius( aLayer, mask_clearance );
                         }
 
-                        itemplotter.PlotPad( pad, aLayer, color, padPlotMode );
+                        itemplotter.PlotPad( plotPad, aLayer, color, padPlotMode );
                         break;
 
                     case PAD_SHAPE::TRAPEZOID:
@@ -538,10 +597,12 @@ void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
                         // to force recalculation of other values after size changing (we do not
                         // really change the rounding percent value)
                         double radius_ratio = pad->GetRoundRectRadiusRatio( aLayer );
-                        pad->SetSize( aLayer, padPlotsSize );
-                        pad->SetRoundRectRadiusRatio( aLayer, radius_ratio );
+                        resizePad( padPlotsSize );
+
+                        if( padCopy )
+                            plotPad->SetRoundRectRadiusRatio( aLayer, radius_ratio );
 
-                        itemplotter.PlotPad( pad, aLayer, color, padPlotMode );
+                        itemplotter.PlotPad( plotPad, aLayer, color, padPlotMode );
                         break;
                     }
 
@@ -549,8 +610,8 @@ void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
                         if( mask_clearance == 0 )
                         {
                             // the size can be slightly inflated by width_adj (PS/PDF only)
-                            pad->SetSize( aLayer, padPlotsSize );
-                            itemplotter.PlotPad( pad, aLayer, color, padPlotMode );
+                            resizePad( padPlotsSize );
+                            itemplotter.PlotPad( plotPad, aLayer, color, padPlotMode );
                         }
                         else
                         {
@@ -618,12 +679,6 @@ void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
                         break;
                     }
                     }
-
-                    // Restore the pad parameters modified by the plot code
-                    pad->SetSize( aLayer, padSize );
-                    pad->SetDelta( aLayer, padDelta );
-                    pad->SetShape( aLayer, padShape );
-                    pad->SetRoundRectRadiusRatio( aLayer, padCornerRadiusRatio );
                 };
 
             for( PCB_LAYER_ID layer : aLayerMask.SeqStackupForPlotting() )
@@ -201,7 +201,7 @@ int ZONE_FILLER_TOOL::ZoneFillDirty( const TOOL_EVENT& aEvent )
 
     for( ZONE* zone : board()->Zones() )
     {
-        if( !zone->IsFilled() || m_dirtyZoneIDs.count( zone->m_Uuid ) )
+        if( !zone->IsFilled() || m_dirtyZoneRegions.count( zone->m_Uuid ) )
             toFill.push_back( zone );
     }
 
@@ -214,8 +214,6 @@ int ZONE_FILLER_TOOL::ZoneFillDirty( const TOOL_EVENT& aEvent )
     int64_t startTime = GetRunningMicroSecs();
     m_fillInProgress = true;
 
-    m_dirtyZoneIDs.clear();
-
     board()->IncrementTimeStamp();    // Clear caches
 
     BOARD_COMMIT                          commit( this );
@@ -223,6 +221,9 @@ int ZONE_FILLER_TOOL::ZoneFillDirty( const TOOL_EVENT& aEvent )
     int                                   pts = 0;
 
     m_filler = std::make_unique<ZONE_FILLER>( board(), &commit );
+    m_filler->SetDirtyRegions( m_dirtyZoneRegions );
+
+    m_dirtyZoneRegions.clear();
 
     if( !board()->GetDesignSettings().m_DRCEngine->RulesValid() )
     {
@@ -62,9 +62,12 @@ public:
 
     PROGRESS_REPORTER* GetProgressReporter();
 
-    void DirtyZone( ZONE* aZone )
+    /**
+     * Mark \a aZone as needing a refill because of a change within \a aDamage.
+     */
+    void DirtyZone( ZONE* aZone, const BOX2I& aDamage )
     {
-        m_dirtyZoneIDs.insert( aZone->m_Uuid );
+        m_dirtyZoneRegions[aZone->m_Uuid].Merge( aDamage );
     }
 
     static bool IsZoneFillAction( const TOOL_EVENT* aEvent );
@@ -83,7 +86,7 @@ private:
     std::unique_ptr<ZONE_FILLER> m_filler;
     bool                         m_fillInProgress;
 
-    std::set<KIID>               m_dirtyZoneIDs;
+    std::map<KIID, BOX2I>        m_dirtyZoneRegions;
 };
 
 #endif
@@ -193,6 +193,8 @@ void ZONE::InitDataFromSrcInCopyCtor( const ZONE& aZone )
                 m_insulatedIslands[layer] = aZone.m_insulatedIslands.at( layer );
             } );
 
+    m_rawFilledPolysList = aZone.m_rawFilledPolysList;
+
     m_layerProperties.clear();
 
     std::ranges::copy( aZone.LayerProperties(),
@@ -642,23 +644,13 @@ const BOX2I ZONE::GetBoundingBox() const
 {
     if( const BOARD* board = GetBoard() )
     {
-        std::unordered_map<const ZONE*, BOX2I>& cache = board->m_ZoneBBoxCache;
-
-        {
-            std::shared_lock<std::shared_mutex> readLock( board->m_CachesMutex );
-
-            auto cacheIter = cache.find( this );
-
-            if( cacheIter != cache.end() )
-                return cacheIter->second;
-        }
+        BOX2I bbox;
 
-        BOX2I bbox = m_Poly->BBox();
+        if( board->m_ZoneBBoxCache.Get( this, bbox ) )
+            return bbox;
 
-        {
-            std::unique_lock<std::shared_mutex> writeLock( board->m_CachesMutex );
-            cache[ this ] = bbox;
-        }
+        bbox = m_Poly->BBox();
+        board->m_ZoneBBoxCache.Set( this, bbox );
 
         return bbox;
     }
@@ -977,10 +969,13 @@ void ZONE::Move( const VECTOR2I& offset )
      */
     if( GetBoard() )
     {
-        auto it = GetBoard()->m_ZoneBBoxCache.find( this );
+        BOX2I bbox;
 
-        if( it != GetBoard()->m_ZoneBBoxCache.end() )
-            it->second.Move( offset );
+        if( GetBoard()->m_ZoneBBoxCache.Get( this, bbox ) )
+        {
+            bbox.Move( offset );
+            GetBoard()->m_ZoneBBoxCache.Set( this, bbox );
+        }
     }
 }
 
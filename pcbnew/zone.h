@@ -669,6 +669,33 @@ public:
         m_FilledPolysList[aLayer] = std::make_shared<SHAPE_POLY_SET>( aPolysList );
     }
 
+    /**
+     * Store the fill of \a aLayer as it was before isolated islands were removed, along with
+     * the hash of the final fill it produced.  Used by incremental refills.
+     */
+    void SetRawFill( PCB_LAYER_ID aLayer, std::shared_ptr<SHAPE_POLY_SET> aRawFill,
+                     const HASH_128& aHash )
+    {
+        m_rawFilledPolysList[aLayer] = { std::move( aRawFill ), aHash };
+    }
+
+    /**
+     * @return the fill of \a aLayer before isolated islands were removed, or nullptr if there
+     *         is none or it was not the source of the current fill (whose hash is \a aFillHash).
+     */
+    std::shared_ptr<SHAPE_POLY_SET> GetRawFill( PCB_LAYER_ID aLayer,
+                                                const HASH_128& aFillHash ) const
+    {
+        auto it = m_rawFilledPolysList.find( aLayer );
+
+        if( it == m_rawFilledPolysList.end() || it->second.second != aFillHash )
+            return nullptr;
+
+        return it->second.first;
+    }
+
+    void ClearRawFills() { m_rawFilledPolysList.clear(); }
+
     /**
      * Check if a given filled polygon is an insulated island.
      *
@@ -964,6 +991,11 @@ protected:
      */
     std::map<PCB_LAYER_ID, std::shared_ptr<SHAPE_POLY_SET>> m_FilledPolysList;
 
+    /// Fills before island removal, and the hash of the final fill each produced.  These are
+    /// never modified once set, so copies of the zone may share them.
+    std::map<PCB_LAYER_ID, std::pair<std::shared_ptr<SHAPE_POLY_SET>, HASH_128>>
+                                           m_rawFilledPolysList;
+
     /// Temp variables used while filling
     LSET                                   m_fillFlags;
 
@@ -0,0 +1,536 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <cstring>
+#include <vector>
+
+#include <wx/dir.h>
+#include <wx/ffile.h>
+#include <wx/filename.h>
+
+#include <advanced_config.h>
+#include <board.h>
+#include <board_design_settings.h>
+#include <build_version.h>
+#include <footprint.h>
+#include <mmh3_hash.h>
+#include <pad.h>
+#include <paths.h>
+#include <pcb_field.h>
+#include <pcb_group.h>
+#include <pcb_track.h>
+#include <project.h>
+#include <wildcards_and_files_ext.h>
+#include <zone.h>
+#include <zone_filler.h>
+#include <geometry/shape_poly_set.h>
+#include "zone_fill_cache.h"
+
+
+// Written into every entry and mixed into every key.  Fills from a different version are never
+// reused, so changes to what is hashed, to the entry format or to the filler's results need a
+// new version.
+static const int32_t  FILL_CACHE_VERSION = 2;
+static const uint32_t FILL_CACHE_MAGIC = 0x4C465A4B;     // "KZFL"
+
+
+static void hashString( MMH3_HASH& aHash, const wxString& aString )
+{
+    aHash.add( std::string( aString.utf8_str() ) );
+}
+
+
+static void hashDouble( MMH3_HASH& aHash, double aValue )
+{
+    aHash.addData( reinterpret_cast<const uint8_t*>( &aValue ), sizeof( aValue ) );
+}
+
+
+static void hashPoint( MMH3_HASH& aHash, const VECTOR2I& aPoint )
+{
+    aHash.add( aPoint.x );
+    aHash.add( aPoint.y );
+}
+
+
+static void hashOptional( MMH3_HASH& aHash, const std::optional<int>& aValue )
+{
+    aHash.add( aValue.has_value() ? 1 : 0 );
+    aHash.add( aValue.value_or( 0 ) );
+}
+
+
+static void hashFile( MMH3_HASH& aHash, const wxString& aPath )
+{
+    wxFFile  file;
+    wxString contents;
+
+    if( wxFileName::FileExists( aPath ) && file.Open( aPath, wxT( "rb" ) ) )
+        file.ReadAll( &contents, wxConvUTF8 );
+
+    hashString( aHash, contents );
+}
+
+
+// Rule conditions can test group membership with memberOfGroup()
+static void hashGroup( MMH3_HASH& aHash, const BOARD_ITEM* aItem )
+{
+    for( PCB_GROUP* group = aItem->GetParentGroup(); group; group = group->GetParentGroup() )
+        hashString( aHash, group->GetName() );
+}
+
+
+// Rule conditions can test any of a footprint's fields, its library link, its sheet and its
+// component class, so all of them can change which constraints apply to its pads.
+static void hashFootprint( MMH3_HASH& aHash, const FOOTPRINT* aFootprint )
+{
+    for( const PCB_FIELD* field : aFootprint->GetFields() )
+    {
+        hashString( aHash, field->GetName() );
+        hashString( aHash, field->GetText() );
+    }
+
+    hashString( aHash, aFootprint->GetFPIDAsString() );
+    hashString( aHash, aFootprint->GetSheetname() );
+    hashString( aHash, aFootprint->GetSheetfile() );
+    hashString( aHash, aFootprint->GetComponentClassAsString() );
+    hashOptional( aHash, aFootprint->GetLocalClearance() );
+    aHash.add( static_cast<int32_t>( aFootprint->GetLocalZoneConnection() ) );
+    aHash.add( aFootprint->GetAttributes() );
+    hashGroup( aHash, aFootprint );
+}
+
+
+static void hashPad( MMH3_HASH& aHash, const PAD* aPad, PCB_LAYER_ID aLayer )
+{
+    aHash.add( static_cast<int32_t>( aPad->Type() ) );
+    hashPoint( aHash, aPad->GetPosition() );
+    hashDouble( aHash, aPad->GetOrientation().AsDegrees() );
+    aHash.add( static_cast<int32_t>( aPad->GetAttribute() ) );
+    aHash.add( static_cast<int32_t>( aPad->GetDrillShape() ) );
+    hashPoint( aHash, aPad->GetDrillSize() );
+    hashString( aHash, aPad->GetNetname() );
+    hashString( aHash, aPad->GetNumber() );
+
+    if( aPad->IsOnLayer( aLayer ) )
+    {
+        aHash.add( aPad->GetEffectivePolygon( aLayer, ERROR_INSIDE )->GetHash().ToString() );
+        aHash.add( static_cast<int32_t>( aPad->GetZoneLayerOverride( aLayer ) ) );
+    }
+
+    hashOptional( aHash, aPad->GetLocalClearance() );
+    hashOptional( aHash, aPad->GetLocalThermalSpokeWidthOverride() );
+    hashOptional( aHash, aPad->GetLocalThermalGapOverride() );
+    aHash.add( static_cast<int32_t>( aPad->GetLocalZoneConnection() ) );
+    hashDouble( aHash, aPad->GetThermalSpokeAngle().AsDegrees() );
+}
+
+
+static void hashTrack( MMH3_HASH& aHash, const PCB_TRACK* aTrack, PCB_LAYER_ID aLayer )
+{
+    aHash.add( static_cast<int32_t>( aTrack->Type() ) );
+    hashString( aHash, aTrack->GetNetname() );
+    hashGroup( aHash, aTrack );
+
+    if( aTrack->Type() == PCB_VIA_T )
+    {
+        const PCB_VIA* via = static_cast<const PCB_VIA*>( aTrack );
+
+        hashPoint( aHash, via->GetPosition() );
+        aHash.add( static_cast<int32_t>( via->GetViaType() ) );
+        aHash.add( static_cast<int32_t>( via->TopLayer() ) );
+        aHash.add( static_cast<int32_t>( via->BottomLayer() ) );
+        aHash.add( via->GetDrillValue() );
+
+        if( via->IsOnLayer( aLayer ) )
+        {
+            aHash.add( via->GetWidth( aLayer ) );
+            aHash.add( static_cast<int32_t>( via->GetZoneLayerOverride( aLayer ) ) );
+        }
+
+        return;
+    }
+
+    aHash.add( static_cast<int32_t>( aTrack->GetLayer() ) );
+    hashPoint( aHash, aTrack->GetStart() );
+    hashPoint( aHash, aTrack->GetEnd() );
+    aHash.add( aTrack->GetWidth() );
+
+    if( aTrack->Type() == PCB_ARC_T )
+        hashPoint( aHash, static_cast<const PCB_ARC*>( aTrack )->GetMid() );
+}
+
+
+static void hashGraphic( MMH3_HASH& aHash, const BOARD_ITEM* aItem, int aMaxError )
+{
+    SHAPE_POLY_SET poly;
+
+    aItem->TransformShapeToPolygon( poly, aItem->GetLayer(), 0, aMaxError, ERROR_INSIDE );
+
+    aHash.add( static_cast<int32_t>( aItem->Type() ) );
+    aHash.add( static_cast<int32_t>( aItem->GetLayer() ) );
+    aHash.add( poly.GetHash().ToString() );
+    hashGroup( aHash, aItem );
+
+    if( aItem->IsConnected() )
+        hashString( aHash, static_cast<const BOARD_CONNECTED_ITEM*>( aItem )->GetNetname() );
+}
+
+
+static void hashOtherZone( MMH3_HASH& aHash, ZONE* aZone, ZONE* aOther, PCB_LAYER_ID aLayer,
+                           int aWorstClearance )
+{
+    aHash.add( aOther->Outline()->GetHash().ToString() );
+    aHash.add( aOther->GetLayerSet().FmtHex() );
+    hashString( aHash, aOther->GetNetname() );
+    aHash.add( static_cast<int32_t>( aOther->GetAssignedPriority() ) );
+    aHash.add( aOther->GetIsRuleArea() ? 1 : 0 );
+    aHash.add( aOther->GetDoNotAllowCopperPour() ? 1 : 0 );
+    aHash.add( aOther->IsTeardropArea() ? 1 : 0 );
+    hashOptional( aHash, aOther->GetLocalClearance() );
+    aHash.add( aOther->GetMinThickness() );
+    hashGroup( aHash, aOther );
+
+    // Only fills which the zone filler waits for are hashed: the fill state of any other zone
+    // depends on the order the filler happens to process them in.
+    if( ZONE_FILLER::DependsOnFill( aZone, aLayer, aOther, aWorstClearance )
+            && aOther->HasFilledPolysForLayer( aLayer ) )
+    {
+        aHash.add( aOther->GetFilledPolysList( aLayer )->GetHash().ToString() );
+    }
+}
+
+
+static wxString cacheDirPath()
+{
+    wxFileName cacheDir;
+    cacheDir.AssignDir( PATHS::GetUserCachePath() );
+    cacheDir.AppendDir( wxT( "zone_fills" ) );
+
+    return cacheDir.GetPath();
+}
+
+
+ZONE_FILL_CACHE::ZONE_FILL_CACHE( BOARD* aBoard ) :
+        m_board( aBoard )
+{
+    m_cacheDir = cacheDirPath();
+
+    MMH3_HASH hash( FILL_CACHE_MAGIC );
+
+    hash.add( FILL_CACHE_VERSION );
+    hashString( hash, GetBuildVersion() );
+
+    BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
+
+    hash.add( bds.m_MaxError );
+    hashDouble( hash, ADVANCED_CFG::GetCfg().m_ExtraClearance );
+
+    // Netclasses, clearances and constraints live in the project file and custom rules, so
+    // rather than chasing every setting, any change to either invalidates the whole board.
+    if( PROJECT* project = m_board->GetProject() )
+    {
+        wxFileName fn( project->GetProjectFullName() );
+        hashFile( hash, fn.GetFullPath() );
+
+        fn.SetExt( FILEEXT::DesignRulesFileExtension );
+        hashFile( hash, fn.GetFullPath() );
+    }
+
+    // The board outline clips every zone, wherever its segments happen to lie.
+    for( BOARD_ITEM* item : m_board->Drawings() )
+    {
+        if( item->IsOnLayer( Edge_Cuts ) )
+            hashGraphic( hash, item, bds.m_MaxError );
+    }
+
+    for( FOOTPRINT* footprint : m_board->Footprints() )
+    {
+        footprint->RunOnChildren(
+                [&]( BOARD_ITEM* child )
+                {
+                    if( child->Type() != PCB_PAD_T && child->IsOnLayer( Edge_Cuts ) )
+                        hashGraphic( hash, child, bds.m_MaxError );
+                } );
+    }
+
+    m_boardHash = hash.digest();
+}
+
+
+HASH_128 ZONE_FILL_CACHE::InputHash( ZONE* aZone, PCB_LAYER_ID aLayer,
+                                     int aWorstClearance ) const
+{
+    MMH3_HASH hash( FILL_CACHE_MAGIC );
+    int       maxError = m_board->GetDesignSettings().m_MaxError;
+
+    hash.add( m_boardHash.ToString() );
+
+    // The zone itself
+    hash.add( static_cast<int32_t>( aLayer ) );
+    hash.add( aZone->Outline()->GetHash().ToString() );
+    hash.add( aZone->GetLayerSet().FmtHex() );
+    hashString( hash, aZone->GetNetname() );
+    hash.add( static_cast<int32_t>( aZone->GetAssignedPriority() ) );
+    hash.add( aZone->IsTeardropArea() ? 1 : 0 );
+    hashOptional( hash, aZone->GetLocalClearance() );
+    hash.add( aZone->GetMinThickness() );
+    hashGroup( hash, aZone );
+    hash.add( static_cast<int32_t>( aZone->GetPadConnection() ) );
+    hash.add( aZone->GetThermalReliefGap() );
+    hash.add( aZone->GetThermalReliefSpokeWidth() );
+    hash.add( aZone->GetCornerSmoothingType() );
+    hash.add( static_cast<int32_t>( aZone->GetCornerRadius() ) );
+    hash.add( static_cast<int32_t>( aZone->GetFillMode() ) );
+
+    if( aZone->GetFillMode() == ZONE_FILL_MODE::HATCH_PATTERN )
+    {
+        hash.add( aZone->GetHatchThickness() );
+        hash.add( aZone->GetHatchGap() );
+        hashDouble( hash, aZone->GetHatchOrientation().AsDegrees() );
+        hash.add( aZone->GetHatchSmoothingLevel() );
+        hashDouble( hash, aZone->GetHatchSmoothingValue() );
+        hashDouble( hash, aZone->GetHatchHoleMinArea() );
+        hash.add( aZone->GetHatchBorderAlgorithm() );
+
+        const std::optional<VECTOR2I>& offset = aZone->LayerProperties( aLayer ).hatching_offset;
+
+        hash.add( offset.has_value() ? 1 : 0 );
+        hashPoint( hash, offset.value_or( VECTOR2I() ) );
+    }
+
+    // Everything which can knock out part of the fill
+    BOX2I bbox = aZone->GetBoundingBox();
+    bbox.Inflate( aWorstClearance );
+
+    for( PCB_TRACK* track : m_board->Tracks() )
+    {
+        if( bbox.Intersects( track->GetBoundingBox() ) )
+            hashTrack( hash, track, aLayer );
+    }
+
+    auto hashIfNearby =
+            [&]( BOARD_ITEM* aItem )
+            {
+                if( !bbox.Intersects( aItem->GetBoundingBox() ) )
+                    return;
+
+                if( aItem->Type() == PCB_PAD_T )
+                    hashPad( hash, static_cast<PAD*>( aItem ), aLayer );
+                else if( aItem->Type() == PCB_ZONE_T )
+                    hashOtherZone( hash, aZone, static_cast<ZONE*>( aItem ), aLayer,
+                                   aWorstClearance );
+                else if( aItem->IsOnLayer( aLayer ) || aItem->IsOnLayer( Margin ) )
+                    hashGraphic( hash, aItem, maxError );
+            };
+
+    for( FOOTPRINT* footprint : m_board->Footprints() )
+    {
+        if( !bbox.Intersects( footprint->GetBoundingBox() ) )
+            continue;
+
+        hashFootprint( hash, footprint );
+        hash.add( footprint->GetCourtyard( aLayer ).GetHash().ToString() );
+        footprint->RunOnChildren( hashIfNearby );
+    }
+
+    for( BOARD_ITEM* item : m_board->Drawings() )
+        hashIfNearby( item );
+
+    for( ZONE* zone : m_board->Zones() )
+    {
+        if( zone != aZone )
+            hashIfNearby( zone );
+    }
+
+    return hash.digest();
+}
+
+
+wxString ZONE_FILL_CACHE::entryPath( const HASH_128& aKey ) const
+{
+    wxFileName fn( m_cacheDir, wxString( aKey.ToString() ), wxT( "fill" ) );
+    return fn.GetFullPath();
+}
+
+
+bool ZONE_FILL_CACHE::Lookup( const HASH_128& aKey, SHAPE_POLY_SET& aFill ) const
+{
+    wxString path = entryPath( aKey );
+
+    if( !wxFileName::FileExists( path ) )
+        return false;
+
+    wxFFile file( path, wxT( "rb" ) );
+
+    if( !file.IsOpened() )
+        return false;
+
+    auto readInt =
+            [&]( int32_t& aValue ) -> bool
+            {
+                return file.Read( &aValue, sizeof( aValue ) ) == sizeof( aValue );
+            };
+
+    int32_t magic = 0;
+    int32_t version = 0;
+    int32_t polyCount = 0;
+
+    if( !readInt( magic ) || static_cast<uint32_t>( magic ) != FILL_CACHE_MAGIC
+            || !readInt( version ) || version != FILL_CACHE_VERSION
+            || !readInt( polyCount ) || polyCount < 0 )
+    {
+        return false;
+    }
+
+    SHAPE_POLY_SET       fill;
+    std::vector<int32_t> coords;
+    const wxFileOffset   pointBytes = 2 * sizeof( int32_t );
+
+    for( int32_t ii = 0; ii < polyCount; ++ii )
+    {
+        int32_t contourCount = 0;
+
+        if( !readInt( contourCount ) || contourCount < 1 )
+            return false;
+
+        for( int32_t jj = 0; jj < contourCount; ++jj )
+        {
+            int32_t pointCount = 0;
+
+            if( !readInt( pointCount ) || pointCount < 0 )
+                return false;
+
+            // A damaged entry mustn't be able to ask for more memory than the file could fill
+            if( pointCount > ( file.Length() - file.Tell() ) / pointBytes )
+                return false;
+
+            coords.resize( 2 * static_cast<size_t>( pointCount ) );
+            size_t bytes = coords.size() * sizeof( int32_t );
+
+            if( file.Read( coords.data(), bytes ) != bytes )
+                return false;
+
+            SHAPE_LINE_CHAIN chain;
+
+            for( int32_t kk = 0; kk < pointCount; ++kk )
+                chain.Append( coords[2 * kk], coords[2 * kk + 1] );
+
+            chain.SetClosed( true );
+
+            if( jj == 0 )
+                fill.AddOutline( chain );
+            else
+                fill.AddHole( chain );
+        }
+    }
+
+    aFill = std::move( fill );
+    file.Close();
+
+    // Entries still in use are kept by Prune()
+    wxFileName( path ).Touch();
+
+    return true;
+}
+
+
+void ZONE_FILL_CACHE::Store( const HASH_128& aKey, const SHAPE_POLY_SET& aFill ) const
+{
+    if( !PATHS::EnsurePathExists( m_cacheDir ) )
+        return;
+
+    std::vector<int32_t> buffer;
+
+    buffer.push_back( static_cast<int32_t>( FILL_CACHE_MAGIC ) );
+    buffer.push_back( FILL_CACHE_VERSION );
+    buffer.push_back( aFill.OutlineCount() );
+
+    for( int ii = 0; ii < aFill.OutlineCount(); ++ii )
+    {
+        const SHAPE_POLY_SET::POLYGON& poly = aFill.CPolygon( ii );
+
+        buffer.push_back( static_cast<int32_t>( poly.size() ) );
+
+        for( const SHAPE_LINE_CHAIN& chain : poly )
+        {
+            buffer.push_back( chain.PointCount() );
+
+            for( const VECTOR2I& pt : chain.CPoints() )
+            {
+                buffer.push_back( pt.x );
+                buffer.push_back( pt.y );
+            }
+        }
+    }
+
+    // Other jobs sharing the cache directory can look this key up while it is being stored, so
+    // the entry only appears under its real name once all of it is on disk.
+    wxString path = entryPath( aKey );
+    wxString tmpPath = wxFileName::CreateTempFileName( path );
+
+    if( tmpPath.IsEmpty() )
+        return;
+
+    {
+        wxFFile file( tmpPath, wxT( "wb" ) );
+        size_t  bytes = buffer.size() * sizeof( int32_t );
+
+        if( !file.IsOpened() || file.Write( buffer.data(), bytes ) != bytes || !file.Close() )
+        {
+            wxRemoveFile( tmpPath );
+            return;
+        }
+    }
+
+    if( !wxRenameFile( tmpPath, path, true ) )
+        wxRemoveFile( tmpPath );
+}
+
+
+void ZONE_FILL_CACHE::Prune( int aMaxAgeDays )
+{
+    wxString dirPath = cacheDirPath();
+    wxDir    dir;
+
+    if( !wxDirExists( dirPath ) || !dir.Open( dirPath ) )
+        return;
+
+    wxDateTime    threshold = wxDateTime::Now() - wxDateSpan::Days( aMaxAgeDays );
+    wxString      fileName;
+    wxArrayString stale;
+
+    // Temporary files left by a job which stopped part way through a store are removed too
+    for( bool cont = dir.GetFirst( &fileName, wxEmptyString, wxDIR_FILES ); cont;
+         cont = dir.GetNext( &fileName ) )
+    {
+        wxFileName fn( dirPath, fileName );
+        wxDateTime modified;
+
+        if( fn.GetTimes( nullptr, &modified, nullptr ) && modified.IsEarlierThan( threshold ) )
+            stale.Add( fn.GetFullPath() );
+    }
+
+    for( const wxString& path : stale )
+        wxRemoveFile( path );
+}
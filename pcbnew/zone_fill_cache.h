@@ -0,0 +1,91 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef ZONE_FILL_CACHE_H
+#define ZONE_FILL_CACHE_H
+
+#include <hash_128.h>
+#include <layer_ids.h>
+#include <wx/string.h>
+
+class BOARD;
+class ZONE;
+class SHAPE_POLY_SET;
+
+
+/**
+ * A content-addressed, on-disk cache of zone fills.
+ *
+ * Each entry is keyed by a hash of everything which contributes to the fill of a single zone
+ * layer: the zone's outline and settings, the project's design settings and custom rules, and
+ * every item (pads, tracks, vias, graphics, other zones) near the zone.  A fill is therefore
+ * only reused when it would be recomputed identically, which lets repeated command-line jobs
+ * over an unchanged board skip the zone filler.
+ *
+ * Entries hold fills from before island removal; island removal depends on connectivity and is
+ * always rerun.  Entries are stored one per file in the user cache directory, and are removed
+ * by Prune() once they have gone unused for long enough.
+ */
+class ZONE_FILL_CACHE
+{
+public:
+    ZONE_FILL_CACHE( BOARD* aBoard );
+
+    /**
+     * Compute the cache key for filling \a aZone on \a aLayer.
+     *
+     * Must be called once all higher-priority zones which the fill depends on have been filled.
+     *
+     * @param aWorstClearance is the largest clearance which can apply to an item, used to find
+     *                        the items which might knock out part of the fill.
+     */
+    HASH_128 InputHash( ZONE* aZone, PCB_LAYER_ID aLayer, int aWorstClearance ) const;
+
+    /**
+     * Fetch a cached fill.
+     *
+     * @return true if an entry was found and read successfully.
+     */
+    bool Lookup( const HASH_128& aKey, SHAPE_POLY_SET& aFill ) const;
+
+    /**
+     * Write a fill to the cache.  Failures are silently ignored; the cache is only an
+     * optimization.
+     */
+    void Store( const HASH_128& aKey, const SHAPE_POLY_SET& aFill ) const;
+
+    /**
+     * Remove entries which have not been stored or looked up for \a aMaxAgeDays days.
+     */
+    static void Prune( int aMaxAgeDays );
+
+private:
+    wxString entryPath( const HASH_128& aKey ) const;
+
+private:
+    BOARD*   m_board;
+    wxString m_cacheDir;
+    HASH_128 m_boardHash;       // Hash of the inputs shared by every zone on the board
+};
+
+#endif // ZONE_FILL_CACHE_H
@@ -23,6 +23,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <atomic>
 #include <future>
 #include <core/kicad_algo.h>
 #include <advanced_config.h>
@@ -43,6 +44,7 @@
 #include <board_commit.h>
 #include <progress_reporter.h>
 #include <geometry/shape_poly_set.h>
+#include <geometry/shape_rect.h>
 #include <geometry/convex_hull.h>
 #include <geometry/geometry_utils.h>
 #include <geometry/vertex_set.h>
@@ -50,6 +52,7 @@
 #include <thread_pool.h>
 #include <math/util.h>      // for KiROUND
 #include "zone_filler.h"
+#include "zone_fill_cache.h"
 #include "project.h"
 #include "project/project_local_settings.h"
 
@@ -202,7 +205,9 @@ ZONE_FILLER::ZONE_FILLER(  BOARD* aBoard, COMMIT* aCommit ) :
         m_commit( aCommit ),
         m_progressReporter( nullptr ),
         m_maxError( ARC_HIGH_DEF ),
-        m_worstClearance( 0 )
+        m_worstClearance( 0 ),
+        m_worstThermalReach( 0 ),
+        m_fillCache( nullptr )
 {
     // To enable add "DebugZoneFiller=1" to kicad_advanced settings file.
     m_debugZoneFiller = ADVANCED_CFG::GetCfg().m_DebugZoneFiller;
@@ -232,6 +237,42 @@ void ZONE_FILLER::SetProgressReporter( PROGRESS_REPORTER* aReporter )
  *
  * Caller is also responsible for re-building connectivity afterwards.
  */
+bool ZONE_FILLER::DependsOnFill( ZONE* aZone, PCB_LAYER_ID aLayer, ZONE* aOtherZone,
+                                 int aWorstClearance )
+{
+    // Check to see if we have to knock-out the filled areas of a higher-priority zone.
+
+    // Even if keepouts exclude copper pours, the exclusion is by outline rather than filled
+    // area, so we're good-to-go here too
+    if( aOtherZone->GetIsRuleArea() )
+        return false;
+
+    // If the other zone is never going to be filled then don't wait for it
+    if( aOtherZone->GetNumCorners() <= 2 )
+        return false;
+
+    // If the zones share no common layers
+    if( !aOtherZone->GetLayerSet().test( aLayer ) )
+        return false;
+
+    if( aZone->HigherPriority( aOtherZone ) )
+        return false;
+
+    // Same-net zones always use outlines to produce determinate results
+    if( aOtherZone->SameNet( aZone ) )
+        return false;
+
+    // A higher priority zone is found: if we intersect then its fill is knocked out of ours
+    BOX2I inflatedBBox = aZone->GetBoundingBox();
+    inflatedBBox.Inflate( aWorstClearance );
+
+    if( !inflatedBBox.Intersects( aOtherZone->GetBoundingBox() ) )
+        return false;
+
+    return aZone->Outline()->Collide( aOtherZone->Outline(), aWorstClearance );
+}
+
+
 bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aParent )
 {
     std::lock_guard<KISPINLOCK> lock( m_board->GetConnectivity()->GetLock() );
@@ -248,6 +289,47 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
 
     m_worstClearance = m_board->GetMaxClearanceValue();
 
+    // Thermal reliefs reach further from a pad than its clearance when the gap is larger, and
+    // their spokes reach another spoke width into the fill.
+    BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
+    DRC_CONSTRAINT         worstConstraint;
+    int                    worstGap = 0;
+    int                    worstSpoke = 0;
+
+    if( bds.m_DRCEngine )
+    {
+        if( bds.m_DRCEngine->QueryWorstConstraint( THERMAL_RELIEF_GAP_CONSTRAINT, worstConstraint ) )
+            worstGap = worstConstraint.GetValue().Min();
+
+        if( bds.m_DRCEngine->QueryWorstConstraint( THERMAL_SPOKE_WIDTH_CONSTRAINT, worstConstraint ) )
+            worstSpoke = worstConstraint.GetValue().Opt();
+    }
+
+    auto accumulateZone =
+            [&]( ZONE* aZone )
+            {
+                worstGap = std::max( worstGap, aZone->GetThermalReliefGap() );
+                worstSpoke = std::max( worstSpoke, aZone->GetThermalReliefSpokeWidth() );
+            };
+
+    for( ZONE* zone : m_board->Zones() )
+        accumulateZone( zone );
+
+    for( FOOTPRINT* footprint : m_board->Footprints() )
+    {
+        for( ZONE* zone : footprint->Zones() )
+            accumulateZone( zone );
+
+        for( PAD* pad : footprint->Pads() )
+        {
+            worstGap = std::max( worstGap, pad->GetLocalThermalGapOverride().value_or( 0 ) );
+            worstSpoke = std::max( worstSpoke,
+                                   pad->GetLocalThermalSpokeWidthOverride().value_or( 0 ) );
+        }
+    }
+
+    m_worstThermalReach = worstGap + worstSpoke;
+
     if( m_progressReporter )
     {
         m_progressReporter->Report( aCheck ? _( "Checking zone fills..." )
@@ -481,46 +563,125 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
         zone->UnFill();
     }
 
-    auto check_fill_dependency =
-            [&]( ZONE* aZone, PCB_LAYER_ID aLayer, ZONE* aOtherZone ) -> bool
+    // Fills from before island removal are kept so that a later edit can refill just the
+    // region it damaged (see SetDirtyRegions()).
+    bool keepRawFills = ADVANCED_CFG::GetCfg().m_IncrementalZoneFill && !m_debugZoneFiller;
+
+    std::map<std::pair<ZONE*, PCB_LAYER_ID>, std::shared_ptr<SHAPE_POLY_SET>> rawFills;
+    std::map<std::pair<ZONE*, PCB_LAYER_ID>, BOX2I>                           fillRegions;
+
+    if( keepRawFills )
+    {
+        int extra_margin = pcbIUScale.mmToIU( ADVANCED_CFG::GetCfg().m_ExtraClearance );
+
+        for( const std::pair<ZONE*, PCB_LAYER_ID>& fillItem : toFill )
+        {
+            ZONE*        zone = fillItem.first;
+            PCB_LAYER_ID layer = fillItem.second;
+
+            // Pre-populate so that the fill threads never insert into the map
+            rawFills[ fillItem ] = nullptr;
+
+            if( aCheck || !zone->IsOnCopperLayer() )
+                continue;
+
+            // Hatch patterns are aligned to the whole zone and can't be spliced
+            if( zone->GetFillMode() == ZONE_FILL_MODE::HATCH_PATTERN )
+                continue;
+
+            auto dirtyIt = m_dirtyRegions.find( zone->m_Uuid );
+
+            if( dirtyIt == m_dirtyRegions.end() || !dirtyIt->second.IsValid() )
+                continue;
+
+            std::shared_ptr<SHAPE_POLY_SET> rawFill = zone->GetRawFill( layer,
+                                                                        oldFillHashes[ fillItem ] );
+
+            if( !rawFill )
+                continue;
+
+            // The damaged items can change the fill out to their clearance or thermal relief,
+            // and the pruning of features narrower than the min thickness reaches a little
+            // further still.
+            BOX2I region = dirtyIt->second;
+            region.Inflate( regionMargin( zone ) + extra_margin );
+
+            rawFills[ fillItem ] = rawFill;
+            fillRegions[ fillItem ] = region;
+        }
+
+        // Zones knock out the fills of different-net, higher-priority zones, so a region must
+        // also cover wherever those fills may change.  Grow regions until they are stable,
+        // falling back to a full fill when a knockout is refilled in full.
+        bool changed = true;
+
+        while( changed )
+        {
+            changed = false;
+
+            for( auto it = fillRegions.begin(); it != fillRegions.end(); )
             {
-                // Check to see if we have to knock-out the filled areas of a higher-priority
-                // zone.  If so we have to wait until said zone is filled before we can fill.
+                ZONE*        zone = it->first.first;
+                PCB_LAYER_ID layer = it->first.second;
+                BOX2I&       region = it->second;
+                BOX2I        zoneBBox = zone->GetBoundingBox();
+                bool         fullFill = false;
 
-                // If the other zone is already filled on the requested layer then we're
-                // good-to-go
-                if( aOtherZone->GetFillFlag( aLayer ) )
-                    return false;
+                for( const std::pair<ZONE*, PCB_LAYER_ID>& other : toFill )
+                {
+                    if( other.first == zone || other.second != layer )
+                        continue;
 
-                // Even if keepouts exclude copper pours, the exclusion is by outline rather than
-                // filled area, so we're good-to-go here too
-                if( aOtherZone->GetIsRuleArea() )
-                    return false;
+                    if( !other.first->HigherPriority( zone ) || other.first->SameNet( zone ) )
+                        continue;
 
-                // If the other zone is never going to be filled then don't wait for it
-                if( aOtherZone->GetNumCorners() <= 2 )
-                    return false;
+                    auto otherIt = fillRegions.find( other );
+                    BOX2I reach = otherIt != fillRegions.end() ? otherIt->second
+                                                               : other.first->GetBoundingBox();
 
-                // If the zones share no common layers
-                if( !aOtherZone->GetLayerSet().test( aLayer ) )
-                    return false;
+                    reach.Inflate( m_worstClearance + extra_margin );
 
-                if( aZone->HigherPriority( aOtherZone ) )
-                    return false;
+                    if( !reach.Intersects( zoneBBox ) )
+                        continue;
 
-                // Same-net zones always use outlines to produce determinate results
-                if( aOtherZone->SameNet( aZone ) )
-                    return false;
+                    if( otherIt == fillRegions.end() )
+                    {
+                        fullFill = true;
+                        break;
+                    }
+
+                    if( !region.Contains( reach ) )
+                    {
+                        region.Merge( reach );
+                        changed = true;
+                    }
+                }
+
+                if( fullFill || region.Contains( zoneBBox ) )
+                {
+                    rawFills[ it->first ] = nullptr;
+                    it = fillRegions.erase( it );
+                    changed = true;
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+    }
 
-                // A higher priority zone is found: if we intersect and it's not filled yet
-                // then we have to wait.
-                BOX2I inflatedBBox = aZone->GetBoundingBox();
-                inflatedBBox.Inflate( m_worstClearance );
+    m_dirtyRegions.clear();
 
-                if( !inflatedBBox.Intersects( aOtherZone->GetBoundingBox() ) )
+    auto check_fill_dependency =
+            [&]( ZONE* aZone, PCB_LAYER_ID aLayer, ZONE* aOtherZone ) -> bool
+            {
+                // If the other zone is already filled on the requested layer then we're
+                // good-to-go
+                if( aOtherZone->GetFillFlag( aLayer ) )
                     return false;
 
-                return aZone->Outline()->Collide( aOtherZone->Outline(), m_worstClearance );
+                return DependsOnFill( aZone, aLayer, aOtherZone, m_worstClearance );
             };
 
     auto fill_lambda =
@@ -558,9 +719,36 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
                         return 0;
 
                     SHAPE_POLY_SET fillPolys;
+                    auto           regionIt = fillRegions.find( aFillItem );
+
+                    if( regionIt != fillRegions.end() )
+                    {
+                        if( !fillZoneRegion( zone, layer, regionIt->second,
+                                             *rawFills.at( aFillItem ), fillPolys ) )
+                        {
+                            return 0;
+                        }
+                    }
+                    else if( m_fillCache && !m_debugZoneFiller )
+                    {
+                        // Higher-priority zones are filled by now, so the key is complete
+                        HASH_128 key = m_fillCache->InputHash( zone, layer, m_worstClearance );
+
+                        if( !m_fillCache->Lookup( key, fillPolys ) )
+                        {
+                            if( !fillSingleZone( zone, layer, fillPolys ) )
+                                return 0;
 
-                    if( !fillSingleZone( zone, layer, fillPolys ) )
+                            m_fillCache->Store( key, fillPolys );
+                        }
+                    }
+                    else if( !fillSingleZone( zone, layer, fillPolys ) )
+                    {
                         return 0;
+                    }
+
+                    if( keepRawFills )
+                        rawFills.at( aFillItem ) = std::make_shared<SHAPE_POLY_SET>( fillPolys );
 
                     zone->SetFilledPolysList( layer, fillPolys );
                 }
@@ -863,6 +1051,16 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
     for( ZONE* zone : aZones )
         zone->CalculateFilledArea();
 
+    for( const auto& [ fillItem, rawFill ] : rawFills )
+    {
+        if( !rawFill )
+            continue;
+
+        fillItem.first->BuildHashValue( fillItem.second );
+        fillItem.first->SetRawFill( fillItem.second, rawFill,
+                                    fillItem.first->GetHashValue( fillItem.second ) );
+    }
+
 
     if( aCheck )
     {
@@ -1038,7 +1236,7 @@ void ZONE_FILLER::addKnockout( BOARD_ITEM* aItem, PCB_LAYER_ID aLayer, int aGap,
  * in spokes, which must be done later.
  */
 void ZONE_FILLER::knockoutThermalReliefs( const ZONE* aZone, PCB_LAYER_ID aLayer,
-                                          SHAPE_POLY_SET& aFill,
+                                          const BOX2I& aFillBox, SHAPE_POLY_SET& aFill,
                                           std::vector<PAD*>& aThermalConnectionPads,
                                           std::vector<PAD*>& aNoConnectionPads )
 {
@@ -1057,7 +1255,7 @@ void ZONE_FILLER::knockoutThermalReliefs( const ZONE* aZone, PCB_LAYER_ID aLayer
             BOX2I padBBox = pad->GetBoundingBox();
             padBBox.Inflate( m_worstClearance );
 
-            if( !padBBox.Intersects( aZone->GetBoundingBox() ) )
+            if( !padBBox.Intersects( aFillBox ) )
                 continue;
 
             bool noConnection = pad->GetNetCode() != aZone->GetNetCode();
@@ -1152,6 +1350,7 @@ void ZONE_FILLER::knockoutThermalReliefs( const ZONE* aZone, PCB_LAYER_ID aLayer
  * not connected to it.
  */
 void ZONE_FILLER::buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLayer,
+                                             const BOX2I& aFillBox,
                                              const std::vector<PAD*>& aNoConnectionPads,
                                              SHAPE_POLY_SET& aHoles )
 {
@@ -1167,7 +1366,7 @@ void ZONE_FILLER::buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLa
     // A small extra clearance to be sure actual track clearances are not smaller than
     // requested clearance due to many approximations in calculations, like arc to segment
     // approx, rounding issues, etc.
-    BOX2I zone_boundingbox = aZone->GetBoundingBox();
+    BOX2I zone_boundingbox = aFillBox;
     int   extra_margin = pcbIUScale.mmToIU( ADVANCED_CFG::GetCfg().m_ExtraClearance );
 
     // Items outside the zone bounding box are skipped, so it needs to be inflated by the
@@ -1539,9 +1738,9 @@ void ZONE_FILLER::buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLa
  * in charge of the fill parameters within their own outlines.
  */
 void ZONE_FILLER::subtractHigherPriorityZones( const ZONE* aZone, PCB_LAYER_ID aLayer,
-                                               SHAPE_POLY_SET& aRawFill )
+                                               const BOX2I& aFillBox, SHAPE_POLY_SET& aRawFill )
 {
-    BOX2I zoneBBox = aZone->GetBoundingBox();
+    const BOX2I& zoneBBox = aFillBox;
 
     auto knockoutZoneOutline =
             [&]( ZONE* aKnockout )
@@ -1656,7 +1855,7 @@ void ZONE_FILLER::connect_nearby_polys( SHAPE_POLY_SET& aPolys, double aDistance
  * fill.
  */
 bool ZONE_FILLER::fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LAYER_ID aDebugLayer,
-                                  const SHAPE_POLY_SET& aSmoothedOutline,
+                                  const BOX2I& aFillBox, const SHAPE_POLY_SET& aSmoothedOutline,
                                   const SHAPE_POLY_SET& aMaxExtents, SHAPE_POLY_SET& aFillPolys )
 {
     m_maxError = m_board->GetDesignSettings().m_MaxError;
@@ -1695,7 +1894,8 @@ bool ZONE_FILLER::fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LA
      * Knockout thermal reliefs.
      */
 
-    knockoutThermalReliefs( aZone, aLayer, aFillPolys, thermalConnectionPads, noConnectionPads );
+    knockoutThermalReliefs( aZone, aLayer, aFillBox, aFillPolys, thermalConnectionPads,
+                            noConnectionPads );
     DUMP_POLYS_TO_COPPER_LAYER( aFillPolys, In2_Cu, wxT( "minus-thermal-reliefs" ) );
 
     if( m_progressReporter && m_progressReporter->IsCancelled() )
@@ -1705,7 +1905,7 @@ bool ZONE_FILLER::fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LA
      * Knockout electrical clearances.
      */
 
-    buildCopperItemClearances( aZone, aLayer, noConnectionPads, clearanceHoles );
+    buildCopperItemClearances( aZone, aLayer, aFillBox, noConnectionPads, clearanceHoles );
     DUMP_POLYS_TO_COPPER_LAYER( clearanceHoles, In3_Cu, wxT( "clearance-holes" ) );
 
     if( m_progressReporter && m_progressReporter->IsCancelled() )
@@ -1715,7 +1915,7 @@ bool ZONE_FILLER::fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LA
      * Add thermal relief spokes.
      */
 
-    buildThermalSpokes( aZone, aLayer, thermalConnectionPads, thermalSpokes );
+    buildThermalSpokes( aZone, aLayer, aFillBox, thermalConnectionPads, thermalSpokes );
 
     if( m_progressReporter && m_progressReporter->IsCancelled() )
         return false;
@@ -1881,7 +2081,7 @@ bool ZONE_FILLER::fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LA
      * Lastly give any same-net but higher-priority zones control over their own area.
      */
 
-    subtractHigherPriorityZones( aZone, aLayer, aFillPolys );
+    subtractHigherPriorityZones( aZone, aLayer, aFillBox, aFillPolys );
     DUMP_POLYS_TO_COPPER_LAYER( aFillPolys, In18_Cu, wxT( "minus-higher-priority-zones" ) );
 
     aFillPolys.Fracture();
@@ -1986,6 +2186,49 @@ bool ZONE_FILLER::fillNonCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer,
 }
 
 
+int ZONE_FILLER::regionMargin( const ZONE* aZone ) const
+{
+    return std::max( m_worstClearance, m_worstThermalReach ) + 2 * aZone->GetMinThickness()
+           + m_board->GetDesignSettings().m_MaxError;
+}
+
+
+bool ZONE_FILLER::isTiledFill( const ZONE* aZone ) const
+{
+    int threshold = ADVANCED_CFG::GetCfg().m_ZoneFillTileThreshold;
+
+    if( threshold <= 0 || GetKiCadThreadPool().get_thread_count() < 2 )
+        return false;
+
+    // Hatch patterns are aligned to the whole zone and can't be computed piecewise
+    if( aZone->GetFillMode() == ZONE_FILL_MODE::HATCH_PATTERN )
+        return false;
+
+    BOX2I zoneBBox = aZone->GetBoundingBox();
+    int   count = 0;
+
+    for( FOOTPRINT* footprint : m_board->Footprints() )
+    {
+        if( !footprint->GetBoundingBox().Intersects( zoneBBox ) )
+            continue;
+
+        for( PAD* pad : footprint->Pads() )
+        {
+            if( pad->GetBoundingBox().Intersects( zoneBBox ) && ++count >= threshold )
+                return true;
+        }
+    }
+
+    for( PCB_TRACK* track : m_board->Tracks() )
+    {
+        if( track->GetBoundingBox().Intersects( zoneBBox ) && ++count >= threshold )
+            return true;
+    }
+
+    return false;
+}
+
+
 /*
  * Build the filled solid areas data from real outlines (stored in m_Poly)
  * The solid areas can be more than one on copper layers, and do not have holes
@@ -2010,10 +2253,18 @@ bool ZONE_FILLER::fillSingleZone( ZONE* aZone, PCB_LAYER_ID aLayer, SHAPE_POLY_S
     if( m_progressReporter && m_progressReporter->IsCancelled() )
         return false;
 
-    if( aZone->IsOnCopperLayer() )
+    if( aZone->IsOnCopperLayer() && debugLayer == UNDEFINED_LAYER && isTiledFill( aZone ) )
+    {
+        if( fillTiledCopperZone( aZone, aLayer, smoothedPoly, maxExtents, aFillPolys ) )
+            aZone->SetNeedRefill( false );
+    }
+    else if( aZone->IsOnCopperLayer() )
     {
-        if( fillCopperZone( aZone, aLayer, debugLayer, smoothedPoly, maxExtents, aFillPolys ) )
+        if( fillCopperZone( aZone, aLayer, debugLayer, aZone->GetBoundingBox(), smoothedPoly,
+                            maxExtents, aFillPolys ) )
+        {
             aZone->SetNeedRefill( false );
+        }
     }
     else
     {
@@ -2025,15 +2276,233 @@ bool ZONE_FILLER::fillSingleZone( ZONE* aZone, PCB_LAYER_ID aLayer, SHAPE_POLY_S
 }
 
 
+bool ZONE_FILLER::fillCopperZoneRegion( const ZONE* aZone, PCB_LAYER_ID aLayer,
+                                        const BOX2I& aRegion,
+                                        const SHAPE_POLY_SET& aSmoothedOutline,
+                                        const SHAPE_POLY_SET& aMaxExtents,
+                                        SHAPE_POLY_SET& aRegionFill )
+{
+    // Anything within the region may depend on the fill up to a clearance or thermal relief and
+    // a couple of min-thickness prunings away.  Pads straddling the region must also be entirely
+    // within the computed area so that their thermal reliefs and spokes come out the same.
+    int   margin = regionMargin( aZone );
+    BOX2I computeBox = aRegion;
+    computeBox.Inflate( margin );
+
+    for( FOOTPRINT* footprint : m_board->Footprints() )
+    {
+        if( !footprint->GetBoundingBox().Intersects( computeBox ) )
+            continue;
+
+        for( PAD* pad : footprint->Pads() )
+        {
+            BOX2I padBBox = pad->GetBoundingBox();
+
+            if( padBBox.Intersects( aRegion ) )
+            {
+                padBBox.Inflate( margin );
+                computeBox.Merge( padBBox );
+            }
+        }
+    }
+
+    SHAPE_POLY_SET computeArea;
+    computeArea.AddOutline( SHAPE_RECT( computeBox ).Outline() );
+
+    SHAPE_POLY_SET smoothedOutline = aSmoothedOutline.CloneDropTriangulation();
+    SHAPE_POLY_SET maxExtents = aMaxExtents.CloneDropTriangulation();
+
+    smoothedOutline.BooleanIntersection( computeArea );
+    maxExtents.BooleanIntersection( computeArea );
+
+    if( !fillCopperZone( aZone, aLayer, UNDEFINED_LAYER, computeBox, smoothedOutline, maxExtents,
+                         aRegionFill ) )
+    {
+        return false;
+    }
+
+    SHAPE_POLY_SET regionArea;
+    regionArea.AddOutline( SHAPE_RECT( aRegion ).Outline() );
+
+    aRegionFill.BooleanIntersection( regionArea );
+    return true;
+}
+
+
+bool ZONE_FILLER::fillZoneRegion( ZONE* aZone, PCB_LAYER_ID aLayer, const BOX2I& aRegion,
+                                  const SHAPE_POLY_SET& aRawFill, SHAPE_POLY_SET& aFillPolys )
+{
+    SHAPE_POLY_SET* boardOutline = m_brdOutlinesValid ? &m_boardOutline : nullptr;
+    SHAPE_POLY_SET  maxExtents;
+    SHAPE_POLY_SET  smoothedPoly;
+    SHAPE_POLY_SET  regionFill;
+
+    if( !aZone->BuildSmoothedPoly( maxExtents, aLayer, boardOutline, &smoothedPoly ) )
+        return false;
+
+    if( m_progressReporter && m_progressReporter->IsCancelled() )
+        return false;
+
+    if( !fillCopperZoneRegion( aZone, aLayer, aRegion, smoothedPoly, maxExtents, regionFill ) )
+        return false;
+
+    SHAPE_POLY_SET regionArea;
+    regionArea.AddOutline( SHAPE_RECT( aRegion ).Outline() );
+
+    aFillPolys = aRawFill.CloneDropTriangulation();
+    aFillPolys.BooleanSubtract( regionArea );
+    aFillPolys.BooleanAdd( regionFill );
+    aFillPolys.Fracture();
+
+    aZone->SetNeedRefill( false );
+    return true;
+}
+
+
+bool ZONE_FILLER::fillTiledCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer,
+                                       const SHAPE_POLY_SET& aSmoothedOutline,
+                                       const SHAPE_POLY_SET& aMaxExtents,
+                                       SHAPE_POLY_SET& aFillPolys )
+{
+    struct TILED_FILL
+    {
+        std::vector<BOX2I>              m_tiles;
+        std::vector<SHAPE_POLY_SET>     m_fills;
+        std::vector<std::promise<bool>> m_results;
+        std::atomic<size_t>             m_next = 0;
+    };
+
+    thread_pool& tp = GetKiCadThreadPool();
+    BOX2I        zoneBBox = aZone->GetBoundingBox();
+    int          maxError = m_board->GetDesignSettings().m_MaxError;
+
+    // Tiles much smaller than the area each one has to be computed over are a waste of time
+    int minTileSize = 4 * regionMargin( aZone );
+    int tileCount = 2 * std::max( 1, (int) tp.get_thread_count() );
+    int cols = KiROUND( std::sqrt( tileCount * (double) zoneBBox.GetWidth()
+                                             / std::max( 1, zoneBBox.GetHeight() ) ) );
+
+    cols = std::clamp( cols, 1, std::max( 1, zoneBBox.GetWidth() / std::max( 1, minTileSize ) ) );
+
+    int rows = std::clamp( ( tileCount + cols - 1 ) / cols, 1,
+                           std::max( 1, zoneBBox.GetHeight() / std::max( 1, minTileSize ) ) );
+
+    if( rows * cols < 2 )
+        return fillCopperZone( aZone, aLayer, UNDEFINED_LAYER, zoneBBox, aSmoothedOutline,
+                               aMaxExtents, aFillPolys );
+
+    std::shared_ptr<TILED_FILL> tiled = std::make_shared<TILED_FILL>();
+
+    // Tiles abut exactly; the outermost ones are grown a little to be sure nothing on the zone
+    // boundary falls between the cracks.
+    for( int row = 0; row < rows; ++row )
+    {
+        for( int col = 0; col < cols; ++col )
+        {
+            int x0 = zoneBBox.GetLeft() + (int) ( (int64_t) zoneBBox.GetWidth() * col / cols );
+            int x1 = zoneBBox.GetLeft() + (int) ( (int64_t) zoneBBox.GetWidth() * ( col + 1 ) / cols );
+            int y0 = zoneBBox.GetTop() + (int) ( (int64_t) zoneBBox.GetHeight() * row / rows );
+            int y1 = zoneBBox.GetTop() + (int) ( (int64_t) zoneBBox.GetHeight() * ( row + 1 ) / rows );
+
+            if( col == 0 )
+                x0 -= maxError;
+
+            if( col == cols - 1 )
+                x1 += maxError;
+
+            if( row == 0 )
+                y0 -= maxError;
+
+            if( row == rows - 1 )
+                y1 += maxError;
+
+            tiled->m_tiles.emplace_back( VECTOR2I( x0, y0 ), VECTOR2I( x1 - x0, y1 - y0 ) );
+        }
+    }
+
+    tiled->m_fills.resize( tiled->m_tiles.size() );
+    tiled->m_results.resize( tiled->m_tiles.size() );
+
+    std::vector<std::future<bool>> results;
+
+    for( std::promise<bool>& result : tiled->m_results )
+        results.push_back( result.get_future() );
+
+    // Tiles are handed out from a shared counter.  The calling thread (which is itself usually
+    // a pool thread) works through them too, so once it runs out every tile has been claimed
+    // by a running thread and waiting for the results can't stall on a helper that hasn't been
+    // scheduled yet.  Helpers which start after the tiles are gone simply return.
+    auto fillTiles =
+            [this, tiled, aZone, aLayer, &aSmoothedOutline, &aMaxExtents]()
+            {
+                for( size_t ii = tiled->m_next++; ii < tiled->m_tiles.size(); ii = tiled->m_next++ )
+                {
+                    // An exception must not escape a pool task, and the tile's result must be
+                    // set whatever happens or the wait below never ends
+                    try
+                    {
+                        bool filled = fillCopperZoneRegion( aZone, aLayer, tiled->m_tiles[ii],
+                                                            aSmoothedOutline, aMaxExtents,
+                                                            tiled->m_fills[ii] );
+
+                        tiled->m_results[ii].set_value( filled );
+                    }
+                    catch( ... )
+                    {
+                        tiled->m_results[ii].set_exception( std::current_exception() );
+                    }
+                }
+            };
+
+    for( size_t ii = 1; ii < tiled->m_tiles.size(); ++ii )
+        tp.push_task( fillTiles );
+
+    fillTiles();
+
+    // Wait for every tile before passing on an exception, as the tiles refer to our arguments
+    bool               ok = true;
+    std::exception_ptr error;
+
+    for( std::future<bool>& result : results )
+    {
+        try
+        {
+            ok &= result.get();
+        }
+        catch( ... )
+        {
+            if( !error )
+                error = std::current_exception();
+        }
+    }
+
+    if( error )
+        std::rethrow_exception( error );
+
+    if( !ok )
+        return false;
+
+    aFillPolys.RemoveAllContours();
+
+    for( const SHAPE_POLY_SET& tileFill : tiled->m_fills )
+        aFillPolys.Append( tileFill );
+
+    aFillPolys.Simplify();
+    aFillPolys.Fracture();
+    return true;
+}
+
+
 /**
  * Function buildThermalSpokes
  */
 void ZONE_FILLER::buildThermalSpokes( const ZONE* aZone, PCB_LAYER_ID aLayer,
+                                      const BOX2I& aFillBox,
                                       const std::vector<PAD*>& aSpokedPadsList,
                                       std::deque<SHAPE_LINE_CHAIN>& aSpokesList )
 {
     BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
-    BOX2I                  zoneBB = aZone->GetBoundingBox();
+    BOX2I                  zoneBB = aFillBox;
     DRC_CONSTRAINT         constraint;
     int                    zone_half_width = aZone->GetMinThickness() / 2;
 
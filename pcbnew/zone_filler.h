@@ -26,6 +26,7 @@
 #ifndef ZONE_FILLER_H
 #define ZONE_FILLER_H
 
+#include <map>
 #include <vector>
 #include <zone.h>
 
@@ -34,6 +35,7 @@ class BOARD;
 class COMMIT;
 class SHAPE_POLY_SET;
 class SHAPE_LINE_CHAIN;
+class ZONE_FILL_CACHE;
 
 
 class ZONE_FILLER
@@ -57,8 +59,34 @@ public:
      */
     bool Fill( const std::vector<ZONE*>& aZones, bool aCheck = false, wxWindow* aParent = nullptr );
 
+    /**
+     * Limit the next Fill() of the given zones to the regions damaged by an edit.
+     *
+     * When incremental filling is enabled, zones which have a fill cached from before island
+     * removal only have the damaged region recalculated, which is then spliced into the cached
+     * fill.  Zones without a usable cached fill (and zones not listed) are filled in full.
+     */
+    void SetDirtyRegions( const std::map<KIID, BOX2I>& aRegions ) { m_dirtyRegions = aRegions; }
+
+    /**
+     * Reuse zone fills from (and record new fills to) a persistent on-disk cache.
+     *
+     * The cache is not owned by the filler and must outlive any calls to Fill().
+     */
+    void SetFillCache( ZONE_FILL_CACHE* aCache ) { m_fillCache = aCache; }
+
     bool IsDebug() const { return m_debugZoneFiller; }
 
+    /**
+     * @return true if the fill of \a aZone on \a aLayer depends on the fill of \a aOtherZone,
+     *         which must then be filled first so that its fill can be knocked out.
+     *
+     * The fill cache hashes the fills of exactly these zones, as the fill state of any other
+     * zone depends on the order the filler happens to process them in.
+     */
+    static bool DependsOnFill( ZONE* aZone, PCB_LAYER_ID aLayer, ZONE* aOtherZone,
+                               int aWorstClearance );
+
 private:
 
     void addKnockout( PAD* aPad, PCB_LAYER_ID aLayer, int aGap, SHAPE_POLY_SET& aHoles );
@@ -68,16 +96,17 @@ private:
 
     void addHoleKnockout( PAD* aPad, int aGap, SHAPE_POLY_SET& aHoles );
 
-    void knockoutThermalReliefs( const ZONE* aZone, PCB_LAYER_ID aLayer, SHAPE_POLY_SET& aFill,
+    void knockoutThermalReliefs( const ZONE* aZone, PCB_LAYER_ID aLayer, const BOX2I& aFillBox,
+                                 SHAPE_POLY_SET& aFill,
                                  std::vector<PAD*>& aThermalConnectionPads,
                                  std::vector<PAD*>& aNoConnectionPads );
 
-    void buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLayer,
+    void buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLayer, const BOX2I& aFillBox,
                                     const std::vector<PAD*>& aNoConnectionPads,
                                     SHAPE_POLY_SET& aHoles );
 
     void subtractHigherPriorityZones( const ZONE* aZone, PCB_LAYER_ID aLayer,
-                                      SHAPE_POLY_SET& aRawFill );
+                                      const BOX2I& aFillBox, SHAPE_POLY_SET& aRawFill );
 
     /**
      * Function fillCopperZone
@@ -88,10 +117,10 @@ private:
      * The filled copper area must be computed before
      * BuildFilledSolidAreasPolygons() call this function just after creating the
      *  filled copper area polygon (without clearance areas
-     * @param aPcb: the current board
+     * @param aFillBox: the extents being filled; items outside it (plus clearance) are ignored
      */
     bool fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LAYER_ID aDebugLayer,
-                         const SHAPE_POLY_SET& aSmoothedOutline,
+                         const BOX2I& aFillBox, const SHAPE_POLY_SET& aSmoothedOutline,
                          const SHAPE_POLY_SET& aMaxExtents, SHAPE_POLY_SET& aFillPolys );
 
     bool fillNonCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer,
@@ -100,7 +129,7 @@ private:
      * Function buildThermalSpokes
      * Constructs a list of all thermal spokes for the given zone.
      */
-    void buildThermalSpokes( const ZONE* box, PCB_LAYER_ID aLayer,
+    void buildThermalSpokes( const ZONE* box, PCB_LAYER_ID aLayer, const BOX2I& aFillBox,
                              const std::vector<PAD*>& aSpokedPadsList,
                              std::deque<SHAPE_LINE_CHAIN>& aSpokes );
 
@@ -125,6 +154,43 @@ private:
      */
     bool fillSingleZone( ZONE* aZone, PCB_LAYER_ID aLayer, SHAPE_POLY_SET& aFillPolys );
 
+    /**
+     * Recalculate the fill of a copper zone within \a aRegion only, and splice the result into
+     * \a aRawFill (the zone's previous fill before island removal).
+     */
+    bool fillZoneRegion( ZONE* aZone, PCB_LAYER_ID aLayer, const BOX2I& aRegion,
+                         const SHAPE_POLY_SET& aRawFill, SHAPE_POLY_SET& aFillPolys );
+
+    /**
+     * Compute the fill of a copper zone clipped to \a aRegion.  The fill is calculated over a
+     * larger area than \a aRegion so that the clipping of the outline has no effect on the part
+     * that is kept.
+     */
+    bool fillCopperZoneRegion( const ZONE* aZone, PCB_LAYER_ID aLayer, const BOX2I& aRegion,
+                               const SHAPE_POLY_SET& aSmoothedOutline,
+                               const SHAPE_POLY_SET& aMaxExtents, SHAPE_POLY_SET& aRegionFill );
+
+    /**
+     * @return how far from an item a change to it can alter the fill of \a aZone: its
+     *         clearance or thermal relief (gap plus spoke), and the min-thickness pruning
+     *         around those.  Fills computed over a region must be computed this far beyond it.
+     */
+    int regionMargin( const ZONE* aZone ) const;
+
+    /**
+     * @return true if \a aZone is big enough to be worth splitting into tiles which are filled
+     *         concurrently (see the ZoneFillTileThreshold advanced setting).
+     */
+    bool isTiledFill( const ZONE* aZone ) const;
+
+    /**
+     * Fill a copper zone layer as a grid of tiles computed concurrently on the thread pool,
+     * and then stitch the tiles back together with a union.
+     */
+    bool fillTiledCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer,
+                              const SHAPE_POLY_SET& aSmoothedOutline,
+                              const SHAPE_POLY_SET& aMaxExtents, SHAPE_POLY_SET& aFillPolys );
+
     /**
      * for zones having the ZONE_FILL_MODE::ZONE_FILL_MODE::HATCH_PATTERN, create a grid pattern
      * in filled areas of aZone, giving to the filled polygons a fill style like a grid
@@ -143,8 +209,12 @@ private:
 
     int                   m_maxError;
     int                   m_worstClearance;
+    int                   m_worstThermalReach;  // largest thermal gap plus spoke width
 
     bool                  m_debugZoneFiller;
+
+    std::map<KIID, BOX2I> m_dirtyRegions;
+    ZONE_FILL_CACHE*      m_fillCache;
 };
 
 #endif
@@ -29,6 +29,7 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <advanced_config.h>
 #include <board.h>
 #include <board_commit.h>
 #include <board_design_settings.h>
@@ -294,6 +295,12 @@ void FillZones( BOARD* m_board )
 }
 
 
+ADVANCED_CFG& WritableAdvancedCfg()
+{
+    return const_cast<ADVANCED_CFG&>( ADVANCED_CFG::GetCfg() );
+}
+
+
 #define TEST( a, b )                                                                               \
     {                                                                                              \
         if( a != b )                                                                               \
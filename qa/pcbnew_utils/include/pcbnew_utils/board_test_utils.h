@@ -38,6 +38,7 @@
 #include <core/typeinfo.h>
 #include <tool/tool_manager.h>
 
+class ADVANCED_CFG;
 class BOARD;
 class BOARD_ITEM;
 class FOOTPRINT;
@@ -235,6 +236,13 @@ void LoadAndTestFootprintFile( const wxString& aLibRelativePath, const wxString&
 void FillZones( BOARD* m_board );
 
 
+/**
+ * Get a writable reference to the advanced settings, so that a test can override one of them
+ * for its own scope with a SCOPED_SET_RESET.
+ */
+ADVANCED_CFG& WritableAdvancedCfg();
+
+
 /**
  * Helper method to check if two footprints are semantically the same.
  */
@@ -0,0 +1,125 @@
+#
+# This program source code file is part of KiCad, a free EDA CAD application.
+#
+# Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+#
+#  This program is free software; you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation; either version 2 of the License, or
+#  (at your option) any later version.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program; if not, write to the Free Software
+#  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+#  MA 02110-1301, USA.
+#
+
+import utils
+import json
+import re
+import shutil
+from pathlib import Path
+from typing import Dict
+
+
+def write_jobset( jobset_path: Path, output_path: Path ) -> None:
+    # Schematic and board jobs alternate, so that with --parallel the drawing sheet users of
+    # both editors run at the same time as each other and as the document loads.  The board
+    # outputs after DRC only read the board, so they run side by side once DRC has finished.
+    jobs = [
+        { "id": "sch_svg", "type": "sch_export_plot_svg", "description": "",
+          "settings": { "format": "svg", "plot_drawing_sheet": True } },
+        { "id": "pcb_svg", "type": "pcb_export_svg", "description": "",
+          "settings": { "layers": [ "F.Cu", "Edge.Cuts" ], "plot_drawing_sheet": True,
+                        "gen_mode": "single", "output_filename": "board.svg" } },
+        { "id": "sch_netlist", "type": "sch_export_netlist", "description": "",
+          "settings": {} },
+        { "id": "pcb_drc", "type": "pcb_drc", "description": "",
+          "settings": {} },
+        { "id": "pcb_gerbers", "type": "pcb_export_gerbers", "description": "",
+          "settings": {} },
+        { "id": "pcb_drill", "type": "pcb_export_drill", "description": "",
+          "depends_on": [ "pcb_drc" ], "settings": {} },
+        { "id": "pcb_pos", "type": "pcb_export_pos", "description": "",
+          "depends_on": [ "sch_netlist" ], "settings": {} },
+        { "id": "sch_svg_custom_ds", "type": "sch_export_plot_svg", "description": "",
+          "settings": { "format": "svg", "plot_drawing_sheet": True,
+                        "drawing_sheet": "custom_ds.kicad_wks", "output_dir": "custom_ds" } },
+        { "id": "pcb_svg_custom_ds", "type": "pcb_export_svg", "description": "",
+          "settings": { "layers": [ "B.Cu", "Edge.Cuts" ], "plot_drawing_sheet": True,
+                        "gen_mode": "single", "drawing_sheet": "custom_ds.kicad_wks",
+                        "output_filename": "board_custom_ds.svg" } }
+    ]
+
+    jobset = {
+        "meta": { "version": 1 },
+        "jobs": jobs,
+        "outputs": [
+            { "id": "folder", "type": "folder", "only": [], "description": "",
+              "settings": { "output_path": str( output_path ) } }
+        ]
+    }
+
+    with open( jobset_path, "w" ) as f:
+        json.dump( jobset, f, indent=2 )
+
+
+def read_outputs( output_path: Path ) -> Dict[str, str]:
+    outputs = {}
+
+    for path in sorted( output_path.rglob( "*" ) ):
+        if path.is_file():
+            text = path.read_text( errors="replace" )
+
+            # Plot dates differ between runs
+            text = re.sub( r"<title>.*</title>", "", text )
+            text = re.sub( r"^;.*$", "", text, flags=re.MULTILINE )
+            text = re.sub( r"\(date .*", "", text )
+            text = re.sub( r"^(G04 Created by|%TF.CreationDate).*$", "", text, flags=re.MULTILINE )
+            text = re.sub( r"\"CreationDate\": \".*\"", "", text )
+            text = re.sub( r"created on .*", "", text, flags=re.IGNORECASE )
+            outputs[ str( path.relative_to( output_path ) ) ] = text
+
+    return outputs
+
+
+def test_jobset_parallel_matches_sequential( kitest ):
+    project_dir = kitest.get_output_path( "cli/jobset_parallel/project/" )
+    source_dir = Path( kitest.get_data_file_path( "cli/basic_test" ) )
+
+    for source in source_dir.glob( "basic_test.kicad_*" ):
+        shutil.copy( source, project_dir )
+
+    shutil.copy( source_dir / "custom_ds.kicad_wks", project_dir )
+
+    results = {}
+
+    for mode, extra_args in [ ( "sequential", [] ), ( "parallel", [ "--parallel" ] ) ]:
+        output_path = kitest.get_output_path( "cli/jobset_parallel/{}/".format( mode ) )
+        jobset_path = project_dir / "{}.kicad_jobset".format( mode )
+
+        write_jobset( jobset_path, output_path )
+
+        command = [utils.kicad_cli(), "jobset", "run", "--file", str( jobset_path ),
+                   "--stop-on-error"]
+        command.extend( extra_args )
+        command.append( str( project_dir / "basic_test.kicad_pro" ) )
+
+        stdout, stderr, exitcode = utils.run_and_capture( command )
+
+        assert exitcode == 0
+        assert stdout is not None
+        assert "9 jobs succeeded" in stdout
+
+        results[mode] = read_outputs( output_path )
+
+    assert len( results["sequential"] ) > 0
+    assert results["parallel"].keys() == results["sequential"].keys()
+
+    for name, text in results["sequential"].items():
+        assert results["parallel"][name] == text, name
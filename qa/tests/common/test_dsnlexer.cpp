@@ -0,0 +1,195 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file
+ * Test suite for the DSN lexer and its keyword lookup
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+// Code under test
+#include <dsnlexer.h>
+
+#include <string>
+#include <vector>
+
+#include <wx/ffile.h>
+#include <wx/filename.h>
+
+
+namespace
+{
+
+/// A keyword table like the ones generated by CMake, sorted and numbered from zero
+const KEYWORD keywords[] = {
+    { "arc", 0 },
+    { "at", 1 },
+    { "footprint", 2 },
+    { "layer", 3 },
+    { "net", 4 },
+    { "pad", 5 },
+    { "segment", 6 },
+    { "uuid", 7 },
+    { "via", 8 },
+    { "width", 9 }
+};
+
+const unsigned keywordCount = sizeof( keywords ) / sizeof( keywords[0] );
+
+} // namespace
+
+
+BOOST_AUTO_TEST_SUITE( DsnLexer )
+
+
+/**
+ * Every keyword must be found, and nothing else.
+ */
+BOOST_AUTO_TEST_CASE( KeywordPerfectHash )
+{
+    KEYWORD_PERFECT_HASH hash( keywords, keywordCount );
+
+    for( const KEYWORD& keyword : keywords )
+        BOOST_CHECK_EQUAL( hash.Find( keyword.name ), keyword.token );
+
+    for( const char* text : { "", "a", "ar", "arcs", "Layer", "layers", "vias", "width " } )
+    {
+        BOOST_TEST_CONTEXT( text )
+        {
+            BOOST_CHECK_EQUAL( hash.Find( text ), -1 );
+        }
+    }
+
+    // A table as large as the board keywords
+    std::vector<std::string> names;
+    std::vector<KEYWORD>     large;
+
+    for( int ii = 0; ii < 1000; ++ii )
+        names.push_back( "keyword_" + std::to_string( ii ) );
+
+    for( int ii = 0; ii < 1000; ++ii )
+        large.push_back( { names[ii].c_str(), ii } );
+
+    KEYWORD_PERFECT_HASH largeHash( large.data(), large.size() );
+
+    for( const KEYWORD& keyword : large )
+        BOOST_CHECK_EQUAL( largeHash.Find( keyword.name ), keyword.token );
+
+    BOOST_CHECK_EQUAL( largeHash.Find( "keyword_1000" ), -1 );
+
+    KEYWORD_PERFECT_HASH empty( nullptr, 0 );
+    BOOST_CHECK_EQUAL( empty.Find( "arc" ), -1 );
+}
+
+
+/**
+ * Lines of a mapped file are tokenized where they are rather than copied.  The tokens, their
+ * positions and the lines reported in errors must be the same as when tokenizing a copy.
+ */
+BOOST_AUTO_TEST_CASE( MappedFileTokensMatchString )
+{
+    const std::string contents = "(footprint \"R1\" (at 1.5 -2e3)\n"
+                                 "  # a comment ) with \"a quote\n"
+                                 "  (pad \"1\" (net 4 \"a \\\"quoted\\\" \\x41\\101 name\")\n"
+                                 "    (layer F.Cu) (uuid abc-123)|)\n"
+                                 "\n"
+                                 "  (width 0.25) symbol)";
+
+    wxString fileName = wxFileName::CreateTempFileName( wxS( "dsnlexer" ) );
+
+    {
+        wxFFile file( fileName, wxS( "wb" ) );
+        BOOST_REQUIRE( file.IsOpened() );
+        file.Write( contents.data(), contents.size() );
+    }
+
+    KEYWORD_PERFECT_HASH hash( keywords, keywordCount );
+
+    {
+        MAPPED_FILE_LINE_READER reader( fileName );
+        DSNLEXER                mapped( keywords, keywordCount, &hash, &reader );
+        DSNLEXER                copied( keywords, keywordCount, &hash, contents );
+
+        int tokens = 0;
+
+        for( ;; )
+        {
+            int tok = mapped.NextTok();
+
+            BOOST_REQUIRE_EQUAL( tok, copied.NextTok() );
+
+            if( tok == DSN_EOF )
+                break;
+
+            ++tokens;
+
+            BOOST_TEST_CONTEXT( copied.CurStr() )
+            {
+                BOOST_CHECK_EQUAL( mapped.CurStr(), copied.CurStr() );
+                BOOST_CHECK( mapped.CurView() == copied.CurView() );
+                BOOST_CHECK_EQUAL( mapped.CurLineNumber(), copied.CurLineNumber() );
+                BOOST_CHECK_EQUAL( mapped.CurOffset(), copied.CurOffset() );
+                BOOST_CHECK_EQUAL( std::string( mapped.CurLine() ),
+                                   std::string( copied.CurLine() ) );
+            }
+
+            if( tok == DSN_STRING && copied.CurStr().find( "quoted" ) != std::string::npos )
+                BOOST_CHECK_EQUAL( mapped.CurStr(), "a \"quoted\" AA name" );
+        }
+
+        BOOST_CHECK_EQUAL( tokens, 32 );
+    }
+
+    // An error reports the line it is on, although mapped lines aren't copied
+    {
+        wxFFile file( fileName, wxS( "wb" ) );
+        BOOST_REQUIRE( file.IsOpened() );
+        file.Write( wxS( "(net 1)\n(net \"unterminated)\n(net 2)\n" ) );
+    }
+
+    {
+        MAPPED_FILE_LINE_READER reader( fileName );
+        DSNLEXER                mapped( keywords, keywordCount, &hash, &reader );
+        bool                    thrown = false;
+
+        try
+        {
+            while( mapped.NextTok() != DSN_EOF )
+                ;
+        }
+        catch( const PARSE_ERROR& error )
+        {
+            thrown = true;
+            BOOST_CHECK_EQUAL( error.lineNumber, 2 );
+            BOOST_CHECK_EQUAL( error.inputLine, "(net \"unterminated)\n" );
+        }
+
+        BOOST_CHECK( thrown );
+    }
+
+    wxRemoveFile( fileName );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,112 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <plotters/plotter_gerber.h>
+
+#include <vector>
+
+
+BOOST_AUTO_TEST_SUITE( GerberApertures )
+
+
+BOOST_AUTO_TEST_CASE( SizedApertures )
+{
+    GERBER_PLOTTER plotter;
+
+    int circle = plotter.GetOrCreateAperture( VECTOR2I( 100, 100 ), 0, ANGLE_0,
+                                              APERTURE::AT_CIRCLE, 0, "" );
+    int rect = plotter.GetOrCreateAperture( VECTOR2I( 100, 100 ), 0, ANGLE_0,
+                                            APERTURE::AT_RECT, 0, "" );
+    int rotated = plotter.GetOrCreateAperture( VECTOR2I( 100, 200 ), 10, ANGLE_90,
+                                               APERTURE::AM_ROUND_RECT, 0, "" );
+
+    BOOST_CHECK_NE( circle, rect );
+    BOOST_CHECK_NE( rect, rotated );
+
+    // The same parameters find the same aperture, whatever was added in between
+    BOOST_CHECK_EQUAL( plotter.GetOrCreateAperture( VECTOR2I( 100, 100 ), 0, ANGLE_0,
+                                                    APERTURE::AT_CIRCLE, 0, "" ),
+                       circle );
+    BOOST_CHECK_EQUAL( plotter.GetOrCreateAperture( VECTOR2I( 100, 200 ), 10, ANGLE_90,
+                                                    APERTURE::AM_ROUND_RECT, 0, "" ),
+                       rotated );
+
+    // Any difference in the parameters is a new aperture
+    BOOST_CHECK_NE( plotter.GetOrCreateAperture( VECTOR2I( 100, 100 ), 0, ANGLE_0,
+                                                 APERTURE::AT_CIRCLE, 1, "" ),
+                    circle );
+    BOOST_CHECK_NE( plotter.GetOrCreateAperture( VECTOR2I( 100, 100 ), 0, ANGLE_0,
+                                                 APERTURE::AT_CIRCLE, 0, "custom" ),
+                    circle );
+    BOOST_CHECK_NE( plotter.GetOrCreateAperture( VECTOR2I( 100, 200 ), 10, ANGLE_45,
+                                                 APERTURE::AM_ROUND_RECT, 0, "" ),
+                    rotated );
+}
+
+
+/**
+ * Corner lists match when their corners are within a couple of IU, including when the first
+ * corners are either side of a hash cell boundary.
+ */
+BOOST_AUTO_TEST_CASE( CornerApertures )
+{
+    GERBER_PLOTTER plotter;
+
+    auto polygon =
+            []( int aX, int aY )
+            {
+                return std::vector<VECTOR2I>{ { aX, aY },
+                                              { aX + 1000, aY },
+                                              { aX + 1000, aY + 500 },
+                                              { aX, aY + 700 } };
+            };
+
+    for( int x : { -9, -1, 0, 7, 8, 1000 } )
+    {
+        BOOST_TEST_CONTEXT( "First corner at x = " << x )
+        {
+            int base = plotter.GetOrCreateAperture( polygon( x, 3 ), ANGLE_0,
+                                                    APERTURE::AM_FREE_POLYGON, 0, "" );
+
+            for( int dx : { -2, -1, 1, 2 } )
+            {
+                BOOST_CHECK_EQUAL( plotter.GetOrCreateAperture( polygon( x + dx, 3 ), ANGLE_0,
+                                                                APERTURE::AM_FREE_POLYGON, 0,
+                                                                "" ),
+                                   base );
+            }
+
+            BOOST_CHECK_NE( plotter.GetOrCreateAperture( polygon( x + 5000, 3 ), ANGLE_0,
+                                                         APERTURE::AM_FREE_POLYGON, 0, "" ),
+                            base );
+            BOOST_CHECK_NE( plotter.GetOrCreateAperture( polygon( x, 3 ), ANGLE_90,
+                                                         APERTURE::AM_FREE_POLYGON, 0, "" ),
+                            base );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -28,6 +28,10 @@
 
 #include <qa_utils/wx_utils/unit_test_utils.h>
 
+#include <clocale>
+
+#include <richio.h>
+
 // Code under test
 #include <string_utils.h>
 
@@ -142,6 +146,56 @@ BOOST_AUTO_TEST_CASE( Double2Str )
 }
 
 
+/**
+ * Test #ParseCDouble and #CLocaleVsnprintf, through STRING_FORMATTER, in a locale which uses
+ * a comma as the decimal separator.
+ */
+BOOST_AUTO_TEST_CASE( CLocaleNumbers )
+{
+    std::string previous = setlocale( LC_NUMERIC, nullptr );
+
+    // Not every system has these locales; the checks still hold in the "C" locale
+    if( !setlocale( LC_NUMERIC, "de_DE.UTF-8" ) )
+        setlocale( LC_NUMERIC, "fr_FR.UTF-8" );
+
+    using CASE = std::pair<std::string, double>;
+
+    const std::vector<CASE> cases = {
+        { "1.5", 1.5 },
+        { "  -0.25", -0.25 },
+        { "1e3", 1000.0 },
+        { "42", 42.0 },
+    };
+
+    for( const auto& [text, expected] : cases )
+    {
+        double      value = 0.0;
+        const char* end = ParseCDouble( text.data(), text.data() + text.size(), value );
+
+        BOOST_CHECK( end == text.data() + text.size() );
+        BOOST_CHECK_EQUAL( value, expected );
+    }
+
+    double      value = 0.0;
+    std::string partial = "2.5)";
+
+    BOOST_CHECK( ParseCDouble( partial.data(), partial.data() + partial.size(), value )
+                 == partial.data() + 3 );
+    BOOST_CHECK_EQUAL( value, 2.5 );
+
+    std::string notANumber = "abc";
+    BOOST_CHECK( ParseCDouble( notANumber.data(), notANumber.data() + notANumber.size(), value )
+                 == nullptr );
+
+    STRING_FORMATTER formatter;
+    formatter.Print( "(%g %0.4f)", 1.5, 0.25 );
+
+    BOOST_CHECK_EQUAL( formatter.GetString(), "(1.5 0.2500)" );
+
+    setlocale( LC_NUMERIC, previous.c_str() );
+}
+
+
 /**
  * Test #EscapeHTML and #UnescapeHTML methods.
  */
@@ -31,6 +31,9 @@
 // Code under test
 #include <richio.h>
 
+#include <wx/ffile.h>
+#include <wx/filename.h>
+
 /**
  * Declare the test suite
  */
@@ -80,4 +83,62 @@ BOOST_AUTO_TEST_CASE( VPrint )
     output.clear();
 }
 
+/**
+ * Check that #MAPPED_FILE_LINE_READER returns the same lines as #FILE_LINE_READER.
+ */
+BOOST_AUTO_TEST_CASE( MappedFileLineReader )
+{
+    const std::string contents = "(kicad_pcb\n\n  (version 20240108)\n  \"a string\")\nno newline";
+    wxString          fileName = wxFileName::CreateTempFileName( wxS( "richio" ) );
+
+    {
+        wxFFile file( fileName, wxS( "wb" ) );
+        BOOST_REQUIRE( file.IsOpened() );
+        file.Write( contents.data(), contents.size() );
+    }
+
+    {
+        FILE_LINE_READER        fileReader( fileName );
+        MAPPED_FILE_LINE_READER mappedReader( fileName );
+
+        BOOST_CHECK_EQUAL( mappedReader.CountLines(), 5u );
+        BOOST_CHECK_EQUAL( mappedReader.FileLength(), contents.size() );
+
+        for( ;; )
+        {
+            char* expected = fileReader.ReadLine();
+            char* line = mappedReader.ReadLine();
+
+            BOOST_REQUIRE_EQUAL( !expected, !line );
+            BOOST_CHECK_EQUAL( mappedReader.LineNumber(), fileReader.LineNumber() );
+
+            if( !line )
+                break;
+
+            BOOST_CHECK_EQUAL( std::string( line ), std::string( expected ) );
+            BOOST_CHECK_EQUAL( mappedReader.Length(), fileReader.Length() );
+        }
+
+        mappedReader.Rewind();
+        BOOST_CHECK_EQUAL( std::string( mappedReader.ReadLine() ), "(kicad_pcb\n" );
+        BOOST_CHECK_EQUAL( mappedReader.LineNumber(), 1u );
+    }
+
+    // Empty files can't be mapped but must still read as empty
+    {
+        wxFFile file( fileName, wxS( "wb" ) );
+    }
+
+    {
+        MAPPED_FILE_LINE_READER mappedReader( fileName );
+
+        BOOST_CHECK_EQUAL( mappedReader.CountLines(), 0u );
+        BOOST_CHECK( !mappedReader.ReadLine() );
+    }
+
+    wxRemoveFile( fileName );
+
+    BOOST_CHECK_THROW( MAPPED_FILE_LINE_READER reader( fileName ), IO_ERROR );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -0,0 +1,170 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <core/sharded_cache.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+
+BOOST_AUTO_TEST_SUITE( ShardedCache )
+
+
+BOOST_AUTO_TEST_CASE( GetSetClear )
+{
+    SHARDED_CACHE<int, int> cache;
+    int                     value = 0;
+
+    BOOST_CHECK( cache.Empty() );
+    BOOST_CHECK( !cache.Get( 1, value ) );
+
+    cache.Set( 1, 10 );
+    cache.Set( 2, 20 );
+    cache.Set( 1, 11 );
+
+    BOOST_CHECK_EQUAL( cache.Size(), 2u );
+    BOOST_CHECK( cache.Get( 1, value ) );
+    BOOST_CHECK_EQUAL( value, 11 );
+    BOOST_CHECK( cache.Get( 2, value ) );
+    BOOST_CHECK_EQUAL( value, 20 );
+
+    cache.Clear();
+
+    BOOST_CHECK( cache.Empty() );
+    BOOST_CHECK( !cache.Get( 1, value ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( GetOrCompute )
+{
+    SHARDED_CACHE<int, int> cache;
+    int                     calls = 0;
+    bool                    hit = true;
+
+    auto compute =
+            [&]()
+            {
+                calls++;
+                return 42;
+            };
+
+    BOOST_CHECK_EQUAL( cache.GetOrCompute( 7, compute, &hit ), 42 );
+    BOOST_CHECK( !hit );
+    BOOST_CHECK_EQUAL( cache.GetOrCompute( 7, compute, &hit ), 42 );
+    BOOST_CHECK( hit );
+    BOOST_CHECK_EQUAL( calls, 1 );
+}
+
+
+BOOST_AUTO_TEST_CASE( ConcurrentAccess )
+{
+    SHARDED_CACHE<int, int>  cache;
+    std::vector<std::thread> threads;
+    const int                count = 10000;
+
+    for( int t = 0; t < 8; ++t )
+    {
+        threads.emplace_back(
+                [&]()
+                {
+                    for( int ii = 0; ii < count; ++ii )
+                        cache.GetOrCompute( ii, [ii]() { return ii * 2; } );
+                } );
+    }
+
+    for( std::thread& thread : threads )
+        thread.join();
+
+    BOOST_CHECK_EQUAL( cache.Size(), static_cast<size_t>( count ) );
+
+    for( int ii = 0; ii < count; ++ii )
+    {
+        int value = 0;
+        BOOST_REQUIRE( cache.Get( ii, value ) );
+        BOOST_CHECK_EQUAL( value, ii * 2 );
+    }
+}
+
+
+/**
+ * A cache with a maximum size must stay within it, and must keep the entries still in use.
+ */
+BOOST_AUTO_TEST_CASE( BoundedSize )
+{
+    const size_t                maxSize = 1280;
+    SHARDED_CACHE<int, int>     cache( maxSize );
+    std::vector<std::thread>    threads;
+    std::atomic<int>            hotMisses( 0 );
+    std::atomic<int>            wrongValues( 0 );
+
+    for( int t = 0; t < 4; ++t )
+    {
+        threads.emplace_back(
+                [&, t]()
+                {
+                    for( int ii = 0; ii < 20000; ++ii )
+                    {
+                        int  key = t * 100000 + ii;
+                        bool hit = false;
+
+                        if( cache.GetOrCompute( key, [key]() { return key * 2; } ) != key * 2 )
+                            wrongValues++;
+
+                        // A few keys are used over and over again
+                        int hotKey = -( ii % 8 ) - 1;
+
+                        cache.GetOrCompute( hotKey, [hotKey]() { return hotKey * 2; }, &hit );
+
+                        if( !hit && ii > 8 )
+                            hotMisses++;
+                    }
+                } );
+    }
+
+    for( std::thread& thread : threads )
+        thread.join();
+
+    BOOST_CHECK_LE( cache.Size(), maxSize );
+    BOOST_CHECK_EQUAL( hotMisses.load(), 0 );
+    BOOST_CHECK_EQUAL( wrongValues.load(), 0 );
+
+    int value = 0;
+
+    BOOST_CHECK( !cache.Get( 0, value ) );
+    BOOST_CHECK( cache.Get( 3 * 100000 + 19999, value ) );
+    BOOST_CHECK_EQUAL( value, ( 3 * 100000 + 19999 ) * 2 );
+
+    cache.Set( 3 * 100000 + 19999, 5 );
+    BOOST_CHECK( cache.Get( 3 * 100000 + 19999, value ) );
+    BOOST_CHECK_EQUAL( value, 5 );
+    BOOST_CHECK_LE( cache.Size(), maxSize );
+
+    cache.Clear();
+    BOOST_CHECK( cache.Empty() );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,211 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file
+ * Test suite for the persistent symbol library index.
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <filesystem>
+
+#include <lib_symbol.h>
+#include <paths.h>
+#include <symbol_index_entry.h>
+#include <sch_io/kicad_sexpr/sch_io_kicad_sexpr.h>
+#include <sch_io/kicad_sexpr/sch_io_kicad_sexpr_lib_index.h>
+
+#include <wx/dir.h>
+#include <wx/filename.h>
+#include <wx/utils.h>
+
+
+static wxString testLibraryPath()
+{
+    return wxString::FromUTF8( KI_TEST::GetEeschemaTestDataDir() )
+           + wxS( "spice_netlists/legacy_pspice/schematic_libspice.kicad_sym" );
+}
+
+
+BOOST_AUTO_TEST_SUITE( SchIoKicadSexprLibIndex )
+
+
+/**
+ * The index must describe the same symbols as a full load of the library.
+ */
+BOOST_AUTO_TEST_CASE( EntriesMatchLibrary )
+{
+    const wxString path = testLibraryPath();
+
+    SCH_IO_KICAD_SEXPR       fullPlugin;
+    std::vector<LIB_SYMBOL*> symbols;
+
+    fullPlugin.EnumerateSymbolLib( symbols, path );
+
+    // Once to build the index if needed, and once more from the stored index
+    for( int pass = 0; pass < 2; ++pass )
+    {
+        SCH_IO_KICAD_SEXPR              indexPlugin;
+        std::vector<SYMBOL_INDEX_ENTRY> entries;
+
+        BOOST_REQUIRE( indexPlugin.EnumerateSymbolIndex( entries, path ) );
+        BOOST_REQUIRE_EQUAL( entries.size(), symbols.size() );
+
+        for( LIB_SYMBOL* symbol : symbols )
+        {
+            BOOST_TEST_CONTEXT( "Symbol " << symbol->GetName() )
+            {
+                auto it = std::find_if( entries.begin(), entries.end(),
+                                        [&]( SYMBOL_INDEX_ENTRY& aEntry )
+                                        {
+                                            return aEntry.GetName() == symbol->GetName();
+                                        } );
+
+                BOOST_REQUIRE( it != entries.end() );
+                BOOST_CHECK_EQUAL( it->GetDesc(), symbol->GetDescription() );
+                BOOST_CHECK_EQUAL( it->GetPinCount(), symbol->GetPinCount() );
+                BOOST_CHECK_EQUAL( it->GetSubUnitCount(), symbol->GetUnitCount() );
+                BOOST_CHECK_EQUAL( it->IsRoot(), symbol->IsRoot() );
+                BOOST_CHECK_EQUAL( it->m_IsPower, symbol->IsPower() );
+            }
+        }
+    }
+}
+
+
+/**
+ * Symbols loaded one at a time through the index must match those from a full load,
+ * including derived symbols.
+ */
+BOOST_AUTO_TEST_CASE( LazyLoadMatchesFullLoad )
+{
+    const wxString path = testLibraryPath();
+
+    SCH_IO_KICAD_SEXPR              indexPlugin;
+    std::vector<SYMBOL_INDEX_ENTRY> entries;
+
+    BOOST_REQUIRE( indexPlugin.EnumerateSymbolIndex( entries, path ) );
+
+    SCH_IO_KICAD_SEXPR lazyPlugin;
+    std::vector<SYMBOL_INDEX_ENTRY> lazyEntries;
+
+    // A fresh plugin reads the stored index and doesn't load the library
+    BOOST_REQUIRE( lazyPlugin.EnumerateSymbolIndex( lazyEntries, path ) );
+
+    SCH_IO_KICAD_SEXPR fullPlugin;
+
+    for( const SYMBOL_INDEX_ENTRY& entry : entries )
+    {
+        const wxString name = entry.GetName();
+
+        BOOST_TEST_CONTEXT( "Symbol " << name )
+        {
+            LIB_SYMBOL* lazy = lazyPlugin.LoadSymbol( path, name );
+            LIB_SYMBOL* full = fullPlugin.LoadSymbol( path, name );
+
+            BOOST_REQUIRE( lazy );
+            BOOST_REQUIRE( full );
+
+            BOOST_CHECK_EQUAL( lazy->GetName(), full->GetName() );
+            BOOST_CHECK_EQUAL( lazy->IsDerived(), full->IsDerived() );
+            BOOST_CHECK_EQUAL( lazy->GetPinCount(), full->GetPinCount() );
+            BOOST_CHECK_EQUAL( lazy->GetUnitCount(), full->GetUnitCount() );
+            BOOST_CHECK_EQUAL( lazy->GetDescription(), full->GetDescription() );
+            BOOST_CHECK_EQUAL( lazy->GetDrawItems().size(), full->GetDrawItems().size() );
+
+            if( full->IsDerived() )
+            {
+                LIB_SYMBOL_SPTR lazyParent = lazy->GetParent().lock();
+                LIB_SYMBOL_SPTR fullParent = full->GetParent().lock();
+
+                BOOST_REQUIRE( lazyParent );
+                BOOST_CHECK_EQUAL( lazyParent->GetName(), fullParent->GetName() );
+            }
+        }
+    }
+
+    BOOST_CHECK( lazyPlugin.LoadSymbol( path, wxS( "NoSuchSymbol" ) ) == nullptr );
+}
+
+
+/**
+ * Indexes which haven't been used for longer than the age limit are removed; those in use are
+ * kept.
+ */
+BOOST_AUTO_TEST_CASE( PruneRemovesOldIndexes )
+{
+    namespace fs = std::filesystem;
+
+    wxString tmpName = wxFileName::CreateTempFileName( wxS( "symbol_index" ) );
+    wxRemoveFile( tmpName );
+
+    fs::path tempDir( tmpName.ToStdString() );
+    fs::create_directories( tempDir );
+
+    // Keep the user's own indexes out of the test
+    wxString cacheHome;
+    bool     hadCacheHome = wxGetEnv( wxS( "KICAD_CACHE_HOME" ), &cacheHome );
+    wxSetEnv( wxS( "KICAD_CACHE_HOME" ), wxString( tempDir.string() ) );
+
+    auto indexFiles =
+            []()
+            {
+                wxFileName dir;
+                dir.AssignDir( PATHS::GetUserCachePath() );
+                dir.AppendDir( wxS( "symbol_index" ) );
+
+                wxArrayString files;
+
+                if( dir.DirExists() )
+                    wxDir::GetAllFiles( dir.GetPath(), &files, wxS( "*.idx" ), wxDIR_FILES );
+
+                return files;
+            };
+
+    SCH_IO_KICAD_SEXPR              plugin;
+    std::vector<SYMBOL_INDEX_ENTRY> entries;
+
+    BOOST_CHECK( plugin.EnumerateSymbolIndex( entries, testLibraryPath() ) );
+
+    wxArrayString files = indexFiles();
+    BOOST_CHECK_EQUAL( files.size(), 1 );
+
+    SCH_IO_KICAD_SEXPR_LIB_INDEX::Prune( 60 );
+    BOOST_CHECK_EQUAL( indexFiles().size(), files.size() );
+
+    wxDateTime old = wxDateTime::Now() - wxDateSpan::Days( 90 );
+
+    for( const wxString& file : files )
+        BOOST_CHECK( wxFileName( file ).SetTimes( &old, &old, nullptr ) );
+
+    SCH_IO_KICAD_SEXPR_LIB_INDEX::Prune( 60 );
+    BOOST_CHECK_EQUAL( indexFiles().size(), 0 );
+
+    if( hadCacheHome )
+        wxSetEnv( wxS( "KICAD_CACHE_HOME" ), cacheHome );
+    else
+        wxUnsetEnv( wxS( "KICAD_CACHE_HOME" ) );
+
+    std::error_code ec;
+    fs::remove_all( tempDir, ec );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -32,6 +32,8 @@
 #include <settings/settings_manager.h>
 #include <locale_io.h>
 
+#include <unordered_set>
+
 struct CONNECTIVITY_TEST_FIXTURE
 {
     CONNECTIVITY_TEST_FIXTURE() :
@@ -125,6 +127,12 @@ BOOST_FIXTURE_TEST_CASE( RemoveAddItems, CONNECTIVITY_TEST_FIXTURE )
                     alg::remove_duplicates( prev_items );
 
 
+                    // Same steps as SCH_EDIT_FRAME::RecalculateConnections(): the net codes are
+                    // taken over before the affected nets are removed from the graph
+                    CONNECTION_GRAPH new_graph( m_schematic.get() );
+
+                    new_graph.SetLastCodes( m_schematic->ConnectionGraph() );
+
                     std::set<std::pair<SCH_SHEET_PATH, SCH_ITEM*>> all_items =
                             m_schematic->ConnectionGraph()->ExtractAffectedItems( { item } );
                     all_items.insert( { path, item } );
@@ -133,17 +141,23 @@ BOOST_FIXTURE_TEST_CASE( RemoveAddItems, CONNECTIVITY_TEST_FIXTURE )
                                                            << " in net " << netname.ToStdString()
                                                            << " has " << all_items.size() << " affected items" );
 
-                    CONNECTION_GRAPH new_graph( m_schematic.get() );
-
-                    new_graph.SetLastCodes( m_schematic->ConnectionGraph() );
+                    std::unordered_set<SCH_SCREEN*> affectedScreens;
+                    SCH_SHEET_LIST                  affectedSheets;
 
                     for( auto&[ path, item ] : all_items )
                     {
                         wxCHECK2( item, continue );
                         item->SetConnectivityDirty();
+                        affectedScreens.insert( path.LastScreen() );
+                    }
+
+                    for( const SCH_SHEET_PATH& sheet : sheets )
+                    {
+                        if( affectedScreens.contains( sheet.LastScreen() ) )
+                            affectedSheets.push_back( sheet );
                     }
 
-                    new_graph.Recalculate( sheets, false );
+                    new_graph.Recalculate( affectedSheets, false );
                     m_schematic->ConnectionGraph()->Merge( new_graph );
 
                     SCH_ITEM_VEC curr_items = item->ConnectedItems( path );
@@ -156,6 +170,17 @@ BOOST_FIXTURE_TEST_CASE( RemoveAddItems, CONNECTIVITY_TEST_FIXTURE )
                                                             << " in net " << netname.ToStdString()
                                                             << " changed from " << prev_items.size()
                                                             << " to " << curr_items.size() << " Location:" << item->GetPosition().x << "," << item->GetPosition().y );
+
+                    // Every item must be left on the net a full rebuild puts it on
+                    CONNECTION_GRAPH::ITEM_NET_NAMES incremental =
+                            m_schematic->ConnectionGraph()->GetItemNetNames();
+
+                    m_schematic->ConnectionGraph()->Recalculate( sheets, true );
+
+                    BOOST_CHECK_EQUAL( CONNECTION_GRAPH::CompareItemNetNames(
+                                               incremental,
+                                               m_schematic->ConnectionGraph()->GetItemNetNames() ),
+                                       0 );
                 }
 
             }
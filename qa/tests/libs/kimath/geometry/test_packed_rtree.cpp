@@ -0,0 +1,244 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <climits>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <geometry/packed_rtree.h>
+
+
+namespace
+{
+
+struct TEST_BOX
+{
+    int min[2];
+    int max[2];
+};
+
+
+bool overlaps( const TEST_BOX& aBox, const int aMin[2], const int aMax[2] )
+{
+    return aBox.min[0] <= aMax[0] && aBox.max[0] >= aMin[0]
+           && aBox.min[1] <= aMax[1] && aBox.max[1] >= aMin[1];
+}
+
+} // namespace
+
+
+BOOST_AUTO_TEST_SUITE( PackedRTree )
+
+
+BOOST_AUTO_TEST_CASE( Empty )
+{
+    PACKED_RTREE<int> tree;
+    const int         min[2] = { INT_MIN, INT_MIN };
+    const int         max[2] = { INT_MAX, INT_MAX };
+
+    BOOST_CHECK( tree.empty() );
+    BOOST_CHECK_EQUAL( tree.Search( min, max, []( int ) { return true; } ), 0 );
+}
+
+
+/**
+ * Searches must find exactly the boxes that a linear scan finds, both from the packed tree
+ * and from items inserted after it was built.
+ */
+BOOST_AUTO_TEST_CASE( SearchMatchesScan )
+{
+    std::minstd_rand rng( 1234 );
+
+    auto coord =
+            [&]( int aRange )
+            {
+                return static_cast<int>( rng() % aRange ) - aRange / 2;
+            };
+
+    for( int count : { 1, 10, 100, 2000 } )
+    {
+        BOOST_TEST_CONTEXT( count << " items" )
+        {
+            PACKED_RTREE<int>     tree;
+            std::vector<TEST_BOX> boxes;
+
+            auto insert =
+                    [&]()
+                    {
+                        TEST_BOX box;
+                        box.min[0] = coord( 1000000 );
+                        box.min[1] = coord( 1000000 );
+                        box.max[0] = box.min[0] + static_cast<int>( rng() % 20000 );
+                        box.max[1] = box.min[1] + static_cast<int>( rng() % 20000 );
+
+                        tree.Insert( box.min, box.max, static_cast<int>( boxes.size() ) );
+                        boxes.push_back( box );
+                    };
+
+            for( int ii = 0; ii < count; ++ii )
+                insert();
+
+            // Search, then grow the overlay enough to force a rebuild and search again
+            for( int pass = 0; pass < 3; ++pass )
+            {
+                for( int query = 0; query < 200; ++query )
+                {
+                    int min[2] = { coord( 1200000 ), coord( 1200000 ) };
+                    int max[2] = { min[0] + static_cast<int>( rng() % 100000 ),
+                                   min[1] + static_cast<int>( rng() % 100000 ) };
+
+                    std::set<int> expected;
+                    std::set<int> found;
+
+                    for( size_t ii = 0; ii < boxes.size(); ++ii )
+                    {
+                        if( overlaps( boxes[ii], min, max ) )
+                            expected.insert( static_cast<int>( ii ) );
+                    }
+
+                    int visited = tree.Search( min, max,
+                                               [&]( int aItem )
+                                               {
+                                                   found.insert( aItem );
+                                                   return true;
+                                               } );
+
+                    BOOST_CHECK( found == expected );
+                    BOOST_CHECK_EQUAL( visited, static_cast<int>( found.size() ) );
+                }
+
+                for( int ii = 0; ii < count / 4 + 40; ++ii )
+                    insert();
+            }
+
+            BOOST_CHECK_EQUAL( tree.size(), boxes.size() );
+            BOOST_CHECK_EQUAL( std::distance( tree.begin(), tree.end() ),
+                               static_cast<long>( boxes.size() ) );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( StopsWhenVisitorReturnsFalse )
+{
+    PACKED_RTREE<int> tree;
+
+    for( int ii = 0; ii < 500; ++ii )
+    {
+        const int min[2] = { ii * 10, 0 };
+        const int max[2] = { ii * 10 + 5, 5 };
+        tree.Insert( min, max, ii );
+    }
+
+    const int min[2] = { INT_MIN, INT_MIN };
+    const int max[2] = { INT_MAX, INT_MAX };
+
+    BOOST_CHECK_EQUAL( tree.Search( min, max, []( int ) { return false; } ), 1 );
+
+    tree.RemoveAll();
+    BOOST_CHECK( tree.empty() );
+    BOOST_CHECK_EQUAL( tree.Search( min, max, []( int ) { return true; } ), 0 );
+}
+
+
+/**
+ * Iterating must see each item once, even when searches are made during the iteration and
+ * the tree has not been built yet.
+ */
+BOOST_AUTO_TEST_CASE( IterateWhileSearching )
+{
+    const int min[2] = { INT_MIN, INT_MIN };
+    const int max[2] = { INT_MAX, INT_MAX };
+
+    auto fill =
+            []( PACKED_RTREE<int>& aTree )
+            {
+                for( int ii = 0; ii < 1000; ++ii )
+                {
+                    const int itemMin[2] = { ( ii * 7919 ) % 10000, ( ii * 104729 ) % 10000 };
+                    const int itemMax[2] = { itemMin[0] + 50, itemMin[1] + 50 };
+                    aTree.Insert( itemMin, itemMax, ii );
+                }
+            };
+
+    {
+        PACKED_RTREE<int> tree;
+        std::set<int>     seen;
+
+        fill( tree );
+
+        for( int item : tree )
+        {
+            BOOST_CHECK_EQUAL( tree.Search( min, max, []( int ) { return true; } ), 1000 );
+            seen.insert( item );
+        }
+
+        BOOST_CHECK_EQUAL( seen.size(), 1000 );
+    }
+
+    // The first search on another thread must not rebuild the tree under the iteration
+    for( int pass = 0; pass < 20; ++pass )
+    {
+        PACKED_RTREE<int> tree;
+        std::set<int>     seen;
+        int               found = 0;
+
+        fill( tree );
+
+        std::thread searcher(
+                [&]()
+                {
+                    found = tree.Search( min, max, []( int ) { return true; } );
+                } );
+
+        for( int item : tree )
+            seen.insert( item );
+
+        searcher.join();
+
+        BOOST_CHECK_EQUAL( seen.size(), 1000 );
+        BOOST_CHECK_EQUAL( found, 1000 );
+    }
+
+    // Once built, the tree is not rebuilt by iterating or searching
+    {
+        PACKED_RTREE<int> tree;
+
+        fill( tree );
+        tree.Build();
+
+        PACKED_RTREE<int>::iterator first = tree.begin();
+        int                         firstItem = *first;
+
+        tree.Search( min, max, []( int ) { return true; } );
+
+        BOOST_CHECK( first == tree.begin() );
+        BOOST_CHECK_EQUAL( *tree.begin(), firstItem );
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
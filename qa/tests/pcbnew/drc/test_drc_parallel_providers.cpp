@@ -0,0 +1,129 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <pcbnew_utils/board_test_utils.h>
+#include <board.h>
+#include <board_design_settings.h>
+#include <pcb_track.h>
+#include <pcb_marker.h>
+#include <drc/drc_engine.h>
+#include <drc/drc_item.h>
+#include <settings/settings_manager.h>
+
+
+struct DRC_PARALLEL_PROVIDERS_TEST_FIXTURE
+{
+    DRC_PARALLEL_PROVIDERS_TEST_FIXTURE() :
+            m_settingsManager( true /* headless */ )
+    { }
+
+    SETTINGS_MANAGER       m_settingsManager;
+    std::unique_ptr<BOARD> m_board;
+};
+
+
+/**
+ * Providers run concurrently must report the same markers as providers run one after another,
+ * including when several providers raise the same error code and its error limit is reached.
+ */
+BOOST_FIXTURE_TEST_CASE( DRCParallelProvidersMatchSequential, DRC_PARALLEL_PROVIDERS_TEST_FIXTURE )
+{
+    for( const wxString& relPath : { "issue5854", "issue7267", "issue18878" } )
+    {
+        BOOST_TEST_CONTEXT( relPath )
+        {
+            KI_TEST::LoadBoard( m_settingsManager, relPath, m_board );
+
+            BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
+
+            bds.m_DRCSeverities[ DRCE_LIB_FOOTPRINT_ISSUES ] = SEVERITY::RPT_SEVERITY_IGNORE;
+            bds.m_DRCSeverities[ DRCE_LIB_FOOTPRINT_MISMATCH ] = SEVERITY::RPT_SEVERITY_IGNORE;
+
+            // A row of overlapping vias on alternating nets gives shorts, hole clearance and
+            // hole-to-hole violations from several providers, well past the error limits
+            NETINFO_ITEM* nets[2] = { new NETINFO_ITEM( m_board.get(), wxS( "PARALLEL_A" ) ),
+                                      new NETINFO_ITEM( m_board.get(), wxS( "PARALLEL_B" ) ) };
+
+            m_board->Add( nets[0] );
+            m_board->Add( nets[1] );
+
+            for( int ii = 0; ii < 600; ++ii )
+            {
+                PCB_VIA* via = new PCB_VIA( m_board.get() );
+
+                via->SetPosition( VECTOR2I( pcbIUScale.mmToIU( 0.4 * ii ),
+                                            pcbIUScale.mmToIU( -50 ) ) );
+                via->SetWidth( pcbIUScale.mmToIU( 0.6 ) );
+                via->SetDrill( pcbIUScale.mmToIU( 0.3 ) );
+                via->SetLayerPair( F_Cu, B_Cu );
+                via->SetNet( nets[ ii % 2 ] );
+                m_board->Add( via );
+            }
+
+            auto runDrc =
+                    [&]( bool aSequential )
+                    {
+                        std::map<int, std::vector<wxString>> markers;
+
+                        bds.m_DRCEngine->SetViolationHandler(
+                                [&]( const std::shared_ptr<DRC_ITEM>& aItem, VECTOR2I aPos,
+                                     int aLayer, DRC_CUSTOM_MARKER_HANDLER* aCustomHandler )
+                                {
+                                    markers[ aItem->GetErrorCode() ].push_back(
+                                            PCB_MARKER( aItem, aPos ).SerializeToString() );
+                                } );
+
+                        // Profiled runs always run the providers one after another
+                        bds.m_DRCEngine->SetProfiling( aSequential );
+                        bds.m_DRCEngine->RunTests( EDA_UNITS::MM, true, false );
+                        bds.m_DRCEngine->SetProfiling( false );
+                        bds.m_DRCEngine->ClearViolationHandler();
+
+                        for( auto& [code, codeMarkers] : markers )
+                            std::sort( codeMarkers.begin(), codeMarkers.end() );
+
+                        return markers;
+                    };
+
+            std::map<int, std::vector<wxString>> sequential = runDrc( true );
+            std::map<int, std::vector<wxString>> concurrent = runDrc( false );
+
+            BOOST_CHECK( bds.m_DRCEngine->IsErrorLimitExceeded( DRCE_SHORTING_ITEMS ) );
+            BOOST_CHECK_EQUAL( sequential.size(), concurrent.size() );
+
+            for( const auto& [code, codeMarkers] : sequential )
+            {
+                BOOST_TEST_CONTEXT( "error code " << code )
+                {
+                    BOOST_CHECK_EQUAL( codeMarkers.size(), concurrent[code].size() );
+
+                    // Past its limit, which violations of a code are kept depends on the order
+                    // in which a provider's own threads find them, even in a sequential run
+                    if( !bds.m_DRCEngine->IsErrorLimitExceeded( code ) )
+                        BOOST_CHECK( codeMarkers == concurrent[code] );
+                }
+            }
+        }
+    }
+}
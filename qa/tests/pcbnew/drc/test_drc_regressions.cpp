@@ -30,6 +30,7 @@
 #include <pcb_marker.h>
 #include <footprint.h>
 #include <drc/drc_item.h>
+#include <drc/drc_rule.h>
 #include <settings/settings_manager.h>
 #include <widgets/report_severity.h>
 
@@ -214,3 +215,45 @@ BOOST_FIXTURE_TEST_CASE( DRCFalseNegativeRegressions, DRC_REGRESSION_TEST_FIXTUR
         }
     }
 }
+
+
+BOOST_FIXTURE_TEST_CASE( DRCDisallowHolesInArea, DRC_REGRESSION_TEST_FIXTURE )
+{
+    // The disallow test checks each item and then its hole, with the same arguments to
+    // EvalRules().  The hole must not be given the item's resolved constraint.
+
+    KI_TEST::LoadBoard( m_settingsManager, "issue7567", m_board );
+
+    // Inside a "NoBottomFootprints" rule area, which allows vias but has a custom rule
+    // disallowing holes
+    PCB_VIA* via = new PCB_VIA( m_board.get() );
+
+    via->SetPosition( VECTOR2I( pcbIUScale.mmToIU( 105 ), pcbIUScale.mmToIU( 100 ) ) );
+    via->SetWidth( pcbIUScale.mmToIU( 0.6 ) );
+    via->SetDrill( pcbIUScale.mmToIU( 0.3 ) );
+    via->SetLayerPair( F_Cu, B_Cu );
+    m_board->Add( via );
+
+    std::vector<DRC_ITEM>  violations;
+    BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
+
+    bds.m_DRCSeverities[ DRCE_LIB_FOOTPRINT_ISSUES ] = SEVERITY::RPT_SEVERITY_IGNORE;
+    bds.m_DRCSeverities[ DRCE_LIB_FOOTPRINT_MISMATCH ] = SEVERITY::RPT_SEVERITY_IGNORE;
+
+    bds.m_DRCEngine->SetViolationHandler(
+            [&]( const std::shared_ptr<DRC_ITEM>& aItem, VECTOR2I aPos, int aLayer,
+                 DRC_CUSTOM_MARKER_HANDLER* aCustomHandler )
+            {
+                if( aItem->GetErrorCode() == DRCE_ALLOWED_ITEMS
+                        && aItem->GetMainItemID() == via->m_Uuid )
+                {
+                    violations.push_back( *aItem );
+                }
+            } );
+
+    bds.m_DRCEngine->RunTests( EDA_UNITS::MM, true, false );
+
+    BOOST_REQUIRE_EQUAL( violations.size(), 1 );
+    BOOST_REQUIRE( violations[0].GetViolatingRule() );
+    BOOST_CHECK( violations[0].GetViolatingRule()->m_Name == wxS( "keepout holes" ) );
+}
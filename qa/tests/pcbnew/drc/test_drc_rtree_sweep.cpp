@@ -0,0 +1,117 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <random>
+#include <set>
+
+#include <board.h>
+#include <pcb_track.h>
+#include <drc/drc_rtree.h>
+
+
+BOOST_AUTO_TEST_SUITE( DRCRtreeSweep )
+
+
+/**
+ * The sweep broad phase must find exactly the colliders that searching the tree once per item
+ * finds, for long and short items in both orientations.
+ */
+BOOST_AUTO_TEST_CASE( SweepMatchesQuery )
+{
+    BOARD            board;
+    DRC_RTREE        tree;
+    std::minstd_rand rng( 1234 );
+    const int        clearance = pcbIUScale.mmToIU( 0.2 );
+
+    auto coord =
+            [&]( double aMaxMm )
+            {
+                return pcbIUScale.mmToIU( aMaxMm * rng() / rng.max() );
+            };
+
+    for( int ii = 0; ii < 500; ++ii )
+    {
+        PCB_TRACK* track = new PCB_TRACK( &board );
+        VECTOR2I   start( coord( 50.0 ), coord( 50.0 ) );
+
+        // A mix of short stubs and long runs
+        VECTOR2I delta = ( ii % 5 == 0 ) ? VECTOR2I( coord( 40.0 ), coord( 2.0 ) )
+                                         : VECTOR2I( coord( 1.0 ), coord( 1.0 ) );
+
+        track->SetLayer( ii % 3 == 0 ? B_Cu : F_Cu );
+        track->SetWidth( pcbIUScale.mmToIU( 0.15 ) );
+        track->SetStart( start );
+        track->SetEnd( ( ii % 2 ) ? start + delta : start + VECTOR2I( delta.y, delta.x ) );
+        board.Add( track );
+
+        tree.Insert( track, track->GetLayer(), clearance );
+    }
+
+    // Only every other track is queried, so pairs of unqueried tracks must be left out
+    std::set<BOARD_ITEM*> queried;
+
+    for( size_t ii = 0; ii < board.Tracks().size(); ii += 2 )
+        queried.insert( board.Tracks()[ii] );
+
+    auto isQueried =
+            [&]( BOARD_ITEM* aItem )
+            {
+                return queried.count( aItem ) > 0;
+            };
+
+    for( PCB_LAYER_ID layer : { F_Cu, B_Cu } )
+    {
+        DRC_RTREE::SWEPT_PAIRS pairs = tree.SweepColliding( layer, clearance, isQueried );
+
+        for( BOARD_ITEM* item : queried )
+        {
+            if( !item->IsOnLayer( layer ) )
+                continue;
+
+            std::set<BOARD_ITEM*> expected;
+            std::set<BOARD_ITEM*> found;
+
+            tree.QueryColliding( item, layer, layer, nullptr,
+                                 [&]( BOARD_ITEM* aOther )
+                                 {
+                                     expected.insert( aOther );
+                                     return true;
+                                 },
+                                 clearance );
+
+            pairs.QueryColliding( item, layer, nullptr,
+                                  [&]( BOARD_ITEM* aOther )
+                                  {
+                                      found.insert( aOther );
+                                      return true;
+                                  },
+                                  clearance );
+
+            BOOST_CHECK( found == expected );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,102 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <map>
+#include <string>
+
+#include <pcbnew_utils/board_test_utils.h>
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <pcbnew/pcb_io/ipc2581/pcb_io_ipc2581.h>
+
+#include <board.h>
+#include <settings/settings_manager.h>
+
+#include <wx/ffile.h>
+#include <wx/filename.h>
+#include <wx/mstream.h>
+#include <wx/xml/xml.h>
+
+
+struct IPC2581_EXPORT_FIXTURE
+{
+    IPC2581_EXPORT_FIXTURE() :
+            m_settingsManager( true /* headless */ )
+    { }
+
+    SETTINGS_MANAGER       m_settingsManager;
+    std::unique_ptr<BOARD> m_board;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( Ipc2581Export, IPC2581_EXPORT_FIXTURE )
+
+
+/**
+ * The exporter writes its document with its own streaming writer, splicing in the layers it
+ * spooled to disk.  The file must be laid out exactly as wxXmlDocument::Save() lays out the
+ * same document.
+ */
+BOOST_AUTO_TEST_CASE( StreamedOutputMatchesXmlDocumentSave )
+{
+    for( const wxString& relPath : { "padstacks_complex", "issue5854", "issue18878" } )
+    {
+        BOOST_TEST_CONTEXT( relPath )
+        {
+            KI_TEST::LoadBoard( m_settingsManager, relPath, m_board );
+
+            wxString fileName = wxFileName::CreateTempFileName( wxS( "ipc2581" ) );
+            std::map<std::string, UTF8> props;
+            PCB_IO_IPC2581              exporter;
+
+            exporter.SaveBoard( fileName, m_board.get(), &props );
+
+            std::string streamed;
+
+            {
+                wxFFile file( fileName, wxS( "rb" ) );
+                BOOST_REQUIRE( file.IsOpened() );
+
+                streamed.resize( file.Length() );
+                BOOST_REQUIRE( file.Read( streamed.data(), streamed.size() ) == streamed.size() );
+            }
+
+            wxXmlDocument        doc;
+            wxMemoryOutputStream saved;
+
+            BOOST_REQUIRE( doc.Load( fileName ) );
+            BOOST_REQUIRE( doc.Save( saved ) );
+
+            wxRemoveFile( fileName );
+
+            std::string expected( saved.GetLength(), '\0' );
+            saved.CopyTo( expected.data(), expected.size() );
+
+            BOOST_CHECK_GT( streamed.size(), 0 );
+            BOOST_CHECK( streamed == expected );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
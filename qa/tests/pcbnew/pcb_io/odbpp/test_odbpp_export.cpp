@@ -0,0 +1,324 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+
+#include <pcbnew_utils/board_test_utils.h>
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <pcbnew/pcb_io/odbpp/pcb_io_odbpp.h>
+
+#include <advanced_config.h>
+#include <board.h>
+#include <pcb_track.h>
+#include <scoped_set_reset.h>
+#include <settings/settings_manager.h>
+
+#include <wx/filename.h>
+#include <wx/tarstrm.h>
+#include <wx/wfstream.h>
+#include <wx/zipstrm.h>
+#include <wx/zstream.h>
+
+
+namespace
+{
+
+/// The files of an exported tree, by path relative to its root
+using ODB_TREE = std::map<std::string, std::string>;
+
+
+/**
+ * Read an exported file.  Lines holding the time of the export are dropped, since two exports
+ * can't be expected to agree on them.
+ */
+std::string readContents( std::istream& aStream )
+{
+    std::string       line;
+    std::stringstream contents;
+
+    while( std::getline( aStream, line ) )
+    {
+        if( line.rfind( "CREATION_DATE=", 0 ) == 0 || line.rfind( "SAVE_DATE=", 0 ) == 0
+            || line.rfind( "# ", 0 ) == 0 )
+        {
+            continue;
+        }
+
+        contents << line << '\n';
+    }
+
+    return contents.str();
+}
+
+
+/**
+ * Read every file of the tree under \a aRoot.
+ */
+ODB_TREE readTree( const std::filesystem::path& aRoot )
+{
+    ODB_TREE tree;
+
+    for( const auto& entry : std::filesystem::recursive_directory_iterator( aRoot ) )
+    {
+        if( !entry.is_regular_file() )
+            continue;
+
+        std::ifstream file( entry.path(), std::ios::binary );
+
+        tree[std::filesystem::relative( entry.path(), aRoot ).generic_string()] =
+                readContents( file );
+    }
+
+    return tree;
+}
+
+
+/**
+ * Read every file of the archive \a aFileName.  Paths are taken relative to \a aRootDir, which
+ * every entry of the archive must be in.
+ */
+ODB_TREE readArchive( const wxString& aFileName, const std::string& aFormat,
+                      const std::string& aRootDir )
+{
+    ODB_TREE tree;
+
+    wxFFileInputStream file( aFileName );
+    BOOST_REQUIRE( file.IsOk() );
+
+    std::unique_ptr<wxZlibInputStream>    zlib;
+    std::unique_ptr<wxArchiveInputStream> archive;
+
+    if( aFormat == "zip" )
+    {
+        archive = std::make_unique<wxZipInputStream>( file );
+    }
+    else
+    {
+        zlib = std::make_unique<wxZlibInputStream>( file, wxZLIB_GZIP );
+        archive = std::make_unique<wxTarInputStream>( *zlib );
+    }
+
+    while( std::unique_ptr<wxArchiveEntry> entry{ archive->GetNextEntry() } )
+    {
+        std::string path = entry->GetName( wxPATH_UNIX ).ToStdString();
+
+        BOOST_TEST_CONTEXT( path )
+        {
+            BOOST_REQUIRE( path.rfind( aRootDir, 0 ) == 0 );
+        }
+
+        if( entry->IsDir() )
+            continue;
+
+        std::string data;
+        char        buffer[4096];
+
+        while( archive->Read( buffer, sizeof( buffer ) ).LastRead() > 0 )
+            data.append( buffer, archive->LastRead() );
+
+        std::istringstream contents( data );
+        tree[path.substr( aRootDir.size() )] = readContents( contents );
+    }
+
+    return tree;
+}
+
+
+ODB_TREE exportTree( BOARD* aBoard, bool aParallel )
+{
+    SCOPED_SET_RESET<bool> parallel( KI_TEST::WritableAdvancedCfg().m_ParallelODBPPExport,
+                                     aParallel );
+
+    wxString tempFile = wxFileName::CreateTempFileName( wxS( "odbpp" ) );
+    wxRemoveFile( tempFile );
+
+    std::filesystem::path root( tempFile.ToStdString() );
+    std::filesystem::create_directories( root );
+
+    std::map<std::string, UTF8> props;
+    PCB_IO_ODBPP                exporter;
+
+    exporter.SaveBoard( tempFile, aBoard, &props );
+
+    ODB_TREE tree = readTree( root );
+    std::filesystem::remove_all( root );
+
+    return tree;
+}
+
+
+/**
+ * Export \a aBoard straight into an archive in \a aFormat and read it back.
+ */
+ODB_TREE exportArchive( BOARD* aBoard, const std::string& aFormat, const std::string& aRootDir )
+{
+    wxString tempFile = wxFileName::CreateTempFileName( wxS( "odbpp" ) );
+    wxRemoveFile( tempFile );
+    tempFile += wxS( "." ) + wxString( aFormat );
+
+    std::map<std::string, UTF8> props;
+    PCB_IO_ODBPP                exporter;
+
+    props["compress"] = aFormat;
+    exporter.SaveBoard( tempFile, aBoard, &props );
+
+    ODB_TREE tree = readArchive( tempFile, aFormat, aRootDir );
+    wxRemoveFile( tempFile );
+
+    return tree;
+}
+
+
+/**
+ * Check that \a aTree holds exactly the files of \a aExpected, with the same contents.
+ */
+void checkSameTree( const ODB_TREE& aExpected, const ODB_TREE& aTree )
+{
+    BOOST_REQUIRE_GT( aExpected.size(), 0 );
+    BOOST_REQUIRE_EQUAL( aExpected.size(), aTree.size() );
+
+    for( const auto& [path, contents] : aExpected )
+    {
+        BOOST_TEST_CONTEXT( path )
+        {
+            auto it = aTree.find( path );
+
+            BOOST_REQUIRE( it != aTree.end() );
+            BOOST_CHECK( it->second == contents );
+        }
+    }
+}
+
+} // namespace
+
+
+struct ODBPP_EXPORT_FIXTURE
+{
+    ODBPP_EXPORT_FIXTURE() :
+            m_settingsManager( true /* headless */ )
+    { }
+
+    SETTINGS_MANAGER       m_settingsManager;
+    std::unique_ptr<BOARD> m_board;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( OdbppExport, ODBPP_EXPORT_FIXTURE )
+
+
+/**
+ * Layers are built and written concurrently.  Drill layers, auxiliary layers and component
+ * layers each collect their own items, so the exported tree must be the same as when the
+ * layers are written one at a time.
+ */
+BOOST_AUTO_TEST_CASE( ParallelExportMatchesSequential )
+{
+    // padstacks has through, blind and buried vias, so several drill spans
+    KI_TEST::LoadBoard( m_settingsManager, "padstacks", m_board );
+
+    std::set<std::pair<PCB_LAYER_ID, PCB_LAYER_ID>> drillSpans;
+
+    // Add covering, plugging and filling layers on top of the board's tenting layers
+    for( PCB_TRACK* track : m_board->Tracks() )
+    {
+        if( track->Type() != PCB_VIA_T )
+            continue;
+
+        PCB_VIA* via = static_cast<PCB_VIA*>( track );
+
+        drillSpans.emplace( via->TopLayer(), via->BottomLayer() );
+
+        via->Padstack().FrontOuterLayers().has_covering = true;
+        via->Padstack().BackOuterLayers().has_plugging = true;
+        via->Padstack().Drill().is_filled = true;
+    }
+
+    BOOST_REQUIRE_GE( drillSpans.size(), 2 );
+
+    ODB_TREE sequential = exportTree( m_board.get(), false );
+    ODB_TREE parallel = exportTree( m_board.get(), true );
+
+    BOOST_REQUIRE_GT( sequential.size(), 0 );
+
+    size_t drillLayers = 0;
+    size_t auxLayers = 0;
+
+    for( const auto& [path, contents] : sequential )
+    {
+        if( path.find( "/layers/drill_" ) != std::string::npos
+            && path.find( "/features" ) != std::string::npos )
+        {
+            drillLayers++;
+        }
+
+        if( path.find( "/layers/covering_front/features" ) != std::string::npos
+            || path.find( "/layers/plugging_back/features" ) != std::string::npos )
+        {
+            auxLayers++;
+        }
+    }
+
+    BOOST_CHECK_GE( drillLayers, 2 );
+    BOOST_CHECK_GE( auxLayers, 1 );
+
+    checkSameTree( sequential, parallel );
+}
+
+
+/**
+ * A zip archive holds the tree at its root, and must hold the same files as a directory export.
+ */
+BOOST_AUTO_TEST_CASE( ZipExportMatchesDirectory )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "padstacks", m_board );
+
+    ODB_TREE directory = exportTree( m_board.get(), false );
+    ODB_TREE archive = exportArchive( m_board.get(), "zip", "" );
+
+    checkSameTree( directory, archive );
+}
+
+
+/**
+ * A gzipped tar archive holds the tree in an odb directory, and must hold the same files as a
+ * directory export.
+ */
+BOOST_AUTO_TEST_CASE( TgzExportMatchesDirectory )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "padstacks", m_board );
+
+    ODB_TREE directory = exportTree( m_board.get(), false );
+    ODB_TREE archive = exportArchive( m_board.get(), "tgz", "odb/" );
+
+    checkSameTree( directory, archive );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,175 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <filesystem>
+#include <map>
+
+#include <footprint_info_impl.h>
+#include <fp_lib_table.h>
+#include <paths.h>
+
+#include <wx/dir.h>
+#include <wx/filename.h>
+#include <wx/textfile.h>
+#include <wx/utils.h>
+
+
+namespace fs = std::filesystem;
+
+
+struct FP_LIBRARY_INDEX_TEST_FIXTURE
+{
+    FP_LIBRARY_INDEX_TEST_FIXTURE()
+    {
+        wxString tmpName = wxFileName::CreateTempFileName( wxS( "fp_library_index" ) );
+        wxRemoveFile( tmpName );
+
+        m_tempDir = fs::path( tmpName.ToStdString() );
+        fs::create_directories( m_tempDir );
+
+        m_hadCacheHome = wxGetEnv( wxS( "KICAD_CACHE_HOME" ), &m_cacheHome );
+        wxSetEnv( wxS( "KICAD_CACHE_HOME" ), wxString( ( m_tempDir / "cache" ).string() ) );
+
+        // Work on a copy, as the test changes the library's timestamp
+        fs::path source = fs::path( KI_TEST::GetTestDataRootDir() ) / "libraries"
+                          / "Resistor_SMD.pretty";
+        m_libPath = m_tempDir / "Resistor_SMD.pretty";
+        fs::copy( source, m_libPath );
+
+        m_table.InsertRow( new FP_LIB_TABLE_ROW( wxS( "Resistor_SMD" ),
+                                                 wxString( m_libPath.string() ),
+                                                 wxS( "KiCad" ), wxEmptyString ) );
+    }
+
+    ~FP_LIBRARY_INDEX_TEST_FIXTURE()
+    {
+        if( m_hadCacheHome )
+            wxSetEnv( wxS( "KICAD_CACHE_HOME" ), m_cacheHome );
+        else
+            wxUnsetEnv( wxS( "KICAD_CACHE_HOME" ) );
+
+        std::error_code ec;
+        fs::remove_all( m_tempDir, ec );
+    }
+
+    /// Read the library with a fresh list and return the description of each footprint.
+    std::map<wxString, wxString> readDescriptions()
+    {
+        FOOTPRINT_LIST_IMPL          list;
+        std::map<wxString, wxString> descriptions;
+
+        BOOST_REQUIRE( list.ReadFootprintFiles( &m_table ) );
+
+        for( const std::unique_ptr<FOOTPRINT_INFO>& fpinfo : list.GetList() )
+            descriptions[ fpinfo->GetName() ] = fpinfo->GetDesc();
+
+        return descriptions;
+    }
+
+    wxArrayString indexFiles()
+    {
+        wxFileName dir;
+        dir.AssignDir( PATHS::GetUserCachePath() );
+        dir.AppendDir( wxS( "footprint_index" ) );
+
+        wxArrayString files;
+
+        if( dir.DirExists() )
+            wxDir::GetAllFiles( dir.GetPath(), &files, wxS( "*.idx" ), wxDIR_FILES );
+
+        return files;
+    }
+
+    fs::path     m_tempDir;
+    fs::path     m_libPath;
+    bool         m_hadCacheHome = false;
+    wxString     m_cacheHome;
+    FP_LIB_TABLE m_table;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( FootprintLibraryIndex, FP_LIBRARY_INDEX_TEST_FIXTURE )
+
+
+/**
+ * An unchanged library is read from its index, and a library whose files changed since the
+ * index was written is parsed again.
+ */
+BOOST_AUTO_TEST_CASE( IndexFollowsLibraryTimestamp )
+{
+    std::map<wxString, wxString> parsed = readDescriptions();
+
+    BOOST_REQUIRE_EQUAL( parsed.size(), 6 );
+
+    wxArrayString files = indexFiles();
+    BOOST_REQUIRE_EQUAL( files.size(), 1 );
+
+    // Change the first footprint's description in the index only.  Header, URI, nickname,
+    // timestamp and count come first, then the name and description of each footprint.
+    wxTextFile indexFile( files[0] );
+    BOOST_REQUIRE( indexFile.Open() );
+
+    wxString indexedName = indexFile.GetLine( 5 );
+    indexFile.GetLine( 6 ) = wxS( "from the index" );
+
+    BOOST_REQUIRE( indexFile.Write() );
+    indexFile.Close();
+
+    std::map<wxString, wxString> indexed = readDescriptions();
+
+    BOOST_CHECK_EQUAL( indexed.size(), parsed.size() );
+    BOOST_CHECK_EQUAL( indexed[indexedName], wxS( "from the index" ) );
+
+    // Touching a footprint changes the library timestamp, so the index is out of date
+    wxFileName fpFile( wxString( m_libPath.string() ), indexedName, wxS( "kicad_mod" ) );
+    wxDateTime later = wxDateTime::Now() + wxTimeSpan::Hours( 1 );
+
+    BOOST_REQUIRE( fpFile.SetTimes( &later, &later, nullptr ) );
+
+    std::map<wxString, wxString> reparsed = readDescriptions();
+
+    BOOST_CHECK( reparsed == parsed );
+}
+
+
+BOOST_AUTO_TEST_CASE( PruneRemovesOldIndexes )
+{
+    readDescriptions();
+
+    wxArrayString files = indexFiles();
+    BOOST_REQUIRE_EQUAL( files.size(), 1 );
+
+    FOOTPRINT_LIST_IMPL::PruneLibraryIndexes( 60 );
+    BOOST_CHECK_EQUAL( indexFiles().size(), 1 );
+
+    wxDateTime old = wxDateTime::Now() - wxDateSpan::Days( 90 );
+    BOOST_REQUIRE( wxFileName( files[0] ).SetTimes( &old, &old, nullptr ) );
+
+    FOOTPRINT_LIST_IMPL::PruneLibraryIndexes( 60 );
+    BOOST_CHECK_EQUAL( indexFiles().size(), 0 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
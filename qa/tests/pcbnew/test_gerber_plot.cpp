@@ -0,0 +1,228 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <map>
+#include <sstream>
+#include <string>
+
+#include <pcbnew_utils/board_test_utils.h>
+#include <board.h>
+#include <footprint.h>
+#include <locale_io.h>
+#include <pad.h>
+#include <pcb_plot_params.h>
+#include <pcbplot.h>
+#include <plotters/plotter_gerber.h>
+#include <settings/settings_manager.h>
+#include <thread_pool.h>
+
+#include <wx/filename.h>
+
+
+namespace
+{
+
+/// The Gerber files of a plot, by layer
+using GERBER_FILES = std::map<PCB_LAYER_ID, std::string>;
+
+
+/**
+ * Read a plotted Gerber file.  Lines holding the time of the plot are dropped, since two plots
+ * can't be expected to agree on them; everything else must match byte for byte.
+ */
+std::string readGerber( const std::filesystem::path& aPath )
+{
+    std::ifstream     file( aPath, std::ios::binary );
+    std::string       line;
+    std::stringstream contents;
+
+    while( std::getline( file, line ) )
+    {
+        if( line.rfind( "G04 Created by KiCad", 0 ) == 0
+                || line.rfind( "%TF.CreationDate", 0 ) == 0 )
+        {
+            continue;
+        }
+
+        contents << line << '\n';
+    }
+
+    return contents.str();
+}
+
+
+/**
+ * Plot \a aLayers of \a aBoard the way the Gerber export job does: each layer is started one
+ * after another and then plotted by its own plotter, on the thread pool if \a aParallel.
+ */
+GERBER_FILES plotGerbers( BOARD* aBoard, const LSEQ& aLayers, bool aParallel )
+{
+    wxString tempFile = wxFileName::CreateTempFileName( wxS( "gerber" ) );
+    wxRemoveFile( tempFile );
+
+    std::filesystem::path root( tempFile.ToStdString() );
+    std::filesystem::create_directories( root );
+
+    PCB_PLOT_PARAMS plotOpts;
+    plotOpts.SetFormat( PLOT_FORMAT::GERBER );
+    plotOpts.SetPlotFrameRef( false );
+    plotOpts.SetDrillMarksType( DRILL_MARKS::NO_DRILL_SHAPE );
+    plotOpts.SetUseGerberX2format( true );
+    plotOpts.SetIncludeGerberNetlistInfo( true );
+    plotOpts.SetSubtractMaskFromSilk( true );
+
+    std::map<PCB_LAYER_ID, GERBER_PLOTTER*>        plotters;
+    std::map<PCB_LAYER_ID, std::filesystem::path> paths;
+
+    LOCALE_IO dummy;
+
+    for( PCB_LAYER_ID layer : aLayers )
+    {
+        std::filesystem::path path = root / ( std::to_string( layer ) + ".gbr" );
+        wxString              layerName = aBoard->GetLayerName( layer );
+
+        PLOTTER* plotter = StartPlotBoard( aBoard, &plotOpts, layer, layerName, path.string(),
+                                           wxEmptyString, wxEmptyString );
+
+        plotters[layer] = static_cast<GERBER_PLOTTER*>( plotter );
+        paths[layer] = path;
+
+        BOOST_REQUIRE( plotters[layer] );
+    }
+
+    auto plotLayer =
+            [&]( PCB_LAYER_ID aLayer )
+            {
+                GERBER_PLOTTER* plotter = plotters.at( aLayer );
+
+                PlotBoardLayers( aBoard, plotter, LSEQ( { aLayer } ), plotOpts );
+                plotter->EndPlot();
+            };
+
+    if( aParallel )
+    {
+        BuildPlotCaches( aBoard );
+
+        thread_pool&                   tp = GetKiCadThreadPool();
+        std::vector<std::future<void>> tasks;
+
+        for( PCB_LAYER_ID layer : aLayers )
+        {
+            tasks.push_back( tp.submit(
+                    [&plotLayer, layer]()
+                    {
+                        plotLayer( layer );
+                    } ) );
+        }
+
+        for( std::future<void>& task : tasks )
+            task.get();
+    }
+    else
+    {
+        for( PCB_LAYER_ID layer : aLayers )
+            plotLayer( layer );
+    }
+
+    GERBER_FILES files;
+
+    for( auto& [layer, plotter] : plotters )
+    {
+        delete plotter;
+        files[layer] = readGerber( paths[layer] );
+    }
+
+    std::filesystem::remove_all( root );
+
+    return files;
+}
+
+} // namespace
+
+
+struct GERBER_PLOT_FIXTURE
+{
+    GERBER_PLOT_FIXTURE() :
+            m_settingsManager( true /* headless */ )
+    { }
+
+    SETTINGS_MANAGER       m_settingsManager;
+    std::unique_ptr<BOARD> m_board;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( GerberPlot, GERBER_PLOT_FIXTURE )
+
+
+/**
+ * Layers plotted concurrently share the board's lazily built pad shapes and text glyphs, so
+ * their Gerbers must be the same as when the layers are plotted one at a time.
+ */
+BOOST_AUTO_TEST_CASE( ParallelPlotMatchesSequential )
+{
+    // issue14549 has outline font text on the silkscreen and mask layers
+    KI_TEST::LoadBoard( m_settingsManager, "issue14549", m_board );
+
+    // Give every other pad its own mask and paste margins
+    int padCount = 0;
+
+    for( FOOTPRINT* footprint : m_board->Footprints() )
+    {
+        for( PAD* pad : footprint->Pads() )
+        {
+            if( padCount++ % 2 )
+                continue;
+
+            pad->SetLocalSolderMaskMargin( pcbIUScale.mmToIU( 0.1 ) );
+            pad->SetLocalSolderPasteMargin( pcbIUScale.mmToIU( -0.05 ) );
+        }
+    }
+
+    BOOST_REQUIRE_GT( padCount, 1 );
+
+    LSEQ layers = { F_Cu, B_Cu, F_Mask, B_Mask, F_Paste, F_SilkS, B_SilkS, Edge_Cuts };
+
+    // Plot in parallel first, while nothing has been cached by a plot yet
+    GERBER_FILES parallel = plotGerbers( m_board.get(), layers, true );
+    GERBER_FILES sequential = plotGerbers( m_board.get(), layers, false );
+
+    BOOST_REQUIRE_EQUAL( sequential.size(), layers.size() );
+    BOOST_REQUIRE_EQUAL( parallel.size(), layers.size() );
+
+    for( PCB_LAYER_ID layer : layers )
+    {
+        BOOST_TEST_CONTEXT( m_board->GetLayerName( layer ) )
+        {
+            BOOST_CHECK_GT( sequential[layer].size(), 0 );
+            BOOST_CHECK( sequential[layer] == parallel[layer] );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
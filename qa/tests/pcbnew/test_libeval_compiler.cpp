@@ -93,6 +93,34 @@ const static std::vector<EXPR_TO_TEST> introspectionExpressions = {
 };
 
 
+struct FOLDING_EXPR_TO_TEST
+{
+    wxString expression;
+    bool     expectFolding;
+
+    friend std::ostream& operator<<( std::ostream& os, const FOLDING_EXPR_TO_TEST& expr )
+    {
+        os << expr.expression;
+        return os;
+    }
+};
+
+// Constant subexpressions mixed with properties, which can't be folded
+const static std::vector<FOLDING_EXPR_TO_TEST> foldingExpressions = {
+    { "A.Width + 1mm * 2", true },
+    { "A.Width > 5mil + 4mil", true },
+    { "(1 + 2) * A.Width - B.Width / (4 - 2)", true },
+    { "-(1 + 1) * A.Width", true },
+    { "A.Width == 10mil && 1 < 2", true },
+    { "A.Netclass == 'HV' || 2 * 3 == 7", true },
+    { "!(1 > 2) && B.Width >= 20mil", true },
+    { "A.Width + B.Width * (2 - 2)", true },
+    { "A.Width > B.Width", false },
+    { "A.Netclass + 1.0", false },
+    { "A.type == 'Track' && A.layer == 'F.Cu'", false }
+};
+
+
 static bool testEvalExpr( const wxString& expr, const LIBEVAL::VALUE& expectedResult,
                           bool expectError = false, BOARD_ITEM* itemA = nullptr,
                           BOARD_ITEM* itemB = nullptr )
@@ -144,12 +172,67 @@ static bool testEvalExpr( const wxString& expr, const LIBEVAL::VALUE& expectedRe
 }
 
 
+/**
+ * Compile an expression with and without constant folding, check that both give the same
+ * result and return the number of ops in the folded and unfolded code.
+ */
+static std::pair<size_t, size_t> testFoldedMatchesUnfolded( const wxString& expr,
+                                                            BOARD_ITEM* itemA = nullptr,
+                                                            BOARD_ITEM* itemB = nullptr )
+{
+    PCBEXPR_COMPILER  foldingCompiler( new PCBEXPR_UNIT_RESOLVER() );
+    PCBEXPR_COMPILER  plainCompiler( new PCBEXPR_UNIT_RESOLVER() );
+    PCBEXPR_UCODE     foldedCode;
+    PCBEXPR_UCODE     unfoldedCode;
+    PCBEXPR_CONTEXT   foldedContext( NULL_CONSTRAINT, UNDEFINED_LAYER );
+    PCBEXPR_CONTEXT   unfoldedContext( NULL_CONSTRAINT, UNDEFINED_LAYER );
+    PCBEXPR_CONTEXT   preflightContext( NULL_CONSTRAINT, UNDEFINED_LAYER );
+
+    BOOST_TEST_MESSAGE( "Expr: '" << expr.c_str() << "'" );
+
+    plainCompiler.SetFoldConstants( false );
+
+    BOOST_REQUIRE( foldingCompiler.Compile( expr, &foldedCode, &preflightContext ) );
+    BOOST_REQUIRE( plainCompiler.Compile( expr, &unfoldedCode, &preflightContext ) );
+
+    foldedContext.SetItems( itemA, itemB );
+    unfoldedContext.SetItems( itemA, itemB );
+
+    LIBEVAL::VALUE* folded = foldedCode.Run( &foldedContext );
+    LIBEVAL::VALUE* unfolded = unfoldedCode.Run( &unfoldedContext );
+
+    BOOST_REQUIRE( folded && unfolded );
+    BOOST_CHECK_EQUAL( folded->GetType(), unfolded->GetType() );
+
+    if( unfolded->GetType() == LIBEVAL::VT_NUMERIC )
+        BOOST_CHECK_EQUAL( folded->AsDouble(), unfolded->AsDouble() );
+    else
+        BOOST_CHECK_EQUAL( folded->AsString(), unfolded->AsString() );
+
+    // Each op is dumped on its own line
+    return { foldedCode.Dump().Freq( '\n' ), unfoldedCode.Dump().Freq( '\n' ) };
+}
+
+
 BOOST_DATA_TEST_CASE( SimpleExpressions, boost::unit_test::data::make( simpleExpressions ), expr )
 {
     testEvalExpr( expr.expression, expr.expectedResult, expr.expectError );
 }
 
 
+BOOST_DATA_TEST_CASE( SimpleExpressionsFoldConstants,
+                      boost::unit_test::data::make( simpleExpressions ), expr )
+{
+    // Expressions made only of constants fold to a single value
+    if( !expr.expectError )
+    {
+        auto [foldedOps, unfoldedOps] = testFoldedMatchesUnfolded( expr.expression );
+
+        BOOST_CHECK_EQUAL( foldedOps, 1 );
+    }
+}
+
+
 BOOST_AUTO_TEST_CASE( IntrospectedProperties )
 {
     PROPERTY_MANAGER& propMgr = PROPERTY_MANAGER::Instance();
@@ -185,4 +268,51 @@ BOOST_AUTO_TEST_CASE( IntrospectedProperties )
     }
 }
 
+
+/**
+ * Folding constant subexpressions must not change the result of expressions which also depend
+ * on the items being tested.
+ */
+BOOST_AUTO_TEST_CASE( FoldedPropertyExpressions )
+{
+    PROPERTY_MANAGER& propMgr = PROPERTY_MANAGER::Instance();
+    propMgr.Rebuild();
+
+    BOARD brd;
+
+    std::shared_ptr<NETCLASS> netclass1( new NETCLASS( "HV" ) );
+    std::shared_ptr<NETCLASS> netclass2( new NETCLASS( "otherClass" ) );
+
+    auto net1info = new NETINFO_ITEM( &brd, "net1", 1 );
+    auto net2info = new NETINFO_ITEM( &brd, "net2", 2 );
+
+    net1info->SetNetClass( netclass1 );
+    net2info->SetNetClass( netclass2 );
+
+    PCB_TRACK trackA( &brd );
+    PCB_TRACK trackB( &brd );
+
+    trackA.SetNet( net1info );
+    trackB.SetNet( net2info );
+
+    trackB.SetLayer( F_Cu );
+
+    trackA.SetWidth( pcbIUScale.MilsToIU( 10 ) );
+    trackB.SetWidth( pcbIUScale.MilsToIU( 20 ) );
+
+    for( const FOLDING_EXPR_TO_TEST& expr : foldingExpressions )
+    {
+        BOOST_TEST_CONTEXT( expr.expression )
+        {
+            auto [foldedOps, unfoldedOps] = testFoldedMatchesUnfolded( expr.expression,
+                                                                       &trackA, &trackB );
+
+            if( expr.expectFolding )
+                BOOST_CHECK_LT( foldedOps, unfoldedOps );
+            else
+                BOOST_CHECK_EQUAL( foldedOps, unfoldedOps );
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
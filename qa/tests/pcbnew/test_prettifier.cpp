@@ -140,3 +140,52 @@ BOOST_FIXTURE_TEST_CASE( BoardAndFootprintPrettifier, PRETTIFIER_TEST_FIXTURE )
 
     std::filesystem::remove_all( tempLibPath );
 }
+
+
+/**
+ * The streaming prettifier used when saving must give exactly the same output as Prettify(),
+ * however its input is split up.
+ */
+BOOST_AUTO_TEST_CASE( StreamingPrettifier )
+{
+    std::vector<std::string> cases = {
+        "prettifier/Reverb_BTDR-1V.kicad_mod",
+        "prettifier/group_and_image.kicad_pcb",
+        "issue3812.kicad_pcb"
+    };
+
+    for( const std::string& testCase : cases )
+    {
+        std::ifstream inFp( KI_TEST::GetPcbnewTestDataDir() + testCase );
+        BOOST_REQUIRE( inFp.is_open() );
+
+        std::stringstream inBuf;
+        inBuf << inFp.rdbuf();
+        const std::string inData = inBuf.str();
+
+        for( bool compact : { false, true } )
+        {
+            std::string expected = inData;
+            KICAD_FORMAT::Prettify( expected, compact );
+
+            for( size_t chunkSize : { 1, 3, 17, 4096 } )
+            {
+                BOOST_TEST_CONTEXT( testCase << " compact " << compact << " chunk " << chunkSize )
+                {
+                    KICAD_FORMAT::PRETTIFIER prettifier( compact );
+                    std::string              result;
+
+                    for( size_t ii = 0; ii < inData.length(); ii += chunkSize )
+                    {
+                        size_t count = std::min( chunkSize, inData.length() - ii );
+                        prettifier.Feed( inData.data() + ii, count, result );
+                    }
+
+                    prettifier.Finish( result );
+
+                    BOOST_CHECK( result == expected );
+                }
+            }
+        }
+    }
+}
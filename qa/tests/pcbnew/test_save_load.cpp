@@ -22,15 +22,24 @@
  */
 
 #include <filesystem>
+#include <set>
 
 #include <qa_utils/wx_utils/unit_test_utils.h>
 #include <boost/test/data/test_case.hpp>
 
 #include <pcbnew_utils/board_test_utils.h>
 #include <pcbnew_utils/board_file_utils.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr.h>
+#include <advanced_config.h>
 #include <board.h>
+#include <footprint.h>
+#include <pcb_track.h>
+#include <scoped_set_reset.h>
 #include <settings/settings_manager.h>
 
+#include <wx/ffile.h>
+#include <wx/filename.h>
+
 
 namespace
 {
@@ -59,6 +68,37 @@ const std::vector<wxString> RegressionSaveLoadTests_tests = {
     /* "issue8003", */    // issue8003 is flaky on some platforms
 };
 
+const std::vector<std::string> ParallelLoadTests_tests = {
+    "issue3812",
+    "issue6284",
+    "issue14559",
+    "padstacks_complex",
+    "parallel_load_comments"    // comment lines holding parentheses and quotes
+};
+
+
+/// A uniquely named file in the temp directory, removed when it goes out of scope.
+struct TEMP_BOARD_FILE
+{
+    TEMP_BOARD_FILE( const wxString& aPrefix ) :
+            m_path( wxFileName::CreateTempFileName( aPrefix ).ToStdString() )
+    { }
+
+    ~TEMP_BOARD_FILE() { wxRemoveFile( m_path ); }
+
+    std::string m_path;
+};
+
+
+wxString readFile( const std::string& aPath )
+{
+    wxFFile  file( aPath, wxS( "rb" ) );
+    wxString contents;
+
+    BOOST_REQUIRE( file.IsOpened() && file.ReadAll( &contents ) );
+    return contents;
+}
+
 }; // namespace
 
 
@@ -72,3 +112,95 @@ BOOST_DATA_TEST_CASE_F( SAVE_LOAD_TEST_FIXTURE, RegressionSaveLoadTests,
 
     std::unique_ptr<BOARD> board2 = KI_TEST::ReadBoardFromFileOrStream( savePath.string() );
 }
+
+
+/**
+ * With ParallelBoardLoad set, boards read from a file have their footprints, tracks, vias and
+ * zones parsed concurrently.  Check that this gives exactly the same board as reading them in
+ * order.
+ */
+BOOST_DATA_TEST_CASE_F( SAVE_LOAD_TEST_FIXTURE, ParallelLoadMatchesSequential,
+                        boost::unit_test::data::make( ParallelLoadTests_tests ), relPath )
+{
+    const std::string boardPath = KI_TEST::GetPcbnewTestDataDir() + relPath + ".kicad_pcb";
+    TEMP_BOARD_FILE   sequentialFile( wxS( "sequential_load_tst" ) );
+    TEMP_BOARD_FILE   parallelFile( wxS( "parallel_load_tst" ) );
+
+    // Boards read from a stream are always parsed in order
+    std::unique_ptr<BOARD> sequential = KI_TEST::ReadBoardFromFileOrStream( boardPath );
+    BOOST_REQUIRE( sequential );
+
+    std::unique_ptr<BOARD> parallel;
+
+    {
+        ADVANCED_CFG&          cfg = KI_TEST::WritableAdvancedCfg();
+        SCOPED_SET_RESET<bool> parallelLoad( cfg.m_ParallelBoardLoad, true );
+        PCB_IO_KICAD_SEXPR     io;
+
+        parallel.reset( io.LoadBoard( boardPath, nullptr ) );
+    }
+
+    BOOST_REQUIRE( parallel );
+
+    KI_TEST::DumpBoardToFile( *sequential, sequentialFile.m_path );
+    KI_TEST::DumpBoardToFile( *parallel, parallelFile.m_path );
+
+    BOOST_CHECK( readFile( sequentialFile.m_path ) == readFile( parallelFile.m_path ) );
+}
+
+
+/**
+ * Large boards have their items formatted concurrently when saved.  Check that this gives
+ * exactly the same file as formatting them in order, that the items still come out in the
+ * usual order, and that saving the board again gives the same file.
+ */
+BOOST_DATA_TEST_CASE_F( SAVE_LOAD_TEST_FIXTURE, ParallelSavePreservesOrder,
+                        boost::unit_test::data::make( ParallelLoadTests_tests ), relPath )
+{
+    TEMP_BOARD_FILE sequentialFile( wxS( "sequential_save_tst" ) );
+    TEMP_BOARD_FILE firstFile( wxS( "parallel_save_tst" ) );
+    TEMP_BOARD_FILE secondFile( wxS( "parallel_save_tst" ) );
+
+    KI_TEST::LoadBoard( m_settingsManager, relPath, m_board );
+
+    ADVANCED_CFG& cfg = KI_TEST::WritableAdvancedCfg();
+
+    {
+        SCOPED_SET_RESET<bool> parallelSave( cfg.m_ParallelBoardSave, false );
+        KI_TEST::DumpBoardToFile( *m_board, sequentialFile.m_path );
+    }
+
+    SCOPED_SET_RESET<bool> parallelSave( cfg.m_ParallelBoardSave, true );
+
+    KI_TEST::DumpBoardToFile( *m_board, firstFile.m_path );
+
+    BOOST_CHECK( readFile( sequentialFile.m_path ) == readFile( firstFile.m_path ) );
+
+    std::unique_ptr<BOARD> reloaded = KI_TEST::ReadBoardFromFileOrStream( firstFile.m_path );
+    BOOST_REQUIRE( reloaded );
+
+    std::set<BOARD_ITEM*, BOARD_ITEM::ptr_cmp>  sortedFootprints( m_board->Footprints().begin(),
+                                                                  m_board->Footprints().end() );
+    std::set<PCB_TRACK*, PCB_TRACK::cmp_tracks> sortedTracks( m_board->Tracks().begin(),
+                                                              m_board->Tracks().end() );
+
+    auto checkOrder =
+            []( const auto& aExpected, const auto& aActual )
+            {
+                BOOST_REQUIRE_EQUAL( aExpected.size(), aActual.size() );
+
+                auto expectedIt = aExpected.begin();
+
+                for( const BOARD_ITEM* item : aActual )
+                    BOOST_CHECK( item->m_Uuid == ( *expectedIt++ )->m_Uuid );
+            };
+
+    checkOrder( sortedFootprints, reloaded->Footprints() );
+    checkOrder( sortedTracks, reloaded->Tracks() );
+    BOOST_CHECK_EQUAL( m_board->Zones().size(), reloaded->Zones().size() );
+    BOOST_CHECK_EQUAL( m_board->Drawings().size(), reloaded->Drawings().size() );
+
+    KI_TEST::DumpBoardToFile( *reloaded, secondFile.m_path );
+
+    BOOST_CHECK( readFile( firstFile.m_path ) == readFile( secondFile.m_path ) );
+}
@@ -0,0 +1,290 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <filesystem>
+#include <map>
+#include <set>
+
+#include <pcbnew_utils/board_test_utils.h>
+#include <board.h>
+#include <board_design_settings.h>
+#include <footprint.h>
+#include <paths.h>
+#include <zone.h>
+#include <zone_filler.h>
+#include <zone_fill_cache.h>
+#include <settings/settings_manager.h>
+
+#include <wx/dir.h>
+#include <wx/ffile.h>
+#include <wx/filename.h>
+#include <wx/utils.h>
+
+
+namespace fs = std::filesystem;
+
+
+struct ZONE_FILL_CACHE_TEST_FIXTURE
+{
+    ZONE_FILL_CACHE_TEST_FIXTURE() :
+            m_settingsManager( true /* headless */ )
+    {
+        wxString tmpName = wxFileName::CreateTempFileName( wxS( "zone_fill_cache" ) );
+        wxRemoveFile( tmpName );
+
+        m_tempDir = fs::path( tmpName.ToStdString() );
+        fs::create_directories( m_tempDir );
+
+        m_hadCacheHome = wxGetEnv( wxS( "KICAD_CACHE_HOME" ), &m_cacheHome );
+        wxSetEnv( wxS( "KICAD_CACHE_HOME" ), wxString( m_tempDir.string() ) );
+    }
+
+    ~ZONE_FILL_CACHE_TEST_FIXTURE()
+    {
+        if( m_hadCacheHome )
+            wxSetEnv( wxS( "KICAD_CACHE_HOME" ), m_cacheHome );
+        else
+            wxUnsetEnv( wxS( "KICAD_CACHE_HOME" ) );
+
+        std::error_code ec;
+        fs::remove_all( m_tempDir, ec );
+    }
+
+    /// Fill every zone, through the cache when one is given, and return each layer's fill hash.
+    std::map<std::pair<KIID, PCB_LAYER_ID>, HASH_128> fill( ZONE_FILL_CACHE* aCache )
+    {
+        ZONE_FILLER        filler( m_board.get(), nullptr );
+        std::vector<ZONE*> toFill( m_board->Zones().begin(), m_board->Zones().end() );
+
+        m_board->IncrementTimeStamp();
+
+        filler.SetFillCache( aCache );
+        BOOST_REQUIRE( filler.Fill( toFill ) );
+
+        std::map<std::pair<KIID, PCB_LAYER_ID>, HASH_128> fills;
+
+        for( ZONE* zone : m_board->Zones() )
+        {
+            zone->GetLayerSet().RunOnLayers(
+                    [&]( PCB_LAYER_ID layer )
+                    {
+                        fills[{ zone->m_Uuid, layer }] = zone->GetFilledPolysList( layer )->GetHash();
+                    } );
+        }
+
+        return fills;
+    }
+
+    wxArrayString cacheEntries()
+    {
+        wxFileName dir;
+        dir.AssignDir( PATHS::GetUserCachePath() );
+        dir.AppendDir( wxS( "zone_fills" ) );
+
+        wxArrayString files;
+
+        if( dir.DirExists() )
+            wxDir::GetAllFiles( dir.GetPath(), &files, wxS( "*.fill" ), wxDIR_FILES );
+
+        return files;
+    }
+
+    SETTINGS_MANAGER       m_settingsManager;
+    std::unique_ptr<BOARD> m_board;
+    fs::path               m_tempDir;
+    bool                   m_hadCacheHome = false;
+    wxString               m_cacheHome;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( ZoneFillCache, ZONE_FILL_CACHE_TEST_FIXTURE )
+
+
+/**
+ * Fills read back from the cache must be the fills the zone filler computes.
+ */
+BOOST_AUTO_TEST_CASE( CachedFillsMatchFilledZones )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "zone_filler", m_board );
+
+    std::map<std::pair<KIID, PCB_LAYER_ID>, HASH_128> expected = fill( nullptr );
+
+    BOOST_REQUIRE( !expected.empty() );
+
+    ZONE_FILL_CACHE cache( m_board.get() );
+
+    BOOST_CHECK( fill( &cache ) == expected );      // Filled and stored
+    BOOST_CHECK_EQUAL( cacheEntries().size(), expected.size() );
+
+    BOOST_CHECK( fill( &cache ) == expected );      // Read back
+    BOOST_CHECK_EQUAL( cacheEntries().size(), expected.size() );
+}
+
+
+/**
+ * Keys must not depend on the order the zone filler happens to fill zones in, so filling the
+ * same board twice must store its fills under the same keys.
+ */
+BOOST_AUTO_TEST_CASE( KeysAreStableAcrossFills )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "zone_filler", m_board );
+
+    auto storedKeys =
+            [&]()
+            {
+                std::set<wxString> keys;
+
+                for( const wxString& entry : cacheEntries() )
+                {
+                    keys.insert( wxFileName( entry ).GetName() );
+                    wxRemoveFile( entry );
+                }
+
+                return keys;
+            };
+
+    ZONE_FILL_CACHE cache( m_board.get() );
+
+    std::map<std::pair<KIID, PCB_LAYER_ID>, HASH_128> fills = fill( &cache );
+    std::set<wxString>                                keys = storedKeys();
+
+    BOOST_REQUIRE_EQUAL( keys.size(), fills.size() );
+
+    for( int pass = 0; pass < 2; ++pass )
+    {
+        BOOST_CHECK( fill( &cache ) == fills );
+        BOOST_CHECK( storedKeys() == keys );
+    }
+}
+
+
+/**
+ * Custom rules can test any footprint field, so changing one must change the key of the zones
+ * around the footprint.
+ */
+BOOST_AUTO_TEST_CASE( KeyIncludesFootprintFields )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "zone_filler", m_board );
+
+    int        worstClearance = m_board->GetMaxClearanceValue();
+    ZONE*      zone = nullptr;
+    FOOTPRINT* footprint = nullptr;
+
+    for( ZONE* candidate : m_board->Zones() )
+    {
+        for( FOOTPRINT* fp : m_board->Footprints() )
+        {
+            if( !zone && candidate->GetBoundingBox().Intersects( fp->GetBoundingBox() ) )
+            {
+                zone = candidate;
+                footprint = fp;
+            }
+        }
+    }
+
+    BOOST_REQUIRE( zone && footprint );
+
+    PCB_LAYER_ID    layer = zone->GetLayerSet().Seq().front();
+    ZONE_FILL_CACHE cache( m_board.get() );
+    HASH_128        key = cache.InputHash( zone, layer, worstClearance );
+
+    BOOST_CHECK( cache.InputHash( zone, layer, worstClearance ) == key );
+
+    footprint->SetValue( footprint->GetValue() + wxS( "_changed" ) );
+
+    BOOST_CHECK( cache.InputHash( zone, layer, worstClearance ) != key );
+}
+
+
+/**
+ * A damaged entry claiming more points than it holds must be rejected rather than allocated.
+ */
+BOOST_AUTO_TEST_CASE( DamagedEntryIsIgnored )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "zone_filler", m_board );
+
+    ZONE_FILL_CACHE cache( m_board.get() );
+    HASH_128        key;
+    SHAPE_POLY_SET  square;
+    SHAPE_POLY_SET  readBack;
+
+    square.NewOutline();
+    square.Append( 0, 0 );
+    square.Append( 1000, 0 );
+    square.Append( 1000, 1000 );
+    square.Append( 0, 1000 );
+
+    key.Value64[0] = 1;
+    key.Value64[1] = 2;
+
+    cache.Store( key, square );
+
+    BOOST_REQUIRE( cache.Lookup( key, readBack ) );
+    BOOST_CHECK( readBack.GetHash() == square.GetHash() );
+
+    wxArrayString entries = cacheEntries();
+    BOOST_REQUIRE_EQUAL( entries.size(), 1 );
+
+    // Keep the magic and version, then claim one polygon with a huge contour
+    int32_t header[2];
+
+    {
+        wxFFile file( entries[0], wxS( "rb" ) );
+        BOOST_REQUIRE( file.Read( header, sizeof( header ) ) == sizeof( header ) );
+    }
+
+    {
+        const int32_t damaged[] = { header[0], header[1], 1, 1, INT32_MAX, 0, 0 };
+        wxFFile       file( entries[0], wxS( "wb" ) );
+
+        BOOST_REQUIRE( file.Write( damaged, sizeof( damaged ) ) == sizeof( damaged ) );
+    }
+
+    BOOST_CHECK( !cache.Lookup( key, readBack ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( PruneRemovesUnusedEntries )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "zone_filler", m_board );
+
+    ZONE_FILL_CACHE cache( m_board.get() );
+    fill( &cache );
+
+    wxArrayString entries = cacheEntries();
+    BOOST_REQUIRE( !entries.empty() );
+
+    ZONE_FILL_CACHE::Prune( 30 );
+    BOOST_CHECK_EQUAL( cacheEntries().size(), entries.size() );
+
+    wxDateTime old = wxDateTime::Now() - wxDateSpan::Days( 45 );
+    BOOST_REQUIRE( wxFileName( entries[0] ).SetTimes( &old, &old, nullptr ) );
+
+    ZONE_FILL_CACHE::Prune( 30 );
+    BOOST_CHECK_EQUAL( cacheEntries().size(), entries.size() - 1 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -25,12 +25,15 @@
 #include <boost/test/data/test_case.hpp>
 
 #include <pcbnew_utils/board_test_utils.h>
+#include <advanced_config.h>
 #include <board.h>
 #include <board_design_settings.h>
 #include <pad.h>
+#include <scoped_set_reset.h>
 #include <pcb_track.h>
 #include <footprint.h>
 #include <zone.h>
+#include <zone_filler.h>
 #include <drc/drc_item.h>
 #include <settings/settings_manager.h>
 
@@ -340,4 +343,144 @@ BOOST_FIXTURE_TEST_CASE( RegressionNetTie, ZONE_FILL_TEST_FIXTURE )
             }
         }
     }
-}
\ No newline at end of file
+}
+
+
+namespace
+{
+
+using ZONE_FILLS = std::map<std::pair<KIID, PCB_LAYER_ID>, SHAPE_POLY_SET>;
+
+
+ZONE_FILLS fillAllZones( BOARD* aBoard, const std::map<KIID, BOX2I>& aDirtyRegions = {} )
+{
+    ZONE_FILLER        filler( aBoard, nullptr );
+    std::vector<ZONE*> toFill( aBoard->Zones().begin(), aBoard->Zones().end() );
+    ZONE_FILLS         fills;
+
+    aBoard->IncrementTimeStamp();    // Clear caches
+
+    filler.SetDirtyRegions( aDirtyRegions );
+    BOOST_REQUIRE( filler.Fill( toFill ) );
+
+    for( ZONE* zone : aBoard->Zones() )
+    {
+        zone->GetLayerSet().RunOnLayers(
+                [&]( PCB_LAYER_ID layer )
+                {
+                    fills[{ zone->m_Uuid, layer }] = *zone->GetFilledPolysList( layer );
+                } );
+    }
+
+    return fills;
+}
+
+
+/**
+ * Fills computed piecewise have extra vertices along the seams, so compare the areas they
+ * cover: anything left of the difference once slivers of the max error are removed is a real
+ * difference.
+ */
+void checkSameFills( const ZONE_FILLS& aExpected, const ZONE_FILLS& aActual, int aMaxError )
+{
+    BOOST_REQUIRE_EQUAL( aExpected.size(), aActual.size() );
+
+    for( const auto& [ key, expected ] : aExpected )
+    {
+        BOOST_TEST_CONTEXT( "zone " << key.first.AsStdString() << " layer " << key.second )
+        {
+            SHAPE_POLY_SET diff;
+
+            diff.BooleanXor( expected, aActual.at( key ) );
+            diff.Deflate( aMaxError, CORNER_STRATEGY::ROUND_ALL_CORNERS, aMaxError );
+
+            BOOST_CHECK( diff.IsEmpty() );
+        }
+    }
+}
+
+} // namespace
+
+
+/**
+ * Refilling only the region around an edit must give the fill a full refill gives, including
+ * when the edit is a thermal relief reaching further than any clearance.
+ */
+BOOST_FIXTURE_TEST_CASE( IncrementalFillMatchesFullFill, ZONE_FILL_TEST_FIXTURE )
+{
+    ADVANCED_CFG&          cfg = KI_TEST::WritableAdvancedCfg();
+    SCOPED_SET_RESET<bool> incremental( cfg.m_IncrementalZoneFill, true );
+
+    KI_TEST::LoadBoard( m_settingsManager, "zone_filler", m_board );
+
+    fillAllZones( m_board.get() );
+
+    PAD* pad = nullptr;
+
+    for( PAD* candidate : m_board->GetPads() )
+    {
+        for( ZONE* zone : m_board->Zones() )
+        {
+            if( !pad && candidate->SameNet( zone )
+                    && ( candidate->GetLayerSet() & zone->GetLayerSet() ).any()
+                    && zone->GetBoundingBox().Contains( candidate->GetBoundingBox() ) )
+            {
+                pad = candidate;
+            }
+        }
+    }
+
+    BOOST_REQUIRE( pad );
+
+    // What a commit reports as damaged: the pad itself
+    BOX2I damage = pad->GetBoundingBox();
+
+    pad->SetLocalZoneConnection( ZONE_CONNECTION::THERMAL );
+    pad->SetLocalThermalGapOverride( pcbIUScale.mmToIU( 2.0 ) );
+
+    std::map<KIID, BOX2I> dirtyRegions;
+
+    for( ZONE* zone : m_board->Zones() )
+    {
+        if( zone->GetBoundingBox().Intersects( damage ) )
+            dirtyRegions[ zone->m_Uuid ] = damage;
+    }
+
+    ZONE_FILLS incrementalFills = fillAllZones( m_board.get(), dirtyRegions );
+    ZONE_FILLS fullFills = fillAllZones( m_board.get() );
+
+    checkSameFills( fullFills, incrementalFills, m_board->GetDesignSettings().m_MaxError );
+}
+
+
+/**
+ * Zones filled as concurrent tiles must come out the same as zones filled in one piece.
+ */
+BOOST_FIXTURE_TEST_CASE( TiledFillMatchesUntiledFill, ZONE_FILL_TEST_FIXTURE )
+{
+    ADVANCED_CFG& cfg = KI_TEST::WritableAdvancedCfg();
+
+    for( const wxString& relPath : { "zone_filler", "notched_zones", "issue16182" } )
+    {
+        BOOST_TEST_CONTEXT( relPath )
+        {
+            KI_TEST::LoadBoard( m_settingsManager, relPath, m_board );
+
+            ZONE_FILLS untiledFills;
+            ZONE_FILLS tiledFills;
+
+            {
+                SCOPED_SET_RESET<int> untiled( cfg.m_ZoneFillTileThreshold, 0 );
+                untiledFills = fillAllZones( m_board.get() );
+            }
+
+            {
+                // Tile every zone with anything in it
+                SCOPED_SET_RESET<int> tiled( cfg.m_ZoneFillTileThreshold, 1 );
+                tiledFills = fillAllZones( m_board.get() );
+            }
+
+            checkSameFills( untiledFills, tiledFills, m_board->GetDesignSettings().m_MaxError );
+        }
+    }
+}
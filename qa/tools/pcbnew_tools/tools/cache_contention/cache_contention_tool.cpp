@@ -0,0 +1,266 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file cache_contention_tool.cpp
+ *
+ * Contention benchmark for the board's rule-function caches (intersectsArea(),
+ * enclosedByArea(), intersectsCourtyard(), ...).
+ *
+ * Each worker thread performs a DRC-like mix of lookups on a shared cache, computing and
+ * inserting on a miss.  The same workload is run against a single std::shared_mutex guarding
+ * a std::unordered_map (the previous BOARD layout) and against the SHARDED_CACHE used now, for
+ * increasing thread counts, and the timings are written as JSON.
+ */
+
+#include <qa_utils/utility_registry.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <wx/cmdline.h>
+#include <wx/msgout.h>
+
+#include <nlohmann/json.hpp>
+
+#include <board.h>
+#include <core/profile.h>
+#include <core/sharded_cache.h>
+
+
+/// The cache layout BOARD used before SHARDED_CACHE: every access goes through one lock.
+class SINGLE_MUTEX_CACHE
+{
+public:
+    bool Get( const PTR_PTR_LAYER_CACHE_KEY& aKey, bool& aValue ) const
+    {
+        std::shared_lock<std::shared_mutex> readLock( m_mutex );
+
+        auto it = m_map.find( aKey );
+
+        if( it == m_map.end() )
+            return false;
+
+        aValue = it->second;
+        return true;
+    }
+
+    void Set( const PTR_PTR_LAYER_CACHE_KEY& aKey, bool aValue )
+    {
+        std::unique_lock<std::shared_mutex> writeLock( m_mutex );
+        m_map[ aKey ] = aValue;
+    }
+
+    void Clear()
+    {
+        std::unique_lock<std::shared_mutex> writeLock( m_mutex );
+        m_map.clear();
+    }
+
+private:
+    mutable std::shared_mutex                         m_mutex;
+    std::unordered_map<PTR_PTR_LAYER_CACHE_KEY, bool> m_map;
+};
+
+
+/**
+ * Stand-in for the geometry test done on a cache miss.  Keeps a miss much more expensive than
+ * a hit, as it is in DRC, without depending on a real board.
+ */
+static bool computeResult( const PTR_PTR_LAYER_CACHE_KEY& aKey, int aWork )
+{
+    uint64_t x = reinterpret_cast<uintptr_t>( aKey.A ) ^ reinterpret_cast<uintptr_t>( aKey.B );
+
+    for( int ii = 0; ii < aWork; ++ii )
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+
+    return ( x >> 63 ) != 0;
+}
+
+
+/**
+ * Run the workload on \a aCache with \a aThreads threads.
+ *
+ * @return wall time in milliseconds.
+ */
+template <typename CACHE>
+static double runWorkload( CACHE& aCache, const std::vector<PTR_PTR_LAYER_CACHE_KEY>& aKeys,
+                           int aThreads, long aOpsPerThread, int aMissWork )
+{
+    aCache.Clear();
+
+    std::atomic<bool>        go( false );
+    std::atomic<int>         ready( 0 );
+    std::vector<std::thread> threads;
+
+    for( int t = 0; t < aThreads; ++t )
+    {
+        threads.emplace_back(
+                [&, t]()
+                {
+                    std::minstd_rand rng( 1234 + t );
+
+                    ready.fetch_add( 1 );
+
+                    while( !go.load( std::memory_order_acquire ) )
+                        std::this_thread::yield();
+
+                    for( long ii = 0; ii < aOpsPerThread; ++ii )
+                    {
+                        const PTR_PTR_LAYER_CACHE_KEY& key = aKeys[ rng() % aKeys.size() ];
+                        bool                           value = false;
+
+                        if( !aCache.Get( key, value ) )
+                            aCache.Set( key, computeResult( key, aMissWork ) );
+                    }
+                } );
+    }
+
+    while( ready.load() < aThreads )
+        std::this_thread::yield();
+
+    PROF_TIMER timer;
+    go.store( true, std::memory_order_release );
+
+    for( std::thread& thread : threads )
+        thread.join();
+
+    timer.Stop();
+    return timer.msecs();
+}
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    { wxCMD_LINE_SWITCH, "h", "help", _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_OPTION, "t", "threads", _( "maximum number of threads (default: all "
+                                            "hardware threads)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, "k", "keys", _( "number of distinct cache keys (default: 200000)" )
+                                              .mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, "n", "operations", _( "lookups per thread (default: 1000000)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, "w", "miss-work", _( "relative cost of a cache miss (default: 200)" )
+                                                   .mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_NONE }
+};
+
+
+int cache_contention_main_func( int argc, char** argv )
+{
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText( _( "This program measures lock contention on the board's rule "
+                               "caches for increasing thread counts and reports the results "
+                               "as JSON." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+
+    if( cmd_parsed_ok != 0 )
+    {
+        // Help and invalid input both stop here
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    long maxThreads = std::max( 1U, std::thread::hardware_concurrency() );
+    long keyCount = 200000;
+    long opsPerThread = 1000000;
+    long missWork = 200;
+
+    cl_parser.Found( "threads", &maxThreads );
+    cl_parser.Found( "keys", &keyCount );
+    cl_parser.Found( "operations", &opsPerThread );
+    cl_parser.Found( "miss-work", &missWork );
+
+    maxThreads = std::max( 1L, maxThreads );
+    keyCount = std::max( 1L, keyCount );
+
+    // Keys are item pairs on a handful of layers, as DRC generates.  The pointers are only
+    // hashed and compared, never dereferenced.
+    std::vector<PTR_PTR_LAYER_CACHE_KEY> keys;
+    std::minstd_rand                     rng( 42 );
+
+    for( long ii = 0; ii < keyCount; ++ii )
+    {
+        auto fakeItem =
+                [&]()
+                {
+                    return reinterpret_cast<BOARD_ITEM*>( static_cast<uintptr_t>( rng() ) * 64 );
+                };
+
+        keys.push_back( { fakeItem(), fakeItem(), static_cast<PCB_LAYER_ID>( rng() % 4 ) } );
+    }
+
+    SINGLE_MUTEX_CACHE                           singleMutex;
+    SHARDED_CACHE<PTR_PTR_LAYER_CACHE_KEY, bool> sharded;
+    nlohmann::json                               results;
+
+    results["keys"] = keyCount;
+    results["operations_per_thread"] = opsPerThread;
+    results["miss_work"] = missWork;
+    results["runs"] = nlohmann::json::array();
+
+    std::vector<long> threadCounts;
+
+    for( long threads = 1; threads < maxThreads; threads *= 2 )
+        threadCounts.push_back( threads );
+
+    threadCounts.push_back( maxThreads );
+
+    for( long threads : threadCounts )
+    {
+        std::cerr << "Threads: " << threads << std::endl;
+
+        double singleMs = runWorkload( singleMutex, keys, threads, opsPerThread, missWork );
+        double shardedMs = runWorkload( sharded, keys, threads, opsPerThread, missWork );
+        double totalOps = static_cast<double>( threads ) * opsPerThread;
+
+        nlohmann::json run;
+        run["threads"] = threads;
+        run["single_mutex_ms"] = singleMs;
+        run["sharded_ms"] = shardedMs;
+        run["single_mutex_mops_per_s"] = totalOps / singleMs / 1000.0;
+        run["sharded_mops_per_s"] = totalOps / shardedMs / 1000.0;
+        results["runs"].push_back( run );
+    }
+
+    std::cout << results.dump( 2 ) << std::endl;
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( { "cache_contention",
+                                                       "Measure thread contention on the "
+                                                       "board's rule caches",
+                                                       cache_contention_main_func } );
@@ -0,0 +1,290 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file drc_broad_phase_tool.cpp
+ *
+ * Benchmark for the copper clearance broad phase.
+ *
+ * A dense BGA fanout is generated: a grid of SMD pads, each with a dogbone track to a through
+ * via, and an escape track from each via on one of the inner layers.  Candidate colliders of
+ * every track and via are then found both by searching the copper item R-tree once per item
+ * and layer (DRC_RTREE::QueryColliding()) and by sweeping each layer
+ * (DRC_RTREE::SweepColliding()).  Both must find the same collisions; the timings are written
+ * as JSON.
+ */
+
+#include <qa_utils/utility_registry.h>
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include <wx/cmdline.h>
+#include <wx/msgout.h>
+
+#include <nlohmann/json.hpp>
+
+#include <board.h>
+#include <core/profile.h>
+#include <drc/drc_rtree.h>
+#include <footprint.h>
+#include <pad.h>
+#include <pcb_track.h>
+
+
+struct FANOUT_PARAMS
+{
+    int balls = 40;                             ///< per side of the ball grid
+    int pitch = pcbIUScale.mmToIU( 0.8 );
+    int padSize = pcbIUScale.mmToIU( 0.4 );
+    int trackWidth = pcbIUScale.mmToIU( 0.1 );
+    int viaSize = pcbIUScale.mmToIU( 0.4 );
+    int viaDrill = pcbIUScale.mmToIU( 0.2 );
+    int copperLayers = 8;
+};
+
+
+static void buildFanout( BOARD& aBoard, const FANOUT_PARAMS& aParams )
+{
+    aBoard.SetCopperLayerCount( aParams.copperLayers );
+
+    std::vector<PCB_LAYER_ID> innerLayers;
+
+    for( PCB_LAYER_ID layer : LSET::InternalCuMask().Seq() )
+    {
+        if( aBoard.IsLayerEnabled( layer ) )
+            innerLayers.push_back( layer );
+    }
+
+    FOOTPRINT* footprint = new FOOTPRINT( &aBoard );
+    aBoard.Add( footprint );
+
+    const int gridEnd = aParams.balls * aParams.pitch;
+
+    for( int row = 0; row < aParams.balls; ++row )
+    {
+        for( int col = 0; col < aParams.balls; ++col )
+        {
+            VECTOR2I ball( col * aParams.pitch, row * aParams.pitch );
+            VECTOR2I viaPos = ball + VECTOR2I( aParams.pitch / 2, aParams.pitch / 2 );
+
+            PAD* pad = new PAD( footprint );
+            pad->SetAttribute( PAD_ATTRIB::SMD );
+            pad->SetLayerSet( PAD::SMDMask() );
+            pad->SetShape( PADSTACK::ALL_LAYERS, PAD_SHAPE::CIRCLE );
+            pad->SetSize( PADSTACK::ALL_LAYERS, VECTOR2I( aParams.padSize, aParams.padSize ) );
+            pad->SetPosition( ball );
+            footprint->Add( pad );
+
+            PCB_TRACK* dogbone = new PCB_TRACK( &aBoard );
+            dogbone->SetLayer( F_Cu );
+            dogbone->SetWidth( aParams.trackWidth );
+            dogbone->SetStart( ball );
+            dogbone->SetEnd( viaPos );
+            aBoard.Add( dogbone );
+
+            PCB_VIA* via = new PCB_VIA( &aBoard );
+            via->SetViaType( VIATYPE::THROUGH );
+            via->SetLayerPair( F_Cu, B_Cu );
+            via->SetPosition( viaPos );
+            via->SetWidth( aParams.viaSize );
+            via->SetDrill( aParams.viaDrill );
+            aBoard.Add( via );
+
+            // Escape to the right of the grid, spreading rows over the inner layers
+            if( !innerLayers.empty() )
+            {
+                PCB_TRACK* escape = new PCB_TRACK( &aBoard );
+                escape->SetLayer( innerLayers[( row + col ) % innerLayers.size()] );
+                escape->SetWidth( aParams.trackWidth );
+                escape->SetStart( viaPos );
+                escape->SetEnd( VECTOR2I( gridEnd + aParams.pitch, viaPos.y ) );
+                aBoard.Add( escape );
+            }
+        }
+    }
+}
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    { wxCMD_LINE_SWITCH, "h", "help", _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_OPTION, "b", "balls", _( "balls per side of the BGA (default: 40)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, "l", "layers", _( "number of copper layers (default: 8)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, "c", "clearance", _( "clearance in micrometres (default: 100)" )
+                                                   .mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, "n", "iterations", _( "number of times to run each method "
+                                               "(default: 3)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_NONE }
+};
+
+
+enum DRC_BROAD_PHASE_RET_CODES
+{
+    RESULTS_DIFFER = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+};
+
+
+int drc_broad_phase_main_func( int argc, char** argv )
+{
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText( _( "This program compares per-item R-tree queries with a sweep over "
+                               "each layer for finding copper clearance candidates on a "
+                               "generated BGA fanout, and reports the results as JSON." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+
+    if( cmd_parsed_ok != 0 )
+    {
+        // Help and invalid input both stop here
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    FANOUT_PARAMS params;
+    long          balls = params.balls;
+    long          layers = params.copperLayers;
+    long          clearanceUm = 100;
+    long          iterations = 3;
+
+    cl_parser.Found( "balls", &balls );
+    cl_parser.Found( "layers", &layers );
+    cl_parser.Found( "clearance", &clearanceUm );
+    cl_parser.Found( "iterations", &iterations );
+
+    params.balls = std::max( 1L, balls );
+    params.copperLayers = std::clamp( layers, 2L, 32L ) & ~1L;
+    iterations = std::max( 1L, iterations );
+
+    const int clearance = pcbIUScale.mmToIU( clearanceUm / 1000.0 );
+
+    BOARD board;
+    buildFanout( board, params );
+
+    LSET      copperLayers = LSET::AllCuMask( board.GetCopperLayerCount() );
+    DRC_RTREE tree;
+
+    auto insert =
+            [&]( BOARD_ITEM* aItem )
+            {
+                LSET itemLayers = aItem->GetLayerSet() & copperLayers;
+
+                if( aItem->Type() == PCB_PAD_T && static_cast<PAD*>( aItem )->HasHole() )
+                    itemLayers = copperLayers;
+
+                for( PCB_LAYER_ID layer : itemLayers.Seq() )
+                    tree.Insert( aItem, layer, clearance );
+            };
+
+    for( PCB_TRACK* track : board.Tracks() )
+        insert( track );
+
+    for( FOOTPRINT* footprint : board.Footprints() )
+    {
+        for( PAD* pad : footprint->Pads() )
+            insert( pad );
+    }
+
+    auto isTrack =
+            []( BOARD_ITEM* aItem )
+            {
+                return aItem->Type() == PCB_TRACE_T || aItem->Type() == PCB_VIA_T;
+            };
+
+    PROF_TIMER timer;
+    double     queryMs = 0.0;
+    double     sweepMs = 0.0;
+    long       queryHits = 0;
+    long       sweepHits = 0;
+    size_t     candidatePairs = 0;
+
+    for( long ii = 0; ii < iterations; ++ii )
+    {
+        queryHits = 0;
+        timer.Start();
+
+        for( PCB_TRACK* track : board.Tracks() )
+        {
+            for( PCB_LAYER_ID layer : LSET( track->GetLayerSet() & copperLayers ).Seq() )
+                queryHits += tree.QueryColliding( track, layer, layer, nullptr, nullptr, clearance );
+        }
+
+        timer.Stop();
+        queryMs += timer.msecs();
+
+        sweepHits = 0;
+        candidatePairs = 0;
+        timer.Start();
+
+        for( PCB_LAYER_ID layer : copperLayers.Seq() )
+        {
+            DRC_RTREE::SWEPT_PAIRS pairs = tree.SweepColliding( layer, clearance, isTrack );
+
+            candidatePairs += pairs.size();
+
+            for( PCB_TRACK* track : board.Tracks() )
+            {
+                if( track->IsOnLayer( layer ) )
+                    sweepHits += pairs.QueryColliding( track, layer, nullptr, nullptr, clearance );
+            }
+        }
+
+        timer.Stop();
+        sweepMs += timer.msecs();
+    }
+
+    nlohmann::json results;
+
+    results["balls"] = params.balls;
+    results["copper_layers"] = params.copperLayers;
+    results["clearance_um"] = clearanceUm;
+    results["tracks"] = board.Tracks().size();
+    results["tree_entries"] = tree.size();
+    results["iterations"] = iterations;
+    results["query_ms_mean"] = queryMs / iterations;
+    results["sweep_ms_mean"] = sweepMs / iterations;
+    results["query_collisions"] = queryHits;
+    results["sweep_collisions"] = sweepHits;
+    results["sweep_candidate_pairs"] = candidatePairs;
+
+    std::cout << results.dump( 2 ) << std::endl;
+
+    if( queryHits != sweepHits )
+    {
+        std::cerr << "Sweep and query found different collisions" << std::endl;
+        return DRC_BROAD_PHASE_RET_CODES::RESULTS_DIFFER;
+    }
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( { "drc_broad_phase",
+                                                       "Compare copper clearance broad phases "
+                                                       "on a generated BGA fanout",
+                                                       drc_broad_phase_main_func } );
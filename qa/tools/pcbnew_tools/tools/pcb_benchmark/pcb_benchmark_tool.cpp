@@ -0,0 +1,596 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file pcb_benchmark_tool.cpp
+ *
+ * Repeatable performance harness for the board-level operations which dominate batch jobs:
+ * loading, zone filling, connectivity, DRC (in total and per test provider) and saving.
+ *
+ * Results are written as JSON so that runs against the same reference boards can be compared
+ * between builds.  No reference boards are shipped with the tool; any boards can be given, for
+ * instance the larger boards in qa/data/pcbnew.  Each phase reports wall time, process CPU time
+ * and the utilization of each thread (the thread's CPU time divided by wall time) for the
+ * calling thread and every thread of the pool; the process's peak resident set size is reported
+ * after each board.
+ */
+
+#include <qa_utils/utility_registry.h>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include <wx/cmdline.h>
+#include <wx/filename.h>
+#include <wx/msgout.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <pthread.h>
+#include <sys/resource.h>
+#include <time.h>
+#ifdef __APPLE__
+#include <mach/mach.h>
+#endif
+#endif
+
+#include <nlohmann/json.hpp>
+
+#include <board.h>
+#include <board_design_settings.h>
+#include <build_version.h>
+#include <core/profile.h>
+#include <drc/drc_engine.h>
+#include <drc/drc_item.h>
+#include <drc/drc_test_provider.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr.h>
+#include <pgm_base.h>
+#include <project.h>
+#include <settings/settings_manager.h>
+#include <thread_pool.h>
+#include <wildcards_and_files_ext.h>
+#include <zone.h>
+#include <zone_filler.h>
+
+
+/// CPU time consumed by the whole process so far, and its peak resident set size.
+struct RESOURCE_USAGE
+{
+    double cpuMs = 0.0;
+    long   peakRssKb = 0;
+};
+
+
+static RESOURCE_USAGE sampleResourceUsage()
+{
+    RESOURCE_USAGE usage;
+
+#ifdef _WIN32
+    FILETIME creation, exit, kernel, user;
+
+    if( GetProcessTimes( GetCurrentProcess(), &creation, &exit, &kernel, &user ) )
+    {
+        auto toMs =
+                []( const FILETIME& aTime )
+                {
+                    ULARGE_INTEGER ticks;
+                    ticks.LowPart = aTime.dwLowDateTime;
+                    ticks.HighPart = aTime.dwHighDateTime;
+                    return ticks.QuadPart / 10000.0;     // 100ns ticks
+                };
+
+        usage.cpuMs = toMs( kernel ) + toMs( user );
+    }
+
+    PROCESS_MEMORY_COUNTERS counters;
+
+    if( K32GetProcessMemoryInfo( GetCurrentProcess(), &counters, sizeof( counters ) ) )
+        usage.peakRssKb = static_cast<long>( counters.PeakWorkingSetSize / 1024 );
+#else
+    struct rusage ru;
+
+    if( getrusage( RUSAGE_SELF, &ru ) == 0 )
+    {
+        usage.cpuMs = ( ru.ru_utime.tv_sec + ru.ru_stime.tv_sec ) * 1000.0
+                      + ( ru.ru_utime.tv_usec + ru.ru_stime.tv_usec ) / 1000.0;
+
+#ifdef __APPLE__
+        usage.peakRssKb = ru.ru_maxrss / 1024;      // bytes on macOS
+#else
+        usage.peakRssKb = ru.ru_maxrss;             // kilobytes on Linux and the BSDs
+#endif
+    }
+#endif
+
+    return usage;
+}
+
+
+/// A thread whose CPU time can be sampled from any other thread.
+struct BENCHMARK_THREAD
+{
+#if defined( _WIN32 )
+    // The thread handle is owned, and closed when the thread is no longer sampled
+    BENCHMARK_THREAD() = default;
+
+    BENCHMARK_THREAD( BENCHMARK_THREAD&& aOther ) noexcept :
+            handle( std::exchange( aOther.handle, nullptr ) )
+    {}
+
+    BENCHMARK_THREAD& operator=( BENCHMARK_THREAD&& aOther ) noexcept
+    {
+        std::swap( handle, aOther.handle );
+        return *this;
+    }
+
+    BENCHMARK_THREAD( const BENCHMARK_THREAD& ) = delete;
+    BENCHMARK_THREAD& operator=( const BENCHMARK_THREAD& ) = delete;
+
+    ~BENCHMARK_THREAD()
+    {
+        if( handle )
+            CloseHandle( handle );
+    }
+
+    HANDLE      handle = nullptr;
+#elif defined( __APPLE__ )
+    mach_port_t port;
+#else
+    clockid_t   clock;
+#endif
+};
+
+
+/// Identify the calling thread, so that its CPU time can be sampled later.
+static BENCHMARK_THREAD currentThread()
+{
+    BENCHMARK_THREAD thread;
+
+#if defined( _WIN32 )
+    thread.handle = OpenThread( THREAD_QUERY_LIMITED_INFORMATION, FALSE, GetCurrentThreadId() );
+#elif defined( __APPLE__ )
+    thread.port = pthread_mach_thread_np( pthread_self() );
+#else
+    pthread_getcpuclockid( pthread_self(), &thread.clock );
+#endif
+
+    return thread;
+}
+
+
+/// CPU time consumed by the given thread so far.
+static double sampleThreadCpuMs( const BENCHMARK_THREAD& aThread )
+{
+#if defined( _WIN32 )
+    FILETIME creation, exit, kernel, user;
+
+    if( aThread.handle && GetThreadTimes( aThread.handle, &creation, &exit, &kernel, &user ) )
+    {
+        auto toMs =
+                []( const FILETIME& aTime )
+                {
+                    ULARGE_INTEGER ticks;
+                    ticks.LowPart = aTime.dwLowDateTime;
+                    ticks.HighPart = aTime.dwHighDateTime;
+                    return ticks.QuadPart / 10000.0;     // 100ns ticks
+                };
+
+        return toMs( kernel ) + toMs( user );
+    }
+#elif defined( __APPLE__ )
+    thread_basic_info_data_t info;
+    mach_msg_type_number_t   count = THREAD_BASIC_INFO_COUNT;
+
+    if( thread_info( aThread.port, THREAD_BASIC_INFO, (thread_info_t) &info, &count )
+            == KERN_SUCCESS )
+    {
+        return ( info.user_time.seconds + info.system_time.seconds ) * 1000.0
+               + ( info.user_time.microseconds + info.system_time.microseconds ) / 1000.0;
+    }
+#else
+    struct timespec ts;
+
+    if( clock_gettime( aThread.clock, &ts ) == 0 )
+        return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+#endif
+
+    return 0.0;
+}
+
+
+/**
+ * Identify the calling thread and every thread of the pool.
+ *
+ * Each pool thread is given one task, and every task waits until all of them have started so
+ * that no thread can pick up a second one.
+ */
+static std::vector<BENCHMARK_THREAD> benchmarkThreads()
+{
+    thread_pool&                   tp = GetKiCadThreadPool();
+    size_t                         poolSize = tp.get_thread_count();
+    std::vector<BENCHMARK_THREAD>  threads( poolSize + 1 );
+    std::atomic<size_t>            started = 0;
+    std::promise<void>             allStarted;
+    std::shared_future<void>       allStartedFuture = allStarted.get_future().share();
+    std::vector<std::future<void>> tasks;
+
+    threads[0] = currentThread();
+
+    for( size_t ii = 0; ii < poolSize; ++ii )
+    {
+        tasks.push_back( tp.submit(
+                [&, ii]()
+                {
+                    threads[ii + 1] = currentThread();
+
+                    if( ++started == poolSize )
+                        allStarted.set_value();
+
+                    allStartedFuture.wait();
+                } ) );
+    }
+
+    for( std::future<void>& task : tasks )
+        task.wait();
+
+    return threads;
+}
+
+
+/// Wall and CPU time of each iteration of a single benchmarked phase.
+class PHASE_TIMINGS
+{
+public:
+    template <typename FUNC>
+    void Measure( const std::vector<BENCHMARK_THREAD>& aThreads, FUNC&& aFunc )
+    {
+        std::vector<double> threadCpuMs( aThreads.size() );
+
+        for( size_t ii = 0; ii < aThreads.size(); ++ii )
+            threadCpuMs[ii] = sampleThreadCpuMs( aThreads[ii] );
+
+        RESOURCE_USAGE before = sampleResourceUsage();
+        PROF_TIMER     timer;
+
+        aFunc();
+
+        timer.Stop();
+        RESOURCE_USAGE after = sampleResourceUsage();
+
+        for( size_t ii = 0; ii < aThreads.size(); ++ii )
+            threadCpuMs[ii] = sampleThreadCpuMs( aThreads[ii] ) - threadCpuMs[ii];
+
+        Add( timer.msecs(), after.cpuMs - before.cpuMs, threadCpuMs );
+    }
+
+    void Add( double aWallMs, double aCpuMs, const std::vector<double>& aThreadCpuMs )
+    {
+        m_wallMs.push_back( aWallMs );
+        m_cpuMs.push_back( aCpuMs );
+
+        m_threadCpuMs.resize( aThreadCpuMs.size(), 0.0 );
+
+        for( size_t ii = 0; ii < aThreadCpuMs.size(); ++ii )
+            m_threadCpuMs[ii] += aThreadCpuMs[ii];
+    }
+
+    nlohmann::json ToJson() const
+    {
+        nlohmann::json j = nlohmann::json::object();
+
+        if( m_wallMs.empty() )
+            return j;
+
+        std::vector<double> sorted = m_wallMs;
+        std::sort( sorted.begin(), sorted.end() );
+
+        double wallSum = std::accumulate( m_wallMs.begin(), m_wallMs.end(), 0.0 );
+        double cpuSum = std::accumulate( m_cpuMs.begin(), m_cpuMs.end(), 0.0 );
+
+        j["iterations"] = m_wallMs.size();
+        j["wall_ms_min"] = sorted.front();
+        j["wall_ms_median"] = sorted[sorted.size() / 2];
+        j["wall_ms_mean"] = wallSum / m_wallMs.size();
+        j["cpu_ms_mean"] = cpuSum / m_cpuMs.size();
+        j["wall_ms"] = m_wallMs;
+
+        // The calling thread first, then the pool threads
+        nlohmann::json& utilization = j["thread_utilization"];
+        utilization = nlohmann::json::array();
+
+        for( double threadCpuMs : m_threadCpuMs )
+            utilization.push_back( wallSum > 0.0 ? threadCpuMs / wallSum : 0.0 );
+
+        return j;
+    }
+
+private:
+    std::vector<double> m_wallMs;
+    std::vector<double> m_cpuMs;
+    std::vector<double> m_threadCpuMs;      ///< total over all iterations, per thread
+};
+
+
+static BOARD* loadBoard( const wxFileName& aBoardFile, PROJECT* aProject )
+{
+    PCB_IO_KICAD_SEXPR io;
+
+    return io.LoadBoard( aBoardFile.GetFullPath(), nullptr, nullptr, aProject );
+}
+
+
+static nlohmann::json benchmarkBoard( const wxFileName& aBoardFile, int aIterations,
+                                      const std::vector<BENCHMARK_THREAD>& aThreads )
+{
+    SETTINGS_MANAGER& mgr = Pgm().GetSettingsManager();
+    wxFileName        projectFile( aBoardFile );
+    wxFileName        rulesFile( aBoardFile );
+
+    projectFile.SetExt( FILEEXT::ProjectFileExtension );
+    rulesFile.SetExt( FILEEXT::DesignRulesFileExtension );
+
+    bool loadedProject = projectFile.FileExists() && mgr.LoadProject( projectFile.GetFullPath() );
+
+    PROJECT*               project = &mgr.Prj();
+    std::unique_ptr<BOARD> board;
+    PHASE_TIMINGS          loadTimings;
+
+    for( int ii = 0; ii < aIterations; ++ii )
+    {
+        // Free the previous board outside the timed section
+        if( board )
+        {
+            board->SetProject( nullptr );
+            board.reset();
+        }
+
+        loadTimings.Measure( aThreads,
+                [&]()
+                {
+                    board.reset( loadBoard( aBoardFile, project ) );
+                } );
+    }
+
+    board->SetProject( project );
+
+    BOARD_DESIGN_SETTINGS&      bds = board->GetDesignSettings();
+    std::shared_ptr<DRC_ENGINE> drcEngine = std::make_shared<DRC_ENGINE>( board.get(), &bds );
+
+    drcEngine->InitEngine( rulesFile.FileExists() ? rulesFile : wxFileName() );
+    bds.m_DRCEngine = drcEngine;
+    board->BuildListOfNets();
+
+    PHASE_TIMINGS connectivityTimings;
+    PHASE_TIMINGS fillTimings;
+    PHASE_TIMINGS drcTimings;
+    PHASE_TIMINGS saveTimings;
+    size_t        violations = 0;
+
+    std::map<wxString, PHASE_TIMINGS> providerTimings;
+
+    for( int ii = 0; ii < aIterations; ++ii )
+    {
+        connectivityTimings.Measure( aThreads,
+                [&]()
+                {
+                    board->BuildConnectivity();
+                } );
+    }
+
+    std::vector<ZONE*> toFill( board->Zones().begin(), board->Zones().end() );
+
+    for( int ii = 0; ii < aIterations; ++ii )
+    {
+        board->IncrementTimeStamp();
+
+        fillTimings.Measure( aThreads,
+                [&]()
+                {
+                    ZONE_FILLER filler( board.get(), nullptr );
+                    filler.Fill( toFill );
+                } );
+
+        board->BuildConnectivity();
+    }
+
+    drcEngine->SetViolationHandler(
+            [&]( const std::shared_ptr<DRC_ITEM>& aItem, const VECTOR2I& aPos, int aLayer,
+                 DRC_CUSTOM_MARKER_HANDLER* aCustomHandler )
+            {
+                violations++;
+            } );
+
+    for( int ii = 0; ii < aIterations; ++ii )
+    {
+        violations = 0;
+
+        drcTimings.Measure( aThreads,
+                [&]()
+                {
+                    drcEngine->RunTests( EDA_UNITS::MM, true, false );
+                } );
+
+        // Re-run each provider alone against the caches generated by the full run.  The error
+        // counts are reset for each one, so that it stops at the same limits as in the full run.
+        size_t totalViolations = violations;
+
+        for( DRC_TEST_PROVIDER* provider : drcEngine->GetTestProviders() )
+        {
+            providerTimings[provider->GetName()].Measure( aThreads,
+                    [&]()
+                    {
+                        drcEngine->RunProvider( provider, EDA_UNITS::MM );
+                    } );
+        }
+
+        violations = totalViolations;
+    }
+
+    drcEngine->ClearViolationHandler();
+
+    wxString savePath = wxFileName::CreateTempFileName( wxS( "pcb_benchmark" ) );
+
+    for( int ii = 0; ii < aIterations; ++ii )
+    {
+        saveTimings.Measure( aThreads,
+                [&]()
+                {
+                    PCB_IO_KICAD_SEXPR io;
+                    io.SaveBoard( savePath, board.get() );
+                } );
+    }
+
+    wxRemoveFile( savePath );
+
+    nlohmann::json result;
+
+    result["board"] = aBoardFile.GetFullPath().ToStdString();
+    result["footprints"] = board->Footprints().size();
+    result["tracks"] = board->Tracks().size();
+    result["zones"] = board->Zones().size();
+    result["nets"] = board->GetNetCount();
+    result["drc_violations"] = violations;
+
+    nlohmann::json& phases = result["phases"];
+
+    phases["load"] = loadTimings.ToJson();
+    phases["connectivity"] = connectivityTimings.ToJson();
+    phases["zone_fill"] = fillTimings.ToJson();
+    phases["drc"] = drcTimings.ToJson();
+    phases["save"] = saveTimings.ToJson();
+
+    for( const auto& [ name, timings ] : providerTimings )
+        phases["drc_providers"][name.ToStdString()] = timings.ToJson();
+
+    result["peak_rss_kb"] = sampleResourceUsage().peakRssKb;
+
+    board->SetProject( nullptr );
+
+    if( loadedProject )
+        mgr.UnloadProject( project, false );
+
+    return result;
+}
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    { wxCMD_LINE_SWITCH, "h", "help", _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_OPTION, "n", "iterations", _( "number of times to run each phase" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, "o", "output", _( "write the JSON results to this file rather than "
+                                           "stdout" ).mb_str(),
+            wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_PARAM, nullptr, nullptr, _( "board file" ).mb_str(), wxCMD_LINE_VAL_STRING,
+            wxCMD_LINE_PARAM_MULTIPLE },
+    { wxCMD_LINE_NONE }
+};
+
+
+enum PCB_BENCHMARK_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+    WRITE_FAILED,
+};
+
+
+int pcb_benchmark_main_func( int argc, char** argv )
+{
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText( _( "This program times loading, zone filling, connectivity, DRC and "
+                               "saving of the given boards and reports the results as JSON. "
+                               "Projects and custom rules are loaded from alongside each "
+                               "board." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+
+    if( cmd_parsed_ok != 0 )
+    {
+        // Help and invalid input both stop here
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    long iterations = 3;
+    cl_parser.Found( "iterations", &iterations );
+    iterations = std::max( 1L, iterations );
+
+    std::vector<BENCHMARK_THREAD> threads = benchmarkThreads();
+    nlohmann::json                results;
+
+    results["version"] = GetBuildVersion().ToStdString();
+    results["threads"] = GetKiCadThreadPool().get_thread_count();
+    results["boards"] = nlohmann::json::array();
+
+    for( size_t ii = 0; ii < cl_parser.GetParamCount(); ++ii )
+    {
+        wxFileName boardFile( cl_parser.GetParam( ii ) );
+        boardFile.MakeAbsolute();
+
+        std::cerr << "Benchmarking: " << boardFile.GetFullPath() << std::endl;
+
+        try
+        {
+            results["boards"].push_back( benchmarkBoard( boardFile, iterations, threads ) );
+        }
+        catch( const IO_ERROR& ioe )
+        {
+            std::cerr << ioe.What() << std::endl;
+            return PCB_BENCHMARK_RET_CODES::LOAD_FAILED;
+        }
+    }
+
+    wxString outputPath;
+
+    if( cl_parser.Found( "output", &outputPath ) )
+    {
+        std::ofstream out( outputPath.ToStdString() );
+
+        if( !out )
+            return PCB_BENCHMARK_RET_CODES::WRITE_FAILED;
+
+        out << results.dump( 2 ) << std::endl;
+    }
+    else
+    {
+        std::cout << results.dump( 2 ) << std::endl;
+    }
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( { "pcb_benchmark",
+                                                       "Time zone fill, DRC, connectivity and "
+                                                       "load/save of PCB files",
+                                                       pcb_benchmark_main_func } );